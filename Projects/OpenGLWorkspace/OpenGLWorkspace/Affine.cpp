@@ -0,0 +1,178 @@
+#include "affine.h"
+
+#include <cmath>
+
+#include "cpu_features.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+Affine::Affine()
+{
+	rows[0] = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
+	rows[1] = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
+	rows[2] = glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
+}
+
+Affine::Affine(const glm::mat4& m)
+{
+	for (int r = 0; r < 3; r++)
+		rows[r] = glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]);
+}
+
+glm::mat4 Affine::toMat4() const
+{
+	glm::mat4 m;
+	for (int c = 0; c < 4; c++)
+		m[c] = glm::vec4(rows[0][c], rows[1][c], rows[2][c], c == 3 ? 1.0f : 0.0f);
+	return m;
+}
+
+Affine affineTranslate(const glm::vec3& offset)
+{
+	Affine a;
+	a.rows[0].w = offset.x;
+	a.rows[1].w = offset.y;
+	a.rows[2].w = offset.z;
+	return a;
+}
+
+Affine affineRotate(float angle, const glm::vec3& axis)
+{
+	float c = std::cos(angle), s = std::sin(angle);
+	glm::vec3 n = glm::normalize(axis);
+	glm::vec3 t = n * (1.0f - c);
+	Affine a;
+	a.rows[0] = glm::vec4(c + t.x * n.x, t.y * n.x - s * n.z, t.z * n.x + s * n.y, 0.0f);
+	a.rows[1] = glm::vec4(t.x * n.y + s * n.z, c + t.y * n.y, t.z * n.y - s * n.x, 0.0f);
+	a.rows[2] = glm::vec4(t.x * n.z - s * n.y, t.y * n.z + s * n.x, c + t.z * n.z, 0.0f);
+	return a;
+}
+
+Affine affineScale(const glm::vec3& factors)
+{
+	Affine a;
+	a.rows[0].x = factors.x;
+	a.rows[1].y = factors.y;
+	a.rows[2].z = factors.z;
+	return a;
+}
+
+#ifdef CPU_X86
+// row r of a * b: a's row spread over b's rows, plus a's translation, which
+// b's implicit 0 0 0 1 row passes through
+static inline __m128 composeRow(__m128 row, __m128 b0, __m128 b1, __m128 b2, __m128 translation)
+{
+	__m128 sum = _mm_add_ps(_mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0),
+		_mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+	sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+	return _mm_add_ps(sum, _mm_and_ps(row, translation));
+}
+
+static inline void compose(const Affine& a, const Affine& b, Affine& out)
+{
+	const __m128 translation = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	__m128 b0 = _mm_loadu_ps(&b.rows[0].x), b1 = _mm_loadu_ps(&b.rows[1].x), b2 = _mm_loadu_ps(&b.rows[2].x);
+	__m128 r0 = composeRow(_mm_loadu_ps(&a.rows[0].x), b0, b1, b2, translation);
+	__m128 r1 = composeRow(_mm_loadu_ps(&a.rows[1].x), b0, b1, b2, translation);
+	__m128 r2 = composeRow(_mm_loadu_ps(&a.rows[2].x), b0, b1, b2, translation);
+	_mm_storeu_ps(&out.rows[0].x, r0);
+	_mm_storeu_ps(&out.rows[1].x, r1);
+	_mm_storeu_ps(&out.rows[2].x, r2);
+}
+#else
+static inline void compose(const Affine& a, const Affine& b, Affine& out)
+{
+	Affine r;
+	for (int i = 0; i < 3; i++)
+	{
+		const glm::vec4& row = a.rows[i];
+		r.rows[i] = row.x * b.rows[0] + row.y * b.rows[1] + row.z * b.rows[2] + glm::vec4(0.0f, 0.0f, 0.0f, row.w);
+	}
+	out = r;
+}
+#endif
+
+Affine operator*(const Affine& a, const Affine& b)
+{
+	Affine out;
+	compose(a, b, out);
+	return out;
+}
+
+glm::vec3 transformPoint(const Affine& a, const glm::vec3& point)
+{
+	glm::vec4 p(point, 1.0f);
+	return glm::vec3(glm::dot(a.rows[0], p), glm::dot(a.rows[1], p), glm::dot(a.rows[2], p));
+}
+
+glm::vec3 transformDirection(const Affine& a, const glm::vec3& direction)
+{
+	glm::vec4 d(direction, 0.0f);
+	return glm::vec3(glm::dot(a.rows[0], d), glm::dot(a.rows[1], d), glm::dot(a.rows[2], d));
+}
+
+Affine inverse(const Affine& a)
+{
+	glm::vec3 r0(a.rows[0]), r1(a.rows[1]), r2(a.rows[2]);
+	// the inverse's columns are the cross products of the other two rows
+	glm::vec3 c0 = glm::cross(r1, r2), c1 = glm::cross(r2, r0), c2 = glm::cross(r0, r1);
+	float determinant = glm::dot(r0, c0);
+	if (determinant == 0.0f)
+		return Affine();
+	float scale = 1.0f / determinant;
+	glm::vec3 t = a.translation();
+	Affine result;
+	for (int i = 0; i < 3; i++)
+	{
+		glm::vec3 row = glm::vec3(c0[i], c1[i], c2[i]) * scale;
+		result.rows[i] = glm::vec4(row, -glm::dot(row, t));
+	}
+	return result;
+}
+
+Affine inverseRigid(const Affine& a)
+{
+	glm::vec3 t = a.translation();
+	Affine result;
+	for (int i = 0; i < 3; i++)
+	{
+		glm::vec3 row(a.rows[0][i], a.rows[1][i], a.rows[2][i]);
+		result.rows[i] = glm::vec4(row, -glm::dot(row, t));
+	}
+	return result;
+}
+
+void propagateAffine(const Affine* local, const int* parent, Affine* world, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		if (parent[i] < 0)
+			world[i] = local[i];
+		else
+			compose(world[parent[i]], local[i], world[i]);
+	}
+}
+
+void affineToMat4(const Affine* in, glm::mat4* out, size_t count)
+{
+#ifdef CPU_X86
+	// the 3 rows plus 0 0 0 1 transposed into 4 columns
+	const __m128 bottom = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+	for (size_t i = 0; i < count; i++)
+	{
+		__m128 r0 = _mm_loadu_ps(&in[i].rows[0].x), r1 = _mm_loadu_ps(&in[i].rows[1].x);
+		__m128 r2 = _mm_loadu_ps(&in[i].rows[2].x), r3 = bottom;
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		float* m = &out[i][0][0];
+		_mm_storeu_ps(m, r0);
+		_mm_storeu_ps(m + 4, r1);
+		_mm_storeu_ps(m + 8, r2);
+		_mm_storeu_ps(m + 12, r3);
+	}
+#else
+	for (size_t i = 0; i < count; i++)
+		out[i] = in[i].toMat4();
+#endif
+}
@@ -0,0 +1,169 @@
+#include "asset_cache.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include "asset_pack.h"
+#include "stb_image.h"
+
+// bump whenever cookTexture's output changes so old entries stop matching
+static const uint32_t textureCookVersion = 2;
+
+// cooked texture file: this header, then the mip chain
+struct CookedTextureHeader
+{
+	char magic[4];			// "ACTX"
+	uint32_t version;
+	uint64_t sourceHash;
+	uint64_t sourceSize;
+	int32_t width;
+	int32_t height;
+	int32_t levels;
+	uint32_t reserved;
+};
+
+static_assert(sizeof(CookedTextureHeader) == 40, "CookedTextureHeader must not have padding");
+
+static size_t chainBytes(int width, int height, int levels)
+{
+	size_t bytes = 0;
+	for (int level = 0; level < levels; level++)
+		bytes += (size_t)std::max(1, width >> level) * std::max(1, height >> level) * 4;
+	return bytes;
+}
+
+AssetCache::AssetCache(const AssetFS& assets, const std::string& directory)
+	: assets(assets), directory(directory)
+{
+#ifdef _WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+}
+
+std::string AssetCache::textureKey(const unsigned char* source, size_t size, const TextureCookSettings& settings)
+{
+	static const char* filters[] = { "box", "kaiser", "lanczos" };
+	const MipSettings& mips = settings.mipSettings;
+	char key[96];
+	if (settings.mipmaps)
+		std::snprintf(key, sizeof(key), "%016llx-%llx-t%u%s-%s%s-c%g", (unsigned long long)assetContentHash(source, size),
+			(unsigned long long)size, textureCookVersion, settings.flipVertically ? "f" : "",
+			filters[(int)mips.filter], mips.srgb ? "-srgb" : "", mips.alphaCoverage);
+	else
+		std::snprintf(key, sizeof(key), "%016llx-%llx-t%u%s", (unsigned long long)assetContentHash(source, size),
+			(unsigned long long)size, textureCookVersion, settings.flipVertically ? "f" : "");
+	return key;
+}
+
+bool AssetCache::texture(const std::string& path, const TextureCookSettings& settings, CookedTexture& texture)
+{
+	Asset source = assets.read(path);
+	if (!source)
+	{
+		std::cout << "ERROR::ASSET_CACHE::SOURCE_NOT_FOUND " << path << std::endl;
+		counters.failures++;
+		return false;
+	}
+	return this->texture(source.data(), source.size(), settings, texture);
+}
+
+bool AssetCache::texture(const unsigned char* source, size_t size, const TextureCookSettings& settings, CookedTexture& texture)
+{
+	uint64_t sourceHash = assetContentHash(source, size);
+	std::string file = directory + "/" + textureKey(source, size, settings) + ".tex";
+	if (readTexture(file, sourceHash, size, texture))
+	{
+		counters.hits++;
+		return true;
+	}
+	if (!cookTexture(source, size, settings, texture))
+	{
+		counters.failures++;
+		return false;
+	}
+	counters.cooks++;
+	// a store that can't be written only costs the next run a decode
+	if (!writeTexture(file, sourceHash, size, texture))
+		std::cout << "ERROR::ASSET_CACHE::CANNOT_WRITE " << file << std::endl;
+	return true;
+}
+
+bool AssetCache::cookTexture(const unsigned char* source, size_t size, const TextureCookSettings& settings, CookedTexture& texture)
+{
+	if (size > INT_MAX)
+		return false;
+	int width, height, channels;
+	// flip on this thread only, so the app's global stb_image setting doesn't leak into the key
+	stbi_set_flip_vertically_on_load_thread(settings.flipVertically ? 1 : 0);
+	unsigned char* pixels = stbi_load_from_memory(source, (int)size, &width, &height, &channels, 4);
+	stbi_set_flip_vertically_on_load_thread(-1);
+	if (!pixels)
+		return false;
+
+	texture.width = width;
+	texture.height = height;
+	if (settings.mipmaps)
+		texture.levels = generateMips(pixels, width, height, settings.mipSettings, texture.pixels);
+	else
+	{
+		texture.levels = 1;
+		texture.pixels.assign(pixels, pixels + (size_t)width * height * 4);
+	}
+	stbi_image_free(pixels);
+	return true;
+}
+
+bool AssetCache::readTexture(const std::string& file, uint64_t sourceHash, uint64_t sourceSize, CookedTexture& texture) const
+{
+	std::ifstream in(file, std::ios::binary);
+	CookedTextureHeader header;
+	if (!in.read((char*)&header, sizeof(header)))
+		return false;
+	// the key already says all this; checking it again catches truncated or foreign files
+	if (std::memcmp(header.magic, "ACTX", 4) != 0 || header.version != textureCookVersion ||
+		header.sourceHash != sourceHash || header.sourceSize != sourceSize ||
+		header.width <= 0 || header.height <= 0 || header.levels <= 0 || header.levels > 32)
+		return false;
+	texture.width = header.width;
+	texture.height = header.height;
+	texture.levels = header.levels;
+	texture.pixels.resize(chainBytes(header.width, header.height, header.levels));
+	return (bool)in.read((char*)texture.pixels.data(), texture.pixels.size()) && in.peek() == EOF;
+}
+
+bool AssetCache::writeTexture(const std::string& file, uint64_t sourceHash, uint64_t sourceSize, const CookedTexture& texture) const
+{
+	CookedTextureHeader header;
+	std::memcpy(header.magic, "ACTX", 4);
+	header.version = textureCookVersion;
+	header.sourceHash = sourceHash;
+	header.sourceSize = sourceSize;
+	header.width = texture.width;
+	header.height = texture.height;
+	header.levels = texture.levels;
+	header.reserved = 0;
+
+	// write under a temporary name so a reader never sees half a file
+	std::string temporary = file + ".tmp";
+	{
+		std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+		out.write((const char*)&header, sizeof(header));
+		out.write((const char*)texture.pixels.data(), texture.pixels.size());
+		if (!out)
+			return false;
+	}
+	std::remove(file.c_str());
+	return std::rename(temporary.c_str(), file.c_str()) == 0;
+}
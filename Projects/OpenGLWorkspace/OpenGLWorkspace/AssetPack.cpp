@@ -0,0 +1,396 @@
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// the structs are written to disk as they are
+static_assert(sizeof(AssetPackHeader) == 40, "AssetPackHeader must not have padding");
+static_assert(sizeof(AssetPackEntry) == 32, "AssetPackEntry must not have padding");
+
+std::string assetPathNormalize(const std::string& path)
+{
+	std::string normalized(path);
+	std::replace(normalized.begin(), normalized.end(), '\\', '/');
+	while (normalized.compare(0, 2, "./") == 0)
+		normalized.erase(0, 2);
+	return normalized;
+}
+
+uint64_t assetPathHash(const std::string& path)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : path)
+	{
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+uint64_t assetContentHash(const unsigned char* data, size_t size)
+{
+	const uint64_t m = 0xc6a4a7935bd1e995ull;
+	const int r = 47;
+	uint64_t hash = 0x9e3779b97f4a7c15ull ^ (size * m);
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8)
+	{
+		uint64_t k;
+		std::memcpy(&k, data + i, 8);
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+		hash ^= k;
+		hash *= m;
+	}
+	if (i < size)
+	{
+		uint64_t tail = 0;
+		for (size_t j = size; j > i; j--)
+			tail = (tail << 8) | data[j - 1];
+		hash ^= tail;
+		hash *= m;
+	}
+	hash ^= hash >> r;
+	hash *= m;
+	hash ^= hash >> r;
+	return hash;
+}
+
+static bool readFile(const std::string& path, std::vector<unsigned char>& data)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+	data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return !file.bad();
+}
+
+// entries are ordered by hash, and by name within a hash so collisions still have one order
+static bool entryLess(uint64_t hashA, const char* nameA, size_t lengthA, uint64_t hashB, const char* nameB, size_t lengthB)
+{
+	if (hashA != hashB)
+		return hashA < hashB;
+	int order = std::memcmp(nameA, nameB, std::min(lengthA, lengthB));
+	return order != 0 ? order < 0 : lengthA < lengthB;
+}
+
+AssetPack::AssetPack()
+	: base(nullptr), length(0), header(nullptr), index(nullptr), names(nullptr)
+#ifdef _WIN32
+	, file(INVALID_HANDLE_VALUE), mapping(nullptr)
+#endif
+{
+}
+
+AssetPack::~AssetPack()
+{
+	close();
+}
+
+bool AssetPack::open(const std::string& path)
+{
+	close();
+#ifdef _WIN32
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+	LARGE_INTEGER fileSize;
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		std::cout << "ERROR::ASSET_PACK::CANNOT_OPEN " << path << std::endl;
+		close();
+		return false;
+	}
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	base = mapping ? (const unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	length = (size_t)fileSize.QuadPart;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	struct stat info;
+	if (fd < 0 || fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		std::cout << "ERROR::ASSET_PACK::CANNOT_OPEN " << path << std::endl;
+		if (fd >= 0)
+			::close(fd);
+		return false;
+	}
+	length = (size_t)info.st_size;
+	void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping keeps the file alive
+	::close(fd);
+	base = mapped != MAP_FAILED ? (const unsigned char*)mapped : nullptr;
+#endif
+	if (!base)
+	{
+		std::cout << "ERROR::ASSET_PACK::CANNOT_MAP " << path << std::endl;
+		close();
+		return false;
+	}
+	if (!validate(path))
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool AssetPack::validate(const std::string& path)
+{
+	if (length < sizeof(AssetPackHeader))
+	{
+		std::cout << "ERROR::ASSET_PACK::TRUNCATED " << path << std::endl;
+		return false;
+	}
+	header = (const AssetPackHeader*)base;
+	if (std::memcmp(header->magic, "APAK", 4) != 0 || header->version != assetPackVersion)
+	{
+		std::cout << "ERROR::ASSET_PACK::NOT_A_PACK " << path << std::endl;
+		return false;
+	}
+	// every offset is checked once here so find() can trust the index
+	uint64_t indexEnd = sizeof(AssetPackHeader) + (uint64_t)header->count * sizeof(AssetPackEntry);
+	if (header->fileSize != length || indexEnd > header->namesOffset ||
+		header->namesOffset > length || header->namesSize > length - header->namesOffset)
+	{
+		std::cout << "ERROR::ASSET_PACK::TRUNCATED " << path << std::endl;
+		return false;
+	}
+	index = (const AssetPackEntry*)(base + sizeof(AssetPackHeader));
+	names = (const char*)base + header->namesOffset;
+	for (uint32_t i = 0; i < header->count; i++)
+	{
+		const AssetPackEntry& entry = index[i];
+		bool inBounds = entry.offset <= length && entry.size <= length - entry.offset &&
+			(uint64_t)entry.nameOffset + entry.nameLength <= header->namesSize;
+		bool sorted = i == 0 || entryLess(index[i - 1].hash, names + index[i - 1].nameOffset, index[i - 1].nameLength,
+			entry.hash, names + entry.nameOffset, entry.nameLength);
+		if (!inBounds || !sorted)
+		{
+			std::cout << "ERROR::ASSET_PACK::BAD_INDEX " << path << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+void AssetPack::close()
+{
+#ifdef _WIN32
+	if (base)
+		UnmapViewOfFile(base);
+	if (mapping)
+		CloseHandle(mapping);
+	if (file != INVALID_HANDLE_VALUE)
+		CloseHandle(file);
+	mapping = nullptr;
+	file = INVALID_HANDLE_VALUE;
+#else
+	if (base)
+		munmap((void*)base, length);
+#endif
+	base = nullptr;
+	length = 0;
+	header = nullptr;
+	index = nullptr;
+	names = nullptr;
+}
+
+const unsigned char* AssetPack::find(const std::string& path, size_t* size) const
+{
+	if (!base)
+		return nullptr;
+	std::string name = assetPathNormalize(path);
+	uint64_t hash = assetPathHash(name);
+	const AssetPackEntry* end = index + header->count;
+	const AssetPackEntry* entry = std::lower_bound(index, end, hash,
+		[](const AssetPackEntry& e, uint64_t h) { return e.hash < h; });
+	for (; entry != end && entry->hash == hash; ++entry)
+	{
+		if (entry->nameLength == name.size() && std::memcmp(names + entry->nameOffset, name.data(), name.size()) == 0)
+		{
+			*size = (size_t)entry->size;
+			return base + entry->offset;
+		}
+	}
+	return nullptr;
+}
+
+std::string AssetPack::name(uint32_t i) const
+{
+	if (i >= count())
+		return std::string();
+	return std::string(names + index[i].nameOffset, index[i].nameLength);
+}
+
+AssetPackWriter::AssetPackWriter(uint32_t alignment)
+	: alignment(std::max(alignment, 1u)), shared(0), savedBytes(0)
+{
+}
+
+bool AssetPackWriter::addFile(const std::string& name, const std::string& path)
+{
+	std::vector<unsigned char> data;
+	if (contains(name) || !readFile(path, data))
+		return false;
+	add(name, std::move(data));
+	return true;
+}
+
+void AssetPackWriter::add(const std::string& name, std::vector<unsigned char> data)
+{
+	Item item;
+	item.name = assetPathNormalize(name);
+	item.hash = assetPathHash(item.name);
+	item.blob = items.size();
+	uint64_t contentHash = assetContentHash(data.data(), data.size());
+	auto range = blobs.equal_range(contentHash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (items[it->second].data == data)
+		{
+			item.blob = it->second;
+			shared++;
+			savedBytes += data.size();
+			break;
+		}
+	}
+	if (item.blob == items.size())
+	{
+		blobs.insert(std::make_pair(contentHash, item.blob));
+		item.data = std::move(data);
+	}
+	names.insert(item.name);
+	items.push_back(std::move(item));
+}
+
+bool AssetPackWriter::contains(const std::string& name) const
+{
+	return names.count(assetPathNormalize(name)) != 0;
+}
+
+bool AssetPackWriter::write(const std::string& path) const
+{
+	std::vector<const Item*> sorted;
+	for (const Item& item : items)
+		sorted.push_back(&item);
+	std::sort(sorted.begin(), sorted.end(), [](const Item* a, const Item* b) {
+		return entryLess(a->hash, a->name.data(), a->name.size(), b->hash, b->name.data(), b->name.size());
+	});
+
+	AssetPackHeader header;
+	std::memcpy(header.magic, "APAK", 4);
+	header.version = assetPackVersion;
+	header.count = (uint32_t)sorted.size();
+	header.alignment = alignment;
+	header.namesOffset = sizeof(AssetPackHeader) + sorted.size() * sizeof(AssetPackEntry);
+	header.namesSize = 0;
+	for (const Item* item : sorted)
+		header.namesSize += item->name.size();
+
+	// blobs are laid out in index order; an asset sharing another's bytes gets its offset
+	std::vector<AssetPackEntry> entries(sorted.size());
+	std::vector<uint64_t> blobOffsets(items.size());
+	uint64_t offset = header.namesOffset + header.namesSize;
+	uint32_t nameOffset = 0;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		const Item& item = *sorted[i];
+		const Item& blob = items[item.blob];
+		if (&blob == &item)
+		{
+			offset = (offset + alignment - 1) / alignment * alignment;
+			blobOffsets[item.blob] = offset;
+			offset += item.data.size();
+		}
+		entries[i].hash = item.hash;
+		entries[i].size = blob.data.size();
+		entries[i].nameOffset = nameOffset;
+		entries[i].nameLength = (uint32_t)item.name.size();
+		nameOffset += entries[i].nameLength;
+	}
+	for (size_t i = 0; i < sorted.size(); i++)
+		entries[i].offset = blobOffsets[sorted[i]->blob];
+	header.fileSize = offset;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file)
+		return false;
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)entries.data(), entries.size() * sizeof(AssetPackEntry));
+	for (const Item* item : sorted)
+		file.write(item->name.data(), item->name.size());
+	uint64_t written = header.namesOffset + header.namesSize;
+	static const char zeros[256] = {};
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		if (&items[sorted[i]->blob] != sorted[i])
+			continue;	// shared, written with its blob
+		for (uint64_t pad = entries[i].offset - written; pad > 0; )
+		{
+			size_t chunk = (size_t)std::min<uint64_t>(pad, sizeof(zeros));
+			file.write(zeros, chunk);
+			pad -= chunk;
+		}
+		file.write((const char*)sorted[i]->data.data(), sorted[i]->data.size());
+		written = entries[i].offset + entries[i].size;
+	}
+	return (bool)file;
+}
+
+AssetFS::AssetFS()
+	: looseFiles(true)
+{
+}
+
+AssetFS::~AssetFS()
+{
+	for (AssetPack* pack : packs)
+		delete pack;
+}
+
+bool AssetFS::mount(const std::string& packPath)
+{
+	AssetPack* pack = new AssetPack();
+	if (!pack->open(packPath))
+	{
+		delete pack;
+		return false;
+	}
+	packs.insert(packs.begin(), pack);
+	return true;
+}
+
+Asset AssetFS::read(const std::string& path) const
+{
+	Asset asset;
+	for (const AssetPack* pack : packs)
+	{
+		asset.view = pack->find(path, &asset.length);
+		if (asset.view)
+			return asset;
+	}
+	if (looseFiles && readFile(path, asset.owned))
+		asset.length = asset.owned.size();
+	return asset;
+}
+
+bool AssetFS::exists(const std::string& path) const
+{
+	size_t size;
+	for (const AssetPack* pack : packs)
+		if (pack->find(path, &size))
+			return true;
+	return looseFiles && std::ifstream(path).good();
+}
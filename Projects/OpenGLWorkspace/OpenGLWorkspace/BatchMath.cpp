@@ -0,0 +1,452 @@
+#include "batch_math.h"
+
+#include <algorithm>
+
+#include "cpu_dispatch.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// the kernels up to AVX all sum in the order c0 * x + c1 * y + c2 * z + c3, so
+// they give the same bits; AVX2 and AVX-512 fuse the multiply-adds and can be
+// off by a rounding
+
+static void transformTail(const float* m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		float px = x[i], py = y[i], pz = z[i];
+		outX[i] = m[0] * px + m[4] * py + m[8] * pz + m[12];
+		outY[i] = m[1] * px + m[5] * py + m[9] * pz + m[13];
+		outZ[i] = m[2] * px + m[6] * py + m[10] * pz + m[14];
+	}
+}
+
+static void transformPackedTail(const float* m, const glm::vec3* in, glm::vec3* out, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		glm::vec3 p = in[i];
+		out[i] = glm::vec3(
+			m[0] * p.x + m[4] * p.y + m[8] * p.z + m[12],
+			m[1] * p.x + m[5] * p.y + m[9] * p.z + m[13],
+			m[2] * p.x + m[6] * p.y + m[10] * p.z + m[14]);
+	}
+}
+
+static void transformScalar(const float* m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t count)
+{
+	transformTail(m, x, y, z, outX, outY, outZ, 0, count);
+}
+
+static void transformPackedScalar(const float* m, const glm::vec3* in, glm::vec3* out, size_t count)
+{
+	transformPackedTail(m, in, out, 0, count);
+}
+
+static void mulScalar(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* pa = &a[i][0][0];
+		const float* pb = &b[i][0][0];
+		float r[16];
+		for (int c = 0; c < 4; c++)
+			for (int row = 0; row < 4; row++)
+				r[c * 4 + row] = pa[row] * pb[c * 4] + pa[4 + row] * pb[c * 4 + 1] + pa[8 + row] * pb[c * 4 + 2] +
+					pa[12 + row] * pb[c * 4 + 3];
+		std::copy(r, r + 16, &out[i][0][0]);
+	}
+}
+
+#ifdef CPU_X86
+// 4 points per step, the rest through the scalar loop
+static void transformSSE(const float* m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t count)
+{
+	__m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	__m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+	__m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+	__m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]), m14 = _mm_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i), pz = _mm_loadu_ps(z + i);
+		_mm_storeu_ps(outX + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, px), _mm_mul_ps(m4, py)), _mm_mul_ps(m8, pz)), m12));
+		_mm_storeu_ps(outY + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, px), _mm_mul_ps(m5, py)), _mm_mul_ps(m9, pz)), m13));
+		_mm_storeu_ps(outZ + i, _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, px), _mm_mul_ps(m6, py)), _mm_mul_ps(m10, pz)), m14));
+	}
+	transformTail(m, x, y, z, outX, outY, outZ, i, count);
+}
+
+// 4 packed points (12 floats) per step, turned into x, y and z vectors and back
+// with shuffles
+static void transformPackedSSE(const float* m, const glm::vec3* in, glm::vec3* out, size_t count)
+{
+	__m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	__m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+	__m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+	__m128 m12 = _mm_set1_ps(m[12]), m13 = _mm_set1_ps(m[13]), m14 = _mm_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* p = &in[i].x;
+		__m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);	// x0y0z0x1 y1z1x2y2 z2x3y3z3
+		__m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));	// x2y2x3y3
+		__m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));	// y0z0y1z1
+		__m128 px = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+		__m128 py = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m128 pz = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, px), _mm_mul_ps(m4, py)), _mm_mul_ps(m8, pz)), m12);
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, px), _mm_mul_ps(m5, py)), _mm_mul_ps(m9, pz)), m13);
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, px), _mm_mul_ps(m6, py)), _mm_mul_ps(m10, pz)), m14);
+
+		__m128 rxy = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));	// x0x2y0y2
+		__m128 ryz = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));	// y1y3z1z3
+		__m128 rzx = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));	// z0z2x1x3
+		float* q = &out[i].x;
+		_mm_storeu_ps(q, _mm_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(q + 4, _mm_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+		_mm_storeu_ps(q + 8, _mm_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+	transformPackedTail(m, in, out, i, count);
+}
+
+static void mulSSE(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* pa = &a[i][0][0];
+		const float* pb = &b[i][0][0];
+		__m128 a0 = _mm_loadu_ps(pa), a1 = _mm_loadu_ps(pa + 4), a2 = _mm_loadu_ps(pa + 8), a3 = _mm_loadu_ps(pa + 12);
+		__m128 r[4];
+		for (int c = 0; c < 4; c++)
+		{
+			__m128 col = _mm_loadu_ps(pb + c * 4);
+			r[c] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(a0, _mm_shuffle_ps(col, col, _MM_SHUFFLE(0, 0, 0, 0))),
+				_mm_mul_ps(a1, _mm_shuffle_ps(col, col, _MM_SHUFFLE(1, 1, 1, 1)))),
+				_mm_mul_ps(a2, _mm_shuffle_ps(col, col, _MM_SHUFFLE(2, 2, 2, 2)))),
+				_mm_mul_ps(a3, _mm_shuffle_ps(col, col, _MM_SHUFFLE(3, 3, 3, 3))));
+		}
+		float* po = &out[i][0][0];
+		for (int c = 0; c < 4; c++)
+			_mm_storeu_ps(po + c * 4, r[c]);
+	}
+}
+
+// the same with 8 points per step
+CPU_TARGET_AVX static void transformAVX(const float* m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t count)
+{
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+	__m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+	__m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i), pz = _mm256_loadu_ps(z + i);
+		_mm256_storeu_ps(outX + i,
+			_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, px), _mm256_mul_ps(m4, py)), _mm256_mul_ps(m8, pz)), m12));
+		_mm256_storeu_ps(outY + i,
+			_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, px), _mm256_mul_ps(m5, py)), _mm256_mul_ps(m9, pz)), m13));
+		_mm256_storeu_ps(outZ + i,
+			_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, px), _mm256_mul_ps(m6, py)), _mm256_mul_ps(m10, pz)), m14));
+	}
+	transformTail(m, x, y, z, outX, outY, outZ, i, count);
+}
+
+// 8 packed points per step; each 128-bit half does what transformPackedSSE does
+// for 4, so the loads go in as halves: points 0-3 low, 4-7 high
+CPU_TARGET_AVX static void transformPackedAVX(const float* m, const glm::vec3* in, glm::vec3* out, size_t count)
+{
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+	__m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+	__m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const float* p = &in[i].x;
+		__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+		__m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+		__m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+		__m256 xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+		__m256 yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+		__m256 px = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+		__m256 py = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 pz = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+		__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, px), _mm256_mul_ps(m4, py)), _mm256_mul_ps(m8, pz)), m12);
+		__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, px), _mm256_mul_ps(m5, py)), _mm256_mul_ps(m9, pz)), m13);
+		__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, px), _mm256_mul_ps(m6, py)), _mm256_mul_ps(m10, pz)), m14);
+
+		__m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+		__m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 ra = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 rb = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 rc = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+		float* q = &out[i].x;
+		_mm_storeu_ps(q, _mm256_castps256_ps128(ra));
+		_mm_storeu_ps(q + 4, _mm256_castps256_ps128(rb));
+		_mm_storeu_ps(q + 8, _mm256_castps256_ps128(rc));
+		_mm_storeu_ps(q + 12, _mm256_extractf128_ps(ra, 1));
+		_mm_storeu_ps(q + 16, _mm256_extractf128_ps(rb, 1));
+		_mm_storeu_ps(q + 20, _mm256_extractf128_ps(rc, 1));
+	}
+	transformPackedTail(m, in, out, i, count);
+}
+
+// two result columns per register: a's columns broadcast to both halves, b's
+// elements picked per half by the shuffle
+CPU_TARGET_AVX static void mulAVX(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* pa = &a[i][0][0];
+		const float* pb = &b[i][0][0];
+		__m256 a0 = _mm256_broadcast_ps((const __m128*)pa), a1 = _mm256_broadcast_ps((const __m128*)(pa + 4));
+		__m256 a2 = _mm256_broadcast_ps((const __m128*)(pa + 8)), a3 = _mm256_broadcast_ps((const __m128*)(pa + 12));
+		__m256 b01 = _mm256_loadu_ps(pb), b23 = _mm256_loadu_ps(pb + 8);
+		__m256 r01 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0))),
+			_mm256_mul_ps(a1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)))),
+			_mm256_mul_ps(a2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2)))),
+			_mm256_mul_ps(a3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3))));
+		__m256 r23 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0))),
+			_mm256_mul_ps(a1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)))),
+			_mm256_mul_ps(a2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2)))),
+			_mm256_mul_ps(a3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3))));
+		float* po = &out[i][0][0];
+		_mm256_storeu_ps(po, r01);
+		_mm256_storeu_ps(po + 8, r23);
+	}
+}
+
+// the AVX kernels with fused multiply-adds: fewer instructions, one rounding
+// per step instead of two
+CPU_TARGET_AVX2 static void transformFMA(const float* m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t count)
+{
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+	__m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+	__m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i), pz = _mm256_loadu_ps(z + i);
+		_mm256_storeu_ps(outX + i, _mm256_fmadd_ps(m8, pz, _mm256_fmadd_ps(m4, py, _mm256_fmadd_ps(m0, px, m12))));
+		_mm256_storeu_ps(outY + i, _mm256_fmadd_ps(m9, pz, _mm256_fmadd_ps(m5, py, _mm256_fmadd_ps(m1, px, m13))));
+		_mm256_storeu_ps(outZ + i, _mm256_fmadd_ps(m10, pz, _mm256_fmadd_ps(m6, py, _mm256_fmadd_ps(m2, px, m14))));
+	}
+	transformTail(m, x, y, z, outX, outY, outZ, i, count);
+}
+
+CPU_TARGET_AVX2 static void transformPackedFMA(const float* m, const glm::vec3* in, glm::vec3* out, size_t count)
+{
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+	__m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+	__m256 m12 = _mm256_set1_ps(m[12]), m13 = _mm256_set1_ps(m[13]), m14 = _mm256_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const float* p = &in[i].x;
+		__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+		__m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+		__m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+		__m256 xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+		__m256 yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+		__m256 px = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+		__m256 py = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 pz = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+		__m256 rx = _mm256_fmadd_ps(m8, pz, _mm256_fmadd_ps(m4, py, _mm256_fmadd_ps(m0, px, m12)));
+		__m256 ry = _mm256_fmadd_ps(m9, pz, _mm256_fmadd_ps(m5, py, _mm256_fmadd_ps(m1, px, m13)));
+		__m256 rz = _mm256_fmadd_ps(m10, pz, _mm256_fmadd_ps(m6, py, _mm256_fmadd_ps(m2, px, m14)));
+
+		__m256 rxy = _mm256_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 ryz = _mm256_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 1, 3, 1));
+		__m256 rzx = _mm256_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 ra = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 rb = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 rc = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+		float* q = &out[i].x;
+		_mm_storeu_ps(q, _mm256_castps256_ps128(ra));
+		_mm_storeu_ps(q + 4, _mm256_castps256_ps128(rb));
+		_mm_storeu_ps(q + 8, _mm256_castps256_ps128(rc));
+		_mm_storeu_ps(q + 12, _mm256_extractf128_ps(ra, 1));
+		_mm_storeu_ps(q + 16, _mm256_extractf128_ps(rb, 1));
+		_mm_storeu_ps(q + 20, _mm256_extractf128_ps(rc, 1));
+	}
+	transformPackedTail(m, in, out, i, count);
+}
+
+CPU_TARGET_AVX2 static void mulFMA(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* pa = &a[i][0][0];
+		const float* pb = &b[i][0][0];
+		__m256 a0 = _mm256_broadcast_ps((const __m128*)pa), a1 = _mm256_broadcast_ps((const __m128*)(pa + 4));
+		__m256 a2 = _mm256_broadcast_ps((const __m128*)(pa + 8)), a3 = _mm256_broadcast_ps((const __m128*)(pa + 12));
+		__m256 b01 = _mm256_loadu_ps(pb), b23 = _mm256_loadu_ps(pb + 8);
+		__m256 r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0)));
+		__m256 r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0)));
+		r01 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+		r23 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+		r01 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+		r23 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+		r01 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+		r23 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+		float* po = &out[i][0][0];
+		_mm256_storeu_ps(po, r01);
+		_mm256_storeu_ps(po + 8, r23);
+	}
+}
+
+// the same with 16 points per step
+CPU_TARGET_AVX512 static void transformAVX512(const float* m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t count)
+{
+	__m512 m0 = _mm512_set1_ps(m[0]), m1 = _mm512_set1_ps(m[1]), m2 = _mm512_set1_ps(m[2]);
+	__m512 m4 = _mm512_set1_ps(m[4]), m5 = _mm512_set1_ps(m[5]), m6 = _mm512_set1_ps(m[6]);
+	__m512 m8 = _mm512_set1_ps(m[8]), m9 = _mm512_set1_ps(m[9]), m10 = _mm512_set1_ps(m[10]);
+	__m512 m12 = _mm512_set1_ps(m[12]), m13 = _mm512_set1_ps(m[13]), m14 = _mm512_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		__m512 px = _mm512_loadu_ps(x + i), py = _mm512_loadu_ps(y + i), pz = _mm512_loadu_ps(z + i);
+		_mm512_storeu_ps(outX + i,
+			_mm512_fmadd_ps(m8, pz, _mm512_fmadd_ps(m4, py, _mm512_fmadd_ps(m0, px, m12))));
+		_mm512_storeu_ps(outY + i,
+			_mm512_fmadd_ps(m9, pz, _mm512_fmadd_ps(m5, py, _mm512_fmadd_ps(m1, px, m13))));
+		_mm512_storeu_ps(outZ + i,
+			_mm512_fmadd_ps(m10, pz, _mm512_fmadd_ps(m6, py, _mm512_fmadd_ps(m2, px, m14))));
+	}
+	transformTail(m, x, y, z, outX, outY, outZ, i, count);
+}
+
+// 16 packed points (three full registers) per step, split into x, y and z with
+// two-source permutes: the first picks what the first two registers hold, the
+// second fills in the rest from the third. Storing runs the same tables backwards
+CPU_TARGET_AVX512 static void transformPackedAVX512(const float* m, const glm::vec3* in, glm::vec3* out, size_t count)
+{
+	// float k of a group of 16 points is component k % 3 of point k / 3
+	int load[2][3][16], store[2][3][16];
+	for (int c = 0; c < 3; c++)
+		for (int i = 0; i < 16; i++)
+		{
+			int k = i * 3 + c;
+			load[0][c][i] = k < 32 ? k : 0;
+			load[1][c][i] = k < 32 ? i : 16 + k - 32;
+			int point = (c * 16 + i) / 3, component = (c * 16 + i) % 3;
+			store[0][c][i] = component == 0 ? point : 16 + point;
+			store[1][c][i] = component == 2 ? 16 + point : i;
+		}
+	__m512i loadFirst[3], loadSecond[3], storeFirst[3], storeSecond[3];
+	for (int c = 0; c < 3; c++)
+	{
+		loadFirst[c] = _mm512_loadu_si512(load[0][c]);
+		loadSecond[c] = _mm512_loadu_si512(load[1][c]);
+		storeFirst[c] = _mm512_loadu_si512(store[0][c]);
+		storeSecond[c] = _mm512_loadu_si512(store[1][c]);
+	}
+
+	__m512 m0 = _mm512_set1_ps(m[0]), m1 = _mm512_set1_ps(m[1]), m2 = _mm512_set1_ps(m[2]);
+	__m512 m4 = _mm512_set1_ps(m[4]), m5 = _mm512_set1_ps(m[5]), m6 = _mm512_set1_ps(m[6]);
+	__m512 m8 = _mm512_set1_ps(m[8]), m9 = _mm512_set1_ps(m[9]), m10 = _mm512_set1_ps(m[10]);
+	__m512 m12 = _mm512_set1_ps(m[12]), m13 = _mm512_set1_ps(m[13]), m14 = _mm512_set1_ps(m[14]);
+	size_t i = 0;
+	for (; i + 16 <= count; i += 16)
+	{
+		const float* p = &in[i].x;
+		__m512 a = _mm512_loadu_ps(p), b = _mm512_loadu_ps(p + 16), c = _mm512_loadu_ps(p + 32);
+		__m512 px = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, loadFirst[0], b), loadSecond[0], c);
+		__m512 py = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, loadFirst[1], b), loadSecond[1], c);
+		__m512 pz = _mm512_permutex2var_ps(_mm512_permutex2var_ps(a, loadFirst[2], b), loadSecond[2], c);
+
+		__m512 rx = _mm512_fmadd_ps(m8, pz, _mm512_fmadd_ps(m4, py, _mm512_fmadd_ps(m0, px, m12)));
+		__m512 ry = _mm512_fmadd_ps(m9, pz, _mm512_fmadd_ps(m5, py, _mm512_fmadd_ps(m1, px, m13)));
+		__m512 rz = _mm512_fmadd_ps(m10, pz, _mm512_fmadd_ps(m6, py, _mm512_fmadd_ps(m2, px, m14)));
+
+		float* q = &out[i].x;
+		_mm512_storeu_ps(q, _mm512_permutex2var_ps(_mm512_permutex2var_ps(rx, storeFirst[0], ry), storeSecond[0], rz));
+		_mm512_storeu_ps(q + 16, _mm512_permutex2var_ps(_mm512_permutex2var_ps(rx, storeFirst[1], ry), storeSecond[1], rz));
+		_mm512_storeu_ps(q + 32, _mm512_permutex2var_ps(_mm512_permutex2var_ps(rx, storeFirst[2], ry), storeSecond[2], rz));
+	}
+	transformPackedTail(m, in, out, i, count);
+}
+
+// a whole matrix per register: each of a's columns copied to all four
+// 128-bit blocks, b's elements picked per block by the shuffle
+CPU_TARGET_AVX512 static void mulAVX512(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count)
+{
+	__m512i column0 = _mm512_set_epi32(3, 2, 1, 0, 3, 2, 1, 0, 3, 2, 1, 0, 3, 2, 1, 0);
+	__m512i column1 = _mm512_add_epi32(column0, _mm512_set1_epi32(4));
+	__m512i column2 = _mm512_add_epi32(column0, _mm512_set1_epi32(8));
+	__m512i column3 = _mm512_add_epi32(column0, _mm512_set1_epi32(12));
+	for (size_t i = 0; i < count; i++)
+	{
+		const float* pa = &a[i][0][0];
+		__m512 pb = _mm512_loadu_ps(&b[i][0][0]);
+		__m512 columns = _mm512_loadu_ps(pa);
+		__m512 a0 = _mm512_permutex2var_ps(columns, column0, columns);
+		__m512 a1 = _mm512_permutex2var_ps(columns, column1, columns);
+		__m512 a2 = _mm512_permutex2var_ps(columns, column2, columns);
+		__m512 a3 = _mm512_permutex2var_ps(columns, column3, columns);
+		__m512 r = _mm512_mul_ps(a0, _mm512_shuffle_ps(pb, pb, _MM_SHUFFLE(0, 0, 0, 0)));
+		r = _mm512_fmadd_ps(a1, _mm512_shuffle_ps(pb, pb, _MM_SHUFFLE(1, 1, 1, 1)), r);
+		r = _mm512_fmadd_ps(a2, _mm512_shuffle_ps(pb, pb, _MM_SHUFFLE(2, 2, 2, 2)), r);
+		r = _mm512_fmadd_ps(a3, _mm512_shuffle_ps(pb, pb, _MM_SHUFFLE(3, 3, 3, 3)), r);
+		_mm512_storeu_ps(&out[i][0][0], r);
+	}
+}
+#endif
+
+// SSE4.1 adds nothing these kernels use
+typedef void (*TransformKernel)(const float*, const float*, const float*, const float*, float*, float*, float*, size_t);
+typedef void (*TransformPackedKernel)(const float*, const glm::vec3*, glm::vec3*, size_t);
+typedef void (*MulKernel)(const glm::mat4*, const glm::mat4*, glm::mat4*, size_t);
+
+#ifdef CPU_X86
+static const DispatchTable<TransformKernel> transformKernels = { {
+	transformScalar, transformSSE, nullptr, transformAVX, transformFMA, transformAVX512 } };
+static const DispatchTable<TransformPackedKernel> transformPackedKernels = { {
+	transformPackedScalar, transformPackedSSE, nullptr, transformPackedAVX, transformPackedFMA, transformPackedAVX512 } };
+static const DispatchTable<MulKernel> mulKernels = { {
+	mulScalar, mulSSE, nullptr, mulAVX, mulFMA, mulAVX512 } };
+#else
+static const DispatchTable<TransformKernel> transformKernels = { { transformScalar } };
+static const DispatchTable<TransformPackedKernel> transformPackedKernels = { { transformPackedScalar } };
+static const DispatchTable<MulKernel> mulKernels = { { mulScalar } };
+#endif
+
+void transformPoints(const glm::mat4& m, const glm::vec3* in, glm::vec3* out, size_t count, const BatchSettings& settings)
+{
+	transformPackedKernels.pick(settings.level)(&m[0][0], in, out, count);
+}
+
+void transformPoints(const glm::mat4& m, const float* x, const float* y, const float* z,
+	float* outX, float* outY, float* outZ, size_t count, const BatchSettings& settings)
+{
+	transformKernels.pick(settings.level)(&m[0][0], x, y, z, outX, outY, outZ, count);
+}
+
+void mulMat4Batch(const glm::mat4* a, const glm::mat4* b, glm::mat4* out, size_t count, const BatchSettings& settings)
+{
+	mulKernels.pick(settings.level)(a, b, out, count);
+}
+
+CpuLevel batchMathLevel(CpuLevel limit)
+{
+	return transformKernels.level(limit);
+}
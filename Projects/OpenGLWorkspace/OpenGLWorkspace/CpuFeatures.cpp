@@ -0,0 +1,108 @@
+#include "cpu_features.h"
+
+#ifdef CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+struct CpuFeatures
+{
+	bool avx = false;
+	bool f16c = false;
+	CpuLevel level = CpuLevel::SSE2;
+
+	CpuFeatures()
+	{
+		unsigned int ecx, ebx7 = 0;
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		ecx = (unsigned int)info[2];
+		__cpuid(info, 0);
+		if (info[0] >= 7)
+		{
+			__cpuidex(info, 7, 0);
+			ebx7 = (unsigned int)info[1];
+		}
+#else
+		unsigned int eax, ebx, edx, ecx7;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return;
+		if (__get_cpuid_max(0, nullptr) >= 7)
+			__cpuid_count(7, 0, eax, ebx7, ecx7, edx);
+#endif
+		if (ecx & (1u << 19))
+			level = CpuLevel::SSE41;
+		// VEX-encoded instructions also need the OS to save YMM state
+		if (!(ecx & (1u << 27)) || !(ecx & (1u << 28)))
+			return;
+#ifdef _MSC_VER
+		unsigned long long xcr0 = _xgetbv(0);
+#else
+		unsigned int lo, hi;
+		__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+		unsigned long long xcr0 = ((unsigned long long)hi << 32) | lo;
+#endif
+		avx = (xcr0 & 6) == 6;
+		f16c = avx && (ecx & (1u << 29)) != 0;
+		if (!avx || level < CpuLevel::SSE41)
+			return;
+		level = CpuLevel::AVX;
+		// AVX2 in leaf 7, FMA in leaf 1
+		if (!f16c || !(ebx7 & (1u << 5)) || !(ecx & (1u << 12)))
+			return;
+		level = CpuLevel::AVX2;
+		// F, DQ, BW and VL, and the OS saving the opmask and upper ZMM state
+		const unsigned int avx512 = (1u << 16) | (1u << 17) | (1u << 30) | (1u << 31);
+		if ((ebx7 & avx512) == avx512 && (xcr0 & 0xe6) == 0xe6)
+			level = CpuLevel::AVX512;
+	}
+};
+
+static const CpuFeatures& features()
+{
+	static const CpuFeatures detected;
+	return detected;
+}
+
+bool cpuHasAVX()
+{
+	return features().avx;
+}
+
+bool cpuHasF16C()
+{
+	return features().f16c;
+}
+
+CpuLevel cpuLevel()
+{
+	return features().level;
+}
+
+#else
+
+bool cpuHasAVX()
+{
+	return false;
+}
+
+bool cpuHasF16C()
+{
+	return false;
+}
+
+CpuLevel cpuLevel()
+{
+	return CpuLevel::Scalar;
+}
+
+#endif
+
+const char* cpuLevelName(CpuLevel level)
+{
+	static const char* const names[] = { "scalar", "SSE2", "SSE4.1", "AVX", "AVX2", "AVX-512" };
+	return level < CpuLevel::Count ? names[(int)level] : "?";
+}
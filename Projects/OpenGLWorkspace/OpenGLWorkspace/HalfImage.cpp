@@ -0,0 +1,26 @@
+#include "half_image.h"
+
+#include <climits>
+
+#include "pack_array.h"
+#include "stb_image.h"
+
+void floatToHalf(const float* src, uint16_t* dst, size_t count)
+{
+	packHalfArray(src, dst, count);
+}
+
+bool loadHalfImage(const unsigned char* data, size_t size, HalfImage& image)
+{
+	if (size > INT_MAX)
+		return false;
+	int channels;
+	float* pixels = stbi_loadf_from_memory(data, (int)size, &image.width, &image.height, &channels, 4);
+	if (!pixels)
+		return false;
+	size_t count = (size_t)image.width * image.height * 4;
+	image.pixels.resize(count);
+	floatToHalf(pixels, image.pixels.data(), count);
+	stbi_image_free(pixels);
+	return true;
+}
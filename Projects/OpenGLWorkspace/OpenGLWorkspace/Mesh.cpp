@@ -0,0 +1,261 @@
+#include "mesh.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "asset_pack.h"
+#include "mesh_optimizer.h"
+
+// one face corner as written in the file: 0-based indices, -1 when absent
+struct ObjCorner
+{
+	int position;
+	int uv;
+	int normal;
+};
+
+static bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char* skipSpace(const char* p, const char* end)
+{
+	while (p < end && isSpace(*p))
+		p++;
+	return p;
+}
+
+static const char* readFloats(const char* p, const char* end, float* out, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		p = skipSpace(p, end);
+		if (p >= end)
+		{
+			out[i] = 0.0f;	// strtof would skip the newline and read on into the next line
+			continue;
+		}
+		char* next;
+		out[i] = std::strtof(p, &next);
+		if (next == p)
+			out[i] = 0.0f;	// vt with only u, or vertices with a missing w are fine
+		p = next;
+	}
+	return p;
+}
+
+// OBJ indices are 1-based, negative ones count back from the last element so far
+static int resolveIndex(long index, size_t count)
+{
+	if (index > 0 && (size_t)index <= count)
+		return (int)(index - 1);
+	if (index < 0 && (size_t)-index <= count)
+		return (int)(count + index);
+	return -2;	// out of range
+}
+
+static bool startsIndex(const char* p, const char* end)
+{
+	// strtol skips whitespace, newlines included, so only hand it an actual number
+	return p < end && (*p == '-' || (*p >= '0' && *p <= '9'));
+}
+
+// parses "v", "v/t", "v//n" or "v/t/n"
+static const char* readCorner(const char* p, const char* end, size_t positions, size_t uvs, size_t normals, ObjCorner& corner)
+{
+	corner.position = -2;
+	corner.uv = -1;
+	corner.normal = -1;
+	if (!startsIndex(p, end))
+		return p;
+	char* next;
+	corner.position = resolveIndex(std::strtol(p, &next, 10), positions);
+	p = next;
+	if (p < end && *p == '/')
+	{
+		p++;
+		if (startsIndex(p, end))
+		{
+			corner.uv = resolveIndex(std::strtol(p, &next, 10), uvs);
+			p = next;
+		}
+		if (p < end && *p == '/')
+		{
+			p++;
+			if (!startsIndex(p, end))
+			{
+				corner.normal = -2;
+				return p;
+			}
+			corner.normal = resolveIndex(std::strtol(p, &next, 10), normals);
+			p = next;
+		}
+	}
+	return p;
+}
+
+static void faceNormal(const float* a, const float* b, const float* c, float* normal)
+{
+	// not normalized: bigger faces weigh more in the smooth normals
+	float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+	float v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+	normal[0] = u[1] * v[2] - u[2] * v[1];
+	normal[1] = u[2] * v[0] - u[0] * v[2];
+	normal[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+static void normalize(float* v)
+{
+	float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+	if (length > 0.0f)
+	{
+		v[0] /= length;
+		v[1] /= length;
+		v[2] /= length;
+	}
+}
+
+bool loadObj(const char* text, size_t size, Mesh& mesh)
+{
+	// a terminated copy, so strtof/strtol can't read past the end
+	std::string source(text, size);
+	const char* p = source.c_str();
+	const char* end = p + size;
+
+	std::vector<float> positions, uvs, normals;
+	std::vector<ObjCorner> corners;	// three per triangle
+	std::vector<ObjCorner> face;
+	int line = 0;
+
+	while (p < end)
+	{
+		line++;
+		const char* lineEnd = (const char*)std::memchr(p, '\n', end - p);
+		if (!lineEnd)
+			lineEnd = end;
+		p = skipSpace(p, lineEnd);
+
+		if (lineEnd - p > 2 && p[0] == 'v' && isSpace(p[1]))
+		{
+			float v[3];
+			readFloats(p + 2, lineEnd, v, 3);
+			positions.insert(positions.end(), v, v + 3);
+		}
+		else if (lineEnd - p > 3 && p[0] == 'v' && p[1] == 't' && isSpace(p[2]))
+		{
+			float v[2];
+			readFloats(p + 3, lineEnd, v, 2);
+			uvs.insert(uvs.end(), v, v + 2);
+		}
+		else if (lineEnd - p > 3 && p[0] == 'v' && p[1] == 'n' && isSpace(p[2]))
+		{
+			float v[3];
+			readFloats(p + 3, lineEnd, v, 3);
+			normals.insert(normals.end(), v, v + 3);
+		}
+		else if (lineEnd - p > 2 && p[0] == 'f' && isSpace(p[1]))
+		{
+			face.clear();
+			const char* q = skipSpace(p + 2, lineEnd);
+			while (q < lineEnd && *q != '#')
+			{
+				ObjCorner corner;
+				const char* next = readCorner(q, lineEnd, positions.size() / 3, uvs.size() / 2, normals.size() / 3, corner);
+				if (next == q || corner.position < 0 || corner.uv == -2 || corner.normal == -2)
+				{
+					std::cout << "ERROR::MESH::OBJ_BAD_FACE line " << line << std::endl;
+					return false;
+				}
+				face.push_back(corner);
+				q = skipSpace(next, lineEnd);
+			}
+			// fan: polygons in OBJ are convex by convention
+			for (size_t i = 2; i < face.size(); i++)
+			{
+				corners.push_back(face[0]);
+				corners.push_back(face[i - 1]);
+				corners.push_back(face[i]);
+			}
+		}
+		// o, g, s, usemtl, mtllib, comments and anything else are skipped
+		p = lineEnd + 1;
+	}
+
+	if (corners.empty())
+	{
+		std::cout << "ERROR::MESH::OBJ_NO_FACES" << std::endl;
+		return false;
+	}
+
+	// corners without a normal share an area-weighted one per position
+	std::vector<float> smooth;
+	for (size_t i = 0; i < corners.size(); i += 3)
+	{
+		if (corners[i].normal >= 0 && corners[i + 1].normal >= 0 && corners[i + 2].normal >= 0)
+			continue;
+		if (smooth.empty())
+			smooth.assign(positions.size(), 0.0f);
+		float normal[3];
+		faceNormal(&positions[corners[i].position * 3], &positions[corners[i + 1].position * 3],
+			&positions[corners[i + 2].position * 3], normal);
+		for (int k = 0; k < 3; k++)
+			for (int c = 0; c < 3; c++)
+				smooth[corners[i + k].position * 3 + c] += normal[c];
+	}
+	for (size_t i = 0; i < smooth.size(); i += 3)
+		normalize(&smooth[i]);
+
+	std::vector<MeshVertex> soup(corners.size());
+	for (size_t i = 0; i < corners.size(); i++)
+	{
+		const ObjCorner& corner = corners[i];
+		MeshVertex& vertex = soup[i];
+		std::memcpy(vertex.position, &positions[corner.position * 3], sizeof(vertex.position));
+		if (corner.normal >= 0)
+			std::memcpy(vertex.normal, &normals[corner.normal * 3], sizeof(vertex.normal));
+		else
+			std::memcpy(vertex.normal, &smooth[corner.position * 3], sizeof(vertex.normal));
+		if (corner.uv >= 0)
+			std::memcpy(vertex.uv, &uvs[corner.uv * 2], sizeof(vertex.uv));
+		else
+			vertex.uv[0] = vertex.uv[1] = 0.0f;
+	}
+	deduplicateVertices(soup, mesh);
+	return true;
+}
+
+bool loadObj(const AssetFS& assets, const std::string& path, Mesh& mesh)
+{
+	Asset source = assets.read(path);
+	if (!source)
+	{
+		std::cout << "ERROR::MESH::FILE_NOT_FOUND " << path << std::endl;
+		return false;
+	}
+	return loadObj((const char*)source.data(), source.size(), mesh);
+}
+
+bool writeObj(const std::string& path, const Mesh& mesh)
+{
+	FILE* file = std::fopen(path.c_str(), "w");
+	if (!file)
+		return false;
+	// %.9g round-trips floats exactly, so loading the output gives back the same vertices
+	for (const MeshVertex& v : mesh.vertices)
+		std::fprintf(file, "v %.9g %.9g %.9g\n", v.position[0], v.position[1], v.position[2]);
+	for (const MeshVertex& v : mesh.vertices)
+		std::fprintf(file, "vt %.9g %.9g\n", v.uv[0], v.uv[1]);
+	for (const MeshVertex& v : mesh.vertices)
+		std::fprintf(file, "vn %.9g %.9g %.9g\n", v.normal[0], v.normal[1], v.normal[2]);
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+	{
+		unsigned int a = mesh.indices[i] + 1, b = mesh.indices[i + 1] + 1, c = mesh.indices[i + 2] + 1;
+		std::fprintf(file, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c);
+	}
+	bool ok = !std::ferror(file);
+	return std::fclose(file) == 0 && ok;
+}
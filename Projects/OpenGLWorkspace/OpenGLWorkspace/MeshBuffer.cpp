@@ -0,0 +1,269 @@
+#include "mesh_buffer.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+MeshBufferGL MeshBufferGL::current()
+{
+	MeshBufferGL gl;
+	gl.GenVertexArrays = glGenVertexArrays;
+	gl.DeleteVertexArrays = glDeleteVertexArrays;
+	gl.BindVertexArray = glBindVertexArray;
+	gl.GenBuffers = glGenBuffers;
+	gl.DeleteBuffers = glDeleteBuffers;
+	gl.BindBuffer = glBindBuffer;
+	gl.BufferData = glBufferData;
+	gl.DrawElements = glDrawElements;
+	gl.DrawElementsInstanced = glDrawElementsInstanced;
+	gl.MultiDrawElements = glMultiDrawElements;
+	gl.Enable = glEnable;
+	gl.Disable = glDisable;
+	gl.PrimitiveRestartIndex = glPrimitiveRestartIndex;
+	gl.layout = VertexLayoutGL::current();
+	return gl;
+}
+
+GLenum indexType(size_t vertexCount, bool restart)
+{
+	size_t reserved = restart ? 1 : 0;
+	if (vertexCount + reserved <= 0x100)
+		return GL_UNSIGNED_BYTE;
+	if (vertexCount + reserved <= 0x10000)
+		return GL_UNSIGNED_SHORT;
+	return GL_UNSIGNED_INT;
+}
+
+size_t indexSize(GLenum type)
+{
+	return type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT ? 2 : 4;
+}
+
+unsigned int restartIndex(GLenum type)
+{
+	return type == GL_UNSIGNED_BYTE ? 0xffu : type == GL_UNSIGNED_SHORT ? 0xffffu : 0xffffffffu;
+}
+
+static uint64_t edgeKey(unsigned int from, unsigned int to)
+{
+	return ((uint64_t)from << 32) | to;
+}
+
+void stripify(const std::vector<unsigned int>& indices, unsigned int restart, std::vector<unsigned int>& strips)
+{
+	size_t triangleCount = indices.size() / 3;
+	strips.clear();
+
+	// every directed edge a->b of a triangle; the neighbor across it has b->a
+	std::unordered_map<uint64_t, unsigned int> edges;
+	edges.reserve(triangleCount * 3);
+	for (size_t t = 0; t < triangleCount; t++)
+		for (int k = 0; k < 3; k++)
+			edges[edgeKey(indices[t * 3 + k], indices[t * 3 + (k + 1) % 3])] = (unsigned int)t;
+
+	std::vector<char> emitted(triangleCount, 0);
+	size_t start = 0;	// first triangle not emitted yet
+	// strips only take triangles the list would draw soon anyway; wandering
+	// further keeps strips long but throws away the list's vertex cache order
+	const size_t window = 8;
+	auto available = [&](unsigned int triangle) -> bool
+	{
+		return !emitted[triangle] && triangle < start + window;
+	};
+	// the available triangle with the directed edge from->to, and its third vertex
+	auto follow = [&](unsigned int from, unsigned int to, unsigned int& third) -> bool
+	{
+		auto found = edges.find(edgeKey(from, to));
+		if (found == edges.end() || !available(found->second))
+			return false;
+		const unsigned int* triangle = &indices[found->second * 3];
+		for (int k = 0; k < 3; k++)
+			if (triangle[k] == from && triangle[(k + 1) % 3] == to)
+			{
+				third = triangle[(k + 2) % 3];
+				emitted[found->second] = 1;
+				return true;
+			}
+		return false;
+	};
+
+	for (; start < triangleCount; start++)
+	{
+		if (emitted[start])
+			continue;
+		emitted[start] = 1;
+
+		// start on the rotation whose last edge has a neighbor to continue with
+		unsigned int a = indices[start * 3], b = indices[start * 3 + 1], c = indices[start * 3 + 2];
+		for (int rotation = 0; rotation < 3; rotation++)
+		{
+			auto found = edges.find(edgeKey(c, b));
+			if (found != edges.end() && available(found->second))
+				break;
+			unsigned int first = a;
+			a = b;
+			b = c;
+			c = first;
+		}
+
+		if (!strips.empty())
+			strips.push_back(restart);
+		strips.push_back(a);
+		strips.push_back(b);
+		strips.push_back(c);
+
+		// odd triangles of a strip are wound the other way, so the edge to
+		// follow flips direction every step
+		for (size_t triangle = 1;; triangle++)
+		{
+			size_t end = strips.size();
+			unsigned int x = strips[end - 2], y = strips[end - 1], next;
+			bool found = triangle % 2 == 1 ? follow(y, x, next) : follow(x, y, next);
+			if (!found)
+				break;
+			strips.push_back(next);
+		}
+	}
+}
+
+MeshBuffer::MeshBuffer(const MeshBufferGL& gl)
+	: gl(gl), vao(0), vbo(0), ebo(0), primitive(GL_TRIANGLES), elementType(GL_UNSIGNED_INT), elementCount(0), vertices(0)
+{
+	gl.GenVertexArrays(1, &vao);
+	gl.GenBuffers(1, &vbo);
+	gl.GenBuffers(1, &ebo);
+}
+
+MeshBuffer::~MeshBuffer()
+{
+	gl.DeleteBuffers(1, &ebo);
+	gl.DeleteBuffers(1, &vbo);
+	gl.DeleteVertexArrays(1, &vao);
+}
+
+template <typename T>
+static void narrow(const std::vector<unsigned int>& indices, std::vector<unsigned char>& bytes)
+{
+	bytes.resize(indices.size() * sizeof(T));
+	T* out = (T*)bytes.data();
+	for (size_t i = 0; i < indices.size(); i++)
+		out[i] = (T)indices[i];
+}
+
+void MeshBuffer::upload(const VertexLayout& layout, const MeshBufferPart* parts, size_t partCount, bool allowStrips)
+{
+	// one vertex buffer and one triangle list, each part's indices moved past the vertices before it
+	std::vector<unsigned char> vertexData;
+	std::vector<unsigned int> list;
+	size_t vertexCount = 0;
+	for (size_t p = 0; p < partCount; p++)
+	{
+		const MeshBufferPart& part = parts[p];
+		vertexData.insert(vertexData.end(), part.vertices, part.vertices + part.vertexCount * layout.stride);
+		for (size_t i = 0; i + 2 < part.indexCount; i += 3)
+			for (int k = 0; k < 3; k++)
+				list.push_back((unsigned int)(part.indices[i + k] + vertexCount));
+		vertexCount += part.vertexCount;
+	}
+
+	// strips save about a third of the indices on connected meshes, but every
+	// restart costs one; go by bytes, since the restart index can widen the type
+	std::vector<unsigned int> strips;
+	GLenum listType = indexType(vertexCount, false);
+	GLenum stripType = indexType(vertexCount, true);
+	if (allowStrips && !list.empty())
+		stripify(list, restartIndex(stripType), strips);
+	bool useStrips = !strips.empty() && strips.size() * indexSize(stripType) < list.size() * indexSize(listType);
+	const std::vector<unsigned int>& elements = useStrips ? strips : list;
+	primitive = useStrips ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
+	elementType = useStrips ? stripType : listType;
+	elementCount = (GLsizei)elements.size();
+	vertices = vertexCount;
+
+	std::vector<unsigned char> indexData;
+	if (elementType == GL_UNSIGNED_BYTE)
+		narrow<uint8_t>(elements, indexData);
+	else if (elementType == GL_UNSIGNED_SHORT)
+		narrow<uint16_t>(elements, indexData);
+	else
+		narrow<uint32_t>(elements, indexData);
+
+	gl.BindVertexArray(vao);
+	gl.BindBuffer(GL_ARRAY_BUFFER, vbo);
+	gl.BufferData(GL_ARRAY_BUFFER, vertexData.size(), vertexData.data(), GL_STATIC_DRAW);
+	// the element buffer binding is part of the vertex array
+	gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	gl.BufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size(), indexData.data(), GL_STATIC_DRAW);
+	layout.apply(0, gl.layout);
+	gl.BindVertexArray(0);
+}
+
+void MeshBuffer::upload(const VertexLayout& layout, const std::vector<unsigned char>& vertexData,
+	const std::vector<unsigned int>& indices, bool allowStrips)
+{
+	MeshBufferPart part;
+	part.vertices = vertexData.data();
+	part.vertexCount = layout.stride ? vertexData.size() / layout.stride : 0;
+	part.indices = indices.data();
+	part.indexCount = indices.size();
+	upload(layout, &part, 1, allowStrips);
+}
+
+void MeshBuffer::draw()
+{
+	if (elementCount == 0)
+		return;
+	gl.BindVertexArray(vao);
+	if (primitive == GL_TRIANGLE_STRIP)
+	{
+		// GL_PRIMITIVE_RESTART_FIXED_INDEX is 4.3; this is the 3.1 way to the same thing
+		gl.Enable(GL_PRIMITIVE_RESTART);
+		gl.PrimitiveRestartIndex(restartIndex(elementType));
+		gl.DrawElements(primitive, elementCount, elementType, (void*)0);
+		gl.Disable(GL_PRIMITIVE_RESTART);
+	}
+	else
+		gl.DrawElements(primitive, elementCount, elementType, (void*)0);
+	counters.draws++;
+	counters.indices += elementCount;
+	counters.indexBytes += elementCount * indexSize(elementType);
+}
+
+void MeshBuffer::drawRange(unsigned int firstIndex, GLsizei count, GLsizei instances)
+{
+	if (count <= 0 || instances <= 0 || primitive != GL_TRIANGLES)
+		return;
+	gl.BindVertexArray(vao);
+	const void* offset = (const void*)(firstIndex * indexSize(elementType));
+	if (instances == 1)
+		gl.DrawElements(GL_TRIANGLES, count, elementType, offset);
+	else
+		gl.DrawElementsInstanced(GL_TRIANGLES, count, elementType, offset, instances);
+	counters.draws++;
+	counters.indices += (unsigned long long)count * instances;
+	counters.indexBytes += (unsigned long long)count * instances * indexSize(elementType);
+}
+
+void MeshBuffer::drawCommands(const DrawElementsIndirectCommand* commands, size_t commandCount)
+{
+	if (primitive != GL_TRIANGLES)
+		return;
+	multiCounts.clear();
+	multiOffsets.clear();
+	unsigned long long fetched = 0;
+	for (size_t i = 0; i < commandCount; i++)
+	{
+		const DrawElementsIndirectCommand& command = commands[i];
+		if (command.count == 0 || command.instanceCount != 1 || command.baseVertex != 0 || command.baseInstance != 0)
+			continue;
+		multiCounts.push_back((GLsizei)command.count);
+		multiOffsets.push_back((const void*)(command.firstIndex * indexSize(elementType)));
+		fetched += command.count;
+	}
+	if (multiCounts.empty())
+		return;
+	gl.BindVertexArray(vao);
+	gl.MultiDrawElements(GL_TRIANGLES, multiCounts.data(), elementType, multiOffsets.data(), (GLsizei)multiCounts.size());
+	counters.draws++;
+	counters.indices += fetched;
+	counters.indexBytes += fetched * indexSize(elementType);
+}
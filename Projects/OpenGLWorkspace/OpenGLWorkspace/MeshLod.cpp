@@ -0,0 +1,347 @@
+#include "mesh_lod.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+#include "mesh_optimizer.h"
+
+// symmetric 4x4 plane quadric, summed over the planes around a vertex and
+// weighted by triangle area; error() divides by the weight, so it comes out
+// as a mean squared distance to those planes
+struct Quadric
+{
+	double a2, b2, c2, d2, ab, ac, ad, bc, bd, cd, weight;
+
+	void add(const Quadric& q)
+	{
+		a2 += q.a2; b2 += q.b2; c2 += q.c2; d2 += q.d2;
+		ab += q.ab; ac += q.ac; ad += q.ad; bc += q.bc; bd += q.bd; cd += q.cd;
+		weight += q.weight;
+	}
+};
+
+static Quadric planeQuadric(double a, double b, double c, double d, double weight)
+{
+	Quadric q;
+	q.a2 = a * a * weight; q.b2 = b * b * weight; q.c2 = c * c * weight; q.d2 = d * d * weight;
+	q.ab = a * b * weight; q.ac = a * c * weight; q.ad = a * d * weight;
+	q.bc = b * c * weight; q.bd = b * d * weight; q.cd = c * d * weight;
+	q.weight = weight;
+	return q;
+}
+
+static float quadricError(const Quadric& a, const Quadric& b, const float* p)
+{
+	double x = p[0], y = p[1], z = p[2];
+	double error =
+		(a.a2 + b.a2) * x * x + (a.b2 + b.b2) * y * y + (a.c2 + b.c2) * z * z + (a.d2 + b.d2) +
+		2.0 * ((a.ab + b.ab) * x * y + (a.ac + b.ac) * x * z + (a.bc + b.bc) * y * z +
+			(a.ad + b.ad) * x + (a.bd + b.bd) * y + (a.cd + b.cd) * z);
+	double weight = a.weight + b.weight;
+	return weight > 0.0 ? (float)std::max(error / weight, 0.0) : 0.0f;
+}
+
+static glm::vec3 position(const std::vector<MeshVertex>& vertices, unsigned int vertex)
+{
+	return glm::vec3(vertices[vertex].position[0], vertices[vertex].position[1], vertices[vertex].position[2]);
+}
+
+static uint64_t edgeKey(unsigned int from, unsigned int to)
+{
+	return ((uint64_t)from << 32) | to;
+}
+
+// vertices that share their position with another vertex (a UV or normal seam)
+// or have an edge without a twin (an open border) stay put
+static void lockedVertices(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices,
+	std::vector<char>& locked)
+{
+	locked.assign(vertices.size(), 0);
+
+	struct PositionHash
+	{
+		size_t operator()(const glm::vec3& p) const
+		{
+			unsigned int bits[3];
+			glm::vec3 q = p + glm::vec3(0.0f);	// -0 and 0 compare equal
+			std::memcpy(bits, &q, sizeof(bits));
+			return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+		}
+	};
+	std::unordered_map<glm::vec3, unsigned int, PositionHash> first;
+	first.reserve(vertices.size());
+	for (unsigned int v = 0; v < vertices.size(); v++)
+	{
+		auto inserted = first.insert(std::make_pair(position(vertices, v), v));
+		if (!inserted.second)
+			locked[v] = locked[inserted.first->second] = 1;
+	}
+
+	std::unordered_map<uint64_t, unsigned int> edges;
+	edges.reserve(indices.size());
+	for (size_t i = 0; i < indices.size(); i += 3)
+		for (int k = 0; k < 3; k++)
+			edges[edgeKey(indices[i + k], indices[i + (k + 1) % 3])]++;
+	for (const auto& edge : edges)
+	{
+		unsigned int from = (unsigned int)(edge.first >> 32), to = (unsigned int)edge.first;
+		if (edges.find(edgeKey(to, from)) == edges.end())
+			locked[from] = locked[to] = 1;
+	}
+}
+
+// would moving 'from' onto 'to' turn any of its other triangles over?
+static bool flips(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices,
+	const std::vector<unsigned int>& offsets, const std::vector<unsigned int>& adjacency, unsigned int from, unsigned int to)
+{
+	glm::vec3 target = position(vertices, to);
+	for (unsigned int a = offsets[from]; a < offsets[from + 1]; a++)
+	{
+		const unsigned int* triangle = &indices[adjacency[a] * 3];
+		if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+			continue;	// collapses away
+		glm::vec3 p[3], q[3];
+		for (int k = 0; k < 3; k++)
+		{
+			p[k] = position(vertices, triangle[k]);
+			q[k] = triangle[k] == from ? target : p[k];
+		}
+		glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+		glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+		// more than about 75 degrees of turn counts as a flip; slivers are left alone
+		if (glm::dot(before, after) < 0.25f * glm::length(before) * glm::length(after))
+			return true;
+	}
+	return false;
+}
+
+float simplifyMesh(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices,
+	size_t targetIndexCount, float targetError, std::vector<unsigned int>& simplified)
+{
+	size_t vertexCount = vertices.size();
+	simplified.assign(indices.begin(), indices.end() - indices.size() % 3);
+	if (simplified.size() <= targetIndexCount || vertexCount == 0)
+		return 0.0f;
+
+	std::vector<char> locked;
+	lockedVertices(vertices, simplified, locked);
+
+	std::vector<Quadric> quadrics(vertexCount);
+	std::memset(quadrics.data(), 0, quadrics.size() * sizeof(Quadric));
+	for (size_t i = 0; i < simplified.size(); i += 3)
+	{
+		glm::vec3 p0 = position(vertices, simplified[i]);
+		glm::vec3 normal = glm::cross(position(vertices, simplified[i + 1]) - p0, position(vertices, simplified[i + 2]) - p0);
+		float area = glm::length(normal);
+		if (area == 0.0f)
+			continue;
+		normal /= area;
+		Quadric plane = planeQuadric(normal.x, normal.y, normal.z, -glm::dot(normal, p0), area * 0.5f);
+		for (int k = 0; k < 3; k++)
+			quadrics[simplified[i + k]].add(plane);
+	}
+
+	struct Collapse
+	{
+		unsigned int from, to;
+		float cost;
+	};
+	std::vector<Collapse> collapses;
+	std::vector<unsigned int> offsets(vertexCount + 1), adjacency, remap(vertexCount);
+	std::vector<char> touched(vertexCount);
+	float limit = targetError * targetError;
+	float reached = 0.0f;
+
+	// passes of independent collapses, cheapest first, until the target or the error limit
+	while (simplified.size() > targetIndexCount)
+	{
+		size_t triangleCount = simplified.size() / 3;
+		std::fill(offsets.begin(), offsets.end(), 0);
+		for (unsigned int index : simplified)
+			offsets[index + 1]++;
+		for (size_t v = 0; v < vertexCount; v++)
+			offsets[v + 1] += offsets[v];
+		adjacency.resize(simplified.size());
+		{
+			std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < simplified.size(); i++)
+				adjacency[fill[simplified[i]]++] = (unsigned int)(i / 3);
+		}
+
+		// each interior edge shows up once as a->b with a < b; try both directions
+		collapses.clear();
+		for (size_t i = 0; i < simplified.size(); i += 3)
+			for (int k = 0; k < 3; k++)
+			{
+				unsigned int a = simplified[i + k], b = simplified[i + (k + 1) % 3];
+				if (a >= b)
+					continue;
+				if (!locked[a])
+					collapses.push_back({ a, b, quadricError(quadrics[a], quadrics[b], vertices[b].position) });
+				if (!locked[b])
+					collapses.push_back({ b, a, quadricError(quadrics[a], quadrics[b], vertices[a].position) });
+			}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.cost < y.cost; });
+
+		// an interior collapse takes two triangles with it
+		size_t wanted = (simplified.size() - targetIndexCount + 5) / 6;
+		size_t applied = 0;
+		for (size_t v = 0; v < vertexCount; v++)
+			remap[v] = (unsigned int)v;
+		std::fill(touched.begin(), touched.end(), 0);
+		for (const Collapse& collapse : collapses)
+		{
+			if (collapse.cost > limit || applied >= wanted)
+				break;
+			if (touched[collapse.from] || touched[collapse.to])
+				continue;
+			if (flips(vertices, simplified, offsets, adjacency, collapse.from, collapse.to))
+				continue;
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to].add(quadrics[collapse.from]);
+			// the triangles around 'from' change shape; keep their other vertices
+			// out of this pass so every flip test above stays valid
+			for (unsigned int a = offsets[collapse.from]; a < offsets[collapse.from + 1]; a++)
+				for (int k = 0; k < 3; k++)
+					touched[simplified[adjacency[a] * 3 + k]] = 1;
+			reached = std::max(reached, collapse.cost);
+			applied++;
+		}
+		if (applied == 0)
+			break;
+
+		size_t write = 0;
+		for (size_t t = 0; t < triangleCount; t++)
+		{
+			unsigned int a = remap[simplified[t * 3]], b = remap[simplified[t * 3 + 1]], c = remap[simplified[t * 3 + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+			simplified[write++] = a;
+			simplified[write++] = b;
+			simplified[write++] = c;
+		}
+		simplified.resize(write);
+	}
+	return std::sqrt(reached);
+}
+
+void buildLodChain(Mesh& mesh, LodChain& chain, const LodChainSettings& settings)
+{
+	chain.indices.clear();
+	chain.levels.clear();
+	if (mesh.vertices.empty() || mesh.indices.size() < 3)
+		return;
+
+	glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+	for (size_t v = 0; v < mesh.vertices.size(); v++)
+	{
+		low = glm::min(low, position(mesh.vertices, (unsigned int)v));
+		high = glm::max(high, position(mesh.vertices, (unsigned int)v));
+	}
+	chain.center = (low + high) * 0.5f;
+	chain.radius = 0.0f;
+	for (size_t v = 0; v < mesh.vertices.size(); v++)
+		chain.radius = std::max(chain.radius, glm::length(position(mesh.vertices, (unsigned int)v) - chain.center));
+
+	// the full mesh is used as it comes, overdraw order and all
+	chain.indices = mesh.indices;
+	chain.levels.push_back({ 0, (unsigned int)mesh.indices.size(), 0.0f });
+
+	// each level simplifies the one before, so errors add up; the budget left
+	// for a level is what the ones before it haven't used
+	std::vector<unsigned int> current = mesh.indices, next;
+	float error = 0.0f;
+	float maxError = settings.maxError * chain.radius;
+	while (chain.levels.size() < settings.maxLevels && current.size() / 3 > settings.minTriangles)
+	{
+		size_t target = std::max((size_t)(current.size() / 3 * settings.reduction), (size_t)settings.minTriangles) * 3;
+		float levelError = simplifyMesh(mesh.vertices, current, target, maxError - error, next);
+		// stuck on the error limit or on locked vertices
+		if (next.size() > current.size() * 9 / 10)
+			break;
+		optimizeVertexCache(next, mesh.vertices.size());
+		error += levelError;
+		chain.levels.push_back({ (unsigned int)chain.indices.size(), (unsigned int)next.size(), error });
+		chain.indices.insert(chain.indices.end(), next.begin(), next.end());
+		current.swap(next);
+	}
+
+	// fetch order for the whole chain, which is the full mesh's first-use order
+	// with the few vertices only coarse levels need added at the end
+	Mesh all;
+	all.vertices.swap(mesh.vertices);
+	all.indices.swap(chain.indices);
+	optimizeVertexFetch(all);
+	mesh.vertices.swap(all.vertices);
+	chain.indices.swap(all.indices);
+	mesh.indices.assign(chain.indices.begin(), chain.indices.begin() + chain.levels[0].indexCount);
+}
+
+void selectLods(const LodChain& chain, const glm::mat4* models, size_t instanceCount, const glm::mat4& view,
+	const glm::mat4& projection, float viewportHeight, LodSelection& selection, const LodSelectSettings& settings)
+{
+	size_t levelCount = chain.levels.size();
+	selection.instances.resize(levelCount);
+	for (std::vector<unsigned int>& instances : selection.instances)
+		instances.clear();
+	selection.triangles = 0;
+	if (levelCount == 0)
+		return;
+
+	// projection[1][1] is 1 / tan(fovy / 2), so this is pixels per unit at distance 1
+	float pixelsAtUnitDistance = projection[1][1] * viewportHeight * 0.5f;
+	std::vector<unsigned int> levels(instanceCount);
+	std::vector<float> screenSize(instanceCount);
+	for (size_t i = 0; i < instanceCount; i++)
+	{
+		const glm::mat4& model = models[i];
+		float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		glm::vec4 center = view * model * glm::vec4(chain.center, 1.0f);
+		// the nearest point of the bounding sphere decides; inside it, always the full mesh
+		float distance = -center.z - chain.radius * scale;
+		unsigned int level = 0;
+		float pixelsPerUnit = FLT_MAX;
+		if (distance > 0.0f)
+		{
+			pixelsPerUnit = pixelsAtUnitDistance * scale / distance;
+			for (level = (unsigned int)levelCount - 1; level > 0; level--)
+				if (chain.levels[level].error * pixelsPerUnit <= settings.pixelError)
+					break;
+		}
+		levels[i] = level;
+		screenSize[i] = pixelsPerUnit;
+		selection.triangles += chain.levels[level].indexCount / 3;
+	}
+
+	if (settings.triangleBudget && selection.triangles > settings.triangleBudget)
+	{
+		// one level coarser at a time, smallest on screen first, until it fits or
+		// everything is at the coarsest level
+		std::vector<unsigned int> order(instanceCount);
+		for (size_t i = 0; i < instanceCount; i++)
+			order[i] = (unsigned int)i;
+		std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) { return screenSize[a] < screenSize[b]; });
+		bool changed = true;
+		while (changed && selection.triangles > settings.triangleBudget)
+		{
+			changed = false;
+			for (unsigned int i : order)
+			{
+				if (levels[i] + 1 >= levelCount)
+					continue;
+				selection.triangles -= (chain.levels[levels[i]].indexCount - chain.levels[levels[i] + 1].indexCount) / 3;
+				levels[i]++;
+				changed = true;
+				if (selection.triangles <= settings.triangleBudget)
+					break;
+			}
+		}
+	}
+
+	for (size_t i = 0; i < instanceCount; i++)
+		selection.instances[levels[i]].push_back((unsigned int)i);
+}
@@ -0,0 +1,338 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+struct VertexHash
+{
+	size_t operator()(const MeshVertex& vertex) const
+	{
+		// FNV-1a over the bits; VertexEqual makes -0 and 0 equal, so hash them the same
+		const float* values = vertex.position;
+		size_t hash = 2166136261u;
+		for (int i = 0; i < 8; i++)
+		{
+			float value = values[i] + 0.0f;
+			unsigned int bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+			hash = (hash ^ bits) * 16777619u;
+		}
+		return hash;
+	}
+};
+
+struct VertexEqual
+{
+	bool operator()(const MeshVertex& a, const MeshVertex& b) const
+	{
+		const float* x = a.position;
+		const float* y = b.position;
+		for (int i = 0; i < 8; i++)
+			if (x[i] != y[i])
+				return false;
+		return true;
+	}
+};
+
+static_assert(sizeof(MeshVertex) == 8 * sizeof(float), "MeshVertex is hashed as 8 packed floats");
+
+void deduplicateVertices(const std::vector<MeshVertex>& corners, Mesh& mesh)
+{
+	std::unordered_map<MeshVertex, unsigned int, VertexHash, VertexEqual> unique;
+	unique.reserve(corners.size());
+	mesh.vertices.clear();
+	mesh.indices.resize(corners.size());
+	for (size_t i = 0; i < corners.size(); i++)
+	{
+		auto inserted = unique.insert(std::make_pair(corners[i], (unsigned int)mesh.vertices.size()));
+		if (inserted.second)
+			mesh.vertices.push_back(corners[i]);
+		mesh.indices[i] = inserted.first->second;
+	}
+}
+
+// FIFO post-transform cache: a vertex is a hit while fewer than 'size' misses
+// happened since it went in. flush() empties it without touching every vertex
+class FifoCache
+{
+public:
+	FifoCache(size_t vertexCount, unsigned int size)
+		: stamps(vertexCount, 0), time(size + 1), size(size) {}
+
+	bool access(unsigned int vertex)
+	{
+		if (time - stamps[vertex] <= size)
+			return true;
+		stamps[vertex] = time++;
+		return false;
+	}
+	void flush() { time += size + 1; }
+
+private:
+	std::vector<unsigned int> stamps;
+	unsigned int time;
+	unsigned int size;
+};
+
+static unsigned int triangleMisses(FifoCache& cache, const unsigned int* triangle)
+{
+	return !cache.access(triangle[0]) + !cache.access(triangle[1]) + !cache.access(triangle[2]);
+}
+
+// next vertex to fan around when the candidates are all dead: the most recently
+// emitted vertex that still has triangles, then the lowest numbered one
+static int skipDeadEnd(std::vector<unsigned int>& deadEnd, const std::vector<unsigned int>& live, size_t& cursor)
+{
+	while (!deadEnd.empty())
+	{
+		unsigned int vertex = deadEnd.back();
+		deadEnd.pop_back();
+		if (live[vertex] > 0)
+			return (int)vertex;
+	}
+	for (; cursor < live.size(); cursor++)
+		if (live[cursor] > 0)
+			return (int)cursor;
+	return -1;
+}
+
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || vertexCount == 0)
+		return;
+
+	// triangles around each vertex, as offsets into one array
+	std::vector<unsigned int> live(vertexCount, 0);
+	for (size_t i = 0; i < triangleCount * 3; i++)
+		live[indices[i]]++;
+	std::vector<unsigned int> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; v++)
+		offsets[v + 1] = offsets[v] + live[v];
+	std::vector<unsigned int> adjacency(triangleCount * 3);
+	{
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; i++)
+			adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+	}
+
+	std::vector<unsigned int> stamps(vertexCount, 0);
+	std::vector<char> emitted(triangleCount, 0);
+	std::vector<unsigned int> deadEnd;
+	std::vector<unsigned int> candidates;
+	std::vector<unsigned int> output;
+	output.reserve(triangleCount * 3);
+	deadEnd.reserve(triangleCount * 3);
+	unsigned int time = cacheSize + 1;
+	size_t cursor = 0;
+
+	int fanning = skipDeadEnd(deadEnd, live, cursor);
+	while (fanning >= 0)
+	{
+		// emit every remaining triangle around the fanning vertex
+		candidates.clear();
+		for (unsigned int a = offsets[fanning]; a < offsets[fanning + 1]; a++)
+		{
+			unsigned int triangle = adjacency[a];
+			if (emitted[triangle])
+				continue;
+			emitted[triangle] = 1;
+			for (int k = 0; k < 3; k++)
+			{
+				unsigned int vertex = indices[triangle * 3 + k];
+				output.push_back(vertex);
+				deadEnd.push_back(vertex);
+				candidates.push_back(vertex);
+				live[vertex]--;
+				if (time - stamps[vertex] > cacheSize)
+					stamps[vertex] = time++;
+			}
+		}
+
+		// pick the candidate that will still be in the cache after its remaining
+		// triangles go out, preferring the one that went in earliest
+		int next = -1;
+		int best = -1;
+		for (unsigned int vertex : candidates)
+		{
+			if (live[vertex] == 0)
+				continue;
+			int priority = 0;
+			if (time - stamps[vertex] + 2 * live[vertex] <= cacheSize)
+				priority = (int)(time - stamps[vertex]);
+			if (priority > best)
+			{
+				best = priority;
+				next = (int)vertex;
+			}
+		}
+		if (next < 0)
+			next = skipDeadEnd(deadEnd, live, cursor);
+		fanning = next;
+	}
+	indices.swap(output);
+}
+
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<MeshVertex>& vertices,
+	float threshold, unsigned int cacheSize)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount < 2)
+		return;
+
+	// hard boundaries: a triangle that misses on all three vertices starts cold
+	// anyway, so clusters can be moved there without losing any reuse
+	std::vector<size_t> clusters;
+	FifoCache cache(vertices.size(), cacheSize);
+	for (size_t t = 0; t < triangleCount; t++)
+		if (triangleMisses(cache, &indices[t * 3]) == 3)
+			clusters.push_back(t);
+	if (clusters.empty() || clusters[0] != 0)
+		clusters.insert(clusters.begin(), 0);
+	clusters.push_back(triangleCount);
+
+	// soft boundaries: split a cluster once its running ACMR gets close enough to
+	// what the whole cluster reaches, so the split costs at most 'threshold'
+	std::vector<size_t> split;
+	for (size_t c = 0; c + 1 < clusters.size(); c++)
+	{
+		size_t begin = clusters[c], end = clusters[c + 1];
+		split.push_back(begin);
+		if (threshold <= 1.0f)
+			continue;
+		cache.flush();
+		unsigned int misses = 0;
+		for (size_t t = begin; t < end; t++)
+			misses += triangleMisses(cache, &indices[t * 3]);
+		float target = (float)misses / (end - begin) * threshold;
+
+		cache.flush();
+		misses = 0;
+		size_t start = begin;
+		for (size_t t = begin; t + 1 < end; t++)
+		{
+			misses += triangleMisses(cache, &indices[t * 3]);
+			if ((float)misses / (t + 1 - start) <= target)
+			{
+				start = t + 1;
+				split.push_back(start);
+				cache.flush();
+				misses = 0;
+			}
+		}
+	}
+	split.push_back(triangleCount);
+
+	// mesh centroid, then each cluster's area-weighted centroid and normal
+	float meshCenter[3] = { 0.0f, 0.0f, 0.0f };
+	float meshArea = 0.0f;
+	struct Cluster
+	{
+		size_t begin, end;
+		float key;
+	};
+	std::vector<Cluster> sorted(split.size() - 1);
+	std::vector<float> centers(sorted.size() * 4);
+	std::vector<float> normals(sorted.size() * 3);
+	for (size_t c = 0; c < sorted.size(); c++)
+	{
+		float* center = &centers[c * 4];
+		float* normal = &normals[c * 3];
+		std::memset(center, 0, 4 * sizeof(float));
+		std::memset(normal, 0, 3 * sizeof(float));
+		for (size_t t = split[c]; t < split[c + 1]; t++)
+		{
+			const float* a = vertices[indices[t * 3 + 0]].position;
+			const float* b = vertices[indices[t * 3 + 1]].position;
+			const float* d = vertices[indices[t * 3 + 2]].position;
+			float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+			float v[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+			float n[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+			float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			for (int k = 0; k < 3; k++)
+			{
+				center[k] += (a[k] + b[k] + d[k]) / 3.0f * area;
+				normal[k] += n[k];
+			}
+			center[3] += area;
+		}
+		for (int k = 0; k < 3; k++)
+			meshCenter[k] += center[k];
+		meshArea += center[3];
+	}
+	for (int k = 0; k < 3; k++)
+		meshCenter[k] = meshArea > 0.0f ? meshCenter[k] / meshArea : 0.0f;
+
+	for (size_t c = 0; c < sorted.size(); c++)
+	{
+		const float* center = &centers[c * 4];
+		const float* normal = &normals[c * 3];
+		float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		float key = 0.0f;
+		if (center[3] > 0.0f && length > 0.0f)
+			for (int k = 0; k < 3; k++)
+				key += (center[k] / center[3] - meshCenter[k]) * normal[k] / length;
+		sorted[c].begin = split[c];
+		sorted[c].end = split[c + 1];
+		sorted[c].key = key;
+	}
+	// clusters facing out from the middle of the mesh first; they can only
+	// occlude the ones behind them
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+	std::vector<unsigned int> output;
+	output.reserve(triangleCount * 3);
+	for (const Cluster& cluster : sorted)
+		output.insert(output.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+	indices.swap(output);
+}
+
+size_t optimizeVertexFetch(Mesh& mesh)
+{
+	std::vector<unsigned int> remap(mesh.vertices.size(), ~0u);
+	unsigned int next = 0;
+	for (unsigned int& index : mesh.indices)
+	{
+		if (remap[index] == ~0u)
+			remap[index] = next++;
+		index = remap[index];
+	}
+	std::vector<MeshVertex> vertices(next);
+	for (size_t i = 0; i < mesh.vertices.size(); i++)
+		if (remap[i] != ~0u)
+			vertices[remap[i]] = mesh.vertices[i];
+	mesh.vertices.swap(vertices);
+	return next;
+}
+
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize)
+{
+	VertexCacheStats stats;
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return stats;
+	FifoCache cache(vertexCount, cacheSize);
+	std::vector<char> used(vertexCount, 0);
+	size_t misses = 0, usedCount = 0;
+	for (size_t i = 0; i < triangleCount * 3; i++)
+	{
+		misses += !cache.access(indices[i]);
+		if (!used[indices[i]])
+		{
+			used[indices[i]] = 1;
+			usedCount++;
+		}
+	}
+	stats.acmr = (float)misses / triangleCount;
+	stats.atvr = (float)misses / usedCount;
+	return stats;
+}
+
+void optimizeMesh(Mesh& mesh, float overdrawThreshold)
+{
+	optimizeVertexCache(mesh.indices, mesh.vertices.size());
+	optimizeOverdraw(mesh.indices, mesh.vertices, overdrawThreshold);
+	optimizeVertexFetch(mesh);
+}
@@ -0,0 +1,361 @@
+#include "meshlet.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <thread>
+
+#include "cpu_features.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+static glm::vec3 position(const Mesh& mesh, unsigned int vertex)
+{
+	const float* p = mesh.vertices[vertex].position;
+	return glm::vec3(p[0], p[1], p[2]);
+}
+
+// bounding sphere around the meshlet's vertices and the cone of its triangle
+// normals; the cone apex sits where every triangle's plane has it behind, so
+// a camera inside the cone sees only back faces
+static MeshletBounds meshletBounds(const Mesh& mesh, const MeshletMesh& meshlets, const Meshlet& meshlet)
+{
+	const unsigned int* vertices = &meshlets.vertices[meshlet.vertexOffset];
+	const unsigned char* triangles = &meshlets.triangles[(size_t)meshlet.triangleOffset * 3];
+
+	glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+	for (unsigned int i = 0; i < meshlet.vertexCount; i++)
+	{
+		low = glm::min(low, position(mesh, vertices[i]));
+		high = glm::max(high, position(mesh, vertices[i]));
+	}
+	MeshletBounds bounds;
+	bounds.center = (low + high) * 0.5f;
+	bounds.radius = 0.0f;
+	for (unsigned int i = 0; i < meshlet.vertexCount; i++)
+		bounds.radius = std::max(bounds.radius, glm::length(position(mesh, vertices[i]) - bounds.center));
+
+	// degenerate triangles face nowhere and don't count
+	std::vector<glm::vec3> normals, corners;
+	glm::vec3 sum(0.0f);
+	for (unsigned int t = 0; t < meshlet.triangleCount; t++)
+	{
+		glm::vec3 a = position(mesh, vertices[triangles[t * 3 + 0]]);
+		glm::vec3 b = position(mesh, vertices[triangles[t * 3 + 1]]);
+		glm::vec3 c = position(mesh, vertices[triangles[t * 3 + 2]]);
+		glm::vec3 normal = glm::cross(b - a, c - a);
+		float length = glm::length(normal);
+		if (length <= 0.0f)
+			continue;
+		normals.push_back(normal / length);
+		corners.push_back(a);
+		sum += normal / length;
+	}
+
+	bounds.coneApex = bounds.center;
+	bounds.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+	bounds.coneCutoff = 2.0f;
+	float sumLength = glm::length(sum);
+	if (normals.empty() || sumLength <= 0.0f)
+		return bounds;
+	glm::vec3 axis = sum / sumLength;
+	float minDot = 1.0f;
+	for (const glm::vec3& normal : normals)
+		minDot = std::min(minDot, glm::dot(normal, axis));
+	// wider than about 170 degrees the cone hardly ever culls anything
+	if (minDot <= 0.1f)
+		return bounds;
+
+	// step back from the center along the axis until behind every triangle's plane
+	float back = 0.0f;
+	for (size_t i = 0; i < normals.size(); i++)
+		back = std::max(back, glm::dot(bounds.center - corners[i], normals[i]) / glm::dot(axis, normals[i]));
+	bounds.coneApex = bounds.center - axis * back;
+	bounds.coneAxis = axis;
+	bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	return bounds;
+}
+
+void buildMeshlets(const Mesh& mesh, MeshletMesh& meshlets, unsigned int maxVertices, unsigned int maxTriangles)
+{
+	maxVertices = std::max(3u, std::min(maxVertices, 255u));
+	maxTriangles = std::max(1u, std::min(maxTriangles, 255u));
+	meshlets = MeshletMesh();
+
+	// where each mesh vertex is in the current meshlet; 0xff while it isn't
+	std::vector<unsigned char> slot(mesh.vertices.size(), 0xff);
+	Meshlet current = {};
+	auto finish = [&]() {
+		if (current.triangleCount == 0)
+			return;
+		for (unsigned int i = 0; i < current.vertexCount; i++)
+			slot[meshlets.vertices[current.vertexOffset + i]] = 0xff;
+		meshlets.meshlets.push_back(current);
+		current.vertexOffset += current.vertexCount;
+		current.triangleOffset += current.triangleCount;
+		current.vertexCount = 0;
+		current.triangleCount = 0;
+	};
+
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+	{
+		const unsigned int* triangle = &mesh.indices[i];
+		unsigned int added = 0;
+		for (int k = 0; k < 3; k++)
+			if (slot[triangle[k]] == 0xff && (k == 0 || triangle[k] != triangle[0]) && (k < 2 || triangle[k] != triangle[1]))
+				added++;
+		if (current.vertexCount + added > maxVertices || current.triangleCount == maxTriangles)
+			finish();
+		for (int k = 0; k < 3; k++)
+		{
+			if (slot[triangle[k]] == 0xff)
+			{
+				slot[triangle[k]] = (unsigned char)current.vertexCount++;
+				meshlets.vertices.push_back(triangle[k]);
+			}
+			meshlets.triangles.push_back(slot[triangle[k]]);
+		}
+		current.triangleCount++;
+	}
+	finish();
+
+	meshlets.bounds.reserve(meshlets.meshlets.size());
+	for (const Meshlet& meshlet : meshlets.meshlets)
+		meshlets.bounds.push_back(meshletBounds(mesh, meshlets, meshlet));
+}
+
+void meshletIndices(const MeshletMesh& meshlets, std::vector<unsigned int>& indices)
+{
+	indices.resize(meshlets.triangles.size());
+	for (const Meshlet& meshlet : meshlets.meshlets)
+		for (unsigned int i = 0; i < meshlet.triangleCount * 3; i++)
+			indices[(size_t)meshlet.triangleOffset * 3 + i] =
+				meshlets.vertices[meshlet.vertexOffset + meshlets.triangles[(size_t)meshlet.triangleOffset * 3 + i]];
+}
+
+MeshletCuller::MeshletCuller(const MeshletMesh& meshlets)
+	: count(meshlets.bounds.size())
+{
+	size_t padded = (count + 7) & ~(size_t)7;
+	// padding has a negative radius, so it's outside every plane, and a cone that never culls
+	centerX.assign(padded, 0.0f); centerY.assign(padded, 0.0f); centerZ.assign(padded, 0.0f);
+	radius.assign(padded, -FLT_MAX);
+	apexX.assign(padded, 0.0f); apexY.assign(padded, 0.0f); apexZ.assign(padded, 0.0f);
+	axisX.assign(padded, 0.0f); axisY.assign(padded, 0.0f); axisZ.assign(padded, 1.0f);
+	cutoff.assign(padded, 2.0f);
+	for (size_t i = 0; i < count; i++)
+	{
+		const MeshletBounds& bounds = meshlets.bounds[i];
+		centerX[i] = bounds.center.x; centerY[i] = bounds.center.y; centerZ[i] = bounds.center.z;
+		radius[i] = bounds.radius;
+		apexX[i] = bounds.coneApex.x; apexY[i] = bounds.coneApex.y; apexZ[i] = bounds.coneApex.z;
+		axisX[i] = bounds.coneAxis.x; axisY[i] = bounds.coneAxis.y; axisZ[i] = bounds.coneAxis.z;
+		cutoff[i] = bounds.coneCutoff;
+	}
+}
+
+// what one cull call tests against: six normalized planes and the camera
+struct CullView
+{
+	float planes[6][4];
+	float camera[3];
+};
+
+// the SoA arrays, read-only, for the kernels
+struct CullArrays
+{
+	const float *centerX, *centerY, *centerZ, *radius;
+	const float *apexX, *apexY, *apexZ, *axisX, *axisY, *axisZ, *cutoff;
+};
+
+// frustum planes straight from the matrix (Gribb & Hartmann), pointing inward
+// and normalized so plane distances compare with radii
+static CullView cullView(const glm::mat4& m, const glm::vec3& camera)
+{
+	CullView view;
+	for (int p = 0; p < 6; p++)
+	{
+		int axis = p / 2;
+		float sign = (p & 1) ? -1.0f : 1.0f;
+		glm::vec4 plane;
+		for (int c = 0; c < 4; c++)
+			plane[c] = m[c][3] + sign * m[c][axis];
+		float length = glm::length(glm::vec3(plane));
+		if (length > 0.0f)
+			plane /= length;
+		for (int c = 0; c < 4; c++)
+			view.planes[p][c] = plane[c];
+	}
+	view.camera[0] = camera.x;
+	view.camera[1] = camera.y;
+	view.camera[2] = camera.z;
+	return view;
+}
+
+// the reference the SIMD kernels match; writes visible[begin, end)
+static size_t cullScalar(const CullArrays& a, const CullView& view, unsigned char* visible, size_t begin, size_t end)
+{
+	size_t kept = 0;
+	for (size_t i = begin; i < end; i++)
+	{
+		bool inside = true;
+		for (int p = 0; p < 6; p++)
+		{
+			const float* plane = view.planes[p];
+			float distance = plane[0] * a.centerX[i] + plane[1] * a.centerY[i] + plane[2] * a.centerZ[i] + plane[3];
+			inside = inside && distance >= -a.radius[i];
+		}
+		float dx = a.apexX[i] - view.camera[0], dy = a.apexY[i] - view.camera[1], dz = a.apexZ[i] - view.camera[2];
+		float along = dx * a.axisX[i] + dy * a.axisY[i] + dz * a.axisZ[i];
+		bool backFacing = along >= a.cutoff[i] * std::sqrt(dx * dx + dy * dy + dz * dz);
+		visible[i] = inside && !backFacing ? 1 : 0;
+		kept += visible[i];
+	}
+	return kept;
+}
+
+#ifdef CPU_X86
+// a movemask result as one byte per lane; returns how many are set
+static size_t storeMask(int mask, int lanes, unsigned char* visible)
+{
+	size_t set = 0;
+	for (int lane = 0; lane < lanes; lane++)
+	{
+		visible[lane] = (unsigned char)((mask >> lane) & 1);
+		set += visible[lane];
+	}
+	return set;
+}
+
+// 4 meshlets per step; begin and end are multiples of 4 within the padding
+static size_t cullSSE(const CullArrays& a, const CullView& view, unsigned char* visible, size_t begin, size_t end)
+{
+	size_t kept = 0;
+	__m128 camX = _mm_set1_ps(view.camera[0]), camY = _mm_set1_ps(view.camera[1]), camZ = _mm_set1_ps(view.camera[2]);
+	for (size_t i = begin; i < end; i += 4)
+	{
+		__m128 cx = _mm_loadu_ps(a.centerX + i), cy = _mm_loadu_ps(a.centerY + i), cz = _mm_loadu_ps(a.centerZ + i);
+		__m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(a.radius + i));
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int p = 0; p < 6; p++)
+		{
+			const float* plane = view.planes[p];
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[0]), cx), _mm_mul_ps(_mm_set1_ps(plane[1]), cy)),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane[2]), cz), _mm_set1_ps(plane[3])));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+		}
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(a.apexX + i), camX);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(a.apexY + i), camY);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(a.apexZ + i), camZ);
+		__m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(a.axisX + i)), _mm_mul_ps(dy, _mm_loadu_ps(a.axisY + i))),
+			_mm_mul_ps(dz, _mm_loadu_ps(a.axisZ + i)));
+		__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+		__m128 backFacing = _mm_cmpge_ps(along, _mm_mul_ps(_mm_loadu_ps(a.cutoff + i), distance));
+		int mask = _mm_movemask_ps(_mm_andnot_ps(backFacing, inside));
+		kept += storeMask(mask, 4, visible + i);
+	}
+	return kept;
+}
+
+// the same with 8 meshlets per step; begin and end are multiples of 8
+CPU_TARGET_AVX static size_t cullAVX(const CullArrays& a, const CullView& view, unsigned char* visible, size_t begin, size_t end)
+{
+	size_t kept = 0;
+	__m256 camX = _mm256_set1_ps(view.camera[0]), camY = _mm256_set1_ps(view.camera[1]), camZ = _mm256_set1_ps(view.camera[2]);
+	for (size_t i = begin; i < end; i += 8)
+	{
+		__m256 cx = _mm256_loadu_ps(a.centerX + i), cy = _mm256_loadu_ps(a.centerY + i), cz = _mm256_loadu_ps(a.centerZ + i);
+		__m256 negRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(a.radius + i));
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (int p = 0; p < 6; p++)
+		{
+			const float* plane = view.planes[p];
+			__m256 distance = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[0]), cx), _mm256_mul_ps(_mm256_set1_ps(plane[1]), cy)),
+				_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane[2]), cz), _mm256_set1_ps(plane[3])));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GE_OQ));
+		}
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(a.apexX + i), camX);
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(a.apexY + i), camY);
+		__m256 dz = _mm256_sub_ps(_mm256_loadu_ps(a.apexZ + i), camZ);
+		__m256 along = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(dx, _mm256_loadu_ps(a.axisX + i)), _mm256_mul_ps(dy, _mm256_loadu_ps(a.axisY + i))),
+			_mm256_mul_ps(dz, _mm256_loadu_ps(a.axisZ + i)));
+		__m256 distance = _mm256_sqrt_ps(
+			_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+		__m256 backFacing = _mm256_cmp_ps(along, _mm256_mul_ps(_mm256_loadu_ps(a.cutoff + i), distance), _CMP_GE_OQ);
+		int mask = _mm256_movemask_ps(_mm256_andnot_ps(backFacing, inside));
+		kept += storeMask(mask, 8, visible + i);
+	}
+	return kept;
+}
+#endif
+
+size_t MeshletCuller::cull(const glm::mat4& modelViewProjection, const glm::vec3& camera, std::vector<unsigned char>& visible,
+	const MeshletCullSettings& settings) const
+{
+	CullView view = cullView(modelViewProjection, camera);
+	CullArrays arrays = { centerX.data(), centerY.data(), centerZ.data(), radius.data(),
+		apexX.data(), apexY.data(), apexZ.data(), axisX.data(), axisY.data(), axisZ.data(), cutoff.data() };
+	// the kernels write whole groups of 8 into the padding, so size for that and trim after
+	size_t padded = centerX.size();
+	visible.resize(padded);
+
+	size_t (*kernel)(const CullArrays&, const CullView&, unsigned char*, size_t, size_t) = cullScalar;
+#ifdef CPU_X86
+	if (settings.simd)
+		kernel = settings.avx && cpuHasAVX() ? cullAVX : cullSSE;
+#endif
+
+	// below this many meshlets per thread, starting the thread costs more than it saves
+	const size_t minGroups = 4096 / 8;
+	size_t groups = padded / 8;
+	int threads = settings.threads > 0 ? settings.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+	threads = (int)std::max<size_t>(1, std::min<size_t>(threads, groups / minGroups));
+
+	size_t kept = 0;
+	if (threads == 1)
+		kept = kernel(arrays, view, visible.data(), 0, padded);
+	else
+	{
+		// bands of whole groups of 8, so no two threads write the same group
+		std::vector<size_t> counts(threads);
+		std::vector<std::thread> workers;
+		auto band = [&](int t) {
+			counts[t] = kernel(arrays, view, visible.data(), groups * t / threads * 8, groups * (t + 1) / threads * 8);
+		};
+		for (int t = 1; t < threads; t++)
+			workers.emplace_back(band, t);
+		band(0);
+		for (std::thread& worker : workers)
+			worker.join();
+		for (size_t c : counts)
+			kept += c;
+	}
+	visible.resize(count);
+	return kept;
+}
+
+void buildMeshletDraws(const MeshletMesh& meshlets, const std::vector<unsigned char>& visible,
+	std::vector<DrawElementsIndirectCommand>& commands)
+{
+	commands.clear();
+	size_t count = std::min(meshlets.meshlets.size(), visible.size());
+	for (size_t i = 0; i < count; i++)
+	{
+		if (!visible[i])
+			continue;
+		const Meshlet& meshlet = meshlets.meshlets[i];
+		// meshlets are back to back in meshletIndices' list, so a visible neighbor extends the last command
+		if (i > 0 && visible[i - 1] && !commands.empty())
+		{
+			commands.back().count += meshlet.triangleCount * 3;
+			continue;
+		}
+		DrawElementsIndirectCommand command = { meshlet.triangleCount * 3, 1, meshlet.triangleOffset * 3, 0, 0 };
+		commands.push_back(command);
+	}
+}
@@ -0,0 +1,341 @@
+#include "mip_generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#include "cpu_features.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// sRGB <-> linear. Encoding finds the nearest code exactly: a coarse table gives
+// a code at or just below the answer and the midpoints between codes finish it
+struct SrgbTables
+{
+	float toLinear[256];
+	float midpoints[255];		// linear value halfway (in sRGB) between code c and c+1
+	unsigned char start[4097];	// code for linear value k/4096
+
+	SrgbTables()
+	{
+		for (int i = 0; i < 256; i++)
+			toLinear[i] = decode(i / 255.0);
+		for (int i = 0; i < 255; i++)
+			midpoints[i] = decode((i + 0.5) / 255.0);
+		int code = 0;
+		for (int k = 0; k <= 4096; k++)
+		{
+			while (code < 255 && midpoints[code] <= k / 4096.0f)
+				code++;
+			start[k] = (unsigned char)code;
+		}
+	}
+
+	static float decode(double c)
+	{
+		return (float)(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+	}
+
+	unsigned char encode(float linear) const
+	{
+		linear = std::min(std::max(linear, 0.0f), 1.0f);
+		int code = start[(int)(linear * 4096.0f)];
+		while (code < 255 && linear >= midpoints[code])
+			code++;
+		return (unsigned char)code;
+	}
+};
+
+static const SrgbTables& srgbTables()
+{
+	static const SrgbTables tables;
+	return tables;
+}
+
+static unsigned char encodeUnorm(float value)
+{
+	return (unsigned char)(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+}
+
+static double sinc(double x)
+{
+	if (std::fabs(x) < 1e-6)
+		return 1.0;
+	x *= 3.14159265358979323846;
+	return std::sin(x) / x;
+}
+
+// modified Bessel function of the first kind, order 0
+static double besselI0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+// 't' in destination texels
+static double kernel(MipFilter filter, double t)
+{
+	const double radius = 3.0;
+	if (std::fabs(t) >= radius)
+		return 0.0;
+	if (filter == MipFilter::Lanczos)
+		return sinc(t) * sinc(t / radius);
+	const double alpha = 4.0;
+	double r = t / radius;
+	return sinc(t) * besselI0(alpha * std::sqrt(1.0 - r * r)) / besselI0(alpha);
+}
+
+// weights for shrinking one axis from 'src' to 'dst' texels; taps that fall off
+// the edge are folded onto the edge texel
+struct Taps
+{
+	std::vector<int> first;
+	std::vector<int> count;
+	std::vector<float> weights;	// 'stride' per destination texel
+	int stride = 0;
+};
+
+static void buildTaps(int src, int dst, MipFilter filter, Taps& taps)
+{
+	double scale = (double)src / dst;
+	double support = filter == MipFilter::Box ? 0.5 * scale : 3.0 * scale;
+	taps.stride = std::min(src, (int)std::ceil(2.0 * support) + 2);
+	taps.first.assign(dst, 0);
+	taps.count.assign(dst, 0);
+	taps.weights.assign((size_t)dst * taps.stride, 0.0f);
+	std::vector<double> weights;
+	for (int x = 0; x < dst; x++)
+	{
+		double center = (x + 0.5) * scale;
+		int lo = (int)std::floor(center - support), hi = (int)std::ceil(center + support) - 1;
+		int first = std::max(lo, 0), last = std::min(hi, src - 1);
+		weights.assign(last - first + 1, 0.0);
+		double total = 0.0;
+		for (int i = lo; i <= hi; i++)
+		{
+			double w;
+			if (filter == MipFilter::Box)
+				w = std::min(i + 1.0, center + support) - std::max((double)i, center - support);
+			else
+				w = kernel(filter, (i + 0.5 - center) / scale);
+			weights[std::min(std::max(i, first), last) - first] += w;
+			total += w;
+		}
+		taps.first[x] = first;
+		taps.count[x] = last - first + 1;
+		for (size_t i = 0; i < weights.size(); i++)
+			taps.weights[(size_t)x * taps.stride + i] = (float)(weights[i] / total);
+	}
+}
+
+// run fn(begin, end) over [0, count) split into contiguous bands
+template <class Fn>
+static void parallelRows(int count, int threads, Fn fn)
+{
+	threads = std::max(1, std::min(threads, count));
+	if (threads == 1)
+	{
+		fn(0, count);
+		return;
+	}
+	std::vector<std::thread> workers;
+	for (int t = 1; t < threads; t++)
+		workers.emplace_back(fn, count * t / threads, count * (t + 1) / threads);
+	fn(0, count / threads);
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+// src is srcWidth x rows RGBA floats; dst is taps.first.size() wide
+static void filterRows(const float* src, int srcWidth, float* dst, const Taps& taps, int begin, int end)
+{
+	int width = (int)taps.first.size();
+	for (int y = begin; y < end; y++)
+	{
+		const float* row = src + (size_t)y * srcWidth * 4;
+		float* out = dst + (size_t)y * width * 4;
+		for (int x = 0; x < width; x++)
+		{
+			const float* in = row + (size_t)taps.first[x] * 4;
+			const float* w = &taps.weights[(size_t)x * taps.stride];
+#ifdef CPU_X86
+			__m128 sum = _mm_setzero_ps();
+			for (int k = 0; k < taps.count[x]; k++)
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(in + k * 4), _mm_set1_ps(w[k])));
+			_mm_storeu_ps(out + x * 4, sum);
+#else
+			float sum[4] = {};
+			for (int k = 0; k < taps.count[x]; k++)
+				for (int c = 0; c < 4; c++)
+					sum[c] += in[k * 4 + c] * w[k];
+			std::memcpy(out + x * 4, sum, sizeof(sum));
+#endif
+		}
+	}
+}
+
+// one output row as a weighted sum of whole input rows; n floats each
+static void sumRowsScalar(const float* const* rows, const float* w, int taps, float* out, size_t n, size_t from)
+{
+	for (size_t i = from; i < n; i++)
+	{
+		float sum = 0.0f;
+		for (int k = 0; k < taps; k++)
+			sum += rows[k][i] * w[k];
+		out[i] = sum;
+	}
+}
+
+#ifdef CPU_X86
+static void sumRowsSSE(const float* const* rows, const float* w, int taps, float* out, size_t n)
+{
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 sum = _mm_setzero_ps();
+		for (int k = 0; k < taps; k++)
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[k] + i), _mm_set1_ps(w[k])));
+		_mm_storeu_ps(out + i, sum);
+	}
+	sumRowsScalar(rows, w, taps, out, n, i);
+}
+
+CPU_TARGET_AVX static void sumRowsAVX(const float* const* rows, const float* w, int taps, float* out, size_t n)
+{
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256 sum = _mm256_setzero_ps();
+		for (int k = 0; k < taps; k++)
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(rows[k] + i), _mm256_set1_ps(w[k])));
+		_mm256_storeu_ps(out + i, sum);
+	}
+	sumRowsScalar(rows, w, taps, out, n, i);
+}
+#endif
+
+static void filterColumns(const float* src, int width, float* dst, const Taps& taps, int begin, int end)
+{
+	size_t n = (size_t)width * 4;
+	std::vector<const float*> rows(taps.stride);
+	for (int y = begin; y < end; y++)
+	{
+		for (int k = 0; k < taps.count[y]; k++)
+			rows[k] = src + (size_t)(taps.first[y] + k) * n;
+		const float* w = &taps.weights[(size_t)y * taps.stride];
+		float* out = dst + (size_t)y * n;
+#ifdef CPU_X86
+		if (cpuHasAVX())
+			sumRowsAVX(rows.data(), w, taps.count[y], out, n);
+		else
+			sumRowsSSE(rows.data(), w, taps.count[y], out, n);
+#else
+		sumRowsScalar(rows.data(), w, taps.count[y], out, n, 0);
+#endif
+	}
+}
+
+static float coverage(const float* pixels, size_t count, float scale, float reference)
+{
+	size_t covered = 0;
+	for (size_t i = 0; i < count; i++)
+		covered += pixels[i * 4 + 3] * scale >= reference;
+	return (float)covered / count;
+}
+
+// alpha scale that brings this level's coverage closest to 'target'
+static float coverageScale(const float* pixels, size_t count, float reference, float target)
+{
+	float lo = 0.0f, hi = 4.0f, best = 1.0f, bestError = 2.0f;
+	for (int i = 0; i < 12; i++)
+	{
+		float scale = (lo + hi) * 0.5f;
+		float current = coverage(pixels, count, scale, reference);
+		if (std::fabs(current - target) < bestError)
+		{
+			best = scale;
+			bestError = std::fabs(current - target);
+		}
+		if (current < target)
+			lo = scale;
+		else
+			hi = scale;
+	}
+	return best;
+}
+
+int generateMips(const unsigned char* pixels, int width, int height, const MipSettings& settings,
+	std::vector<unsigned char>& chain)
+{
+	const SrgbTables& srgb = srgbTables();
+	int threads = settings.threads > 0 ? settings.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+	// below this many texels per band a thread costs more than it saves
+	const size_t minBand = 16 * 1024;
+	auto threadsFor = [&](size_t texels) { return (int)std::max<size_t>(1, std::min<size_t>(threads, texels / minBand)); };
+
+	int levels = 1;
+	for (int side = std::max(width, height); side > 1; side >>= 1)
+		levels++;
+	size_t bytes = 0;
+	for (int level = 0; level < levels; level++)
+		bytes += (size_t)std::max(1, width >> level) * std::max(1, height >> level) * 4;
+	chain.resize(bytes);
+	std::memcpy(chain.data(), pixels, (size_t)width * height * 4);
+
+	std::vector<float> current((size_t)width * height * 4), rows, next;
+	parallelRows(height, threadsFor((size_t)width * height), [&](int begin, int end) {
+		for (size_t i = (size_t)begin * width * 4; i < (size_t)end * width * 4; i++)
+			current[i] = settings.srgb && (i & 3) != 3 ? srgb.toLinear[pixels[i]] : pixels[i] / 255.0f;
+	});
+	float target = 0.0f;
+	if (settings.alphaCoverage > 0.0f)
+		target = coverage(current.data(), (size_t)width * height, 1.0f, settings.alphaCoverage);
+
+	unsigned char* out = chain.data() + (size_t)width * height * 4;
+	int srcWidth = width, srcHeight = height;
+	Taps horizontal, vertical;
+	for (int level = 1; level < levels; level++)
+	{
+		int dstWidth = std::max(1, srcWidth >> 1), dstHeight = std::max(1, srcHeight >> 1);
+		buildTaps(srcWidth, dstWidth, settings.filter, horizontal);
+		buildTaps(srcHeight, dstHeight, settings.filter, vertical);
+		rows.resize((size_t)dstWidth * srcHeight * 4);
+		next.resize((size_t)dstWidth * dstHeight * 4);
+
+		parallelRows(srcHeight, threadsFor((size_t)srcWidth * srcHeight), [&](int begin, int end) {
+			filterRows(current.data(), srcWidth, rows.data(), horizontal, begin, end);
+		});
+		parallelRows(dstHeight, threadsFor((size_t)dstWidth * srcHeight), [&](int begin, int end) {
+			filterColumns(rows.data(), dstWidth, next.data(), vertical, begin, end);
+		});
+
+		size_t texels = (size_t)dstWidth * dstHeight;
+		float alphaScale = settings.alphaCoverage > 0.0f ? coverageScale(next.data(), texels, settings.alphaCoverage, target) : 1.0f;
+		parallelRows(dstHeight, threadsFor(texels), [&](int begin, int end) {
+			for (size_t i = (size_t)begin * dstWidth * 4; i < (size_t)end * dstWidth * 4; i++)
+			{
+				if ((i & 3) == 3)
+					out[i] = encodeUnorm(next[i] * alphaScale);
+				else
+					out[i] = settings.srgb ? srgb.encode(next[i]) : encodeUnorm(next[i]);
+			}
+		});
+
+		// the next level is filtered from the unscaled alpha, so scaling doesn't compound
+		current.swap(next);
+		out += texels * 4;
+		srcWidth = dstWidth;
+		srcHeight = dstHeight;
+	}
+	return levels;
+}
@@ -0,0 +1,458 @@
+#include "noise_field.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <glm/gtc/noise.hpp>
+
+#include "cpu_dispatch.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// one octave over one row: out[i] += amplitude * noise((x0 + i * step) * frequency, y, z),
+// with y and z already scaled by the frequency. 2D kernels ignore z
+struct NoiseRow
+{
+	float x0, step, frequency;
+	float y, z;
+	float amplitude;
+};
+
+static float rowX(const NoiseRow& row, int i)
+{
+	return (row.x0 + (float)i * row.step) * row.frequency;
+}
+
+static void perlin2Tail(const NoiseRow& row, float* out, int begin, int end)
+{
+	for (int i = begin; i < end; i++)
+		out[i] += row.amplitude * glm::perlin(glm::vec2(rowX(row, i), row.y));
+}
+
+static void perlin3Tail(const NoiseRow& row, float* out, int begin, int end)
+{
+	for (int i = begin; i < end; i++)
+		out[i] += row.amplitude * glm::perlin(glm::vec3(rowX(row, i), row.y, row.z));
+}
+
+static void simplex2Tail(const NoiseRow& row, float* out, int begin, int end)
+{
+	for (int i = begin; i < end; i++)
+		out[i] += row.amplitude * glm::simplex(glm::vec2(rowX(row, i), row.y));
+}
+
+static void simplex3Tail(const NoiseRow& row, float* out, int begin, int end)
+{
+	for (int i = begin; i < end; i++)
+		out[i] += row.amplitude * glm::simplex(glm::vec3(rowX(row, i), row.y, row.z));
+}
+
+static void perlin2Scalar(const NoiseRow& row, float* out, int count)
+{
+	perlin2Tail(row, out, 0, count);
+}
+
+static void perlin3Scalar(const NoiseRow& row, float* out, int count)
+{
+	perlin3Tail(row, out, 0, count);
+}
+
+static void simplex2Scalar(const NoiseRow& row, float* out, int count)
+{
+	simplex2Tail(row, out, 0, count);
+}
+
+static void simplex3Scalar(const NoiseRow& row, float* out, int count)
+{
+	simplex3Tail(row, out, 0, count);
+}
+
+#ifdef CPU_X86
+// glm's noise helpers (detail/_noise.hpp) and the common functions they use,
+// 8 lanes at a time; the constants are glm's double literals rounded to float
+// the way its static_cast<T> does
+
+CPU_TARGET_AVX static inline __m256 splat(float value)
+{
+	return _mm256_set1_ps(value);
+}
+
+CPU_TARGET_AVX static inline __m256 fract(__m256 x)
+{
+	return _mm256_sub_ps(x, _mm256_floor_ps(x));
+}
+
+CPU_TARGET_AVX static inline __m256 absolute(__m256 x)
+{
+	return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+}
+
+// x - floor(x / 289) * 289, which is also what glm::mod(x, 289) gives
+CPU_TARGET_AVX static inline __m256 mod289(__m256 x)
+{
+	return _mm256_sub_ps(x, _mm256_mul_ps(_mm256_floor_ps(_mm256_div_ps(x, splat(289.0f))), splat(289.0f)));
+}
+
+CPU_TARGET_AVX static inline __m256 permute(__m256 x)
+{
+	return mod289(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(x, splat(34.0f)), splat(1.0f)), x));
+}
+
+CPU_TARGET_AVX static inline __m256 taylorInvSqrt(__m256 r)
+{
+	return _mm256_sub_ps(splat((float)1.79284291400159), _mm256_mul_ps(splat((float)0.85373472095314), r));
+}
+
+CPU_TARGET_AVX static inline __m256 fade(__m256 t)
+{
+	__m256 cube = _mm256_mul_ps(_mm256_mul_ps(t, t), t);
+	return _mm256_mul_ps(cube, _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, splat(6.0f)), splat(15.0f))),
+		splat(10.0f)));
+}
+
+CPU_TARGET_AVX static inline __m256 mix(__m256 a, __m256 b, __m256 t)
+{
+	return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+}
+
+// step(edge, x): 0 where x < edge, else 1
+CPU_TARGET_AVX static inline __m256 step(__m256 edge, __m256 x)
+{
+	return _mm256_andnot_ps(_mm256_cmp_ps(x, edge, _CMP_LT_OQ), splat(1.0f));
+}
+
+CPU_TARGET_AVX static inline __m256 rowX8(const NoiseRow& row, int i)
+{
+	__m256 index = _mm256_add_ps(_mm256_set1_ps((float)i), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7));
+	return _mm256_mul_ps(_mm256_add_ps(splat(row.x0), _mm256_mul_ps(index, splat(row.step))), splat(row.frequency));
+}
+
+CPU_TARGET_AVX static inline void accumulate(const NoiseRow& row, float* out, __m256 noise)
+{
+	_mm256_storeu_ps(out, _mm256_add_ps(_mm256_loadu_ps(out), _mm256_mul_ps(splat(row.amplitude), noise)));
+}
+
+// one corner of 2D perlin: the gradient hashed from 'hash' dotted with the offset
+CPU_TARGET_AVX static inline __m256 perlinCorner2(__m256 hash, __m256 fx, __m256 fy)
+{
+	__m256 gx = _mm256_sub_ps(_mm256_mul_ps(splat(2.0f), fract(_mm256_div_ps(hash, splat(41.0f)))), splat(1.0f));
+	__m256 gy = _mm256_sub_ps(absolute(gx), splat(0.5f));
+	gx = _mm256_sub_ps(gx, _mm256_floor_ps(_mm256_add_ps(gx, splat(0.5f))));
+	__m256 norm = taylorInvSqrt(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)));
+	gx = _mm256_mul_ps(gx, norm);
+	gy = _mm256_mul_ps(gy, norm);
+	return _mm256_add_ps(_mm256_mul_ps(gx, fx), _mm256_mul_ps(gy, fy));
+}
+
+CPU_TARGET_AVX static void perlin2AVX(const NoiseRow& row, float* out, int count)
+{
+	__m256 y = splat(row.y);
+	__m256 y0 = mod289(_mm256_add_ps(_mm256_floor_ps(y), splat(0.0f)));
+	__m256 y1 = mod289(_mm256_add_ps(_mm256_floor_ps(y), splat(1.0f)));
+	__m256 fy0 = _mm256_sub_ps(fract(y), splat(0.0f));
+	__m256 fy1 = _mm256_sub_ps(fract(y), splat(1.0f));
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = rowX8(row, i);
+		__m256 x0 = mod289(_mm256_add_ps(_mm256_floor_ps(x), splat(0.0f)));
+		__m256 x1 = mod289(_mm256_add_ps(_mm256_floor_ps(x), splat(1.0f)));
+		__m256 fx0 = _mm256_sub_ps(fract(x), splat(0.0f));
+		__m256 fx1 = _mm256_sub_ps(fract(x), splat(1.0f));
+
+		__m256 px0 = permute(x0), px1 = permute(x1);
+		__m256 n00 = perlinCorner2(permute(_mm256_add_ps(px0, y0)), fx0, fy0);
+		__m256 n10 = perlinCorner2(permute(_mm256_add_ps(px1, y0)), fx1, fy0);
+		__m256 n01 = perlinCorner2(permute(_mm256_add_ps(px0, y1)), fx0, fy1);
+		__m256 n11 = perlinCorner2(permute(_mm256_add_ps(px1, y1)), fx1, fy1);
+
+		__m256 fadeX = fade(fx0), fadeY = fade(fy0);
+		__m256 noise = mix(mix(n00, n10, fadeX), mix(n01, n11, fadeX), fadeY);
+		accumulate(row, out + i, _mm256_mul_ps(splat((float)2.3), noise));
+	}
+	perlin2Tail(row, out, i, count);
+}
+
+// one corner of 3D perlin: a gradient on the octahedron picked by 'hash'
+CPU_TARGET_AVX static inline __m256 perlinCorner3(__m256 hash, __m256 fx, __m256 fy, __m256 fz)
+{
+	__m256 gx = _mm256_mul_ps(hash, splat((float)(1.0 / 7.0)));
+	__m256 gy = _mm256_sub_ps(fract(_mm256_mul_ps(_mm256_floor_ps(gx), splat((float)(1.0 / 7.0)))), splat(0.5f));
+	gx = fract(gx);
+	__m256 gz = _mm256_sub_ps(_mm256_sub_ps(splat(0.5f), absolute(gx)), absolute(gy));
+	__m256 sz = step(gz, _mm256_setzero_ps());
+	gx = _mm256_sub_ps(gx, _mm256_mul_ps(sz, _mm256_sub_ps(step(_mm256_setzero_ps(), gx), splat(0.5f))));
+	gy = _mm256_sub_ps(gy, _mm256_mul_ps(sz, _mm256_sub_ps(step(_mm256_setzero_ps(), gy), splat(0.5f))));
+	__m256 norm = taylorInvSqrt(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)),
+		_mm256_mul_ps(gz, gz)));
+	gx = _mm256_mul_ps(gx, norm);
+	gy = _mm256_mul_ps(gy, norm);
+	gz = _mm256_mul_ps(gz, norm);
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, fx), _mm256_mul_ps(gy, fy)), _mm256_mul_ps(gz, fz));
+}
+
+CPU_TARGET_AVX static void perlin3AVX(const NoiseRow& row, float* out, int count)
+{
+	__m256 y = splat(row.y), z = splat(row.z);
+	__m256 y0 = mod289(_mm256_floor_ps(y)), y1 = mod289(_mm256_add_ps(_mm256_floor_ps(y), splat(1.0f)));
+	__m256 z0 = mod289(_mm256_floor_ps(z)), z1 = mod289(_mm256_add_ps(_mm256_floor_ps(z), splat(1.0f)));
+	__m256 fy0 = fract(y), fy1 = _mm256_sub_ps(fy0, splat(1.0f));
+	__m256 fz0 = fract(z), fz1 = _mm256_sub_ps(fz0, splat(1.0f));
+	__m256 fadeY = fade(fy0), fadeZ = fade(fz0);
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = rowX8(row, i);
+		__m256 x0 = mod289(_mm256_floor_ps(x)), x1 = mod289(_mm256_add_ps(_mm256_floor_ps(x), splat(1.0f)));
+		__m256 fx0 = fract(x), fx1 = _mm256_sub_ps(fx0, splat(1.0f));
+
+		__m256 px0 = permute(x0), px1 = permute(x1);
+		__m256 h00 = permute(_mm256_add_ps(px0, y0)), h10 = permute(_mm256_add_ps(px1, y0));
+		__m256 h01 = permute(_mm256_add_ps(px0, y1)), h11 = permute(_mm256_add_ps(px1, y1));
+
+		__m256 n000 = perlinCorner3(permute(_mm256_add_ps(h00, z0)), fx0, fy0, fz0);
+		__m256 n100 = perlinCorner3(permute(_mm256_add_ps(h10, z0)), fx1, fy0, fz0);
+		__m256 n010 = perlinCorner3(permute(_mm256_add_ps(h01, z0)), fx0, fy1, fz0);
+		__m256 n110 = perlinCorner3(permute(_mm256_add_ps(h11, z0)), fx1, fy1, fz0);
+		__m256 n001 = perlinCorner3(permute(_mm256_add_ps(h00, z1)), fx0, fy0, fz1);
+		__m256 n101 = perlinCorner3(permute(_mm256_add_ps(h10, z1)), fx1, fy0, fz1);
+		__m256 n011 = perlinCorner3(permute(_mm256_add_ps(h01, z1)), fx0, fy1, fz1);
+		__m256 n111 = perlinCorner3(permute(_mm256_add_ps(h11, z1)), fx1, fy1, fz1);
+
+		__m256 fadeX = fade(fx0);
+		__m256 nz00 = mix(n000, n001, fadeZ), nz10 = mix(n100, n101, fadeZ);
+		__m256 nz01 = mix(n010, n011, fadeZ), nz11 = mix(n110, n111, fadeZ);
+		__m256 noise = mix(mix(nz00, nz01, fadeY), mix(nz10, nz11, fadeY), fadeX);
+		accumulate(row, out + i, _mm256_mul_ps(splat((float)2.2), noise));
+	}
+	perlin3Tail(row, out, i, count);
+}
+
+// one corner of 2D simplex: falloff weight times the gradient's dot with the offset
+CPU_TARGET_AVX static inline __m256 simplexCorner2(__m256 hash, __m256 dx, __m256 dy)
+{
+	__m256 m = _mm256_max_ps(_mm256_sub_ps(splat(0.5f), _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))),
+		_mm256_setzero_ps());
+	m = _mm256_mul_ps(m, m);
+	m = _mm256_mul_ps(m, m);
+	// 41 gradients over a line, mapped onto a diamond
+	__m256 x = _mm256_sub_ps(_mm256_mul_ps(splat(2.0f), fract(_mm256_mul_ps(hash, splat((float)0.024390243902439)))),
+		splat(1.0f));
+	__m256 h = _mm256_sub_ps(absolute(x), splat(0.5f));
+	__m256 a0 = _mm256_sub_ps(x, _mm256_floor_ps(_mm256_add_ps(x, splat(0.5f))));
+	m = _mm256_mul_ps(m, taylorInvSqrt(_mm256_add_ps(_mm256_mul_ps(a0, a0), _mm256_mul_ps(h, h))));
+	return _mm256_mul_ps(m, _mm256_add_ps(_mm256_mul_ps(a0, dx), _mm256_mul_ps(h, dy)));
+}
+
+CPU_TARGET_AVX static void simplex2AVX(const NoiseRow& row, float* out, int count)
+{
+	const __m256 c0 = splat((float)0.211324865405187), c1 = splat((float)0.366025403784439);
+	const __m256 c2 = splat((float)-0.577350269189626), one = splat(1.0f);
+	__m256 y = splat(row.y);
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = rowX8(row, i);
+		// skew to the cell, then unskew back to the first corner
+		__m256 s = _mm256_add_ps(_mm256_mul_ps(x, c1), _mm256_mul_ps(y, c1));
+		__m256 ix = _mm256_floor_ps(_mm256_add_ps(x, s)), iy = _mm256_floor_ps(_mm256_add_ps(y, s));
+		__m256 t = _mm256_add_ps(_mm256_mul_ps(ix, c0), _mm256_mul_ps(iy, c0));
+		__m256 x0 = _mm256_add_ps(_mm256_sub_ps(x, ix), t), y0 = _mm256_add_ps(_mm256_sub_ps(y, iy), t);
+
+		// the middle corner is x + 1 or y + 1, whichever offset is larger
+		__m256 i1x = _mm256_and_ps(_mm256_cmp_ps(x0, y0, _CMP_GT_OQ), one);
+		__m256 i1y = _mm256_andnot_ps(_mm256_cmp_ps(x0, y0, _CMP_GT_OQ), one);
+		__m256 x1 = _mm256_sub_ps(_mm256_add_ps(x0, c0), i1x), y1 = _mm256_sub_ps(_mm256_add_ps(y0, c0), i1y);
+		__m256 x2 = _mm256_add_ps(x0, c2), y2 = _mm256_add_ps(y0, c2);
+
+		ix = mod289(ix);
+		iy = mod289(iy);
+		__m256 p0 = permute(_mm256_add_ps(permute(_mm256_add_ps(iy, _mm256_setzero_ps())), ix));
+		__m256 p1 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(iy, i1y)), ix), i1x));
+		__m256 p2 = permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(iy, one)), ix), one));
+
+		__m256 noise = _mm256_add_ps(_mm256_add_ps(simplexCorner2(p0, x0, y0), simplexCorner2(p1, x1, y1)),
+			simplexCorner2(p2, x2, y2));
+		accumulate(row, out + i, _mm256_mul_ps(splat(130.0f), noise));
+	}
+	simplex2Tail(row, out, i, count);
+}
+
+struct SimplexCorner3
+{
+	__m256 x, y, z;
+};
+
+// one corner of 3D simplex: a gradient from a 7x7 grid mapped onto an
+// octahedron, dotted with the offset; the falloff is applied by the caller
+CPU_TARGET_AVX static inline __m256 simplexGradient3(__m256 hash, const SimplexCorner3& d)
+{
+	const float n = (float)0.142857142857;
+	const __m256 nsx = splat(n * 2.0f - 0.0f), nsy = splat(n * 0.5f - 1.0f), nsz = splat(n * 1.0f - 0.0f);
+	__m256 j = _mm256_sub_ps(hash, _mm256_mul_ps(splat(49.0f), _mm256_floor_ps(_mm256_mul_ps(_mm256_mul_ps(hash, nsz), nsz))));
+	__m256 gx = _mm256_floor_ps(_mm256_mul_ps(j, nsz));
+	__m256 gy = _mm256_floor_ps(_mm256_sub_ps(j, _mm256_mul_ps(splat(7.0f), gx)));
+	gx = _mm256_add_ps(_mm256_mul_ps(gx, nsx), nsy);
+	gy = _mm256_add_ps(_mm256_mul_ps(gy, nsx), nsy);
+	__m256 gz = _mm256_sub_ps(_mm256_sub_ps(splat(1.0f), absolute(gx)), absolute(gy));
+
+	// fold the lower half of the octahedron up: gz <= 0 moves x and y away from 0
+	__m256 sh = _mm256_xor_ps(step(gz, _mm256_setzero_ps()), _mm256_set1_ps(-0.0f));
+	__m256 sx = _mm256_add_ps(_mm256_mul_ps(_mm256_floor_ps(gx), splat(2.0f)), splat(1.0f));
+	__m256 sy = _mm256_add_ps(_mm256_mul_ps(_mm256_floor_ps(gy), splat(2.0f)), splat(1.0f));
+	gx = _mm256_add_ps(gx, _mm256_mul_ps(sx, sh));
+	gy = _mm256_add_ps(gy, _mm256_mul_ps(sy, sh));
+
+	__m256 norm = taylorInvSqrt(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)),
+		_mm256_mul_ps(gz, gz)));
+	gx = _mm256_mul_ps(gx, norm);
+	gy = _mm256_mul_ps(gy, norm);
+	gz = _mm256_mul_ps(gz, norm);
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(gx, d.x), _mm256_mul_ps(gy, d.y)), _mm256_mul_ps(gz, d.z));
+}
+
+CPU_TARGET_AVX static inline __m256 simplexFalloff3(const SimplexCorner3& d)
+{
+	__m256 m = _mm256_max_ps(_mm256_sub_ps(splat((float)0.6), _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d.x, d.x),
+		_mm256_mul_ps(d.y, d.y)), _mm256_mul_ps(d.z, d.z))), _mm256_setzero_ps());
+	m = _mm256_mul_ps(m, m);
+	return _mm256_mul_ps(m, m);
+}
+
+CPU_TARGET_AVX static inline __m256 simplexHash3(__m256 ix, __m256 iy, __m256 iz, __m256 ox, __m256 oy, __m256 oz)
+{
+	return permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(_mm256_add_ps(permute(_mm256_add_ps(iz, oz)), iy),
+		oy)), ix), ox));
+}
+
+CPU_TARGET_AVX static void simplex3AVX(const NoiseRow& row, float* out, int count)
+{
+	const __m256 cx = splat((float)(1.0 / 6.0)), cy = splat((float)(1.0 / 3.0));
+	const __m256 zero = _mm256_setzero_ps(), one = splat(1.0f);
+	__m256 y = splat(row.y), z = splat(row.z);
+	int i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = rowX8(row, i);
+		__m256 s = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, cy), _mm256_mul_ps(y, cy)), _mm256_mul_ps(z, cy));
+		__m256 ix = _mm256_floor_ps(_mm256_add_ps(x, s));
+		__m256 iy = _mm256_floor_ps(_mm256_add_ps(y, s));
+		__m256 iz = _mm256_floor_ps(_mm256_add_ps(z, s));
+		__m256 t = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ix, cx), _mm256_mul_ps(iy, cx)), _mm256_mul_ps(iz, cx));
+		SimplexCorner3 d0 = { _mm256_add_ps(_mm256_sub_ps(x, ix), t), _mm256_add_ps(_mm256_sub_ps(y, iy), t),
+			_mm256_add_ps(_mm256_sub_ps(z, iz), t) };
+
+		// which of the six tetrahedra: the order of the offsets picks the middle corners
+		__m256 gx = step(d0.y, d0.x), gy = step(d0.z, d0.y), gz = step(d0.x, d0.z);
+		__m256 lx = _mm256_sub_ps(one, gx), ly = _mm256_sub_ps(one, gy), lz = _mm256_sub_ps(one, gz);
+		__m256 i1x = _mm256_min_ps(gx, lz), i1y = _mm256_min_ps(gy, lx), i1z = _mm256_min_ps(gz, ly);
+		__m256 i2x = _mm256_max_ps(gx, lz), i2y = _mm256_max_ps(gy, lx), i2z = _mm256_max_ps(gz, ly);
+
+		SimplexCorner3 d1 = { _mm256_add_ps(_mm256_sub_ps(d0.x, i1x), cx), _mm256_add_ps(_mm256_sub_ps(d0.y, i1y), cx),
+			_mm256_add_ps(_mm256_sub_ps(d0.z, i1z), cx) };
+		SimplexCorner3 d2 = { _mm256_add_ps(_mm256_sub_ps(d0.x, i2x), cy), _mm256_add_ps(_mm256_sub_ps(d0.y, i2y), cy),
+			_mm256_add_ps(_mm256_sub_ps(d0.z, i2z), cy) };
+		SimplexCorner3 d3 = { _mm256_sub_ps(d0.x, splat(0.5f)), _mm256_sub_ps(d0.y, splat(0.5f)),
+			_mm256_sub_ps(d0.z, splat(0.5f)) };
+
+		ix = mod289(ix);
+		iy = mod289(iy);
+		iz = mod289(iz);
+		__m256 n0 = simplexGradient3(simplexHash3(ix, iy, iz, zero, zero, zero), d0);
+		__m256 n1 = simplexGradient3(simplexHash3(ix, iy, iz, i1x, i1y, i1z), d1);
+		__m256 n2 = simplexGradient3(simplexHash3(ix, iy, iz, i2x, i2y, i2z), d2);
+		__m256 n3 = simplexGradient3(simplexHash3(ix, iy, iz, one, one, one), d3);
+
+		__m256 noise = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(simplexFalloff3(d0), n0), _mm256_mul_ps(simplexFalloff3(d1), n1)),
+			_mm256_add_ps(_mm256_mul_ps(simplexFalloff3(d2), n2), _mm256_mul_ps(simplexFalloff3(d3), n3)));
+		accumulate(row, out + i, _mm256_mul_ps(splat(42.0f), noise));
+	}
+	simplex3Tail(row, out, i, count);
+}
+#endif
+
+// the kernels only use AVX, so AVX2 and AVX-512 machines run the AVX ones
+typedef void (*NoiseKernel)(const NoiseRow&, float*, int);
+
+#ifdef CPU_X86
+static const DispatchTable<NoiseKernel> perlin2Kernels = { { perlin2Scalar, nullptr, nullptr, perlin2AVX } };
+static const DispatchTable<NoiseKernel> perlin3Kernels = { { perlin3Scalar, nullptr, nullptr, perlin3AVX } };
+static const DispatchTable<NoiseKernel> simplex2Kernels = { { simplex2Scalar, nullptr, nullptr, simplex2AVX } };
+static const DispatchTable<NoiseKernel> simplex3Kernels = { { simplex3Scalar, nullptr, nullptr, simplex3AVX } };
+#else
+static const DispatchTable<NoiseKernel> perlin2Kernels = { { perlin2Scalar } };
+static const DispatchTable<NoiseKernel> perlin3Kernels = { { perlin3Scalar } };
+static const DispatchTable<NoiseKernel> simplex2Kernels = { { simplex2Scalar } };
+static const DispatchTable<NoiseKernel> simplex3Kernels = { { simplex3Scalar } };
+#endif
+
+// run fn(begin, end) over [0, count) split into contiguous bands
+template <class Fn>
+static void parallelRows(int count, int threads, Fn fn)
+{
+	threads = std::max(1, std::min(threads, count));
+	if (threads == 1)
+	{
+		fn(0, count);
+		return;
+	}
+	std::vector<std::thread> workers;
+	for (int t = 1; t < threads; t++)
+		workers.emplace_back(fn, count * t / threads, count * (t + 1) / threads);
+	fn(0, count / threads);
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+// rows of 'width' samples; row r sits at y = origin.y + (r % height) * spacing and
+// z = origin.z + (r / height) * spacing
+static void noiseRows(NoiseKernel kernel, float* out, int width, int height, int rows, const glm::vec3& origin,
+	float spacing, const NoiseSettings& settings)
+{
+	int threads = settings.threads > 0 ? settings.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+	// below this many samples per band a thread costs more than it saves
+	const size_t minBand = 16 * 1024;
+	threads = (int)std::max<size_t>(1, std::min<size_t>(threads, (size_t)width * rows / minBand));
+
+	parallelRows(rows, threads, [&](int begin, int end) {
+		std::fill(out + (size_t)begin * width, out + (size_t)end * width, 0.0f);
+		// octave by octave over the band, so each pass stays within one kernel
+		NoiseRow row;
+		row.x0 = origin.x;
+		row.step = spacing;
+		row.frequency = settings.frequency;
+		row.amplitude = 1.0f;
+		for (int octave = 0; octave < settings.octaves; octave++)
+		{
+			for (int r = begin; r < end; r++)
+			{
+				row.y = (origin.y + (float)(r % height) * spacing) * row.frequency;
+				row.z = (origin.z + (float)(r / height) * spacing) * row.frequency;
+				kernel(row, out + (size_t)r * width, width);
+			}
+			row.frequency *= settings.lacunarity;
+			row.amplitude *= settings.gain;
+		}
+	});
+}
+
+void noiseGrid2D(float* out, int width, int height, const glm::vec2& origin, float spacing, const NoiseSettings& settings)
+{
+	const DispatchTable<NoiseKernel>& kernels = settings.type == NoiseType::Simplex ? simplex2Kernels : perlin2Kernels;
+	noiseRows(kernels.pick(settings.level), out, width, height, height, glm::vec3(origin, 0.0f), spacing, settings);
+}
+
+void noiseGrid3D(float* out, int width, int height, int depth, const glm::vec3& origin, float spacing,
+	const NoiseSettings& settings)
+{
+	const DispatchTable<NoiseKernel>& kernels = settings.type == NoiseType::Simplex ? simplex3Kernels : perlin3Kernels;
+	noiseRows(kernels.pick(settings.level), out, width, height, height * depth, origin, spacing, settings);
+}
+
+CpuLevel noiseLevel(CpuLevel limit)
+{
+	return perlin2Kernels.level(limit);
+}
@@ -0,0 +1,447 @@
+#include "pack_array.h"
+
+#include <cstring>
+
+#include <glm/gtc/packing.hpp>
+
+#include "cpu_dispatch.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// the scalar kernels and every tail call glm, so whatever the SIMD bodies
+// compute has to match it bit for bit; only the half conversions round ties
+// differently, and they run their tails through the SIMD body instead
+
+static void packHalfScalar(const float* src, uint16_t* dst, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		dst[i] = glm::packHalf1x16(src[i]);
+}
+
+static void unpackHalfTail(const uint16_t* src, float* dst, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+		dst[i] = glm::unpackHalf1x16(src[i]);
+}
+
+static void unpackHalfScalar(const uint16_t* src, float* dst, size_t count)
+{
+	unpackHalfTail(src, dst, 0, count);
+}
+
+static void packSnorm3x10Tail(const glm::vec4* src, uint32_t* dst, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+		dst[i] = glm::packSnorm3x10_1x2(src[i]);
+}
+
+static void packSnorm3x10Scalar(const glm::vec4* src, uint32_t* dst, size_t count)
+{
+	packSnorm3x10Tail(src, dst, 0, count);
+}
+
+static void unpackSnorm3x10Tail(const uint32_t* src, glm::vec4* dst, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+		dst[i] = glm::unpackSnorm3x10_1x2(src[i]);
+}
+
+static void unpackSnorm3x10Scalar(const uint32_t* src, glm::vec4* dst, size_t count)
+{
+	unpackSnorm3x10Tail(src, dst, 0, count);
+}
+
+static void packUnorm4x8Tail(const glm::vec4* src, uint32_t* dst, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+		dst[i] = glm::packUnorm4x8(src[i]);
+}
+
+static void packUnorm4x8Scalar(const glm::vec4* src, uint32_t* dst, size_t count)
+{
+	packUnorm4x8Tail(src, dst, 0, count);
+}
+
+static void unpackUnorm4x8Tail(const uint32_t* src, glm::vec4* dst, size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+		dst[i] = glm::unpackUnorm4x8(src[i]);
+}
+
+static void unpackUnorm4x8Scalar(const uint32_t* src, glm::vec4* dst, size_t count)
+{
+	unpackUnorm4x8Tail(src, dst, 0, count);
+}
+
+#ifdef CPU_X86
+// glm::round is std::round, halves away from zero, where the conversion
+// instructions round them to even; truncate and step by the fraction instead,
+// which is exact
+static __m128i roundAway(__m128 v)
+{
+	__m128i i = _mm_cvttps_epi32(v);
+	__m128 fraction = _mm_sub_ps(v, _mm_cvtepi32_ps(i));
+	i = _mm_sub_epi32(i, _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f))));
+	return _mm_add_epi32(i, _mm_castps_si128(_mm_cmple_ps(fraction, _mm_set1_ps(-0.5f))));
+}
+
+// four floats to halves in the low 16 bits of each lane, sign-extended so
+// _mm_packs_epi32 keeps them intact; after Fabian Giesen's float_to_half_fast3
+static __m128i floatToHalfSSE2(__m128 f)
+{
+	const __m128i signMask = _mm_set1_epi32((int)0x80000000u);
+	const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);			// this and above becomes inf
+	const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);		// below this the half is subnormal
+	const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+	const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+	__m128 sign = _mm_and_ps(f, _mm_castsi128_ps(signMask));
+	__m128 absf = _mm_xor_ps(f, sign);
+	__m128i absi = _mm_castps_si128(absf);
+
+	__m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absf, absf));
+	__m128i isRegular = _mm_cmpgt_epi32(f16Max, absi);
+	__m128i infOrNan = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+	// subnormal results: let the FPU round by adding a magic number
+	__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absi);
+	__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absf, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+	// normal results: rebias the exponent and round half to even
+	__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absi, 31 - 13), 31);
+	__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absi, normalBias), mantissaOdd), 13);
+
+	__m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+	__m128i magnitude = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNan));
+	return _mm_or_si128(magnitude, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+// four halves in the low 16 bits of each lane to floats; after Fabian Giesen's
+// half_to_float_fast, where a multiply rebiases the exponent and normalizes
+// subnormals, so it relies on denormals not being flushed
+static __m128 halfToFloatSSE2(__m128i h)
+{
+	const __m128i expMantissa = _mm_set1_epi32(0x7fff);
+	const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+	const __m128i largestFinite = _mm_set1_epi32(0x7bff);
+	const __m128i infOrNanExponent = _mm_set1_epi32(255 << 23);
+
+	__m128i magnitude = _mm_and_si128(h, expMantissa);
+	__m128i sign = _mm_slli_epi32(_mm_xor_si128(h, magnitude), 16);
+	__m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(magnitude, 13)), magic);
+	__m128i infOrNan = _mm_and_si128(_mm_cmpgt_epi32(magnitude, largestFinite), infOrNanExponent);
+	return _mm_or_ps(scaled, _mm_castsi128_ps(_mm_or_si128(sign, infOrNan)));
+}
+
+static void packHalfSSE2(const float* src, uint16_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i lo = floatToHalfSSE2(_mm_loadu_ps(src + i));
+		__m128i hi = floatToHalfSSE2(_mm_loadu_ps(src + i + 4));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(lo, hi));
+	}
+	if (i < count)
+	{
+		// same conversion for the tail, so every element rounds the same way
+		float in[8] = {};
+		uint16_t out[8];
+		std::memcpy(in, src + i, (count - i) * sizeof(float));
+		_mm_storeu_si128((__m128i*)out, _mm_packs_epi32(floatToHalfSSE2(_mm_loadu_ps(in)), floatToHalfSSE2(_mm_loadu_ps(in + 4))));
+		std::memcpy(dst + i, out, (count - i) * sizeof(uint16_t));
+	}
+}
+
+static void unpackHalfSSE2(const uint16_t* src, float* dst, size_t count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m128i h = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_ps(dst + i, halfToFloatSSE2(_mm_unpacklo_epi16(h, zero)));
+		_mm_storeu_ps(dst + i + 4, halfToFloatSSE2(_mm_unpackhi_epi16(h, zero)));
+	}
+	unpackHalfTail(src, dst, i, count);
+}
+
+// x, y and z of four vectors to 10 bits each and w to 2, as the
+// GL_INT_2_10_10_10_REV bit fields glm packs into
+static __m128i snorm3x10SSE2(__m128 x, __m128 y, __m128 z, __m128 w)
+{
+	const __m128 one = _mm_set1_ps(1.0f), minusOne = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(511.0f);
+	const __m128i tenBits = _mm_set1_epi32(0x3ff);
+	__m128i ix = _mm_and_si128(roundAway(_mm_mul_ps(_mm_min_ps(_mm_max_ps(x, minusOne), one), scale)), tenBits);
+	__m128i iy = _mm_and_si128(roundAway(_mm_mul_ps(_mm_min_ps(_mm_max_ps(y, minusOne), one), scale)), tenBits);
+	__m128i iz = _mm_and_si128(roundAway(_mm_mul_ps(_mm_min_ps(_mm_max_ps(z, minusOne), one), scale)), tenBits);
+	__m128i iw = roundAway(_mm_min_ps(_mm_max_ps(w, minusOne), one));
+	return _mm_or_si128(_mm_or_si128(ix, _mm_slli_epi32(iy, 10)), _mm_or_si128(_mm_slli_epi32(iz, 20), _mm_slli_epi32(iw, 30)));
+}
+
+static void packSnorm3x10SSE2(const glm::vec4* src, uint32_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* p = &src[i].x;
+		__m128 x = _mm_loadu_ps(p), y = _mm_loadu_ps(p + 4), z = _mm_loadu_ps(p + 8), w = _mm_loadu_ps(p + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_si128((__m128i*)(dst + i), snorm3x10SSE2(x, y, z, w));
+	}
+	packSnorm3x10Tail(src, dst, i, count);
+}
+
+static void unpackSnorm3x10SSE2(const uint32_t* src, glm::vec4* dst, size_t count)
+{
+	const __m128 scale = _mm_set1_ps(511.0f), minusOne = _mm_set1_ps(-1.0f);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		// shifting a field to the top and back down sign-extends it; glm divides
+		// rather than multiplying by 1 / 511, and so does this
+		__m128i p = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128 x = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(p, 22), 22)), scale), minusOne);
+		__m128 y = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(p, 12), 22)), scale), minusOne);
+		__m128 z = _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(p, 2), 22)), scale), minusOne);
+		__m128 w = _mm_max_ps(_mm_cvtepi32_ps(_mm_srai_epi32(p, 30)), minusOne);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		float* q = &dst[i].x;
+		_mm_storeu_ps(q, x);
+		_mm_storeu_ps(q + 4, y);
+		_mm_storeu_ps(q + 8, z);
+		_mm_storeu_ps(q + 12, w);
+	}
+	unpackSnorm3x10Tail(src, dst, i, count);
+}
+
+static __m128i unorm8SSE2(__m128 v)
+{
+	return roundAway(_mm_mul_ps(_mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)), _mm_set1_ps(255.0f)));
+}
+
+// one vector per 32-bit lane already, so two saturating packs put the bytes in place
+static void packUnorm4x8SSE2(const glm::vec4* src, uint32_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* p = &src[i].x;
+		__m128i ab = _mm_packs_epi32(unorm8SSE2(_mm_loadu_ps(p)), unorm8SSE2(_mm_loadu_ps(p + 4)));
+		__m128i cd = _mm_packs_epi32(unorm8SSE2(_mm_loadu_ps(p + 8)), unorm8SSE2(_mm_loadu_ps(p + 12)));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(ab, cd));
+	}
+	packUnorm4x8Tail(src, dst, i, count);
+}
+
+static void unpackUnorm4x8SSE2(const uint32_t* src, glm::vec4* dst, size_t count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(0.0039215686274509803921568627451f);	// glm's 1 / 255
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i p = _mm_loadu_si128((const __m128i*)(src + i));
+		__m128i lo = _mm_unpacklo_epi8(p, zero), hi = _mm_unpackhi_epi8(p, zero);
+		float* q = &dst[i].x;
+		_mm_storeu_ps(q, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(q + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(q + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(q + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+	}
+	unpackUnorm4x8Tail(src, dst, i, count);
+}
+
+// AVX2 kernels; the level also means F16C. The rounding steps can't be fused
+// into multiply-adds: the product also feeds the truncation, so GCC keeps it
+// rounded
+
+CPU_TARGET_AVX2 static __m256i roundAwayAVX2(__m256 v)
+{
+	__m256i i = _mm256_cvttps_epi32(v);
+	__m256 fraction = _mm256_sub_ps(v, _mm256_cvtepi32_ps(i));
+	i = _mm256_sub_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ)));
+	return _mm256_add_epi32(i, _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(-0.5f), _CMP_LE_OQ)));
+}
+
+CPU_TARGET_AVX2 static void packHalfAVX2(const float* src, uint16_t* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+		_mm_storeu_si128((__m128i*)(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+	if (i < count)
+	{
+		float in[8] = {};
+		uint16_t out[8];
+		std::memcpy(in, src + i, (count - i) * sizeof(float));
+		_mm_storeu_si128((__m128i*)out, _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+		std::memcpy(dst + i, out, (count - i) * sizeof(uint16_t));
+	}
+}
+
+CPU_TARGET_AVX2 static void unpackHalfAVX2(const uint16_t* src, float* dst, size_t count)
+{
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(src + i))));
+	unpackHalfTail(src, dst, i, count);
+}
+
+// two vectors per register, vectors i..i+3 in the low halves and i+4..i+7 in
+// the high ones, so the in-lane transpose leaves x, y, z and w in order
+CPU_TARGET_AVX2 static __m256 loadPair(const float* low, const float* high)
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+}
+
+CPU_TARGET_AVX2 static void transposeLanes(__m256& r0, __m256& r1, __m256& r2, __m256& r3)
+{
+	__m256 t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1);
+	__m256 t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+	r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+	r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+	r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+	r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+CPU_TARGET_AVX2 static void packSnorm3x10AVX2(const glm::vec4* src, uint32_t* dst, size_t count)
+{
+	const __m256 one = _mm256_set1_ps(1.0f), minusOne = _mm256_set1_ps(-1.0f), scale = _mm256_set1_ps(511.0f);
+	const __m256i tenBits = _mm256_set1_epi32(0x3ff);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const float* p = &src[i].x;
+		__m256 x = loadPair(p, p + 16), y = loadPair(p + 4, p + 20), z = loadPair(p + 8, p + 24), w = loadPair(p + 12, p + 28);
+		transposeLanes(x, y, z, w);
+		__m256i ix = _mm256_and_si256(roundAwayAVX2(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(x, minusOne), one), scale)), tenBits);
+		__m256i iy = _mm256_and_si256(roundAwayAVX2(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(y, minusOne), one), scale)), tenBits);
+		__m256i iz = _mm256_and_si256(roundAwayAVX2(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(z, minusOne), one), scale)), tenBits);
+		__m256i iw = roundAwayAVX2(_mm256_min_ps(_mm256_max_ps(w, minusOne), one));
+		__m256i packed = _mm256_or_si256(_mm256_or_si256(ix, _mm256_slli_epi32(iy, 10)),
+			_mm256_or_si256(_mm256_slli_epi32(iz, 20), _mm256_slli_epi32(iw, 30)));
+		_mm256_storeu_si256((__m256i*)(dst + i), packed);
+	}
+	packSnorm3x10Tail(src, dst, i, count);
+}
+
+CPU_TARGET_AVX2 static void unpackSnorm3x10AVX2(const uint32_t* src, glm::vec4* dst, size_t count)
+{
+	const __m256 scale = _mm256_set1_ps(511.0f), minusOne = _mm256_set1_ps(-1.0f);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256i p = _mm256_loadu_si256((const __m256i*)(src + i));
+		__m256 x = _mm256_max_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(p, 22), 22)), scale), minusOne);
+		__m256 y = _mm256_max_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(p, 12), 22)), scale), minusOne);
+		__m256 z = _mm256_max_ps(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(p, 2), 22)), scale), minusOne);
+		__m256 w = _mm256_max_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(p, 30)), minusOne);
+		// vector k in the low half of register k and vector k + 4 in its high half
+		transposeLanes(x, y, z, w);
+		float* q = &dst[i].x;
+		_mm256_storeu_ps(q, _mm256_permute2f128_ps(x, y, 0x20));
+		_mm256_storeu_ps(q + 8, _mm256_permute2f128_ps(z, w, 0x20));
+		_mm256_storeu_ps(q + 16, _mm256_permute2f128_ps(x, y, 0x31));
+		_mm256_storeu_ps(q + 24, _mm256_permute2f128_ps(z, w, 0x31));
+	}
+	unpackSnorm3x10Tail(src, dst, i, count);
+}
+
+CPU_TARGET_AVX2 static __m256i unorm8AVX2(__m256 v)
+{
+	return roundAwayAVX2(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f)), _mm256_set1_ps(255.0f)));
+}
+
+CPU_TARGET_AVX2 static void packUnorm4x8AVX2(const glm::vec4* src, uint32_t* dst, size_t count)
+{
+	// the packs work within 128-bit halves and leave vectors 0 2 4 6 1 3 5 7
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const float* p = &src[i].x;
+		__m256i ab = _mm256_packs_epi32(unorm8AVX2(_mm256_loadu_ps(p)), unorm8AVX2(_mm256_loadu_ps(p + 8)));
+		__m256i cd = _mm256_packs_epi32(unorm8AVX2(_mm256_loadu_ps(p + 16)), unorm8AVX2(_mm256_loadu_ps(p + 24)));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), order));
+	}
+	packUnorm4x8Tail(src, dst, i, count);
+}
+
+CPU_TARGET_AVX2 static void unpackUnorm4x8AVX2(const uint32_t* src, glm::vec4* dst, size_t count)
+{
+	const __m256 scale = _mm256_set1_ps(0.0039215686274509803921568627451f);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+		for (size_t k = 0; k < 8; k += 2)
+		{
+			__m256i bytes = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i + k)));
+			_mm256_storeu_ps(&dst[i + k].x, _mm256_mul_ps(_mm256_cvtepi32_ps(bytes), scale));
+		}
+	unpackUnorm4x8Tail(src, dst, i, count);
+}
+#endif
+
+// SSE4.1 and AVX add nothing these kernels use; F16C comes with the AVX2 level
+typedef void (*PackHalfKernel)(const float*, uint16_t*, size_t);
+typedef void (*UnpackHalfKernel)(const uint16_t*, float*, size_t);
+typedef void (*PackVec4Kernel)(const glm::vec4*, uint32_t*, size_t);
+typedef void (*UnpackVec4Kernel)(const uint32_t*, glm::vec4*, size_t);
+
+#ifdef CPU_X86
+static const DispatchTable<PackHalfKernel> packHalfKernels = { {
+	packHalfScalar, packHalfSSE2, nullptr, nullptr, packHalfAVX2 } };
+static const DispatchTable<UnpackHalfKernel> unpackHalfKernels = { {
+	unpackHalfScalar, unpackHalfSSE2, nullptr, nullptr, unpackHalfAVX2 } };
+static const DispatchTable<PackVec4Kernel> packSnorm3x10Kernels = { {
+	packSnorm3x10Scalar, packSnorm3x10SSE2, nullptr, nullptr, packSnorm3x10AVX2 } };
+static const DispatchTable<UnpackVec4Kernel> unpackSnorm3x10Kernels = { {
+	unpackSnorm3x10Scalar, unpackSnorm3x10SSE2, nullptr, nullptr, unpackSnorm3x10AVX2 } };
+static const DispatchTable<PackVec4Kernel> packUnorm4x8Kernels = { {
+	packUnorm4x8Scalar, packUnorm4x8SSE2, nullptr, nullptr, packUnorm4x8AVX2 } };
+static const DispatchTable<UnpackVec4Kernel> unpackUnorm4x8Kernels = { {
+	unpackUnorm4x8Scalar, unpackUnorm4x8SSE2, nullptr, nullptr, unpackUnorm4x8AVX2 } };
+#else
+static const DispatchTable<PackHalfKernel> packHalfKernels = { { packHalfScalar } };
+static const DispatchTable<UnpackHalfKernel> unpackHalfKernels = { { unpackHalfScalar } };
+static const DispatchTable<PackVec4Kernel> packSnorm3x10Kernels = { { packSnorm3x10Scalar } };
+static const DispatchTable<UnpackVec4Kernel> unpackSnorm3x10Kernels = { { unpackSnorm3x10Scalar } };
+static const DispatchTable<PackVec4Kernel> packUnorm4x8Kernels = { { packUnorm4x8Scalar } };
+static const DispatchTable<UnpackVec4Kernel> unpackUnorm4x8Kernels = { { unpackUnorm4x8Scalar } };
+#endif
+
+void packHalfArray(const float* src, uint16_t* dst, size_t count, const PackSettings& settings)
+{
+	packHalfKernels.pick(settings.level)(src, dst, count);
+}
+
+void unpackHalfArray(const uint16_t* src, float* dst, size_t count, const PackSettings& settings)
+{
+	unpackHalfKernels.pick(settings.level)(src, dst, count);
+}
+
+void packSnorm3x10Array(const glm::vec4* src, uint32_t* dst, size_t count, const PackSettings& settings)
+{
+	packSnorm3x10Kernels.pick(settings.level)(src, dst, count);
+}
+
+void unpackSnorm3x10Array(const uint32_t* src, glm::vec4* dst, size_t count, const PackSettings& settings)
+{
+	unpackSnorm3x10Kernels.pick(settings.level)(src, dst, count);
+}
+
+void packUnorm4x8Array(const glm::vec4* src, uint32_t* dst, size_t count, const PackSettings& settings)
+{
+	packUnorm4x8Kernels.pick(settings.level)(src, dst, count);
+}
+
+void unpackUnorm4x8Array(const uint32_t* src, glm::vec4* dst, size_t count, const PackSettings& settings)
+{
+	unpackUnorm4x8Kernels.pick(settings.level)(src, dst, count);
+}
+
+CpuLevel packArrayLevel(CpuLevel limit)
+{
+	return packHalfKernels.level(limit);
+}
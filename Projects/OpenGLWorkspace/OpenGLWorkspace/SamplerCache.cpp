@@ -0,0 +1,132 @@
+#include "sampler_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+// EXT_texture_filter_anisotropic, core in 4.6; glad was generated without it
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+#define GL_TEXTURE_MAX_ANISOTROPY 0x84FE
+#endif
+#ifndef GL_MAX_TEXTURE_MAX_ANISOTROPY
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+SamplerGL SamplerGL::current()
+{
+	SamplerGL gl;
+	gl.GenSamplers = glGenSamplers;
+	gl.DeleteSamplers = glDeleteSamplers;
+	gl.BindSampler = glBindSampler;
+	gl.SamplerParameteri = glSamplerParameteri;
+	gl.SamplerParameterf = glSamplerParameterf;
+	gl.SamplerParameterfv = glSamplerParameterfv;
+	gl.GetFloatv = glGetFloatv;
+	gl.GetError = glGetError;
+	return gl;
+}
+
+bool SamplerDesc::operator==(const SamplerDesc& other) const
+{
+	return wrapS == other.wrapS && wrapT == other.wrapT && wrapR == other.wrapR &&
+		minFilter == other.minFilter && magFilter == other.magFilter &&
+		maxAnisotropy == other.maxAnisotropy && lodBias == other.lodBias &&
+		borderColor[0] == other.borderColor[0] && borderColor[1] == other.borderColor[1] &&
+		borderColor[2] == other.borderColor[2] && borderColor[3] == other.borderColor[3];
+}
+
+static size_t hashCombine(size_t seed, size_t value)
+{
+	return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+static size_t hashFloat(float value)
+{
+	// -0 and 0 compare equal, so they have to hash the same
+	value += 0.0f;
+	unsigned int bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+size_t SamplerDescHash::operator()(const SamplerDesc& desc) const
+{
+	size_t hash = 0;
+	hash = hashCombine(hash, (size_t)desc.wrapS);
+	hash = hashCombine(hash, (size_t)desc.wrapT);
+	hash = hashCombine(hash, (size_t)desc.wrapR);
+	hash = hashCombine(hash, (size_t)desc.minFilter);
+	hash = hashCombine(hash, (size_t)desc.magFilter);
+	hash = hashCombine(hash, hashFloat(desc.maxAnisotropy));
+	hash = hashCombine(hash, hashFloat(desc.lodBias));
+	for (float channel : desc.borderColor)
+		hash = hashCombine(hash, hashFloat(channel));
+	return hash;
+}
+
+SamplerCache::SamplerCache(const SamplerGL& gl)
+	: gl(gl), maxAnisotropy(0.0f)
+{
+}
+
+SamplerCache::~SamplerCache()
+{
+	for (auto& entry : samplers)
+		gl.DeleteSamplers(1, &entry.second);
+}
+
+GLuint SamplerCache::get(const SamplerDesc& desc)
+{
+	counters.lookups++;
+	auto found = samplers.find(desc);
+	if (found != samplers.end())
+		return found->second;
+
+	if (maxAnisotropy == 0.0f)
+	{
+		// without the extension the query fails and leaves 1, which turns anisotropy off
+		GLfloat limit = 1.0f;
+		gl.GetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &limit);
+		gl.GetError();
+		maxAnisotropy = std::max(limit, 1.0f);
+	}
+
+	GLuint sampler;
+	gl.GenSamplers(1, &sampler);
+	gl.SamplerParameteri(sampler, GL_TEXTURE_WRAP_S, desc.wrapS);
+	gl.SamplerParameteri(sampler, GL_TEXTURE_WRAP_T, desc.wrapT);
+	gl.SamplerParameteri(sampler, GL_TEXTURE_WRAP_R, desc.wrapR);
+	gl.SamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, desc.minFilter);
+	gl.SamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, desc.magFilter);
+	gl.SamplerParameterf(sampler, GL_TEXTURE_LOD_BIAS, desc.lodBias);
+	gl.SamplerParameterfv(sampler, GL_TEXTURE_BORDER_COLOR, desc.borderColor);
+	if (maxAnisotropy > 1.0f && desc.maxAnisotropy > 1.0f)
+		gl.SamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, std::min(desc.maxAnisotropy, maxAnisotropy));
+	samplers[desc] = sampler;
+	counters.created++;
+	return sampler;
+}
+
+void SamplerCache::bind(GLuint unit, const SamplerDesc& desc)
+{
+	bind(unit, get(desc));
+}
+
+void SamplerCache::bind(GLuint unit, GLuint sampler)
+{
+	if (unit >= bound.size())
+		bound.resize(unit + 1, 0);
+	if (bound[unit] == sampler)
+	{
+		counters.skippedBinds++;
+		return;
+	}
+	gl.BindSampler(unit, sampler);
+	bound[unit] = sampler;
+	counters.binds++;
+}
+
+void SamplerCache::invalidateBindings()
+{
+	// ~0u never matches a real sampler, so the next bind on each unit goes through
+	std::fill(bound.begin(), bound.end(), ~0u);
+}
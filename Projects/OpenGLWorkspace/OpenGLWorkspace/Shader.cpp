@@ -31,9 +31,23 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
 	{
 		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
 	}
-	const char* vShaderCode = vertexCode.c_str();
-	const char* fShaderCode = fragmentCode.c_str();
+	compile(vertexCode.c_str(), fragmentCode.c_str());
+}
 
+Shader::Shader(const AssetFS& assets, const char* vertexPath, const char* fragmentPath)
+{
+	// 1. the sources come straight out of the pack; no files to open
+	Asset vertexSource = assets.read(vertexPath);
+	Asset fragmentSource = assets.read(fragmentPath);
+	if (!vertexSource || !fragmentSource)
+	{
+		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
+	}
+	compile(vertexSource.text().c_str(), fragmentSource.text().c_str());
+}
+
+void Shader::compile(const char* vShaderCode, const char* fShaderCode)
+{
 	// 2. compile shaders
 	unsigned int vertex, fragment;
 	int success;
@@ -96,4 +110,7 @@ void Shader::setFloat(const std::string &name, float value) const
 {
 	glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
 }
-
+void Shader::setMat4(const std::string &name, const glm::mat4 &value) const
+{
+	glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &value[0][0]);
+}
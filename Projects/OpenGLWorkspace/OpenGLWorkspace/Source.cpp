@@ -7,6 +7,12 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include "shader.h"
+#include "texture_cache.h"
+#include "asset_cache.h"
+#include "asset_pack.h"
+#include "sampler_cache.h"
+#include "vertex_format.h"
+#include "mesh_buffer.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -19,6 +25,11 @@ void DrawCustomShader();
 void DrawTexture(GLFWwindow* window);
 void DrawTransformation(GLFWwindow* window);
 
+// shaders and textures; packed into assets.pack by Tools/pack_assets, loose files otherwise
+AssetFS assets;
+// decoded textures with mips, shared by every asset with the same contents
+AssetCache cookedAssets(assets, "cooked");
+
 int main()
 {
 	glfwInit();
@@ -44,6 +55,8 @@ int main()
 		return -1;
 	}
 
+	assets.mount("assets.pack");
+
 	glViewport(0, 0, 800, 600);
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
@@ -317,7 +330,7 @@ void DrawCustomShader()
 
 #pragma region Create, compile, and link vertex and fragment shaders in custom shader class
 
-	Shader customShader("vertex.vert", "fragment.frag");
+	Shader customShader(assets, "vertex.vert", "fragment.frag");
 
 #pragma endregion
 
@@ -370,7 +383,7 @@ void DrawTexture(GLFWwindow* window)
 	};
 	float blendAmount = 0.1f;
 
-	Shader shader("texVert.vert", "texFrag.frag");
+	Shader shader(assets, "texVert.vert", "texFrag.frag");
 	shader.setFloat("blendAmount", blendAmount);
 	unsigned int VAO;
 	glGenVertexArrays(1, &VAO);
@@ -379,62 +392,19 @@ void DrawTexture(GLFWwindow* window)
 
 	stbi_set_flip_vertically_on_load(true);
 
-	int width, height, nrChannels;
-	unsigned char *data = stbi_load("moon-texture.png", &width, &height, &nrChannels, 0);
-	std::cout << "Channels: " << nrChannels;
-	int width2, height2, nrChannels2;
-	unsigned char *data2 = stbi_load("strawberry.png", &width2, &height2, &nrChannels2, 0);
-
-
-	unsigned int texture;
-	glGenTextures(1, &texture);
-
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, texture);
-
-	// set the texture wrapping/filtering options (on the currently bound texture object)
-	// s and t since it's part of the 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	float bordercolor[] = { 0, 0, 0, 1.0f };
-	glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, bordercolor);
-
-	if (data)
-	{
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-	else
-	{
-		std::cout << "Failed to load texture" << std::endl;
-	}
-
-	stbi_image_free(data);
-
-	unsigned int texture2;
-	glGenTextures(1, &texture2);
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, texture2);
-
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-	if (data2)
-	{
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width2, height2, 0, GL_RGBA, GL_UNSIGNED_BYTE, data2);
-		glGenerateMipmap(GL_TEXTURE_2D);
-	}
-	else
-	{
-		std::cout << "Failed to load texture" << std::endl;
-	}
-
-	stbi_image_free(data2);
+	// textures stay loaded until the cache goes out of scope or they fall out of its budget
+	TextureCache textures(64 * 1024 * 1024, TextureCache::Policy::DropMips, TextureGL::current(), TextureLoader::cooked(cookedAssets));
+	// sampling state lives in sampler objects bound to the units, not in the textures
+	SamplerCache samplers;
+	SamplerDesc moonSampler;
+	moonSampler.wrapS = moonSampler.wrapT = GL_REPEAT;
+	moonSampler.minFilter = moonSampler.magFilter = GL_NEAREST;
+	moonSampler.borderColor[3] = 1.0f;
+	SamplerDesc strawberrySampler;
+	strawberrySampler.wrapS = strawberrySampler.wrapT = GL_MIRRORED_REPEAT;
+	strawberrySampler.minFilter = strawberrySampler.magFilter = GL_NEAREST;
+	GLuint moonSamplerID = samplers.get(moonSampler);
+	GLuint strawberrySamplerID = samplers.get(strawberrySampler);
 
 	shader.use();
 	shader.setInt("ourTexture", 0);
@@ -477,10 +447,13 @@ void DrawTexture(GLFWwindow* window)
 		glEnableVertexAttribArray(2);
 
 
+		textures.beginFrame();
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texture);
+		glBindTexture(GL_TEXTURE_2D, textures.acquire("moon-texture.png"));
+		samplers.bind(0, moonSamplerID);
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, texture2);
+		glBindTexture(GL_TEXTURE_2D, textures.acquire("strawberry.png"));
+		samplers.bind(1, strawberrySamplerID);
 
 		glBindVertexArray(VAO);
 		//glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, 0);
@@ -494,17 +467,13 @@ void DrawTexture(GLFWwindow* window)
 
 void DrawTransformation(GLFWwindow* window)
 {
-	glm::vec4 vec(1.0f, 0.0f, 0.0f, 1.0f);
-	glm::mat4 identity;
-	glm::mat4 translation;
-
-	translation = glm::translate(identity, glm::vec3(1.0f, 1.0f, 0.0f));
-	vec = translation * vec;
+	// the constant matrices are built by the compiler where glm has C++14 constexpr; rotate stays at runtime
+	GLM_CONSTEXPR_CXX14 glm::mat4 const translation = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 1.0f, 0.0f));
+	GLM_CONSTEXPR_CXX14 glm::vec4 const vec = translation * glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
 	std::cout << vec.x << vec.y << vec.z << std::endl;
 
-	glm::mat4 trans;
-	trans = glm::rotate(trans, glm::radians(90.0f), glm::vec3(0.0, 0.0, 1.0));
-	trans = glm::scale(trans, glm::vec3(1) * 0.5f);
+	GLM_CONSTEXPR_CXX14 glm::mat4 const halfScale = glm::scale(glm::mat4(1.0f), glm::vec3(0.5f));
+	glm::mat4 const trans = glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0, 0.0, 1.0)) * halfScale;
 
 	float squareVertices[] =
 	{
@@ -514,37 +483,29 @@ void DrawTransformation(GLFWwindow* window)
 		-0.5f, -0.5f, 0.0f,		1,1,1,			0.0f, 0.0f,		// bottom left
 		-0.5f, 0.5f, 0.0f,		1,1,1,			0.0, 1.0f		// top left
 	};
-	int squareIndices[] =
+	std::vector<unsigned int> squareIndices =
 	{
 		0, 1, 3,
 		1, 2, 3
 	};
 
-	Shader shader("transformVert.vert", "transformFrag.frag");
-
-	unsigned int VAO;
-	unsigned int VBO; // vertex buffer object
-	unsigned int EBO; // element buffer object
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
-	glGenBuffers(1, &EBO);
-
-	glBindVertexArray(VAO);
-
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(squareVertices), squareVertices, GL_STATIC_DRAW);
+	Shader shader(assets, "transformVert.vert", "transformFrag.frag");
 
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(squareIndices), squareIndices, GL_STATIC_DRAW);
-
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
-
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
+	// quantized to half positions, unorm8 colors and half texture coords: 16 bytes a vertex instead of 32
+	VertexSource squareSources[] =
+	{
+		{ AttributeKind::Position, 0, 3, squareVertices + 0, 8 },
+		{ AttributeKind::Color, 1, 3, squareVertices + 3, 8 },
+		{ AttributeKind::TexCoord, 2, 2, squareVertices + 6, 8 },
+	};
+	VertexLayout squareLayout = chooseVertexLayout(squareSources, 3, 4);
+	std::vector<unsigned char> packedSquare;
+	packVertices(squareSources, 3, 4, squareLayout, packedSquare);
 
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-	glEnableVertexAttribArray(2);
+	// 4 vertices fit byte indices, and the two triangles make one 4-index strip
+	MeshBuffer square;
+	square.upload(squareLayout, packedSquare, squareIndices);
+	unsigned long long reportedIndexBytes = ~0ull;
 
 	stbi_set_flip_vertically_on_load(true);
 
@@ -574,6 +535,7 @@ void DrawTransformation(GLFWwindow* window)
 	//stbi_image_free(data);
 
 	shader.use();
+	shader.setMat4("positionTransform", squareLayout.positionTransform());
 	while (!glfwWindowShouldClose(window))
 	{
 		// input
@@ -587,9 +549,17 @@ void DrawTransformation(GLFWwindow* window)
 		//glBindTexture(GL_TEXTURE_2D, texture);
 
 		shader.use();
-		glBindVertexArray(VAO);
+		square.resetStats();
+		square.draw();
 		//glDrawArrays(GL_TRIANGLES, 0, 3);
-		glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, (void*)0);
+
+		// index bytes fetched this frame, in the title bar whenever it changes
+		if (square.stats().indexBytes != reportedIndexBytes)
+		{
+			reportedIndexBytes = square.stats().indexBytes;
+			std::string title = "Eden - " + std::to_string(reportedIndexBytes) + " index bytes/frame";
+			glfwSetWindowTitle(window, title.c_str());
+		}
 
 		glfwSwapBuffers(window);
 		glfwPollEvents();
@@ -0,0 +1,375 @@
+#include "texture_cache.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+#include "asset_cache.h"
+#include "asset_pack.h"
+#include "half_image.h"
+#include "stb_image.h"
+
+TextureGL TextureGL::current()
+{
+	// the gl* names are glad's function pointers, so this has to run after gladLoadGLLoader
+	TextureGL gl;
+	gl.GenTextures = glGenTextures;
+	gl.DeleteTextures = glDeleteTextures;
+	gl.BindTexture = glBindTexture;
+	gl.GetIntegerv = glGetIntegerv;
+	gl.TexImage2D = glTexImage2D;
+	gl.TexParameteri = glTexParameteri;
+	gl.GenerateMipmap = glGenerateMipmap;
+	return gl;
+}
+
+static bool stbImageLoad(void*, const std::string& path, TextureImage& image)
+{
+	int channels;
+	image.pixels = stbi_load(path.c_str(), &image.width, &image.height, &channels, 4);
+	return image.pixels != nullptr;
+}
+
+static bool stbImageLoadAsset(void* user, const std::string& path, TextureImage& image)
+{
+	Asset asset = ((const AssetFS*)user)->read(path);
+	if (!asset || asset.size() > INT_MAX)
+		return false;
+	int channels;
+	image.pixels = stbi_load_from_memory(asset.data(), (int)asset.size(), &image.width, &image.height, &channels, 4);
+	return image.pixels != nullptr;
+}
+
+static void stbImageRelease(void*, TextureImage& image)
+{
+	stbi_image_free(image.pixels);
+	image.pixels = nullptr;
+}
+
+TextureLoader TextureLoader::stbImage()
+{
+	TextureLoader loader;
+	loader.load = stbImageLoad;
+	loader.release = stbImageRelease;
+	loader.user = nullptr;
+	return loader;
+}
+
+TextureLoader TextureLoader::stbImage(const AssetFS& assets)
+{
+	TextureLoader loader;
+	loader.load = stbImageLoadAsset;
+	loader.release = stbImageRelease;
+	loader.user = (void*)&assets;
+	return loader;
+}
+
+static bool cookedLoad(void* user, const std::string& path, TextureImage& image)
+{
+	AssetCache* cache = (AssetCache*)user;
+	CookedTexture* cooked = new CookedTexture();
+	if (!cache->texture(path, cache->textureSettings, *cooked))
+	{
+		delete cooked;
+		return false;
+	}
+	image.width = cooked->width;
+	image.height = cooked->height;
+	image.levels = cooked->levels;
+	image.pixels = cooked->pixels.data();
+	image.handle = cooked;
+	return true;
+}
+
+static void cookedRelease(void*, TextureImage& image)
+{
+	delete (CookedTexture*)image.handle;
+	image.pixels = nullptr;
+	image.handle = nullptr;
+}
+
+TextureLoader TextureLoader::cooked(AssetCache& cache)
+{
+	TextureLoader loader;
+	loader.load = cookedLoad;
+	loader.release = cookedRelease;
+	loader.user = &cache;
+	return loader;
+}
+
+static bool hdrLoad(void* user, const std::string& path, TextureImage& image)
+{
+	Asset asset = ((const AssetFS*)user)->read(path);
+	HalfImage* half = new HalfImage();
+	if (!asset || !loadHalfImage(asset.data(), asset.size(), *half))
+	{
+		delete half;
+		return false;
+	}
+	image.width = half->width;
+	image.height = half->height;
+	image.internalFormat = GL_RGBA16F;
+	image.pixels = (unsigned char*)half->pixels.data();
+	image.handle = half;
+	return true;
+}
+
+static void hdrRelease(void*, TextureImage& image)
+{
+	delete (HalfImage*)image.handle;
+	image.pixels = nullptr;
+	image.handle = nullptr;
+}
+
+TextureLoader TextureLoader::hdr(const AssetFS& assets)
+{
+	TextureLoader loader;
+	loader.load = hdrLoad;
+	loader.release = hdrRelease;
+	loader.user = (void*)&assets;
+	return loader;
+}
+
+// RGBA16F takes half floats and twice the memory; everything else here is RGBA8
+static GLenum pixelType(GLenum internalFormat)
+{
+	return internalFormat == GL_RGBA16F ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+}
+
+static size_t pixelBytes(GLenum internalFormat)
+{
+	return internalFormat == GL_RGBA16F ? 8 : 4;
+}
+
+static bool isMipmapFilter(GLint filter)
+{
+	return filter == GL_NEAREST_MIPMAP_NEAREST || filter == GL_LINEAR_MIPMAP_NEAREST ||
+		filter == GL_NEAREST_MIPMAP_LINEAR || filter == GL_LINEAR_MIPMAP_LINEAR;
+}
+
+static int mipLevels(int width, int height)
+{
+	int levels = 1;
+	for (int size = std::max(width, height); size > 1; size >>= 1)
+		levels++;
+	return levels;
+}
+
+static bool sameParams(const TextureParams& a, const TextureParams& b)
+{
+	return a.wrapS == b.wrapS && a.wrapT == b.wrapT && a.minFilter == b.minFilter && a.magFilter == b.magFilter;
+}
+
+size_t TextureCache::textureBytes(int width, int height, bool mipmapped, int baseLevel, GLenum internalFormat)
+{
+	int levels = mipmapped ? mipLevels(width, height) : 1;
+	size_t bytes = 0;
+	for (int level = baseLevel; level < levels; level++)
+		bytes += (size_t)std::max(1, width >> level) * std::max(1, height >> level) * pixelBytes(internalFormat);
+	return bytes;
+}
+
+TextureCache::TextureCache(size_t budgetBytes, Policy policy, const TextureGL& gl, const TextureLoader& loader)
+	: gl(gl), loader(loader), policy(policy), budgetBytes(budgetBytes), frame(0)
+{
+}
+
+TextureCache::~TextureCache()
+{
+	clear();
+}
+
+GLuint TextureCache::acquire(const std::string& path, const TextureParams& params)
+{
+	auto found = entries.find(path);
+	if (found != entries.end())
+	{
+		EntryList::iterator it = found->second;
+		lru.splice(lru.begin(), lru, it);
+		it->lastFrame = frame;
+		if (it->baseLevel == 0 && sameParams(it->params, params))
+		{
+			counters.hits++;
+			return it->id;
+		}
+		// dropped mips (or a different mip setup) need the file again; if that fails
+		// the texture we already have is still usable
+		TextureParams previous = it->params;
+		it->params = params;
+		if (it->baseLevel > 0)
+			counters.restreams++;
+		if (!upload(*it))
+			it->params = previous;
+		return it->id;
+	}
+
+	counters.misses++;
+	Entry entry;
+	entry.path = path;
+	entry.id = 0;
+	entry.width = entry.height = 0;
+	entry.levels = 1;
+	entry.baseLevel = 0;
+	entry.internalFormat = GL_RGBA8;
+	entry.bytes = 0;
+	entry.lastFrame = frame;
+	entry.params = params;
+	lru.push_front(entry);
+	entries[path] = lru.begin();
+	if (!upload(lru.front()))
+	{
+		erase(lru.begin());
+		return 0;
+	}
+	return lru.front().id;
+}
+
+void TextureCache::beginFrame()
+{
+	frame++;
+}
+
+void TextureCache::release(const std::string& path)
+{
+	auto found = entries.find(path);
+	if (found != entries.end())
+		erase(found->second);
+}
+
+void TextureCache::clear()
+{
+	while (!lru.empty())
+		erase(lru.begin());
+}
+
+void TextureCache::setBudget(size_t bytes)
+{
+	budgetBytes = bytes;
+	enforceBudget(0);
+}
+
+int TextureCache::droppedLevels(const std::string& path) const
+{
+	auto found = entries.find(path);
+	return found != entries.end() ? found->second->baseLevel : 0;
+}
+
+bool TextureCache::upload(Entry& entry)
+{
+	TextureImage image;
+	if (!loader.load(loader.user, entry.path, image))
+	{
+		std::cout << "Failed to load texture " << entry.path << std::endl;
+		counters.loadFailures++;
+		return false;
+	}
+
+	bool mipmapped = isMipmapFilter(entry.params.minFilter);
+	size_t bytes = textureBytes(image.width, image.height, mipmapped, 0, image.internalFormat);
+	// make room before the new storage exists; the entry itself is pinned by lastFrame
+	if (bytes > entry.bytes)
+		enforceBudget(bytes - entry.bytes);
+
+	GLint previous;
+	gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+	if (entry.id == 0)
+		gl.GenTextures(1, &entry.id);
+	gl.BindTexture(GL_TEXTURE_2D, entry.id);
+	gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, entry.params.wrapS);
+	gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, entry.params.wrapT);
+	gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, entry.params.minFilter);
+	gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, entry.params.magFilter);
+	gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	GLenum type = pixelType(image.internalFormat);
+	gl.TexImage2D(GL_TEXTURE_2D, 0, image.internalFormat, image.width, image.height, 0, GL_RGBA, type, image.pixels);
+	if (mipmapped && image.levels == mipLevels(image.width, image.height))
+	{
+		// the loader brought its own mips
+		size_t pixelSize = pixelBytes(image.internalFormat);
+		const unsigned char* level = image.pixels + (size_t)image.width * image.height * pixelSize;
+		for (int i = 1; i < image.levels; i++)
+		{
+			int width = std::max(1, image.width >> i), height = std::max(1, image.height >> i);
+			gl.TexImage2D(GL_TEXTURE_2D, i, image.internalFormat, width, height, 0, GL_RGBA, type, level);
+			level += (size_t)width * height * pixelSize;
+		}
+	}
+	else if (mipmapped)
+		gl.GenerateMipmap(GL_TEXTURE_2D);
+	gl.BindTexture(GL_TEXTURE_2D, previous);
+	loader.release(loader.user, image);
+
+	entry.width = image.width;
+	entry.height = image.height;
+	entry.levels = mipmapped ? mipLevels(image.width, image.height) : 1;
+	entry.baseLevel = 0;
+	entry.internalFormat = image.internalFormat;
+	setBytes(entry, bytes);
+	return true;
+}
+
+void TextureCache::enforceBudget(size_t incoming)
+{
+	while (counters.residentBytes + incoming > budgetBytes)
+	{
+		// oldest texture not used this frame; with DropMips, the oldest one that still has a level to give
+		EntryList::iterator victim = lru.end(), trimmable = lru.end();
+		for (EntryList::iterator it = lru.begin(); it != lru.end(); ++it)
+		{
+			if (it->lastFrame == frame)
+				continue;
+			victim = it;
+			if (policy == Policy::DropMips && dropTopLevel(*it, true))
+				trimmable = it;
+		}
+		if (victim == lru.end())
+			return;	// everything left is in use this frame; stay over budget
+		if (trimmable != lru.end())
+		{
+			dropTopLevel(*trimmable);
+			counters.mipDrops++;
+		}
+		else
+		{
+			erase(victim);
+			counters.evictions++;
+		}
+	}
+}
+
+bool TextureCache::dropTopLevel(Entry& entry, bool checkOnly)
+{
+	int next = entry.baseLevel + 1;
+	if (next >= entry.levels || std::max(entry.width >> next, entry.height >> next) < minTrimmedSize)
+		return false;
+	if (checkOnly)
+		return true;
+
+	// stop sampling the level, then respecify it as empty so the driver can release its storage
+	GLint previous;
+	gl.GetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+	gl.BindTexture(GL_TEXTURE_2D, entry.id);
+	gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, next);
+	gl.TexImage2D(GL_TEXTURE_2D, entry.baseLevel, entry.internalFormat, 0, 0, 0, GL_RGBA, pixelType(entry.internalFormat), nullptr);
+	gl.BindTexture(GL_TEXTURE_2D, previous);
+
+	entry.baseLevel = next;
+	setBytes(entry, textureBytes(entry.width, entry.height, true, next, entry.internalFormat));
+	return true;
+}
+
+void TextureCache::erase(EntryList::iterator it)
+{
+	if (it->id != 0)
+		gl.DeleteTextures(1, &it->id);
+	counters.residentBytes -= it->bytes;
+	entries.erase(it->path);
+	lru.erase(it);
+}
+
+void TextureCache::setBytes(Entry& entry, size_t bytes)
+{
+	counters.residentBytes = counters.residentBytes - entry.bytes + bytes;
+	entry.bytes = bytes;
+	counters.peakBytes = std::max(counters.peakBytes, counters.residentBytes);
+}
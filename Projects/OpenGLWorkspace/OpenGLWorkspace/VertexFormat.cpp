@@ -0,0 +1,265 @@
+#include "vertex_format.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "pack_array.h"
+
+VertexLayoutGL VertexLayoutGL::current()
+{
+	VertexLayoutGL gl;
+	gl.VertexAttribPointer = glVertexAttribPointer;
+	gl.EnableVertexAttribArray = glEnableVertexAttribArray;
+	return gl;
+}
+
+glm::mat4 VertexLayout::positionTransform() const
+{
+	return glm::scale(glm::translate(glm::mat4(1.0f), positionOffset), positionScale);
+}
+
+void VertexLayout::apply(size_t bufferOffset, const VertexLayoutGL& gl) const
+{
+	for (const VertexAttribute& attribute : attributes)
+	{
+		gl.VertexAttribPointer(attribute.location, attribute.components, attribute.type, attribute.normalized,
+			stride, (void*)(bufferOffset + attribute.offset));
+		gl.EnableVertexAttribArray(attribute.location);
+	}
+}
+
+static const float* component(const VertexSource& source, size_t vertex)
+{
+	return source.data + vertex * source.stride;
+}
+
+// largest error half floats would add to any component; FLT_MAX if some don't fit
+static float halfError(const VertexSource& source, size_t vertexCount)
+{
+	float error = 0.0f;
+	for (size_t v = 0; v < vertexCount; v++)
+		for (int c = 0; c < source.components; c++)
+		{
+			float value = component(source, v)[c];
+			if (!(std::fabs(value) <= 65504.0f))
+				return FLT_MAX;
+			error = std::max(error, std::fabs(glm::unpackHalf1x16(glm::packHalf1x16(value)) - value));
+		}
+	return error;
+}
+
+static void bounds(const VertexSource& source, size_t vertexCount, glm::vec3& low, glm::vec3& high)
+{
+	low = glm::vec3(FLT_MAX);
+	high = glm::vec3(-FLT_MAX);
+	for (size_t v = 0; v < vertexCount; v++)
+		for (int c = 0; c < source.components && c < 3; c++)
+		{
+			low[c] = std::min(low[c], component(source, v)[c]);
+			high[c] = std::max(high[c], component(source, v)[c]);
+		}
+	if (vertexCount == 0)
+		low = high = glm::vec3(0.0f);
+	for (int c = source.components; c < 3; c++)
+		low[c] = high[c] = 0.0f;
+}
+
+static bool inUnitRange(const VertexSource& source, size_t vertexCount)
+{
+	for (size_t v = 0; v < vertexCount; v++)
+		for (int c = 0; c < source.components; c++)
+		{
+			float value = component(source, v)[c];
+			if (!(value >= 0.0f && value <= 1.0f))
+				return false;
+		}
+	return true;
+}
+
+static AttributeFormat chooseFormat(const VertexSource& source, size_t vertexCount, const VertexFormatSettings& settings,
+	VertexLayout& layout, bool& positionTaken)
+{
+	if (!settings.quantize || source.components < 1 || source.components > 4)
+		return AttributeFormat::Float;
+
+	switch (source.kind)
+	{
+	case AttributeKind::Position:
+	{
+		if (source.components > 3)
+			return AttributeFormat::Float;
+		glm::vec3 low, high;
+		bounds(source, vertexCount, low, high);
+		glm::vec3 extent = high - low;
+		float allowed = settings.positionError * std::max(extent.x, std::max(extent.y, extent.z));
+		if (halfError(source, vertexCount) <= allowed)
+			return AttributeFormat::Half;
+		// int16 relative to the bounds needs the transform, and there's only one per layout
+		if (positionTaken || !(allowed > 0.0f) || !(extent.x < FLT_MAX && extent.y < FLT_MAX && extent.z < FLT_MAX))
+			return AttributeFormat::Float;
+		// rounding to the nearest step is off by at most half a step
+		glm::vec3 scale = glm::max(extent * 0.5f / 32767.0f, glm::vec3(FLT_MIN));
+		if (std::max(scale.x, std::max(scale.y, scale.z)) * 0.5f > allowed)
+			return AttributeFormat::Float;
+		layout.positionOffset = (low + high) * 0.5f;
+		layout.positionScale = scale;
+		positionTaken = true;
+		return AttributeFormat::Int16;
+	}
+	case AttributeKind::Normal:
+		// 9 bits and a sign is about a tenth of a degree, well below shading precision
+		return source.components == 3 ? AttributeFormat::Snorm10 : AttributeFormat::Float;
+	case AttributeKind::Color:
+		if (inUnitRange(source, vertexCount))
+			return AttributeFormat::Unorm8;
+		return halfError(source, vertexCount) < FLT_MAX ? AttributeFormat::Half : AttributeFormat::Float;
+	case AttributeKind::TexCoord:
+		return halfError(source, vertexCount) <= settings.texCoordError ? AttributeFormat::Half : AttributeFormat::Float;
+	}
+	return AttributeFormat::Float;
+}
+
+VertexLayout chooseVertexLayout(const VertexSource* sources, size_t sourceCount, size_t vertexCount,
+	const VertexFormatSettings& settings)
+{
+	VertexLayout layout;
+	bool positionTaken = false;
+	GLuint offset = 0;
+	for (size_t i = 0; i < sourceCount; i++)
+	{
+		const VertexSource& source = sources[i];
+		VertexAttribute attribute;
+		attribute.location = source.location;
+		attribute.format = chooseFormat(source, vertexCount, settings, layout, positionTaken);
+		attribute.components = source.components;
+		attribute.offset = offset;
+		GLuint bytes = 0;
+		switch (attribute.format)
+		{
+		case AttributeFormat::Float:
+			attribute.type = GL_FLOAT;
+			attribute.normalized = GL_FALSE;
+			bytes = 4 * source.components;
+			break;
+		case AttributeFormat::Half:
+			attribute.type = GL_HALF_FLOAT;
+			attribute.normalized = GL_FALSE;
+			bytes = 2 * source.components;
+			break;
+		case AttributeFormat::Int16:
+			attribute.type = GL_SHORT;
+			attribute.normalized = GL_FALSE;
+			bytes = 2 * source.components;
+			break;
+		case AttributeFormat::Snorm10:
+			// packed formats always have 4 components; the shader can still read a vec3
+			attribute.type = GL_INT_2_10_10_10_REV;
+			attribute.normalized = GL_TRUE;
+			attribute.components = 4;
+			bytes = 4;
+			break;
+		case AttributeFormat::Unorm8:
+			attribute.type = GL_UNSIGNED_BYTE;
+			attribute.normalized = GL_TRUE;
+			attribute.components = 4;
+			bytes = 4;
+			break;
+		}
+		// keep every attribute 4-byte aligned; some drivers fall off the fast path otherwise
+		offset += (bytes + 3) & ~3u;
+		layout.attributes.push_back(attribute);
+	}
+	layout.stride = (GLsizei)offset;
+	return layout;
+}
+
+// the pack_array.h kernels want contiguous input, so Half, Snorm10 and Unorm8
+// attributes are gathered and packed this many vertices at a time
+static const size_t packBlockSize = 256;
+
+void packVertices(const VertexSource* sources, size_t sourceCount, size_t vertexCount, const VertexLayout& layout,
+	std::vector<unsigned char>& vertices)
+{
+	float floats[packBlockSize * 4];
+	uint16_t halves[packBlockSize * 4];
+	glm::vec4 vectors[packBlockSize];
+	uint32_t packed[packBlockSize];
+	vertices.assign(vertexCount * layout.stride, 0);
+	for (size_t i = 0; i < sourceCount && i < layout.attributes.size(); i++)
+	{
+		const VertexSource& source = sources[i];
+		const VertexAttribute& attribute = layout.attributes[i];
+		for (size_t first = 0; first < vertexCount; first += packBlockSize)
+		{
+			size_t count = std::min(packBlockSize, vertexCount - first);
+			unsigned char* out = vertices.data() + first * layout.stride + attribute.offset;
+			switch (attribute.format)
+			{
+			case AttributeFormat::Float:
+				for (size_t v = 0; v < count; v++)
+					std::memcpy(out + v * layout.stride, component(source, first + v), source.components * sizeof(float));
+				break;
+			case AttributeFormat::Half:
+				for (size_t v = 0; v < count; v++)
+					std::memcpy(floats + v * source.components, component(source, first + v), source.components * sizeof(float));
+				packHalfArray(floats, halves, count * source.components);
+				for (size_t v = 0; v < count; v++)
+					std::memcpy(out + v * layout.stride, halves + v * source.components, source.components * 2);
+				break;
+			case AttributeFormat::Int16:
+				for (size_t v = 0; v < count; v++)
+				{
+					const float* in = component(source, first + v);
+					for (int c = 0; c < source.components; c++)
+					{
+						float q = std::round((in[c] - layout.positionOffset[c]) / layout.positionScale[c]);
+						int16_t value = (int16_t)std::min(std::max(q, -32767.0f), 32767.0f);
+						std::memcpy(out + v * layout.stride + c * 2, &value, 2);
+					}
+				}
+				break;
+			case AttributeFormat::Snorm10:
+			case AttributeFormat::Unorm8:
+			{
+				// normals get w = 0, colors without alpha get 1
+				float w = attribute.format == AttributeFormat::Snorm10 ? 0.0f : 1.0f;
+				for (size_t v = 0; v < count; v++)
+				{
+					const float* in = component(source, first + v);
+					vectors[v] = glm::vec4(0.0f, 0.0f, 0.0f, w);
+					for (int c = 0; c < source.components; c++)
+						vectors[v][c] = in[c];
+				}
+				if (attribute.format == AttributeFormat::Snorm10)
+					packSnorm3x10Array(vectors, packed, count);
+				else
+					packUnorm4x8Array(vectors, packed, count);
+				for (size_t v = 0; v < count; v++)
+					std::memcpy(out + v * layout.stride, packed + v, 4);
+				break;
+			}
+			}
+		}
+	}
+}
+
+VertexLayout packMesh(const Mesh& mesh, std::vector<unsigned char>& vertices, const VertexFormatSettings& settings)
+{
+	const size_t stride = sizeof(MeshVertex) / sizeof(float);
+	const MeshVertex* first = mesh.vertices.empty() ? nullptr : mesh.vertices.data();
+	VertexSource sources[] =
+	{
+		{ AttributeKind::Position, 0, 3, first ? first->position : nullptr, stride },
+		{ AttributeKind::Normal, 1, 3, first ? first->normal : nullptr, stride },
+		{ AttributeKind::TexCoord, 2, 2, first ? first->uv : nullptr, stride },
+	};
+	VertexLayout layout = chooseVertexLayout(sources, 3, mesh.vertices.size(), settings);
+	packVertices(sources, 3, mesh.vertices.size(), layout, vertices);
+	return layout;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef AFFINE_H
+#define AFFINE_H
+
+#include <cstddef>
+
+#include <glm/glm.hpp>
+
+// an affine transform as the top three rows of its 4x4 matrix, 12 floats; the
+// bottom row is always 0 0 0 1 and isn't stored. Composing two takes 36
+// multiply-adds against a mat4's 64, and each row is one SSE register. Keep
+// scene transforms in these and turn them into a mat4 only for upload
+struct Affine
+{
+	glm::vec4 rows[3];
+
+	Affine();	// identity
+	// drops m's bottom row, which has to be 0 0 0 1 for the result to mean m
+	explicit Affine(const glm::mat4& m);
+
+	glm::mat4 toMat4() const;
+	glm::vec3 translation() const { return glm::vec3(rows[0].w, rows[1].w, rows[2].w); }
+};
+
+Affine affineTranslate(const glm::vec3& offset);
+Affine affineRotate(float angle, const glm::vec3& axis);	// radians, like glm::rotate
+Affine affineScale(const glm::vec3& factors);
+
+// a * b applies b first, as with matrices
+Affine operator*(const Affine& a, const Affine& b);
+
+glm::vec3 transformPoint(const Affine& a, const glm::vec3& point);
+glm::vec3 transformDirection(const Affine& a, const glm::vec3& direction);	// no translation
+
+// any invertible transform: the 3x3 part through cross products, then the
+// translation through that. Singular ones come back as the identity
+Affine inverse(const Affine& a);
+// rotation and translation only: the 3x3 part transposed
+Affine inverseRigid(const Affine& a);
+
+// scene graph propagation: world[i] = world[parent[i]] * local[i], or local[i]
+// where parent[i] is negative. Parents have to come before their children
+void propagateAffine(const Affine* local, const int* parent, Affine* world, size_t count);
+
+// for upload
+void affineToMat4(const Affine* in, glm::mat4* out, size_t count);
+
+#endif // !AFFINE_H
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mip_generator.h"
+
+class AssetFS;
+
+// how a texture is cooked; part of the cache key, so changing any of them cooks again
+struct TextureCookSettings
+{
+	bool flipVertically = true;	// first row is the bottom one, as OpenGL expects
+	bool mipmaps = true;		// full mip chain down to 1x1
+	MipSettings mipSettings;	// threads don't change the output and aren't part of the key
+};
+
+// an RGBA8 texture out of the cook step: 'levels' mip levels back to back, largest first
+struct CookedTexture
+{
+	int width = 0;
+	int height = 0;
+	int levels = 0;
+	std::vector<unsigned char> pixels;
+};
+
+struct AssetCacheStats
+{
+	unsigned long hits = 0;		// cooked output found in the store
+	unsigned long cooks = 0;	// decoded and stored
+	unsigned long failures = 0;	// missing or undecodable sources
+};
+
+// content-addressed store of cooked assets. Entries are keyed by a hash of the
+// source bytes plus the cook settings, so the same image under another name or
+// in another project is cooked once, and a renamed or copied file isn't cooked again
+class AssetCache
+{
+public:
+	// 'directory' is created if it doesn't exist; sources are read through 'assets'
+	AssetCache(const AssetFS& assets, const std::string& directory);
+
+	// cooked version of the asset at 'path'
+	bool texture(const std::string& path, const TextureCookSettings& settings, CookedTexture& texture);
+	// same, for source bytes that are already in memory
+	bool texture(const unsigned char* source, size_t size, const TextureCookSettings& settings, CookedTexture& texture);
+
+	// settings used by the TextureLoader that reads through this cache
+	TextureCookSettings textureSettings;
+
+	// store key for some source bytes cooked with 'settings'
+	static std::string textureKey(const unsigned char* source, size_t size, const TextureCookSettings& settings);
+	// decode and cook without touching the store
+	static bool cookTexture(const unsigned char* source, size_t size, const TextureCookSettings& settings, CookedTexture& texture);
+
+	const AssetCacheStats& stats() const { return counters; }
+
+private:
+	bool readTexture(const std::string& file, uint64_t sourceHash, uint64_t sourceSize, CookedTexture& texture) const;
+	bool writeTexture(const std::string& file, uint64_t sourceHash, uint64_t sourceSize, const CookedTexture& texture) const;
+
+	const AssetFS& assets;
+	std::string directory;
+	AssetCacheStats counters;
+};
+
+#endif // !ASSET_CACHE_H
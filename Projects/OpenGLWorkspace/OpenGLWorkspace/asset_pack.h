@@ -0,0 +1,159 @@
+#pragma once
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// pack file layout, all integers little-endian:
+//   AssetPackHeader
+//   AssetPackEntry[count]	sorted by hash, then by name
+//   names					entry names, not terminated
+//   blobs					each starting on an 'alignment' boundary
+struct AssetPackHeader
+{
+	char magic[4];			// "APAK"
+	uint32_t version;
+	uint32_t count;
+	uint32_t alignment;
+	uint64_t namesOffset;
+	uint64_t namesSize;
+	uint64_t fileSize;
+};
+
+struct AssetPackEntry
+{
+	uint64_t hash;			// assetPathHash of the name
+	uint64_t offset;		// from the start of the file
+	uint64_t size;
+	uint32_t nameOffset;	// from namesOffset
+	uint32_t nameLength;
+};
+
+static const uint32_t assetPackVersion = 1;
+
+// asset names use '/' and no leading "./", so "Assets\\moon.png" and "./Assets/moon.png" are the same asset
+std::string assetPathNormalize(const std::string& path);
+// 64-bit FNV-1a of an already normalized path
+uint64_t assetPathHash(const std::string& path);
+// 64-bit MurmurHash64A of file contents; identifies an asset by what's in it rather than where it is
+uint64_t assetContentHash(const unsigned char* data, size_t size);
+
+// a read-only pack mapped into memory; lookups don't touch the file system
+class AssetPack
+{
+public:
+	AssetPack();
+	~AssetPack();
+
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+
+	// map 'path' and check its header and index; false (and an error printed) if it isn't a valid pack
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const { return base != nullptr; }
+
+	// contents of the asset named 'path', or nullptr if the pack doesn't have it
+	const unsigned char* find(const std::string& path, size_t* size) const;
+
+	uint32_t count() const { return header ? header->count : 0; }
+	// name of entry 'index', in index order
+	std::string name(uint32_t index) const;
+
+private:
+	bool validate(const std::string& path);
+
+	const unsigned char* base;
+	size_t length;
+	const AssetPackHeader* header;
+	const AssetPackEntry* index;
+	const char* names;
+#ifdef _WIN32
+	void* file;
+	void* mapping;
+#endif
+};
+
+// collects files and writes them out as a pack
+class AssetPackWriter
+{
+public:
+	explicit AssetPackWriter(uint32_t alignment = 64);
+
+	// add a file under 'name'; false if it can't be read or the name is already taken.
+	// contents identical to an asset already added are stored once, under both names
+	bool addFile(const std::string& name, const std::string& path);
+	void add(const std::string& name, std::vector<unsigned char> data);
+	bool contains(const std::string& name) const;
+
+	bool write(const std::string& path) const;
+
+	// assets that share another asset's bytes, and the bytes that saves
+	size_t sharedCount() const { return shared; }
+	uint64_t sharedBytes() const { return savedBytes; }
+
+private:
+	struct Item
+	{
+		std::string name;
+		uint64_t hash;
+		size_t blob;	// index of the item holding the bytes; itself unless they're shared
+		std::vector<unsigned char> data;
+	};
+
+	uint32_t alignment;
+	std::vector<Item> items;
+	std::unordered_set<std::string> names;
+	std::unordered_multimap<uint64_t, size_t> blobs;	// content hash -> item
+	size_t shared;
+	uint64_t savedBytes;
+};
+
+// asset bytes handed out by AssetFS; either a view into a mounted pack or a loose file read into memory
+class Asset
+{
+public:
+	Asset() : view(nullptr), length(0) {}
+
+	const unsigned char* data() const { return view ? view : owned.data(); }
+	size_t size() const { return length; }
+	explicit operator bool() const { return view != nullptr || !owned.empty(); }
+	std::string text() const { return std::string((const char*)data(), length); }
+
+private:
+	friend class AssetFS;
+	const unsigned char* view;
+	size_t length;
+	std::vector<unsigned char> owned;
+};
+
+// looks assets up in the mounted packs, most recently mounted first, then
+// optionally as loose files relative to the working directory
+class AssetFS
+{
+public:
+	AssetFS();
+	~AssetFS();
+
+	AssetFS(const AssetFS&) = delete;
+	AssetFS& operator=(const AssetFS&) = delete;
+
+	bool mount(const std::string& packPath);
+	// loose files are on by default so the app still runs without a pack
+	void setLooseFiles(bool enabled) { looseFiles = enabled; }
+
+	// an empty Asset if 'path' can't be found
+	Asset read(const std::string& path) const;
+	bool exists(const std::string& path) const;
+
+private:
+	std::vector<AssetPack*> packs;
+	bool looseFiles;
+};
+
+#endif // !ASSET_PACK_H
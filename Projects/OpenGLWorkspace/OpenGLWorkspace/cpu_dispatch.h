@@ -0,0 +1,36 @@
+#pragma once
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include "cpu_features.h"
+
+// one kernel per CpuLevel, for code that ships in one binary to every x86
+// machine: each kernel is compiled with its level's CPU_TARGET_* attribute
+// and the table hands out the best one the CPU runs. Levels without a kernel
+// of their own stay null and fall back to the level below, so a table only
+// needs entries where a level actually helps; the Scalar one is required.
+// Choosing costs a few compares, so dispatch per array, not per element
+template <typename Kernel>
+struct DispatchTable
+{
+	Kernel kernels[(int)CpuLevel::Count];
+
+	// the kernel for the highest level that this CPU supports, that is no
+	// higher than 'limit' and that has an entry
+	Kernel pick(CpuLevel limit = CpuLevel::AVX512) const
+	{
+		return kernels[(int)level(limit)];
+	}
+
+	// which level pick() lands on, for reports
+	CpuLevel level(CpuLevel limit = CpuLevel::AVX512) const
+	{
+		CpuLevel top = cpuLevel() < limit ? cpuLevel() : limit;
+		int level = top < CpuLevel::Count ? (int)top : (int)CpuLevel::Count - 1;
+		while (level > 0 && !kernels[level])
+			level--;
+		return (CpuLevel)level;
+	}
+};
+
+#endif // !CPU_DISPATCH_H
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// x86 SIMD code is compiled in when the target has at least SSE2; everything
+// newer is compiled with per-function target attributes and chosen at runtime
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CPU_X86
+#ifdef _MSC_VER
+#define CPU_TARGET_SSE41
+#define CPU_TARGET_AVX
+#define CPU_TARGET_F16C
+#define CPU_TARGET_AVX2
+#define CPU_TARGET_AVX512
+#else
+#define CPU_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define CPU_TARGET_AVX __attribute__((target("avx")))
+#define CPU_TARGET_F16C __attribute__((target("avx,f16c")))
+#define CPU_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define CPU_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl,avx2,fma,f16c")))
+#endif
+#endif
+
+// what this CPU and OS support, detected once; always false off x86
+bool cpuHasAVX();
+bool cpuHasF16C();
+
+// instruction set levels for kernels, each including everything below it.
+// AVX2 also means FMA and F16C, and AVX512 the F, DQ, BW and VL subsets
+// (Skylake-X and later)
+enum class CpuLevel
+{
+	Scalar,
+	SSE2,
+	SSE41,
+	AVX,
+	AVX2,
+	AVX512,
+	Count
+};
+
+// the highest level this CPU and OS support, detected once
+CpuLevel cpuLevel();
+const char* cpuLevelName(CpuLevel level);
+
+#endif // !CPU_FEATURES_H
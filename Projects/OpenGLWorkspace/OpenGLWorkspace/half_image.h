@@ -0,0 +1,25 @@
+#pragma once
+#ifndef HALF_IMAGE_H
+#define HALF_IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// RGBA half-float pixels, ready for a GL_RGBA16F texture
+struct HalfImage
+{
+	int width = 0;
+	int height = 0;
+	std::vector<uint16_t> pixels;
+};
+
+// IEEE binary16 with round-to-nearest-even through packHalfArray (pack_array.h);
+// glm's packHalf, which rounds ties away from zero, on other architectures
+void floatToHalf(const float* src, uint16_t* dst, size_t count);
+
+// decode .hdr as is, or an 8-bit image converted to linear (stbi_ldr_to_hdr_gamma),
+// then convert to half floats; honors stbi_set_flip_vertically_on_load
+bool loadHalfImage(const unsigned char* data, size_t size, HalfImage& image);
+
+#endif // !HALF_IMAGE_H
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef MESH_H
+#define MESH_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class AssetFS;
+
+// same 8-float interleaved layout as the hard-coded vertex arrays, with a normal
+// where they have a color
+struct MeshVertex
+{
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+// indexed triangle list
+struct Mesh
+{
+	std::vector<MeshVertex> vertices;
+	std::vector<unsigned int> indices;
+};
+
+// Wavefront OBJ: v, vt, vn and f (polygons are fanned into triangles, negative
+// indices count back from the end). Faces without normals get smooth ones.
+// Identical vertices are merged, so the result is indexed but not optimized;
+// run optimizeMesh on it before uploading.
+bool loadObj(const char* text, size_t size, Mesh& mesh);
+bool loadObj(const AssetFS& assets, const std::string& path, Mesh& mesh);
+
+// writes 'mesh' back out as OBJ with one v/vt/vn per vertex, in vertex order
+bool writeObj(const std::string& path, const Mesh& mesh);
+
+#endif // !MESH_H
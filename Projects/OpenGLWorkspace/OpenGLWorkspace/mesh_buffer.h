@@ -0,0 +1,122 @@
+#pragma once
+#ifndef MESH_BUFFER_H
+#define MESH_BUFFER_H
+
+#include <glad/glad.h>	// for the OpenGL headers
+
+#include <cstddef>
+#include <vector>
+
+#include "vertex_format.h"
+
+// the GL entry points MeshBuffer calls; current() picks up the ones glad loaded
+struct MeshBufferGL
+{
+	PFNGLGENVERTEXARRAYSPROC GenVertexArrays;
+	PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays;
+	PFNGLBINDVERTEXARRAYPROC BindVertexArray;
+	PFNGLGENBUFFERSPROC GenBuffers;
+	PFNGLDELETEBUFFERSPROC DeleteBuffers;
+	PFNGLBINDBUFFERPROC BindBuffer;
+	PFNGLBUFFERDATAPROC BufferData;
+	PFNGLDRAWELEMENTSPROC DrawElements;
+	PFNGLDRAWELEMENTSINSTANCEDPROC DrawElementsInstanced;
+	PFNGLMULTIDRAWELEMENTSPROC MultiDrawElements;
+	PFNGLENABLEPROC Enable;
+	PFNGLDISABLEPROC Disable;
+	PFNGLPRIMITIVERESTARTINDEXPROC PrimitiveRestartIndex;
+	VertexLayoutGL layout;
+
+	static MeshBufferGL current();
+};
+
+// smallest of GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT and GL_UNSIGNED_INT that can
+// index 'vertexCount' vertices; with 'restart' the largest value of the type
+// is kept free for the restart index
+GLenum indexType(size_t vertexCount, bool restart);
+size_t indexSize(GLenum type);
+// the restart index for 'type': all bits set, as GL_PRIMITIVE_RESTART_FIXED_INDEX uses
+unsigned int restartIndex(GLenum type);
+
+// triangle list to triangle strips with the same winding, separated by 'restart';
+// strips follow the list's triangle order, so cache-optimized input stays cache friendly
+void stripify(const std::vector<unsigned int>& indices, unsigned int restart, std::vector<unsigned int>& strips);
+
+// glMultiDrawElementsIndirect's command layout, so a list can go straight into
+// a GL_DRAW_INDIRECT_BUFFER on 4.3
+struct DrawElementsIndirectCommand
+{
+	GLuint count;
+	GLuint instanceCount;
+	GLuint firstIndex;
+	GLint baseVertex;
+	GLuint baseInstance;
+};
+
+// one mesh going into a MeshBuffer: vertices packed with the buffer's layout
+// and a triangle list indexing them
+struct MeshBufferPart
+{
+	const unsigned char* vertices;
+	size_t vertexCount;
+	const unsigned int* indices;
+	size_t indexCount;
+};
+
+struct MeshBufferStats
+{
+	unsigned long draws = 0;
+	unsigned long long indices = 0;		// indices the GPU fetched
+	unsigned long long indexBytes = 0;	// and their size
+};
+
+// one vertex array with a vertex and an index buffer holding one or more meshes
+// that share a vertex layout, drawn with a single glDrawElements. Indices are
+// as narrow as the vertex count allows, and the parts are stored as strips
+// joined by primitive restart when that takes fewer indices than a list
+class MeshBuffer
+{
+public:
+	explicit MeshBuffer(const MeshBufferGL& gl = MeshBufferGL::current());
+	~MeshBuffer();
+
+	MeshBuffer(const MeshBuffer&) = delete;
+	MeshBuffer& operator=(const MeshBuffer&) = delete;
+
+	// replaces whatever the buffer held; 'allowStrips' false always keeps a triangle list
+	void upload(const VertexLayout& layout, const MeshBufferPart* parts, size_t partCount, bool allowStrips = true);
+	void upload(const VertexLayout& layout, const std::vector<unsigned char>& vertices, const std::vector<unsigned int>& indices,
+		bool allowStrips = true);
+
+	// binds the vertex array and draws everything
+	void draw();
+	// draws 'count' indices from 'firstIndex', 'instances' times; only for buffers
+	// uploaded without strips, e.g. one level of a LodChain
+	void drawRange(unsigned int firstIndex, GLsizei count, GLsizei instances = 1);
+	// draws a list of ranges, e.g. the visible meshlets, in one glMultiDrawElements;
+	// 3.3 has no indirect draws, so baseVertex and baseInstance must be 0 and
+	// instanceCount 1, and commands that break that are skipped
+	void drawCommands(const DrawElementsIndirectCommand* commands, size_t commandCount);
+
+	GLenum mode() const { return primitive; }
+	GLenum type() const { return elementType; }
+	GLsizei count() const { return elementCount; }
+	size_t vertexCount() const { return vertices; }
+
+	// counts what draw() fetched since the last resetStats()
+	const MeshBufferStats& stats() const { return counters; }
+	void resetStats() { counters = MeshBufferStats(); }
+
+private:
+	MeshBufferGL gl;
+	GLuint vao, vbo, ebo;
+	GLenum primitive;
+	GLenum elementType;
+	GLsizei elementCount;
+	size_t vertices;
+	MeshBufferStats counters;
+	std::vector<GLsizei> multiCounts;		// drawCommands' scratch, kept between frames
+	std::vector<const void*> multiOffsets;
+};
+
+#endif // !MESH_BUFFER_H
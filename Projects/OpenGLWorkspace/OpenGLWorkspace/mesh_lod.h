@@ -0,0 +1,71 @@
+#pragma once
+#ifndef MESH_LOD_H
+#define MESH_LOD_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+
+// simplifies a triangle list by collapsing edges in order of quadric error
+// (Garland & Heckbert 1997) until it's down to 'targetIndexCount' indices or
+// the next collapse would move the surface by more than 'targetError'.
+// Vertices only ever collapse onto other vertices, so the result indexes the
+// same vertex buffer. Vertices on UV/normal seams or open borders don't move.
+// Returns the error reached, as a distance in mesh units
+float simplifyMesh(const std::vector<MeshVertex>& vertices, const std::vector<unsigned int>& indices,
+	size_t targetIndexCount, float targetError, std::vector<unsigned int>& simplified);
+
+struct MeshLodLevel
+{
+	unsigned int firstIndex;
+	unsigned int indexCount;
+	float error;	// distance in mesh units this level may be off from the full mesh
+};
+
+struct LodChainSettings
+{
+	float reduction = 0.5f;			// each level aims for this fraction of the previous one's triangles
+	float maxError = 0.05f;			// relative to the mesh's bounding radius; coarser levels aren't built
+	unsigned int maxLevels = 8;
+	unsigned int minTriangles = 32;
+};
+
+// every level of a mesh, back to back in one index list over one vertex buffer
+struct LodChain
+{
+	std::vector<unsigned int> indices;
+	std::vector<MeshLodLevel> levels;	// finest first; levels[0] is the full mesh
+	glm::vec3 center = glm::vec3(0.0f);	// bounding sphere, in mesh space
+	float radius = 0.0f;
+};
+
+// builds the chain from a mesh that's already been through optimizeMesh; the
+// coarser levels are optimized for the vertex cache, and the mesh's vertices
+// are reordered for fetch across all levels
+void buildLodChain(Mesh& mesh, LodChain& chain, const LodChainSettings& settings = LodChainSettings());
+
+struct LodSelectSettings
+{
+	float pixelError = 1.0f;			// largest error on screen a level may show, in pixels
+	unsigned long triangleBudget = 0;	// most triangles for all instances together; 0 for no limit
+};
+
+// instances grouped by the level they draw with, one instanced draw each
+struct LodSelection
+{
+	std::vector<std::vector<unsigned int>> instances;	// per level, indices into the model matrices
+	unsigned long triangles = 0;
+};
+
+// picks the coarsest level of 'chain' whose error stays under the pixel error
+// for every instance, from its projected size with 'view' and a perspective
+// 'projection'. Over the triangle budget, the instances smallest on screen go
+// coarser first
+void selectLods(const LodChain& chain, const glm::mat4* models, size_t instanceCount, const glm::mat4& view,
+	const glm::mat4& projection, float viewportHeight, LodSelection& selection,
+	const LodSelectSettings& settings = LodSelectSettings());
+
+#endif // !MESH_LOD_H
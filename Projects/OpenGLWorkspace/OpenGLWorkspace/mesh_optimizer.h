@@ -0,0 +1,47 @@
+#pragma once
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "mesh.h"
+
+// post-transform cache size the optimizer aims for and the analysis simulates;
+// a FIFO of 16 is a fair stand-in for current hardware
+const unsigned int meshCacheSize = 16;
+
+struct VertexCacheStats
+{
+	float acmr = 0.0f;	// transformed vertices per triangle: 0.5 is ideal for big grids, 3 is no reuse at all
+	float atvr = 0.0f;	// transformed vertices per vertex: 1 is ideal
+};
+
+// turns a triangle soup (three corners per triangle) into an indexed mesh,
+// merging equal vertices through a hash map; first use keeps its place
+void deduplicateVertices(const std::vector<MeshVertex>& corners, Mesh& mesh);
+
+// reorders triangles for the post-transform vertex cache (Tipsify, Sander et al. 2007);
+// linear time, so it's fine to run at load time and not only in the tools
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+	unsigned int cacheSize = meshCacheSize);
+
+// reorders the clusters of a cache-optimized index list so outward-facing ones
+// at the outside of the mesh draw first, which cuts overdraw from most angles.
+// Clusters are split further while that keeps ACMR within 'threshold' times the
+// cache-optimized value, so 1.05 gives up about 5% of vertex reuse for less overdraw
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<MeshVertex>& vertices,
+	float threshold = 1.05f, unsigned int cacheSize = meshCacheSize);
+
+// reorders vertices into the order the index list first uses them, so fetches
+// walk the vertex buffer forwards; drops unreferenced vertices and returns the new count
+size_t optimizeVertexFetch(Mesh& mesh);
+
+// simulates a FIFO cache of 'cacheSize' vertices over the index list
+VertexCacheStats analyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount,
+	unsigned int cacheSize = meshCacheSize);
+
+// cache, then overdraw, then fetch order
+void optimizeMesh(Mesh& mesh, float overdrawThreshold = 1.05f);
+
+#endif // !MESH_OPTIMIZER_H
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef MESHLET_H
+#define MESHLET_H
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+#include "mesh_buffer.h"
+
+// limits that fit NVIDIA's mesh shader sweet spot and keep the triangle list
+// 4-byte aligned; anything up to 255 works
+const unsigned int meshletMaxVertices = 64;
+const unsigned int meshletMaxTriangles = 124;
+
+struct Meshlet
+{
+	unsigned int vertexOffset;		// into MeshletMesh::vertices
+	unsigned int triangleOffset;	// into MeshletMesh::triangles, in triangles
+	unsigned int vertexCount;
+	unsigned int triangleCount;
+};
+
+// everything the culling pass needs, in mesh space
+struct MeshletBounds
+{
+	glm::vec3 center;
+	float radius;
+	// the meshlet faces away from every camera position p with
+	// dot(normalize(coneApex - p), coneAxis) >= coneCutoff; a cutoff above 1 never culls
+	glm::vec3 coneApex;
+	glm::vec3 coneAxis;
+	float coneCutoff;
+};
+
+struct MeshletMesh
+{
+	std::vector<Meshlet> meshlets;
+	std::vector<MeshletBounds> bounds;
+	std::vector<unsigned int> vertices;		// per meshlet, the mesh vertices it uses
+	std::vector<unsigned char> triangles;	// per meshlet, three indices into its vertices each
+};
+
+// splits a triangle list into meshlets in list order, so run optimizeVertexCache
+// on it first: cache order keeps neighbors together and the meshlets compact
+void buildMeshlets(const Mesh& mesh, MeshletMesh& meshlets,
+	unsigned int maxVertices = meshletMaxVertices, unsigned int maxTriangles = meshletMaxTriangles);
+
+// the meshlets' triangles as one index list over the mesh's vertices, meshlet
+// by meshlet, so meshlet i is 3 * triangleOffset indices in
+void meshletIndices(const MeshletMesh& meshlets, std::vector<unsigned int>& indices);
+
+struct MeshletCullSettings
+{
+	int threads = 0;	// 0 for one per core; small meshes use one anyway
+	bool simd = true;	// false for the scalar reference path
+	bool avx = true;	// false keeps to SSE on CPUs with AVX
+};
+
+// frustum and backface culling of meshlets, 4 (SSE) or 8 (AVX) at a time over
+// a structure-of-arrays copy of the bounds
+class MeshletCuller
+{
+public:
+	explicit MeshletCuller(const MeshletMesh& meshlets);
+
+	// marks each meshlet visible (1) or culled (0) for a camera whose
+	// model-view-projection is 'modelViewProjection' and whose position in mesh
+	// space is 'camera'; returns how many are visible
+	size_t cull(const glm::mat4& modelViewProjection, const glm::vec3& camera, std::vector<unsigned char>& visible,
+		const MeshletCullSettings& settings = MeshletCullSettings()) const;
+
+	size_t size() const { return count; }
+
+private:
+	size_t count;
+	// padded to a multiple of 8 with meshlets that always fail the frustum test
+	std::vector<float> centerX, centerY, centerZ, radius;
+	std::vector<float> apexX, apexY, apexZ, axisX, axisY, axisZ, cutoff;
+};
+
+// draw commands for the visible meshlets, with runs of neighbors merged into
+// one command; firstIndex is into meshletIndices' list
+void buildMeshletDraws(const MeshletMesh& meshlets, const std::vector<unsigned char>& visible,
+	std::vector<DrawElementsIndirectCommand>& commands);
+
+#endif // !MESHLET_H
@@ -0,0 +1,33 @@
+#pragma once
+#ifndef MIP_GENERATOR_H
+#define MIP_GENERATOR_H
+
+#include <vector>
+
+enum class MipFilter
+{
+	Box,		// area average; soft, never rings
+	Kaiser,		// windowed sinc, 3 texels wide; sharper, slight ringing
+	Lanczos		// Lanczos-3; sharpest
+};
+
+struct MipSettings
+{
+	MipFilter filter = MipFilter::Kaiser;
+	// color is stored as sRGB and averaged in linear light; alpha is always linear
+	bool srgb = true;
+	// above 0, alpha on every level is scaled so the share of texels with alpha >= this
+	// stays what it is on level 0, which keeps alpha-tested foliage from thinning out
+	float alphaCoverage = 0.0f;
+	// 0 uses every hardware thread; small levels always run on the calling thread
+	int threads = 0;
+};
+
+// full mip chain for an RGBA8 image, down to 1x1: 'chain' gets every level back
+// to back, largest first, starting with an unchanged copy of 'pixels'.
+// Returns the number of levels. Levels are filtered from the previous one in
+// float, so rounding doesn't build up down the chain
+int generateMips(const unsigned char* pixels, int width, int height, const MipSettings& settings,
+	std::vector<unsigned char>& chain);
+
+#endif // !MIP_GENERATOR_H
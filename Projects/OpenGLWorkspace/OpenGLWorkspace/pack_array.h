@@ -0,0 +1,59 @@
+#pragma once
+#ifndef PACK_ARRAY_H
+#define PACK_ARRAY_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "cpu_features.h"
+
+// glm's vertex packing functions over whole arrays, for cooking meshes: 4
+// (SSE2) or 8 (AVX2, which also means F16C) values per step instead of one glm
+// call each, with the kernel picked per call from the CPU's level
+// (cpu_dispatch.h). Every level gives glm's bits, with one exception: the SIMD
+// half conversions round ties to even, as F16C and GPUs do, where
+// glm::packHalf1x16 rounds them away from zero. On one core of an AVX-512
+// server CPU, 64k values in L2 (Tools/pack_array):
+//
+//                          scalar   SSE2    AVX2
+//   packHalfArray           ~90M    ~950M   ~10G    floats/s
+//   unpackHalfArray         ~500M   ~1.2G   ~6.4G   floats/s
+//   packSnorm3x10Array      ~35M    ~450M   ~700M   vectors/s
+//   unpackSnorm3x10Array    ~90M    ~900M   ~1.2G   vectors/s
+//   packUnorm4x8Array       ~22M    ~530M   ~950M   vectors/s
+//   unpackUnorm4x8Array     ~320M   ~1.5G   ~1.5G   vectors/s
+//
+// The SSE2 half unpacking multiplies denormal floats for subnormal halves,
+// which is slow on most CPUs; its figure is for the tool's input, where one
+// half in 32 is subnormal
+
+struct PackSettings
+{
+	// the highest instruction set the kernels may use; Scalar runs glm itself
+	CpuLevel level = CpuLevel::AVX512;
+};
+
+// dst[i] = glm::packHalf1x16(src[i]), ties rounded to even from SSE2 up
+void packHalfArray(const float* src, uint16_t* dst, size_t count, const PackSettings& settings = PackSettings());
+
+// dst[i] = glm::unpackHalf1x16(src[i]); exact at every level
+void unpackHalfArray(const uint16_t* src, float* dst, size_t count, const PackSettings& settings = PackSettings());
+
+// dst[i] = glm::packSnorm3x10_1x2(src[i]), GL_INT_2_10_10_10_REV normalized
+void packSnorm3x10Array(const glm::vec4* src, uint32_t* dst, size_t count, const PackSettings& settings = PackSettings());
+
+// dst[i] = glm::unpackSnorm3x10_1x2(src[i])
+void unpackSnorm3x10Array(const uint32_t* src, glm::vec4* dst, size_t count, const PackSettings& settings = PackSettings());
+
+// dst[i] = glm::packUnorm4x8(src[i]), GL_UNSIGNED_BYTE normalized
+void packUnorm4x8Array(const glm::vec4* src, uint32_t* dst, size_t count, const PackSettings& settings = PackSettings());
+
+// dst[i] = glm::unpackUnorm4x8(src[i])
+void unpackUnorm4x8Array(const uint32_t* src, glm::vec4* dst, size_t count, const PackSettings& settings = PackSettings());
+
+// the instruction set the kernels run with on this CPU, capped at 'limit'
+CpuLevel packArrayLevel(CpuLevel limit = CpuLevel::AVX512);
+
+#endif // !PACK_ARRAY_H
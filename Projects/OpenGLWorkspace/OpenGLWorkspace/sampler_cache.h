@@ -0,0 +1,85 @@
+#pragma once
+#ifndef SAMPLER_CACHE_H
+#define SAMPLER_CACHE_H
+
+#include <glad/glad.h>	// for the OpenGL headers
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// the GL entry points the cache calls; current() picks up the ones glad loaded
+struct SamplerGL
+{
+	PFNGLGENSAMPLERSPROC GenSamplers;
+	PFNGLDELETESAMPLERSPROC DeleteSamplers;
+	PFNGLBINDSAMPLERPROC BindSampler;
+	PFNGLSAMPLERPARAMETERIPROC SamplerParameteri;
+	PFNGLSAMPLERPARAMETERFPROC SamplerParameterf;
+	PFNGLSAMPLERPARAMETERFVPROC SamplerParameterfv;
+	PFNGLGETFLOATVPROC GetFloatv;
+	PFNGLGETERRORPROC GetError;
+
+	static SamplerGL current();
+};
+
+// everything a sampler object holds; equal descriptors share one sampler
+struct SamplerDesc
+{
+	GLint wrapS = GL_REPEAT;
+	GLint wrapT = GL_REPEAT;
+	GLint wrapR = GL_REPEAT;
+	GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+	GLint magFilter = GL_LINEAR;
+	float maxAnisotropy = 1.0f;	// clamped to what the driver allows; 1 turns it off
+	float lodBias = 0.0f;
+	float borderColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+	bool operator==(const SamplerDesc& other) const;
+	bool operator!=(const SamplerDesc& other) const { return !(*this == other); }
+};
+
+struct SamplerDescHash
+{
+	size_t operator()(const SamplerDesc& desc) const;
+};
+
+struct SamplerCacheStats
+{
+	unsigned long created = 0;		// sampler objects made
+	unsigned long lookups = 0;		// get() calls
+	unsigned long binds = 0;		// glBindSampler calls made
+	unsigned long skippedBinds = 0;	// bind() calls where the unit already had that sampler
+};
+
+// one GL sampler object per distinct SamplerDesc, plus the sampler bound to each
+// texture unit so rebinding the same one costs nothing
+class SamplerCache
+{
+public:
+	explicit SamplerCache(const SamplerGL& gl = SamplerGL::current());
+	~SamplerCache();
+
+	SamplerCache(const SamplerCache&) = delete;
+	SamplerCache& operator=(const SamplerCache&) = delete;
+
+	// sampler object for 'desc', created on first use
+	GLuint get(const SamplerDesc& desc);
+	// bind the sampler for 'desc' to texture unit 'unit' (0 for GL_TEXTURE0) unless it's already there
+	void bind(GLuint unit, const SamplerDesc& desc);
+	void bind(GLuint unit, GLuint sampler);
+	// forget what's bound, after something outside the cache called glBindSampler
+	void invalidateBindings();
+
+	size_t size() const { return samplers.size(); }
+	const SamplerCacheStats& stats() const { return counters; }
+
+private:
+	SamplerGL gl;
+	std::unordered_map<SamplerDesc, GLuint, SamplerDescHash> samplers;
+	std::vector<GLuint> bound;	// per texture unit
+	float maxAnisotropy;		// 0 until queried
+	SamplerCacheStats counters;
+};
+
+#endif // !SAMPLER_CACHE_H
@@ -9,6 +9,10 @@
 #include <sstream>
 #include <iostream>
 
+#include <glm/glm.hpp>
+
+#include "asset_pack.h"
+
 class Shader
 {
 public:
@@ -17,12 +21,18 @@ public:
 
 	// constructor reads and builds the shader
 	Shader(const GLchar* vertexPath, const GLchar* fragmentPath);
+	// same, with the sources looked up in an asset pack (or loose files, if the AssetFS allows them)
+	Shader(const AssetFS& assets, const GLchar* vertexPath, const GLchar* fragmentPath);
 	// use/activate the shader
 	void use();
 	// utility uniform functions
 	void setBool(const std::string &name, bool value) const;
 	void setInt(const std::string &name, int value) const;
 	void setFloat(const std::string &name, float value) const;
+	void setMat4(const std::string &name, const glm::mat4 &value) const;
+
+private:
+	void compile(const char* vShaderCode, const char* fShaderCode);
 };
 
 
@@ -0,0 +1,149 @@
+#pragma once
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <glad/glad.h>	// for the OpenGL headers
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// the GL entry points the cache calls; current() picks up the ones glad loaded,
+// tests can fill in stubs instead and drive the cache without a GPU
+struct TextureGL
+{
+	PFNGLGENTEXTURESPROC GenTextures;
+	PFNGLDELETETEXTURESPROC DeleteTextures;
+	PFNGLBINDTEXTUREPROC BindTexture;
+	PFNGLGETINTEGERVPROC GetIntegerv;
+	PFNGLTEXIMAGE2DPROC TexImage2D;
+	PFNGLTEXPARAMETERIPROC TexParameteri;
+	PFNGLGENERATEMIPMAPPROC GenerateMipmap;
+
+	static TextureGL current();
+};
+
+// RGBA pixels, as returned by a TextureLoader
+struct TextureImage
+{
+	int width = 0;
+	int height = 0;
+	// GL_RGBA8 with unsigned bytes, or GL_RGBA16F with half floats
+	GLenum internalFormat = GL_RGBA8;
+	// mip levels in 'pixels', back to back and largest first; short of a full
+	// chain only the first level is used and the cache generates the rest
+	int levels = 1;
+	unsigned char* pixels = nullptr;
+	void* handle = nullptr;	// whatever the loader needs to release the pixels
+};
+
+class AssetFS;
+class AssetCache;
+
+// reads a texture file; the default uses stb_image
+struct TextureLoader
+{
+	bool (*load)(void* user, const std::string& path, TextureImage& image);
+	void (*release)(void* user, TextureImage& image);
+	void* user;
+
+	static TextureLoader stbImage();
+	// decodes straight out of an asset pack; 'assets' has to outlive the cache
+	static TextureLoader stbImage(const AssetFS& assets);
+	// cooked textures with their mip chains, decoded only when 'cache' doesn't have them yet
+	static TextureLoader cooked(AssetCache& cache);
+	// GL_RGBA16F textures from .hdr files, or linearized 8-bit images
+	static TextureLoader hdr(const AssetFS& assets);
+};
+
+// sampling state applied whenever a texture is (re)uploaded
+struct TextureParams
+{
+	GLint wrapS = GL_REPEAT;
+	GLint wrapT = GL_REPEAT;
+	GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+	GLint magFilter = GL_LINEAR;
+};
+
+struct TextureCacheStats
+{
+	unsigned long hits = 0;			// resident at full resolution
+	unsigned long misses = 0;		// not resident, loaded from file
+	unsigned long restreams = 0;	// resident with dropped mips, reloaded at full resolution
+	unsigned long evictions = 0;	// deleted to get under budget
+	unsigned long mipDrops = 0;		// top mip levels released to get under budget
+	unsigned long loadFailures = 0;
+	size_t residentBytes = 0;
+	size_t peakBytes = 0;
+};
+
+class TextureCache
+{
+public:
+	enum class Policy
+	{
+		Evict,		// delete least-recently-used textures
+		DropMips	// drop top mip levels of least-recently-used textures first, then delete
+	};
+
+	TextureCache(size_t budgetBytes, Policy policy = Policy::DropMips,
+		const TextureGL& gl = TextureGL::current(), const TextureLoader& loader = TextureLoader::stbImage());
+	~TextureCache();
+
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	// texture name for 'path' at full resolution, loading it if needed; 0 if it can't be loaded
+	GLuint acquire(const std::string& path, const TextureParams& params = TextureParams());
+	// textures acquired since the last beginFrame are never evicted or trimmed
+	void beginFrame();
+	// delete one texture, or all of them
+	void release(const std::string& path);
+	void clear();
+
+	void setBudget(size_t budgetBytes);
+	size_t budget() const { return budgetBytes; }
+	bool isResident(const std::string& path) const { return entries.count(path) != 0; }
+	// number of top mip levels currently dropped from 'path', 0 if not resident
+	int droppedLevels(const std::string& path) const;
+	const TextureCacheStats& stats() const { return counters; }
+
+	// GPU bytes of a width x height texture from mip 'baseLevel' down, with or without mips
+	static size_t textureBytes(int width, int height, bool mipmapped, int baseLevel = 0, GLenum internalFormat = GL_RGBA8);
+	// don't drop a mip level if that would leave the largest side below this
+	static const int minTrimmedSize = 32;
+
+private:
+	struct Entry
+	{
+		std::string path;
+		GLuint id;
+		int width, height;
+		int levels;			// 1 without mips
+		int baseLevel;		// levels dropped from the top
+		GLenum internalFormat;
+		size_t bytes;
+		unsigned long lastFrame;
+		TextureParams params;
+	};
+	typedef std::list<Entry> EntryList;
+
+	bool upload(Entry& entry);
+	void enforceBudget(size_t incoming);
+	// release the largest resident mip level, or with checkOnly just say whether it could
+	bool dropTopLevel(Entry& entry, bool checkOnly = false);
+	void erase(EntryList::iterator it);
+	void setBytes(Entry& entry, size_t bytes);
+
+	TextureGL gl;
+	TextureLoader loader;
+	Policy policy;
+	size_t budgetBytes;
+	unsigned long frame;
+	EntryList lru;	// most recently used first
+	std::unordered_map<std::string, EntryList::iterator> entries;
+	TextureCacheStats counters;
+};
+
+#endif // !TEXTURE_CACHE_H
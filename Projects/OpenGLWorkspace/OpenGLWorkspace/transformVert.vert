@@ -6,9 +6,12 @@ layout (location = 2) in vec2 aTexCoord;
 out vec3 ourColor;
 out vec2 TexCoord;
 
+// undoes vertex quantization; see VertexLayout::positionTransform
+uniform mat4 positionTransform;
+
 void main()
 {
-    gl_Position = vec4(aPos, 1.0);
+    gl_Position = positionTransform * vec4(aPos, 1.0);
     ourColor = aColor;
     TexCoord = aTexCoord;
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef VERTEX_FORMAT_H
+#define VERTEX_FORMAT_H
+
+#include <glad/glad.h>	// for the OpenGL headers
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh.h"
+
+// the GL entry points VertexLayout::apply calls; current() picks up the ones glad loaded
+struct VertexLayoutGL
+{
+	PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
+	PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
+
+	static VertexLayoutGL current();
+};
+
+// how one attribute is stored in the vertex buffer
+enum class AttributeFormat
+{
+	Float,		// GL_FLOAT, as the source
+	Half,		// GL_HALF_FLOAT
+	Int16,		// GL_SHORT, positions relative to the mesh bounds; not normalized, since
+				// GL 3.3 and 4.2 map signed normalized integers differently
+	Snorm10,	// GL_INT_2_10_10_10_REV normalized, unit vectors
+	Unorm8		// GL_UNSIGNED_BYTE normalized, colors in [0, 1]
+};
+
+// what an attribute holds; decides which formats it may be quantized to
+enum class AttributeKind
+{
+	Position,
+	Normal,
+	Color,
+	TexCoord
+};
+
+// one float attribute of the source vertices: 'components' floats at 'data',
+// 'stride' floats from one vertex to the next
+struct VertexSource
+{
+	AttributeKind kind;
+	GLuint location;	// layout (location = ...) in the vertex shader
+	int components;
+	const float* data;
+	size_t stride;
+};
+
+struct VertexAttribute
+{
+	GLuint location;
+	AttributeFormat format;
+	GLint components;	// as passed to glVertexAttribPointer, so 4 for Snorm10 and Unorm8
+	GLenum type;
+	GLboolean normalized;
+	GLuint offset;		// bytes from the start of the vertex; always a multiple of 4
+};
+
+// packed vertex layout, one attribute per VertexSource and in the same order
+struct VertexLayout
+{
+	std::vector<VertexAttribute> attributes;
+	GLsizei stride = 0;
+	// Int16 positions are stored as (position - offset) / scale; the vertex
+	// shader gets them back with positionTransform(), identity for other formats
+	glm::vec3 positionOffset = glm::vec3(0.0f);
+	glm::vec3 positionScale = glm::vec3(1.0f);
+
+	glm::mat4 positionTransform() const;
+	// glVertexAttribPointer and glEnableVertexAttribArray for every attribute,
+	// into the GL_ARRAY_BUFFER and vertex array that are bound
+	void apply(size_t bufferOffset = 0, const VertexLayoutGL& gl = VertexLayoutGL::current()) const;
+};
+
+struct VertexFormatSettings
+{
+	bool quantize = true;					// false keeps every attribute as float
+	float positionError = 1.0f / 4096.0f;	// largest position error allowed, relative to the mesh's largest extent
+	float texCoordError = 1.0f / 4096.0f;	// largest texture coordinate error allowed; a quarter texel at 1024
+};
+
+// smallest format for each source that stays within the settings' error bounds:
+// positions go to half, or int16 relative to the bounds when half isn't
+// precise enough; normals to 10_10_10_2; colors in [0, 1] to unorm8; texture
+// coordinates to half. Anything else stays float
+VertexLayout chooseVertexLayout(const VertexSource* sources, size_t sourceCount, size_t vertexCount,
+	const VertexFormatSettings& settings = VertexFormatSettings());
+
+// converts the sources to 'layout', which must have come from chooseVertexLayout with the same sources
+void packVertices(const VertexSource* sources, size_t sourceCount, size_t vertexCount, const VertexLayout& layout,
+	std::vector<unsigned char>& vertices);
+
+// both of the above for a Mesh: position at location 0, normal at 1, uv at 2
+VertexLayout packMesh(const Mesh& mesh, std::vector<unsigned char>& vertices,
+	const VertexFormatSettings& settings = VertexFormatSettings());
+
+#endif // !VERTEX_FORMAT_H
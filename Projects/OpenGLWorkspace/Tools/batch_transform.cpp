@@ -0,0 +1,250 @@
+// batch_transform - time the batch math kernels against each other
+//
+//   batch_transform [--points <count>] [--rounds <count>]
+//
+// Transforms a random point cloud, packed and as structure-of-arrays, and
+// multiplies arrays of matrices with the kernel for each instruction set level
+// the CPU has, then prints points or matrices per second. Every kernel has to
+// give the scalar one's results, exactly up to AVX and within a rounding for
+// the fused multiply-adds of AVX2 and AVX-512. The default 100k points stay in L2; a
+// few million show the memory bound instead.
+//
+// Then propagates a scene graph of one node per 16 points, every node a child
+// of an earlier one, as glm::mat4 and as Affine, and converts the Affine
+// results to mat4 as an upload would. Before that, the nodes' local matrices
+// are rebuilt from translation, rotation and scale the way a scene update
+// does, through glm::translate, rotate and scale and through glm::composeTRS.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../glm batch_transform.cpp ../OpenGLWorkspace/Affine.cpp
+//       ../OpenGLWorkspace/BatchMath.cpp ../OpenGLWorkspace/CpuFeatures.cpp -o batch_transform
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\glm batch_transform.cpp ..\OpenGLWorkspace\Affine.cpp
+//       ..\OpenGLWorkspace\BatchMath.cpp ..\OpenGLWorkspace\CpuFeatures.cpp
+
+#include "affine.h"
+#include "batch_math.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Data
+{
+	glm::mat4 matrix;
+	std::vector<glm::vec3> points;
+	std::vector<float> x, y, z;
+	std::vector<glm::mat4> a, b;
+};
+
+struct Results
+{
+	std::vector<glm::vec3> points;
+	std::vector<float> x, y, z;
+	std::vector<glm::mat4> matrices;
+};
+
+// the largest difference between two arrays, relative to the reference where that's above 1
+static float difference(const float* values, const float* reference, size_t count)
+{
+	float largest = 0.0f;
+	for (size_t i = 0; i < count; i++)
+		largest = std::max(largest, std::abs(values[i] - reference[i]) / std::max(1.0f, std::abs(reference[i])));
+	return largest;
+}
+
+// runs every kernel 'rounds' times with one path; false if any result differs from 'reference'
+static bool run(const char* name, const Data& data, int rounds, const BatchSettings& settings, Results& results,
+	const Results* reference)
+{
+	size_t count = data.points.size();
+	results.points.resize(count);
+	results.x.resize(count);
+	results.y.resize(count);
+	results.z.resize(count);
+	results.matrices.resize(data.a.size());
+
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		transformPoints(data.matrix, data.points.data(), results.points.data(), count, settings);
+	double packed = elapsed(start);
+
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		transformPoints(data.matrix, data.x.data(), data.y.data(), data.z.data(),
+			results.x.data(), results.y.data(), results.z.data(), count, settings);
+	double soa = elapsed(start);
+
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		mulMat4Batch(data.a.data(), data.b.data(), results.matrices.data(), data.a.size(), settings);
+	double matrices = elapsed(start);
+
+	// the fused multiply-adds of AVX2 and AVX-512 round once where the others round twice
+	bool same = true;
+	float error = 0.0f;
+	if (reference)
+	{
+		error = std::max(std::max(difference(&results.points[0].x, &reference->points[0].x, count * 3),
+			difference(&results.matrices[0][0][0], &reference->matrices[0][0][0], data.a.size() * 16)),
+			std::max(std::max(difference(results.x.data(), reference->x.data(), count),
+			difference(results.y.data(), reference->y.data(), count)), difference(results.z.data(), reference->z.data(), count)));
+		same = settings.level >= CpuLevel::AVX2 ? error <= 1e-4f : error == 0.0f;
+	}
+	std::printf("  %-8s %8.1f M points/s packed  %8.1f M points/s SoA  %8.1f M matrices/s  error %.1e%s\n", name,
+		count * rounds / (packed * 1e6), count * rounds / (soa * 1e6), data.a.size() * rounds / (matrices * 1e6), error,
+		same ? "" : "  MISMATCH");
+	return same;
+}
+
+// local matrices from each node's translation, rotation and scale, once through
+// the chain of glm builders and once composed directly; false if they differ by
+// more than roundings
+static bool runLocalTransforms(size_t count, int rounds)
+{
+	std::vector<glm::vec3> translations(count), axes(count), scales(count);
+	std::vector<float> angles(count);
+	std::mt19937 random(3);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	for (size_t i = 0; i < count; i++)
+	{
+		translations[i] = glm::vec3(unit(random), unit(random), unit(random)) * 100.0f;
+		axes[i] = glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + 0.01f);
+		angles[i] = unit(random) * 3.0f;
+		scales[i] = glm::vec3(1.0f + unit(random) * 0.5f);
+	}
+
+	std::vector<glm::mat4> chained(count);
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		for (size_t i = 0; i < count; i++)
+			chained[i] = glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), translations[i]), angles[i], axes[i]), scales[i]);
+	double chain = elapsed(start);
+
+	// an animated scene keeps its rotations as quaternions, so they aren't part of the timing
+	std::vector<glm::quat> orientations(count);
+	for (size_t i = 0; i < count; i++)
+		orientations[i] = glm::angleAxis(angles[i], axes[i]);
+	std::vector<glm::mat4> composed(count);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		for (size_t i = 0; i < count; i++)
+			composed[i] = glm::composeTRS(translations[i], orientations[i], scales[i]);
+	double compose = elapsed(start);
+
+	float error = difference(&composed[0][0][0], &chained[0][0][0], count * 16);
+	std::printf("  local transforms: %.1f M nodes/s translate/rotate/scale, %.1f M nodes/s composeTRS  error %.1e%s\n",
+		count * rounds / (chain * 1e6), count * rounds / (compose * 1e6), error, error <= 1e-4f ? "" : "  MISMATCH");
+	return error <= 1e-4f;
+}
+
+// world transforms for a scene graph whose node i hangs off a random earlier node;
+// false if the Affine results differ from the mat4 ones by more than roundings
+static bool runSceneGraph(const std::vector<glm::mat4>& locals, int rounds)
+{
+	size_t count = locals.size();
+	std::vector<int> parent(count);
+	std::mt19937 random(2);
+	for (size_t i = 0; i < count; i++)
+		parent[i] = i == 0 ? -1 : (int)(random() % i);
+
+	std::vector<glm::mat4> world(count);
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		for (size_t i = 0; i < count; i++)
+			world[i] = parent[i] < 0 ? locals[i] : world[parent[i]] * locals[i];
+	double matrices = elapsed(start);
+
+	std::vector<Affine> affineLocals(count), affineWorld(count);
+	for (size_t i = 0; i < count; i++)
+		affineLocals[i] = Affine(locals[i]);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		propagateAffine(affineLocals.data(), parent.data(), affineWorld.data(), count);
+	double affine = elapsed(start);
+
+	std::vector<glm::mat4> uploaded(count);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		affineToMat4(affineWorld.data(), uploaded.data(), count);
+	double upload = elapsed(start);
+
+	float error = difference(&uploaded[0][0][0], &world[0][0][0], count * 16);
+	std::printf("  scene graph: %.1f M nodes/s mat4, %.1f M nodes/s Affine, %.1f M/s Affine to mat4  error %.1e%s\n",
+		count * rounds / (matrices * 1e6), count * rounds / (affine * 1e6), count * rounds / (upload * 1e6), error,
+		error <= 1e-4f ? "" : "  MISMATCH");
+	return error <= 1e-4f;
+}
+
+int main(int argc, char** argv)
+{
+	int first = 1;
+	int count = 100000;
+	int rounds = 200;
+	while (argc > first + 1 && argv[first][0] == '-')
+	{
+		std::string option = argv[first];
+		if (option == "--points")
+			count = std::max(1, std::atoi(argv[first + 1]));
+		else if (option == "--rounds")
+			rounds = std::max(1, std::atoi(argv[first + 1]));
+		else
+			break;
+		first += 2;
+	}
+	if (argc != first)
+	{
+		std::cout << "usage: batch_transform [--points <count>] [--rounds <count>]" << std::endl;
+		return 1;
+	}
+
+	// an odd count exercises the scalar tail after the SIMD steps
+	Data data;
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+	data.matrix = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f) *
+		glm::lookAt(glm::vec3(50.0f, 20.0f, 80.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	for (int i = 0; i < count; i++)
+	{
+		glm::vec3 p(coordinate(random), coordinate(random), coordinate(random));
+		data.points.push_back(p);
+		data.x.push_back(p.x);
+		data.y.push_back(p.y);
+		data.z.push_back(p.z);
+	}
+	// one matrix per 16 points, about what a scene of small instanced meshes has
+	for (int i = 0; i < count / 16 + 1; i++)
+	{
+		glm::vec3 axis = glm::normalize(glm::vec3(coordinate(random), coordinate(random), coordinate(random)) + 0.01f);
+		data.a.push_back(glm::rotate(glm::translate(glm::mat4(1.0f), data.points[i]), coordinate(random), axis));
+		data.b.push_back(glm::scale(glm::mat4(1.0f), glm::vec3(1.0f + coordinate(random) * 0.01f)));
+	}
+	std::printf("%d points, %d matrices, %d rounds\n", count, (int)data.a.size(), rounds);
+
+	// every level this CPU runs that has kernels of its own
+	Results reference, results;
+	BatchSettings settings;
+	settings.level = CpuLevel::Scalar;
+	bool same = run(cpuLevelName(CpuLevel::Scalar), data, rounds, settings, reference, nullptr);
+	for (int level = (int)CpuLevel::SSE2; level <= (int)cpuLevel(); level++)
+	{
+		settings.level = (CpuLevel)level;
+		if (batchMathLevel(settings.level) == settings.level)
+			same = run(cpuLevelName(settings.level), data, rounds, settings, results, &reference) && same;
+	}
+	same = runLocalTransforms(data.a.size(), rounds) && same;
+	same = runSceneGraph(data.a, rounds) && same;
+	return same ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// cull_meshlets - split an OBJ mesh into meshlets and time the CPU culling pass
+//
+//   cull_meshlets [--views <count>] [--threads <count>] <input.obj>
+//
+// Builds meshlets from the mesh in vertex cache order, then culls them for
+// cameras orbiting the mesh, each looking at its center with a 60 degree
+// frustum, with the scalar, SSE and (where the CPU has it) AVX kernels. Every
+// kernel has to agree with the scalar one; the output is how many meshlets
+// each kernel gets through per second and how many draw commands the visible
+// ones make. Small meshes cull in microseconds, so tile the mesh (e.g. with
+// a modeling tool) for numbers that mean something; --threads only helps past
+// a few thousand meshlets.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../glm -I../../../glad/include cull_meshlets.cpp
+//       ../OpenGLWorkspace/Meshlet.cpp ../OpenGLWorkspace/Mesh.cpp ../OpenGLWorkspace/MeshOptimizer.cpp
+//       ../OpenGLWorkspace/AssetPack.cpp ../OpenGLWorkspace/CpuFeatures.cpp -o cull_meshlets -lpthread
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\glm /I..\..\..\glad\include cull_meshlets.cpp
+//       ..\OpenGLWorkspace\Meshlet.cpp ..\OpenGLWorkspace\Mesh.cpp ..\OpenGLWorkspace\MeshOptimizer.cpp
+//       ..\OpenGLWorkspace\AssetPack.cpp ..\OpenGLWorkspace\CpuFeatures.cpp
+
+#include "asset_pack.h"
+#include "cpu_features.h"
+#include "mesh.h"
+#include "mesh_optimizer.h"
+#include "meshlet.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Camera
+{
+	glm::mat4 viewProjection;
+	glm::vec3 position;
+};
+
+static double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// culls for every camera with one kernel; returns false if any result differs from 'reference'
+static bool run(const char* name, const MeshletCuller& culler, const std::vector<Camera>& cameras,
+	const MeshletCullSettings& settings, const std::vector<std::vector<unsigned char>>& reference)
+{
+	std::vector<unsigned char> visible;
+	size_t kept = 0;
+	bool same = true;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < cameras.size(); i++)
+	{
+		kept += culler.cull(cameras[i].viewProjection, cameras[i].position, visible, settings);
+		same = same && (reference.empty() || visible == reference[i]);
+	}
+	double milliseconds = elapsed(start);
+	std::printf("  %-8s %8.3f ms/view  %8.1f M meshlets/s  %5.1f%% visible%s\n", name, milliseconds / cameras.size(),
+		culler.size() * cameras.size() / (milliseconds * 1000.0), 100.0 * kept / (culler.size() * cameras.size()),
+		same ? "" : "  MISMATCH");
+	return same;
+}
+
+int main(int argc, char** argv)
+{
+	int first = 1;
+	int views = 256;
+	int threads = 1;
+	while (argc > first + 1 && argv[first][0] == '-')
+	{
+		std::string option = argv[first];
+		if (option == "--views")
+			views = std::max(1, std::atoi(argv[first + 1]));
+		else if (option == "--threads")
+			threads = std::max(0, std::atoi(argv[first + 1]));
+		else
+			break;
+		first += 2;
+	}
+	if (argc != first + 1)
+	{
+		std::cout << "usage: cull_meshlets [--views <count>] [--threads <count>] <input.obj>" << std::endl;
+		return 1;
+	}
+
+	AssetFS loose;
+	Mesh mesh;
+	if (!loadObj(loose, argv[first], mesh))
+		return 1;
+	optimizeVertexCache(mesh.indices, mesh.vertices.size());
+
+	MeshletMesh meshlets;
+	auto start = std::chrono::steady_clock::now();
+	buildMeshlets(mesh, meshlets);
+	double buildTime = elapsed(start);
+	size_t culledByCone = 0;
+	for (const MeshletBounds& bounds : meshlets.bounds)
+		culledByCone += bounds.coneCutoff <= 1.0f ? 1 : 0;
+	std::printf("%s: %u triangles in %u meshlets (%.1f triangles, %.1f vertices each), %u with a usable cone, built in %.1f ms\n",
+		argv[first], (unsigned int)(mesh.indices.size() / 3), (unsigned int)meshlets.meshlets.size(),
+		mesh.indices.size() / 3.0 / meshlets.meshlets.size(), (double)meshlets.vertices.size() / meshlets.meshlets.size(),
+		(unsigned int)culledByCone, buildTime);
+
+	// orbit at 1.5 times the bounding box's half diagonal, so parts of the mesh face away and the frustum clips the sides
+	glm::vec3 low(mesh.vertices[0].position[0], mesh.vertices[0].position[1], mesh.vertices[0].position[2]), high = low;
+	for (const MeshVertex& vertex : mesh.vertices)
+	{
+		glm::vec3 p(vertex.position[0], vertex.position[1], vertex.position[2]);
+		low = glm::min(low, p);
+		high = glm::max(high, p);
+	}
+	glm::vec3 center = (low + high) * 0.5f;
+	float radius = glm::length(high - low) * 0.5f;
+	std::vector<Camera> cameras(views);
+	for (int i = 0; i < views; i++)
+	{
+		float angle = 6.2831853f * i / views;
+		glm::vec3 offset(std::cos(angle), 0.35f * std::sin(angle * 3.0f), std::sin(angle));
+		cameras[i].position = center + glm::normalize(offset) * radius * 1.5f;
+		// aimed off center, so the near half of the mesh fills the view and the rest falls outside
+		glm::vec3 target = center + glm::vec3(-offset.z, 0.0f, offset.x) * radius * 0.5f;
+		cameras[i].viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, radius * 0.01f, radius * 10.0f) *
+			glm::lookAt(cameras[i].position, target, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+
+	MeshletCuller culler(meshlets);
+	MeshletCullSettings settings;
+	settings.threads = threads;
+
+	std::vector<std::vector<unsigned char>> reference(views);
+	settings.simd = false;
+	for (int i = 0; i < views; i++)
+		culler.cull(cameras[i].viewProjection, cameras[i].position, reference[i], settings);
+
+	bool same = run("scalar", culler, cameras, settings, reference);
+	settings.simd = true;
+	settings.avx = false;
+	same = run("SSE", culler, cameras, settings, reference) && same;
+	if (cpuHasAVX())
+	{
+		settings.avx = true;
+		same = run("AVX", culler, cameras, settings, reference) && same;
+	}
+
+	std::vector<DrawElementsIndirectCommand> commands;
+	size_t commandCount = 0;
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < views; i++)
+	{
+		buildMeshletDraws(meshlets, reference[i], commands);
+		commandCount += commands.size();
+	}
+	std::printf("  %.1f draw commands per view, built in %.3f ms\n", (double)commandCount / views, elapsed(start) / views);
+	return same ? 0 : 1;
+}
@@ -0,0 +1,449 @@
+// mesh_buffer - check stripify, the index widths and MeshBuffer::upload without a GPU
+//
+//   mesh_buffer
+//
+// Stripifies grids and meshes made of disjoint pieces, expands the strips back
+// into triangles (odd ones flipped, restarts split) and checks they are the
+// input triangles with the same winding. Checks indexType on both sides of
+// 256 and 65536 vertices, with and without a reserved restart index. Then
+// uploads meshes into a MeshBuffer with stub GL entry points and checks that
+// it picks strips exactly when they take fewer index bytes than the list,
+// that the element buffer holds the narrowed indices and still draws the
+// same triangles, and that draw() sets up primitive restart for strips only.
+// Prints each check and exits with the number that failed.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../glm -I../../../glad/include mesh_buffer.cpp
+//       ../OpenGLWorkspace/MeshBuffer.cpp ../OpenGLWorkspace/VertexFormat.cpp ../OpenGLWorkspace/PackArray.cpp
+//       ../OpenGLWorkspace/CpuFeatures.cpp -o mesh_buffer
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\glm /I..\..\..\glad\include mesh_buffer.cpp
+//       ..\OpenGLWorkspace\MeshBuffer.cpp ..\OpenGLWorkspace\VertexFormat.cpp ..\OpenGLWorkspace\PackArray.cpp
+//       ..\OpenGLWorkspace\CpuFeatures.cpp
+
+#include "mesh_buffer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// MeshBufferGL::current and VertexLayoutGL::current read these; glad isn't linked, the checks never call it
+PFNGLGENVERTEXARRAYSPROC glad_glGenVertexArrays;
+PFNGLDELETEVERTEXARRAYSPROC glad_glDeleteVertexArrays;
+PFNGLBINDVERTEXARRAYPROC glad_glBindVertexArray;
+PFNGLGENBUFFERSPROC glad_glGenBuffers;
+PFNGLDELETEBUFFERSPROC glad_glDeleteBuffers;
+PFNGLBINDBUFFERPROC glad_glBindBuffer;
+PFNGLBUFFERDATAPROC glad_glBufferData;
+PFNGLDRAWELEMENTSPROC glad_glDrawElements;
+PFNGLDRAWELEMENTSINSTANCEDPROC glad_glDrawElementsInstanced;
+PFNGLMULTIDRAWELEMENTSPROC glad_glMultiDrawElements;
+PFNGLENABLEPROC glad_glEnable;
+PFNGLDISABLEPROC glad_glDisable;
+PFNGLPRIMITIVERESTARTINDEXPROC glad_glPrimitiveRestartIndex;
+PFNGLVERTEXATTRIBPOINTERPROC glad_glVertexAttribPointer;
+PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray;
+
+// buffers and vertex arrays share one name space in the stub
+static std::map<GLuint, bool> stubAlive;
+static std::map<GLuint, std::vector<unsigned char>> stubBuffers;
+static GLuint stubNextName = 1;
+static GLuint stubArrayBuffer = 0;
+static GLuint stubElementBuffer = 0;
+static bool stubRestart = false;
+static GLuint stubRestartIndex = 0;
+static int stubPointers = 0;
+
+// the last glDrawElements as the stub saw it
+struct StubDraw
+{
+	GLenum mode;
+	GLsizei count;
+	GLenum type;
+	bool restart;
+	GLuint restartIndex;
+	std::vector<unsigned char> elements;	// the element buffer at the time
+};
+
+static StubDraw stubDraw;
+
+static void APIENTRY stubGen(GLsizei n, GLuint* names)
+{
+	for (GLsizei i = 0; i < n; i++)
+	{
+		names[i] = stubNextName++;
+		stubAlive[names[i]] = true;
+	}
+}
+
+static void APIENTRY stubDelete(GLsizei n, const GLuint* names)
+{
+	for (GLsizei i = 0; i < n; i++)
+		stubAlive[names[i]] = false;
+}
+
+static void APIENTRY stubBindVertexArray(GLuint)
+{
+}
+
+static void APIENTRY stubBindBuffer(GLenum target, GLuint buffer)
+{
+	(target == GL_ELEMENT_ARRAY_BUFFER ? stubElementBuffer : stubArrayBuffer) = buffer;
+}
+
+static void APIENTRY stubBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	stubBuffers[target == GL_ELEMENT_ARRAY_BUFFER ? stubElementBuffer : stubArrayBuffer].assign(bytes, bytes + size);
+}
+
+static void APIENTRY stubDrawElements(GLenum mode, GLsizei count, GLenum type, const void*)
+{
+	stubDraw.mode = mode;
+	stubDraw.count = count;
+	stubDraw.type = type;
+	stubDraw.restart = stubRestart;
+	stubDraw.restartIndex = stubRestartIndex;
+	stubDraw.elements = stubBuffers[stubElementBuffer];
+}
+
+static void APIENTRY stubDrawElementsInstanced(GLenum, GLsizei, GLenum, const void*, GLsizei)
+{
+}
+
+static void APIENTRY stubMultiDrawElements(GLenum, const GLsizei*, GLenum, const void* const*, GLsizei)
+{
+}
+
+static void APIENTRY stubEnable(GLenum cap)
+{
+	if (cap == GL_PRIMITIVE_RESTART)
+		stubRestart = true;
+}
+
+static void APIENTRY stubDisable(GLenum cap)
+{
+	if (cap == GL_PRIMITIVE_RESTART)
+		stubRestart = false;
+}
+
+static void APIENTRY stubPrimitiveRestartIndex(GLuint index)
+{
+	stubRestartIndex = index;
+}
+
+static void APIENTRY stubVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*)
+{
+	stubPointers++;
+}
+
+static void APIENTRY stubEnableVertexAttribArray(GLuint)
+{
+}
+
+static MeshBufferGL stubGL()
+{
+	MeshBufferGL gl;
+	gl.GenVertexArrays = stubGen;
+	gl.DeleteVertexArrays = stubDelete;
+	gl.BindVertexArray = stubBindVertexArray;
+	gl.GenBuffers = stubGen;
+	gl.DeleteBuffers = stubDelete;
+	gl.BindBuffer = stubBindBuffer;
+	gl.BufferData = stubBufferData;
+	gl.DrawElements = stubDrawElements;
+	gl.DrawElementsInstanced = stubDrawElementsInstanced;
+	gl.MultiDrawElements = stubMultiDrawElements;
+	gl.Enable = stubEnable;
+	gl.Disable = stubDisable;
+	gl.PrimitiveRestartIndex = stubPrimitiveRestartIndex;
+	gl.layout.VertexAttribPointer = stubVertexAttribPointer;
+	gl.layout.EnableVertexAttribArray = stubEnableVertexAttribArray;
+	return gl;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what)
+{
+	std::cout << (ok ? "  ok      " : "  FAILED  ") << what << std::endl;
+	if (!ok)
+		failures++;
+}
+
+typedef std::array<unsigned int, 3> Triangle;
+
+// rotated so the smallest index comes first, which keeps the winding
+static Triangle canonical(unsigned int a, unsigned int b, unsigned int c)
+{
+	if (b < a && b < c)
+		return Triangle{ { b, c, a } };
+	if (c < a && c < b)
+		return Triangle{ { c, a, b } };
+	return Triangle{ { a, b, c } };
+}
+
+static std::vector<Triangle> listTriangles(const std::vector<unsigned int>& indices)
+{
+	std::vector<Triangle> triangles;
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		triangles.push_back(canonical(indices[i], indices[i + 1], indices[i + 2]));
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+// what GL draws from 'strips': every odd triangle of a strip has its first two
+// vertices swapped, and 'restart' starts a new strip; degenerate triangles are counted, not kept
+static std::vector<Triangle> stripTriangles(const std::vector<unsigned int>& strips, unsigned int restart,
+	size_t& degenerate, size_t& stripCount)
+{
+	std::vector<Triangle> triangles;
+	degenerate = 0;
+	stripCount = 0;
+	for (size_t begin = 0; begin < strips.size();)
+	{
+		size_t end = begin;
+		while (end < strips.size() && strips[end] != restart)
+			end++;
+		stripCount++;
+		for (size_t i = begin; i + 2 < end; i++)
+		{
+			unsigned int a = strips[i], b = strips[i + 1], c = strips[i + 2];
+			if ((i - begin) % 2 == 1)
+				std::swap(a, b);
+			if (a == b || b == c || a == c)
+				degenerate++;
+			else
+				triangles.push_back(canonical(a, b, c));
+		}
+		begin = end + 1;
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+// width x height vertices, two counter-clockwise triangles per quad, row by row;
+// the diagonal runs from each quad's first vertex, or from its second with 'otherDiagonal'
+static std::vector<unsigned int> grid(unsigned int width, unsigned int height, bool otherDiagonal = false)
+{
+	std::vector<unsigned int> indices;
+	for (unsigned int y = 0; y + 1 < height; y++)
+		for (unsigned int x = 0; x + 1 < width; x++)
+		{
+			unsigned int i = y * width + x;
+			unsigned int quad[] = { i, i + 1, i + width + 1, i, i + width + 1, i + width };
+			unsigned int other[] = { i, i + 1, i + width, i + 1, i + width + 1, i + width };
+			indices.insert(indices.end(), otherDiagonal ? other : quad, (otherDiagonal ? other : quad) + 6);
+		}
+	return indices;
+}
+
+// separate triangles, separate quads, a closed fan and a quad wound the other way
+static std::vector<unsigned int> pieces()
+{
+	std::vector<unsigned int> indices;
+	unsigned int next = 0;
+	for (int i = 0; i < 5; i++, next += 3)
+	{
+		unsigned int triangle[] = { next, next + 1, next + 2 };
+		indices.insert(indices.end(), triangle, triangle + 3);
+	}
+	for (int i = 0; i < 4; i++, next += 4)
+	{
+		unsigned int quad[] = { next, next + 1, next + 2, next + 2, next + 1, next + 3 };
+		indices.insert(indices.end(), quad, quad + 6);
+	}
+	for (unsigned int k = 0; k < 8; k++)
+	{
+		unsigned int triangle[] = { next, next + 1 + k, next + 1 + (k + 1) % 8 };
+		indices.insert(indices.end(), triangle, triangle + 3);
+	}
+	next += 9;
+	unsigned int reversed[] = { next, next + 2, next + 1, next + 1, next + 2, next + 3 };
+	indices.insert(indices.end(), reversed, reversed + 6);
+	return indices;
+}
+
+static void checkStrips(const char* name, const std::vector<unsigned int>& list, size_t minStrips)
+{
+	const unsigned int restart = 0xffff;
+	std::vector<unsigned int> strips;
+	stripify(list, restart, strips);
+	size_t degenerate, stripCount;
+	std::vector<Triangle> triangles = stripTriangles(strips, restart, degenerate, stripCount);
+	std::ostringstream out;
+	out << name << ": " << list.size() << " list indices, " << strips.size() << " in " << stripCount << " strips";
+	check(triangles == listTriangles(list), out.str() + ", same triangles and windings");
+	check(degenerate == 0 && stripCount >= minStrips && strips.front() != restart && strips.back() != restart,
+		std::string(name) + ": no degenerate triangles, restarts only between strips");
+}
+
+static void checkStripify()
+{
+	std::cout << "stripify" << std::endl;
+	checkStrips("32x32 grid", grid(32, 32), 1);
+	checkStrips("32x32 grid, other diagonal", grid(32, 32, true), 1);
+	checkStrips("2x2 grid", grid(2, 2), 1);
+	checkStrips("pieces", pieces(), 5 + 4 + 1 + 1);
+
+	// the triangles of the strip 0 1 2 ... n as a list, in strip order
+	std::vector<unsigned int> ribbon;
+	for (unsigned int t = 0; t < 9; t++)
+	{
+		unsigned int triangle[] = { t, t + 1, t + 2 };
+		if (t % 2 == 1)
+			std::swap(triangle[0], triangle[1]);
+		ribbon.insert(ribbon.end(), triangle, triangle + 3);
+	}
+	std::vector<unsigned int> strips;
+	stripify(std::vector<unsigned int>(ribbon.begin(), ribbon.end() - 3), 0xff, strips);
+	bool whole = strips.size() == 10;
+	for (unsigned int i = 0; whole && i < 10; i++)
+		whole = strips[i] == i;
+	check(whole, "8 triangles that form a strip come back as that strip");
+	stripify(ribbon, 0xff, strips);
+	check(std::count(strips.begin(), strips.end(), 0xffu) == 1, "a 9th is past the window and starts another");
+
+	strips.assign(1, 7);
+	stripify(std::vector<unsigned int>(), 0xff, strips);
+	check(strips.empty(), "an empty list gives no strips");
+	std::vector<unsigned int> list = grid(32, 32);
+	stripify(list, 0xffff, strips);
+	check(strips.size() < list.size(), "a grid takes fewer indices as strips");
+}
+
+static void checkIndexType()
+{
+	std::cout << "index widths" << std::endl;
+	check(indexType(0, false) == GL_UNSIGNED_BYTE && indexType(255, false) == GL_UNSIGNED_BYTE &&
+		indexType(256, false) == GL_UNSIGNED_BYTE && indexType(257, false) == GL_UNSIGNED_SHORT, "byte up to 256 vertices");
+	check(indexType(255, true) == GL_UNSIGNED_BYTE && indexType(256, true) == GL_UNSIGNED_SHORT,
+		"255 with a restart index, which takes 0xff");
+	check(indexType(65535, false) == GL_UNSIGNED_SHORT && indexType(65536, false) == GL_UNSIGNED_SHORT &&
+		indexType(65537, false) == GL_UNSIGNED_INT, "short up to 65536");
+	check(indexType(65535, true) == GL_UNSIGNED_SHORT && indexType(65536, true) == GL_UNSIGNED_INT,
+		"65535 with a restart index");
+	check(restartIndex(GL_UNSIGNED_BYTE) == 0xffu && restartIndex(GL_UNSIGNED_SHORT) == 0xffffu &&
+		restartIndex(GL_UNSIGNED_INT) == 0xffffffffu, "restart indices are all ones");
+	check(indexSize(GL_UNSIGNED_BYTE) == 1 && indexSize(GL_UNSIGNED_SHORT) == 2 && indexSize(GL_UNSIGNED_INT) == 4,
+		"index sizes");
+}
+
+static std::vector<unsigned int> widen(const std::vector<unsigned char>& bytes, GLenum type)
+{
+	std::vector<unsigned int> indices(bytes.size() / indexSize(type));
+	for (size_t i = 0; i < indices.size(); i++)
+		if (type == GL_UNSIGNED_BYTE)
+			indices[i] = bytes[i];
+		else if (type == GL_UNSIGNED_SHORT)
+		{
+			uint16_t index;
+			std::memcpy(&index, &bytes[i * 2], 2);
+			indices[i] = index;
+		}
+		else
+			std::memcpy(&indices[i], &bytes[i * 4], 4);
+	return indices;
+}
+
+// uploads 'parts' (each of 'vertexCount' vertices and 'list' as indices) and
+// checks the choice against the index bytes of both forms, and what gets drawn
+static void checkUpload(const char* name, const std::vector<unsigned int>& list, size_t vertexCount, size_t partCount,
+	bool allowStrips, GLenum expectedMode, GLenum expectedType)
+{
+	VertexLayout layout;
+	VertexAttribute position = { 0, AttributeFormat::Float, 3, GL_FLOAT, GL_FALSE, 0 };
+	layout.attributes.push_back(position);
+	layout.stride = 12;
+	std::vector<unsigned char> vertices(vertexCount * layout.stride);
+	std::vector<MeshBufferPart> parts(partCount);
+	std::vector<unsigned int> merged;
+	for (size_t p = 0; p < partCount; p++)
+	{
+		parts[p].vertices = vertices.data();
+		parts[p].vertexCount = vertexCount;
+		parts[p].indices = list.data();
+		parts[p].indexCount = list.size();
+		for (unsigned int index : list)
+			merged.push_back(index + (unsigned int)(p * vertexCount));
+	}
+	size_t totalVertices = vertexCount * partCount;
+
+	// what the upload should weigh up
+	GLenum listType = indexType(totalVertices, false);
+	GLenum stripType = indexType(totalVertices, true);
+	std::vector<unsigned int> strips;
+	stripify(merged, restartIndex(stripType), strips);
+	size_t listBytes = merged.size() * indexSize(listType);
+	size_t stripBytes = strips.size() * indexSize(stripType);
+	bool stripsSmaller = stripBytes < listBytes;
+
+	int pointers = stubPointers;
+	MeshBuffer buffer(stubGL());
+	buffer.upload(layout, parts.data(), parts.size(), allowStrips);
+	buffer.draw();
+
+	std::ostringstream out;
+	out << name << ": list " << listBytes << " bytes, strips " << stripBytes << ", uploaded "
+		<< stubDraw.elements.size() << (buffer.mode() == GL_TRIANGLE_STRIP ? " as strips" : " as a list");
+	GLenum mode = allowStrips && stripsSmaller ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
+	check(buffer.mode() == mode && mode == expectedMode && buffer.type() == expectedType &&
+		buffer.type() == (mode == GL_TRIANGLE_STRIP ? stripType : listType), out.str());
+
+	std::vector<unsigned int> elements = widen(stubDraw.elements, stubDraw.type);
+	bool drawn = stubDraw.mode == buffer.mode() && stubDraw.type == buffer.type() && stubDraw.count == buffer.count() &&
+		elements.size() == (size_t)buffer.count() && buffer.vertexCount() == totalVertices && stubPointers == pointers + 1 &&
+		stubBuffers[stubArrayBuffer].size() == vertices.size() * partCount;
+	size_t degenerate = 0, stripCount = 0;
+	if (buffer.mode() == GL_TRIANGLE_STRIP)
+		drawn = drawn && stubDraw.restart && stubDraw.restartIndex == restartIndex(buffer.type()) &&
+			stripTriangles(elements, stubDraw.restartIndex, degenerate, stripCount) == listTriangles(merged);
+	else
+		drawn = drawn && !stubDraw.restart && listTriangles(elements) == listTriangles(merged);
+	check(drawn && !stubRestart, std::string(name) + ": the element buffer draws the parts' triangles");
+	check(buffer.stats().draws == 1 && buffer.stats().indexBytes == stubDraw.elements.size(),
+		std::string(name) + ": stats count the element bytes");
+}
+
+static std::vector<unsigned int> quad()
+{
+	unsigned int indices[] = { 0, 1, 2, 2, 1, 3 };
+	return std::vector<unsigned int>(indices, indices + 6);
+}
+
+static void checkUploads()
+{
+	std::cout << "upload" << std::endl;
+	checkUpload("8x8 grid", grid(8, 8), 64, 1, true, GL_TRIANGLE_STRIP, GL_UNSIGNED_BYTE);
+	checkUpload("8x8 grid, no strips", grid(8, 8), 64, 1, false, GL_TRIANGLES, GL_UNSIGNED_BYTE);
+	checkUpload("200x200 grid", grid(200, 200), 40000, 1, true, GL_TRIANGLE_STRIP, GL_UNSIGNED_SHORT);
+	checkUpload("300x300 grid", grid(300, 300), 90000, 1, true, GL_TRIANGLE_STRIP, GL_UNSIGNED_INT);
+	// a quad is 6 list indices or 4 strip indices and a restart
+	checkUpload("63 quads", quad(), 4, 63, true, GL_TRIANGLE_STRIP, GL_UNSIGNED_BYTE);
+	checkUpload("64 quads, 256 vertices", quad(), 4, 64, true, GL_TRIANGLES, GL_UNSIGNED_BYTE);
+	checkUpload("16383 quads", quad(), 4, 16383, true, GL_TRIANGLE_STRIP, GL_UNSIGNED_SHORT);
+	checkUpload("16384 quads, 65536 vertices", quad(), 4, 16384, true, GL_TRIANGLES, GL_UNSIGNED_SHORT);
+	// strips of one triangle take 4 indices each
+	std::vector<unsigned int> triangle(1, 0);
+	triangle.push_back(1);
+	triangle.push_back(2);
+	checkUpload("50 triangles", triangle, 3, 50, true, GL_TRIANGLES, GL_UNSIGNED_BYTE);
+}
+
+int main()
+{
+	checkStripify();
+	checkIndexType();
+	checkUploads();
+
+	size_t leaked = 0;
+	for (auto& name : stubAlive)
+		leaked += name.second;
+	check(leaked == 0, "every buffer and vertex array deleted with its MeshBuffer");
+	std::cout << (failures ? "FAILED" : "all passed") << std::endl;
+	return failures;
+}
@@ -0,0 +1,108 @@
+// optimize_mesh - index an OBJ mesh and reorder it for the vertex cache, overdraw and fetch
+//
+//   optimize_mesh [--overdraw <threshold>] [--lod] <input.obj> [output.obj]
+//
+// Prints vertex cache stats (ACMR and ATVR for a 16-entry FIFO) for the mesh as
+// it comes out of the loader and after each optimization pass. With an output
+// path the optimized mesh is written back as OBJ; loadObj keeps its order, so
+// the app gets the optimized mesh without running the passes again.
+//
+// --overdraw sets how much ACMR the overdraw pass may give up, 1.05 by default;
+// 1 keeps the cache order untouched apart from moving whole cold-start clusters.
+//
+// --lod also builds a LodChain and prints its levels. OBJ has nowhere to put
+// them, so the output file still gets the full mesh only.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../glm optimize_mesh.cpp ../OpenGLWorkspace/Mesh.cpp
+//       ../OpenGLWorkspace/MeshOptimizer.cpp ../OpenGLWorkspace/MeshLod.cpp ../OpenGLWorkspace/AssetPack.cpp -o optimize_mesh
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\glm optimize_mesh.cpp ..\OpenGLWorkspace\Mesh.cpp
+//       ..\OpenGLWorkspace\MeshOptimizer.cpp ..\OpenGLWorkspace\MeshLod.cpp ..\OpenGLWorkspace\AssetPack.cpp
+
+#include "asset_pack.h"
+#include "mesh.h"
+#include "mesh_lod.h"
+#include "mesh_optimizer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static void report(const char* step, const Mesh& mesh, double milliseconds)
+{
+	VertexCacheStats stats = analyzeVertexCache(mesh.indices, mesh.vertices.size());
+	std::printf("  %-10s ACMR %.3f  ATVR %.3f  (%.1f ms)\n", step, stats.acmr, stats.atvr, milliseconds);
+}
+
+static double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	int first = 1;
+	float threshold = 1.05f;
+	bool lods = false;
+	if (argc > first + 1 && std::string(argv[first]) == "--overdraw")
+	{
+		threshold = (float)std::atof(argv[first + 1]);
+		first += 2;
+	}
+	if (argc > first && std::string(argv[first]) == "--lod")
+	{
+		lods = true;
+		first++;
+	}
+	if (argc < first + 1 || argc > first + 2)
+	{
+		std::cout << "usage: optimize_mesh [--overdraw <threshold>] [--lod] <input.obj> [output.obj]" << std::endl;
+		return 1;
+	}
+
+	AssetFS loose;
+	Mesh mesh;
+	auto start = std::chrono::steady_clock::now();
+	if (!loadObj(loose, argv[first], mesh))
+		return 1;
+	std::cout << argv[first] << ": " << mesh.indices.size() / 3 << " triangles, " << mesh.vertices.size()
+		<< " vertices after merging duplicates" << std::endl;
+	report("loaded", mesh, elapsed(start));
+
+	start = std::chrono::steady_clock::now();
+	optimizeVertexCache(mesh.indices, mesh.vertices.size());
+	report("cache", mesh, elapsed(start));
+
+	start = std::chrono::steady_clock::now();
+	optimizeOverdraw(mesh.indices, mesh.vertices, threshold);
+	report("overdraw", mesh, elapsed(start));
+
+	// fetch order doesn't change which vertices hit the cache, only where they are in memory
+	start = std::chrono::steady_clock::now();
+	optimizeVertexFetch(mesh);
+	report("fetch", mesh, elapsed(start));
+
+	if (lods)
+	{
+		// on a copy: the chain reorders vertices, and the output should match the passes above
+		Mesh copy = mesh;
+		LodChain chain;
+		start = std::chrono::steady_clock::now();
+		buildLodChain(copy, chain);
+		std::printf("  %u LOD levels in %.1f ms, bounding radius %g\n", (unsigned int)chain.levels.size(), elapsed(start), chain.radius);
+		for (size_t level = 0; level < chain.levels.size(); level++)
+			std::printf("    %u: %7u triangles, error %g\n", (unsigned int)level, chain.levels[level].indexCount / 3, chain.levels[level].error);
+	}
+
+	if (argc == first + 2)
+	{
+		if (!writeObj(argv[first + 1], mesh))
+		{
+			std::cout << "ERROR::OPTIMIZE_MESH::CANNOT_WRITE " << argv[first + 1] << std::endl;
+			return 1;
+		}
+		std::cout << "written to " << argv[first + 1] << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,214 @@
+// pack_array - check and time the vertex packing kernels
+//
+//   pack_array [--values <count>] [--rounds <count>]
+//
+// Packs and unpacks arrays of random values, as halves, 10_10_10_2 vectors and
+// unorm8 colors, with the kernel for each instruction set level the CPU has,
+// and prints values or vectors per second. Every kernel has to give glm's
+// results bit for bit, NaNs aside, whose payloads aren't compared; the SIMD
+// half packing may round a tie the other way, which counts as long as both
+// halves are equally close to the float. The inputs mix in the edge cases:
+// every half, ties, denormals, infinities, NaNs and values out of range. The
+// default 64k values stay in L2.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../glm pack_array.cpp ../OpenGLWorkspace/PackArray.cpp
+//       ../OpenGLWorkspace/CpuFeatures.cpp -o pack_array
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\glm pack_array.cpp ..\OpenGLWorkspace\PackArray.cpp
+//       ..\OpenGLWorkspace\CpuFeatures.cpp
+
+#include "pack_array.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+static double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct Data
+{
+	std::vector<float> floats;
+	std::vector<uint16_t> halves;
+	std::vector<glm::vec4> vectors;
+	std::vector<uint32_t> packed;
+};
+
+struct Results
+{
+	std::vector<uint16_t> halves;
+	std::vector<float> floats;
+	std::vector<uint32_t> snorm, unorm;
+	std::vector<glm::vec4> snormVectors, unormVectors;
+};
+
+static bool sameFloat(float a, float b)
+{
+	uint32_t x, y;
+	std::memcpy(&x, &a, 4);
+	std::memcpy(&y, &b, 4);
+	return x == y || (a != a && b != b);
+}
+
+// a half from a kernel against glm's for 'value': equal, both NaN, or the
+// other side of a tie
+static bool sameHalf(uint16_t half, uint16_t reference, float value)
+{
+	if (half == reference)
+		return true;
+	float a = glm::unpackHalf1x16(half), b = glm::unpackHalf1x16(reference);
+	if (a != a && b != b)
+		return true;
+	return std::abs((double)a - value) == std::abs((double)b - value);
+}
+
+// mismatches between one level's results and glm's
+static size_t compare(const Data& data, const Results& results, const Results& reference)
+{
+	size_t mismatches = 0;
+	for (size_t i = 0; i < data.floats.size(); i++)
+		mismatches += !sameHalf(results.halves[i], reference.halves[i], data.floats[i]);
+	for (size_t i = 0; i < data.halves.size(); i++)
+		mismatches += !sameFloat(results.floats[i], reference.floats[i]);
+	for (size_t i = 0; i < data.vectors.size(); i++)
+	{
+		mismatches += results.snorm[i] != reference.snorm[i];
+		mismatches += results.unorm[i] != reference.unorm[i];
+	}
+	for (size_t i = 0; i < data.packed.size(); i++)
+		for (int c = 0; c < 4; c++)
+		{
+			mismatches += !sameFloat(results.snormVectors[i][c], reference.snormVectors[i][c]);
+			mismatches += !sameFloat(results.unormVectors[i][c], reference.unormVectors[i][c]);
+		}
+	return mismatches;
+}
+
+// runs every kernel 'rounds' times at one level; false if any result differs from 'reference'
+static bool run(const char* name, const Data& data, int rounds, const PackSettings& settings, Results& results,
+	const Results* reference)
+{
+	results.halves.resize(data.floats.size());
+	results.floats.resize(data.halves.size());
+	results.snorm.resize(data.vectors.size());
+	results.unorm.resize(data.vectors.size());
+	results.snormVectors.resize(data.packed.size());
+	results.unormVectors.resize(data.packed.size());
+
+	double seconds[6];
+	auto start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		packHalfArray(data.floats.data(), results.halves.data(), data.floats.size(), settings);
+	seconds[0] = elapsed(start);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		unpackHalfArray(data.halves.data(), results.floats.data(), data.halves.size(), settings);
+	seconds[1] = elapsed(start);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		packSnorm3x10Array(data.vectors.data(), results.snorm.data(), data.vectors.size(), settings);
+	seconds[2] = elapsed(start);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		unpackSnorm3x10Array(data.packed.data(), results.snormVectors.data(), data.packed.size(), settings);
+	seconds[3] = elapsed(start);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		packUnorm4x8Array(data.vectors.data(), results.unorm.data(), data.vectors.size(), settings);
+	seconds[4] = elapsed(start);
+	start = std::chrono::steady_clock::now();
+	for (int r = 0; r < rounds; r++)
+		unpackUnorm4x8Array(data.packed.data(), results.unormVectors.data(), data.packed.size(), settings);
+	seconds[5] = elapsed(start);
+
+	size_t mismatches = reference ? compare(data, results, *reference) : 0;
+	double values = (double)data.floats.size() * rounds / 1e6, vectors = (double)data.vectors.size() * rounds / 1e6;
+	std::printf("  %-8s half %7.1f / %7.1f M/s  snorm10 %7.1f / %7.1f M/s  unorm8 %7.1f / %7.1f M/s%s\n", name,
+		values / seconds[0], values / seconds[1], vectors / seconds[2], vectors / seconds[3],
+		vectors / seconds[4], vectors / seconds[5], mismatches ? "  MISMATCH" : "");
+	if (mismatches)
+		std::printf("  %d mismatches\n", (int)mismatches);
+	return mismatches == 0;
+}
+
+static float fromBits(uint32_t bits)
+{
+	float value;
+	std::memcpy(&value, &bits, 4);
+	return value;
+}
+
+int main(int argc, char** argv)
+{
+	int first = 1;
+	int count = 65536;
+	int rounds = 200;
+	while (argc > first + 1 && argv[first][0] == '-')
+	{
+		std::string option = argv[first];
+		if (option == "--values")
+			count = std::max(1, std::atoi(argv[first + 1]));
+		else if (option == "--rounds")
+			rounds = std::max(1, std::atoi(argv[first + 1]));
+		else
+			break;
+		first += 2;
+	}
+	if (argc != first)
+	{
+		std::cout << "usage: pack_array [--values <count>] [--rounds <count>]" << std::endl;
+		return 1;
+	}
+
+	// one extra value, so the odd count exercises the scalar tails after the SIMD steps
+	Data data;
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> unit(-1.25f, 1.25f);
+	std::uniform_real_distribution<float> wide(-70000.0f, 70000.0f);
+	for (int i = 0; i <= count; i++)
+	{
+		uint32_t bits = random();
+		switch (i % 4)
+		{
+		case 0: data.floats.push_back(fromBits(bits)); break;		// anything, NaNs and denormals included
+		case 1: data.floats.push_back(wide(random)); break;
+		case 2: data.floats.push_back(unit(random) * 0.001f); break;
+		// halfway between two halves, or the smallest denormal
+		case 3: data.floats.push_back(i % 8 == 3 ? (glm::unpackHalf1x16((uint16_t)bits) + glm::unpackHalf1x16((uint16_t)(bits + 1))) * 0.5f
+			: std::ldexp((float)(bits % 3), -25)); break;
+		}
+		data.halves.push_back((uint16_t)(i < 65536 ? i : bits));		// every half, then random ones
+		data.packed.push_back(bits);
+		glm::vec4 v(unit(random), unit(random), unit(random), unit(random));
+		if (i % 64 == 0)
+			v = glm::vec4(std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::infinity(), -0.0f, 0.5f);
+		else if (i % 64 == 1)
+			v = glm::vec4((float)(int)(bits % 511) / 511.0f, 0.5f / 255.0f, -1.5f / 511.0f, -0.5f);
+		data.vectors.push_back(v);
+	}
+	std::printf("%d values, %d rounds\n", (int)data.floats.size(), rounds);
+
+	// every level this CPU runs that has kernels of its own
+	Results reference, results;
+	PackSettings settings;
+	settings.level = CpuLevel::Scalar;
+	bool same = run(cpuLevelName(CpuLevel::Scalar), data, rounds, settings, reference, nullptr);
+	for (int level = (int)CpuLevel::SSE2; level <= (int)cpuLevel(); level++)
+	{
+		settings.level = (CpuLevel)level;
+		if (packArrayLevel(settings.level) == settings.level)
+			same = run(cpuLevelName(settings.level), data, rounds, settings, results, &reference) && same;
+	}
+	return same ? 0 : 1;
+}
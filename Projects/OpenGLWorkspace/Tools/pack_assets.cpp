@@ -0,0 +1,183 @@
+// pack_assets - build an asset pack for AssetFS out of asset directories
+//
+//   pack_assets [--cook <cache dir>] <output.pack> <dir> [dir...]
+//
+// Textures, shaders and meshes under each directory are stored by their path relative
+// to it, so "Assets/moon-texture.png" becomes "moon-texture.png". When two
+// directories have a file with the same name, the first directory wins; files
+// with identical contents are stored once whatever their names.
+//
+// --cook also runs every texture through an AssetCache in <cache dir>, so the
+// app finds them already decoded and mipped. Textures already in the cache
+// aren't decoded again.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../libraries/Includes pack_assets.cpp
+//       ../OpenGLWorkspace/AssetPack.cpp ../OpenGLWorkspace/AssetCache.cpp
+//       ../OpenGLWorkspace/MipGenerator.cpp ../OpenGLWorkspace/CpuFeatures.cpp -o pack_assets -lpthread
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\libraries\Includes pack_assets.cpp
+//       ..\OpenGLWorkspace\AssetPack.cpp ..\OpenGLWorkspace\AssetCache.cpp
+//       ..\OpenGLWorkspace\MipGenerator.cpp ..\OpenGLWorkspace\CpuFeatures.cpp
+//
+// e.g. from Projects/OpenGLWorkspace:
+//   pack_assets --cook OpenGLWorkspace/cooked OpenGLWorkspace/assets.pack OpenGLWorkspace Assets ../../Assets
+
+#include "asset_cache.h"
+#include "asset_pack.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+static bool hasExtension(const std::string& name, const char* const* extensions, size_t count)
+{
+	std::string lower(name);
+	std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+	for (size_t i = 0; i < count; i++)
+	{
+		std::string ext(extensions[i]);
+		if (lower.size() > ext.size() && lower.compare(lower.size() - ext.size(), ext.size(), ext) == 0)
+			return true;
+	}
+	return false;
+}
+
+static bool isTexture(const std::string& name)
+{
+	static const char* extensions[] = { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".psd", ".gif" };
+	return hasExtension(name, extensions, sizeof(extensions) / sizeof(extensions[0]));
+}
+
+static bool isAsset(const std::string& name)
+{
+	static const char* extensions[] = { ".hdr", ".vert", ".frag", ".geom", ".glsl", ".obj" };
+	return isTexture(name) || hasExtension(name, extensions, sizeof(extensions) / sizeof(extensions[0]));
+}
+
+// relative paths of the asset files under 'root', sorted so packs come out the same every time
+static void listAssets(const std::string& root, const std::string& relative, std::vector<std::string>& files)
+{
+	std::string dir = relative.empty() ? root : root + "/" + relative;
+	std::vector<std::string> names, subdirs;
+#ifdef _WIN32
+	WIN32_FIND_DATAA found;
+	HANDLE search = FindFirstFileA((dir + "/*").c_str(), &found);
+	if (search == INVALID_HANDLE_VALUE)
+		return;
+	do
+	{
+		std::string name = found.cFileName;
+		if (name == "." || name == "..")
+			continue;
+		if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			subdirs.push_back(name);
+		else
+			names.push_back(name);
+	} while (FindNextFileA(search, &found));
+	FindClose(search);
+#else
+	DIR* handle = opendir(dir.c_str());
+	if (!handle)
+		return;
+	while (dirent* found = readdir(handle))
+	{
+		std::string name = found->d_name;
+		struct stat info;
+		if (name == "." || name == ".." || stat((dir + "/" + name).c_str(), &info) != 0)
+			continue;
+		if (S_ISDIR(info.st_mode))
+			subdirs.push_back(name);
+		else if (S_ISREG(info.st_mode))
+			names.push_back(name);
+	}
+	closedir(handle);
+#endif
+	std::sort(names.begin(), names.end());
+	std::sort(subdirs.begin(), subdirs.end());
+	for (const std::string& name : names)
+		if (isAsset(name))
+			files.push_back(relative.empty() ? name : relative + "/" + name);
+	for (const std::string& name : subdirs)
+		listAssets(root, relative.empty() ? name : relative + "/" + name, files);
+}
+
+int main(int argc, char** argv)
+{
+	int first = 1;
+	const char* cookDirectory = nullptr;
+	if (argc > 2 && std::string(argv[1]) == "--cook")
+	{
+		cookDirectory = argv[2];
+		first = 3;
+	}
+	if (argc < first + 2)
+	{
+		std::cout << "usage: pack_assets [--cook <cache dir>] <output.pack> <dir> [dir...]" << std::endl;
+		return 1;
+	}
+	const char* output = argv[first];
+
+	AssetPackWriter writer;
+	std::vector<std::string> textures;
+	int packed = 0, skipped = 0;
+	for (int i = first + 1; i < argc; i++)
+	{
+		std::vector<std::string> files;
+		listAssets(argv[i], "", files);
+		for (const std::string& file : files)
+		{
+			std::string path = std::string(argv[i]) + "/" + file;
+			if (writer.contains(file))
+			{
+				std::cout << "  skipping " << path << ", already packed" << std::endl;
+				skipped++;
+			}
+			else if (!writer.addFile(file, path))
+			{
+				std::cout << "ERROR::PACK_ASSETS::CANNOT_READ " << path << std::endl;
+				return 1;
+			}
+			else
+			{
+				packed++;
+				if (isTexture(file))
+					textures.push_back(path);
+			}
+		}
+	}
+
+	if (!writer.write(output))
+	{
+		std::cout << "ERROR::PACK_ASSETS::CANNOT_WRITE " << output << std::endl;
+		return 1;
+	}
+	std::cout << packed << " assets packed into " << output << ", " << skipped << " duplicate names skipped, "
+		<< writer.sharedCount() << " identical files stored once (" << writer.sharedBytes() / 1024 << " KB saved)" << std::endl;
+
+	if (cookDirectory)
+	{
+		AssetFS loose;
+		AssetCache cache(loose, cookDirectory);
+		CookedTexture cooked;
+		for (const std::string& path : textures)
+			cache.texture(path, cache.textureSettings, cooked);
+		const AssetCacheStats& stats = cache.stats();
+		std::cout << stats.cooks << " textures cooked into " << cookDirectory << ", " << stats.hits << " already cooked, "
+			<< stats.failures << " failed" << std::endl;
+		if (stats.failures)
+			return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,233 @@
+// sampler_cache - check SamplerCache's sharing and bind skipping without a GPU
+//
+//   sampler_cache
+//
+// Drives a SamplerCache through stub GL entry points and checks what it did to
+// the stub samplers: equal descriptors share one sampler object, lodBias -0
+// and +0 count as equal, anisotropy is clamped to the limit the stub reports
+// (and left alone when either side is 1), a unit that already has the sampler
+// isn't bound again, invalidateBindings makes the next bind on every unit go
+// through, and the destructor deletes every sampler. Prints each check and
+// exits with the number that failed.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../libraries/Includes -I../../../glad/include sampler_cache.cpp
+//       ../OpenGLWorkspace/SamplerCache.cpp -o sampler_cache
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\libraries\Includes /I..\..\..\glad\include sampler_cache.cpp
+//       ..\OpenGLWorkspace\SamplerCache.cpp
+
+#include "sampler_cache.h"
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+// SamplerGL::current reads these; glad isn't linked, the checks never call it
+PFNGLGENSAMPLERSPROC glad_glGenSamplers;
+PFNGLDELETESAMPLERSPROC glad_glDeleteSamplers;
+PFNGLBINDSAMPLERPROC glad_glBindSampler;
+PFNGLSAMPLERPARAMETERIPROC glad_glSamplerParameteri;
+PFNGLSAMPLERPARAMETERFPROC glad_glSamplerParameterf;
+PFNGLSAMPLERPARAMETERFVPROC glad_glSamplerParameterfv;
+PFNGLGETFLOATVPROC glad_glGetFloatv;
+PFNGLGETERRORPROC glad_glGetError;
+
+static const GLenum maxAnisotropyParam = 0x84FE;		// GL_TEXTURE_MAX_ANISOTROPY
+static const GLenum maxAnisotropyLimit = 0x84FF;		// GL_MAX_TEXTURE_MAX_ANISOTROPY
+
+// what the stub GL saw happen to one sampler name
+struct StubSampler
+{
+	bool alive = false;
+	std::map<GLenum, float> params;	// every parameter set, last value wins
+};
+
+static std::map<GLuint, StubSampler> stubSamplers;
+static GLuint stubNextName = 1;
+static GLuint stubUnits[16];			// sampler bound to each unit
+static int stubBindCalls = 0;
+static int stubLimitQueries = 0;
+static float stubLimit = 16.0f;			// 0 makes the query fail like a driver without the extension
+
+static void APIENTRY stubGenSamplers(GLsizei n, GLuint* samplers)
+{
+	for (GLsizei i = 0; i < n; i++)
+	{
+		samplers[i] = stubNextName++;
+		stubSamplers[samplers[i]].alive = true;
+	}
+}
+
+static void APIENTRY stubDeleteSamplers(GLsizei n, const GLuint* samplers)
+{
+	for (GLsizei i = 0; i < n; i++)
+		stubSamplers[samplers[i]].alive = false;
+}
+
+static void APIENTRY stubBindSampler(GLuint unit, GLuint sampler)
+{
+	stubUnits[unit] = sampler;
+	stubBindCalls++;
+}
+
+static void APIENTRY stubSamplerParameteri(GLuint sampler, GLenum pname, GLint param)
+{
+	stubSamplers[sampler].params[pname] = (float)param;
+}
+
+static void APIENTRY stubSamplerParameterf(GLuint sampler, GLenum pname, GLfloat param)
+{
+	stubSamplers[sampler].params[pname] = param;
+}
+
+static void APIENTRY stubSamplerParameterfv(GLuint sampler, GLenum pname, const GLfloat* params)
+{
+	stubSamplers[sampler].params[pname] = params[0];
+}
+
+static void APIENTRY stubGetFloatv(GLenum pname, GLfloat* data)
+{
+	if (pname != maxAnisotropyLimit)
+		return;
+	stubLimitQueries++;
+	if (stubLimit > 0.0f)
+		*data = stubLimit;
+}
+
+static GLenum APIENTRY stubGetError()
+{
+	return GL_NO_ERROR;
+}
+
+static SamplerGL stubGL()
+{
+	SamplerGL gl;
+	gl.GenSamplers = stubGenSamplers;
+	gl.DeleteSamplers = stubDeleteSamplers;
+	gl.BindSampler = stubBindSampler;
+	gl.SamplerParameteri = stubSamplerParameteri;
+	gl.SamplerParameterf = stubSamplerParameterf;
+	gl.SamplerParameterfv = stubSamplerParameterfv;
+	gl.GetFloatv = stubGetFloatv;
+	gl.GetError = stubGetError;
+	return gl;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what)
+{
+	std::cout << (ok ? "  ok      " : "  FAILED  ") << what << std::endl;
+	if (!ok)
+		failures++;
+}
+
+static bool hasAnisotropy(GLuint sampler, float value)
+{
+	const std::map<GLenum, float>& params = stubSamplers[sampler].params;
+	auto found = params.find(maxAnisotropyParam);
+	return value == 0.0f ? found == params.end() : found != params.end() && found->second == value;
+}
+
+static void checkSharing()
+{
+	std::cout << "sharing" << std::endl;
+	SamplerCache cache(stubGL());
+	SamplerDesc linear;
+	SamplerDesc clamped;
+	clamped.wrapS = clamped.wrapT = GL_CLAMP_TO_EDGE;
+	GLuint a = cache.get(linear);
+	GLuint b = cache.get(clamped);
+	check(a != b && cache.size() == 2 && cache.stats().created == 2, "different descriptors get their own sampler");
+	check(cache.get(SamplerDesc()) == a && cache.get(clamped) == b && cache.stats().created == 2 &&
+		cache.stats().lookups == 4, "equal descriptors share one");
+	check(stubSamplers[b].params[GL_TEXTURE_WRAP_S] == GL_CLAMP_TO_EDGE &&
+		stubSamplers[b].params[GL_TEXTURE_MIN_FILTER] == GL_LINEAR_MIPMAP_LINEAR, "the sampler gets the descriptor's state");
+
+	SamplerDesc negativeZero;
+	negativeZero.lodBias = -0.0f;
+	SamplerDesc borderZero;
+	borderZero.borderColor[2] = -0.0f;
+	check(cache.get(negativeZero) == a && cache.get(borderZero) == a && cache.size() == 2,
+		"-0 and +0 are the same descriptor");
+	check(SamplerDescHash()(negativeZero) == SamplerDescHash()(linear), "and hash the same");
+}
+
+static void checkAnisotropy()
+{
+	std::cout << "anisotropy" << std::endl;
+	stubLimit = 8.0f;
+	stubLimitQueries = 0;
+	{
+		SamplerCache cache(stubGL());
+		SamplerDesc desc;
+		GLuint off = cache.get(desc);
+		desc.maxAnisotropy = 4.0f;
+		GLuint four = cache.get(desc);
+		desc.maxAnisotropy = 16.0f;
+		GLuint sixteen = cache.get(desc);
+		check(hasAnisotropy(off, 0.0f), "left unset when the descriptor asks for 1");
+		check(hasAnisotropy(four, 4.0f), "set as asked below the limit");
+		check(hasAnisotropy(sixteen, 8.0f), "clamped to the limit above it");
+		check(stubLimitQueries == 1, "the limit is queried once");
+	}
+
+	stubLimit = 0.0f;
+	{
+		SamplerCache cache(stubGL());
+		SamplerDesc desc;
+		desc.maxAnisotropy = 16.0f;
+		check(hasAnisotropy(cache.get(desc), 0.0f), "left unset when the driver doesn't have it");
+	}
+	stubLimit = 16.0f;
+}
+
+static void checkBinds()
+{
+	std::cout << "binds" << std::endl;
+	SamplerCache cache(stubGL());
+	SamplerDesc linear;
+	SamplerDesc nearest;
+	nearest.minFilter = nearest.magFilter = GL_NEAREST;
+	GLuint a = cache.get(linear);
+	GLuint b = cache.get(nearest);
+	int calls = stubBindCalls;
+
+	cache.bind(3, 0u);
+	check(stubBindCalls == calls && cache.stats().skippedBinds == 1, "units start out with sampler 0");
+	cache.bind(0, linear);
+	cache.bind(1, nearest);
+	check(stubUnits[0] == a && stubUnits[1] == b && cache.stats().binds == 2, "a new sampler on a unit is bound");
+	cache.bind(0, linear);
+	cache.bind(1, b);
+	check(stubBindCalls == calls + 2 && cache.stats().binds == 2 && cache.stats().skippedBinds == 3,
+		"the sampler the unit already has is skipped");
+	cache.bind(0, nearest);
+	check(stubUnits[0] == b && cache.stats().binds == 3, "a different one isn't");
+
+	// something outside the cache rebinds the units behind its back
+	stubBindSampler(0, 0);
+	stubBindSampler(1, 0);
+	calls = stubBindCalls;
+	cache.invalidateBindings();
+	cache.bind(0, nearest);
+	cache.bind(1, nearest);
+	cache.bind(3, 0u);
+	check(stubBindCalls == calls + 3 && stubUnits[0] == b && stubUnits[1] == b && cache.stats().binds == 6,
+		"after invalidateBindings every unit is bound again, sampler 0 too");
+	cache.bind(1, nearest);
+	check(stubBindCalls == calls + 3 && cache.stats().skippedBinds == 4, "then skipping resumes");
+}
+
+int main()
+{
+	checkSharing();
+	checkAnisotropy();
+	checkBinds();
+
+	size_t leaked = 0;
+	for (auto& sampler : stubSamplers)
+		leaked += sampler.second.alive;
+	check(leaked == 0, "every sampler deleted with its cache");
+	std::cout << (failures ? "FAILED" : "all passed") << std::endl;
+	return failures;
+}
@@ -0,0 +1,286 @@
+// texture_cache - check TextureCache's budget policies without a GPU
+//
+//   texture_cache
+//
+// Drives a TextureCache through stub GL entry points and a loader that makes
+// up square RGBA8 images, then checks what it did to the stub textures:
+// least-recently-used textures go first when over budget, DropMips raises
+// GL_TEXTURE_BASE_LEVEL of a texture (as far as minTrimmedSize allows) before
+// deleting it, textures acquired since the last beginFrame are never touched,
+// and the stats count all of it. Prints each check and exits with the number
+// that failed.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../libraries/Includes -I../../../glad/include texture_cache.cpp
+//       ../OpenGLWorkspace/TextureCache.cpp ../OpenGLWorkspace/AssetCache.cpp ../OpenGLWorkspace/AssetPack.cpp
+//       ../OpenGLWorkspace/HalfImage.cpp ../OpenGLWorkspace/PackArray.cpp ../OpenGLWorkspace/MipGenerator.cpp
+//       ../OpenGLWorkspace/CpuFeatures.cpp -o texture_cache -lpthread
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\libraries\Includes /I..\..\..\glad\include texture_cache.cpp
+//       ..\OpenGLWorkspace\TextureCache.cpp ..\OpenGLWorkspace\AssetCache.cpp ..\OpenGLWorkspace\AssetPack.cpp
+//       ..\OpenGLWorkspace\HalfImage.cpp ..\OpenGLWorkspace\PackArray.cpp ..\OpenGLWorkspace\MipGenerator.cpp
+//       ..\OpenGLWorkspace\CpuFeatures.cpp
+
+#include "texture_cache.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// TextureGL::current reads these; glad isn't linked, the checks never call it
+PFNGLGENTEXTURESPROC glad_glGenTextures;
+PFNGLDELETETEXTURESPROC glad_glDeleteTextures;
+PFNGLBINDTEXTUREPROC glad_glBindTexture;
+PFNGLGETINTEGERVPROC glad_glGetIntegerv;
+PFNGLTEXIMAGE2DPROC glad_glTexImage2D;
+PFNGLTEXPARAMETERIPROC glad_glTexParameteri;
+PFNGLGENERATEMIPMAPPROC glad_glGenerateMipmap;
+
+// what the stub GL saw happen to one texture name
+struct StubTexture
+{
+	bool alive = false;
+	int baseLevel = 0;
+	int uploads = 0;			// level 0 specified with pixels
+	std::vector<int> baseLevels;	// every GL_TEXTURE_BASE_LEVEL set, in order
+	int baseLevelAtDelete = -1;
+};
+
+static std::map<GLuint, StubTexture> stubTextures;
+static GLuint stubNextName = 1;
+static GLuint stubBound = 0;
+
+static void APIENTRY stubGenTextures(GLsizei n, GLuint* textures)
+{
+	for (GLsizei i = 0; i < n; i++)
+	{
+		textures[i] = stubNextName++;
+		stubTextures[textures[i]].alive = true;
+	}
+}
+
+static void APIENTRY stubDeleteTextures(GLsizei n, const GLuint* textures)
+{
+	for (GLsizei i = 0; i < n; i++)
+	{
+		StubTexture& texture = stubTextures[textures[i]];
+		texture.alive = false;
+		texture.baseLevelAtDelete = texture.baseLevel;
+		if (stubBound == textures[i])
+			stubBound = 0;
+	}
+}
+
+static void APIENTRY stubBindTexture(GLenum, GLuint texture)
+{
+	stubBound = texture;
+}
+
+static void APIENTRY stubGetIntegerv(GLenum pname, GLint* data)
+{
+	*data = pname == GL_TEXTURE_BINDING_2D ? (GLint)stubBound : 0;
+}
+
+static void APIENTRY stubTexImage2D(GLenum, GLint level, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void* pixels)
+{
+	if (level == 0 && pixels)
+		stubTextures[stubBound].uploads++;
+}
+
+static void APIENTRY stubTexParameteri(GLenum, GLenum pname, GLint param)
+{
+	if (pname != GL_TEXTURE_BASE_LEVEL)
+		return;
+	StubTexture& texture = stubTextures[stubBound];
+	texture.baseLevel = param;
+	texture.baseLevels.push_back(param);
+}
+
+static void APIENTRY stubGenerateMipmap(GLenum)
+{
+}
+
+static TextureGL stubGL()
+{
+	TextureGL gl;
+	gl.GenTextures = stubGenTextures;
+	gl.DeleteTextures = stubDeleteTextures;
+	gl.BindTexture = stubBindTexture;
+	gl.GetIntegerv = stubGetIntegerv;
+	gl.TexImage2D = stubTexImage2D;
+	gl.TexParameteri = stubTexParameteri;
+	gl.GenerateMipmap = stubGenerateMipmap;
+	return gl;
+}
+
+// "name:size" loads as a size x size image; anything without a size fails to load
+static bool stubLoad(void*, const std::string& path, TextureImage& image)
+{
+	size_t colon = path.find(':');
+	if (colon == std::string::npos)
+		return false;
+	image.width = image.height = std::atoi(path.c_str() + colon + 1);
+	image.pixels = new unsigned char[(size_t)image.width * image.height * 4]();
+	return true;
+}
+
+static void stubRelease(void*, TextureImage& image)
+{
+	delete[] image.pixels;
+	image.pixels = nullptr;
+}
+
+static TextureLoader stubLoader()
+{
+	TextureLoader loader;
+	loader.load = stubLoad;
+	loader.release = stubRelease;
+	loader.user = nullptr;
+	return loader;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what)
+{
+	std::cout << (ok ? "  ok      " : "  FAILED  ") << what << std::endl;
+	if (!ok)
+		failures++;
+}
+
+static size_t mipped(int size)
+{
+	return TextureCache::textureBytes(size, size, true);
+}
+
+// room for three 64x64 textures; every acquire is in a frame of its own
+static void checkLruOrder()
+{
+	std::cout << "LRU eviction" << std::endl;
+	TextureCache cache(3 * mipped(64), TextureCache::Policy::Evict, stubGL(), stubLoader());
+	GLuint a = cache.acquire("a:64");
+	cache.beginFrame();
+	GLuint b = cache.acquire("b:64");
+	cache.beginFrame();
+	GLuint c = cache.acquire("c:64");
+	cache.beginFrame();
+	cache.acquire("a:64");	// a is the most recent again, b the least
+	cache.beginFrame();
+	cache.acquire("d:64");
+	check(!cache.isResident("b:64") && !stubTextures[b].alive, "the least recently used texture goes first");
+	check(cache.isResident("a:64") && cache.isResident("c:64") && cache.isResident("d:64"), "the others stay");
+	cache.beginFrame();
+	cache.acquire("e:64");
+	check(!cache.isResident("c:64") && !stubTextures[c].alive && cache.isResident("a:64"), "then the next least recently used");
+	check(stubTextures[a].alive && stubTextures[a].uploads == 1, "a hit doesn't upload again");
+	check(cache.stats().evictions == 2 && cache.stats().mipDrops == 0, "Evict never drops mips");
+}
+
+// room for a 256x256 texture with mips and one trimmed to 64x64; a 256
+// texture can give up three levels before its largest side would fall below
+// minTrimmedSize, so a few trimmed ones fit before the oldest has to go
+static void checkDropMips()
+{
+	std::cout << "DropMips" << std::endl;
+	TextureCache cache(mipped(256) + mipped(64), TextureCache::Policy::DropMips, stubGL(), stubLoader());
+	GLuint x = cache.acquire("x:256");
+	cache.beginFrame();
+	GLuint y = cache.acquire("y:256");
+	cache.beginFrame();
+	cache.acquire("z:256");
+	check(cache.isResident("x:256") && cache.droppedLevels("x:256") >= 1, "over budget, the oldest texture loses its top level");
+	check(stubTextures[x].baseLevel == cache.droppedLevels("x:256"), "GL_TEXTURE_BASE_LEVEL follows the dropped levels");
+	check(cache.stats().evictions == 0 && cache.stats().mipDrops >= 1, "nothing deleted while levels can be dropped");
+
+	// keep loading until x has to go
+	char path[32];
+	for (int i = 0; i < 16 && stubTextures[x].alive; i++)
+	{
+		cache.beginFrame();
+		std::snprintf(path, sizeof(path), "w%d:256", i);
+		cache.acquire(path);
+	}
+	const std::vector<int>& levels = stubTextures[x].baseLevels;
+	bool rising = levels.size() == 4;
+	for (size_t i = 0; rising && i < levels.size(); i++)
+		rising = levels[i] == (int)i;
+	check(!stubTextures[x].alive && stubTextures[x].baseLevelAtDelete == 3 && rising,
+		"base level raised 1, 2, 3 before the texture is deleted");
+	check(cache.stats().evictions >= 1, "then it is evicted");
+
+	// y has dropped levels by now; acquiring it brings it back at full resolution
+	cache.beginFrame();
+	unsigned long restreams = cache.stats().restreams;
+	int dropped = cache.droppedLevels("y:256");
+	GLuint again = cache.acquire("y:256");
+	check(dropped > 0 && again == y && cache.droppedLevels("y:256") == 0 && stubTextures[y].baseLevel == 0,
+		"a trimmed texture is reloaded whole under the same name");
+	check(cache.stats().restreams == restreams + 1, "and counts as a restream");
+}
+
+// the budget only fits one texture
+static void checkPinned()
+{
+	std::cout << "textures in use this frame" << std::endl;
+	for (int p = 0; p < 2; p++)
+	{
+		TextureCache::Policy policy = p ? TextureCache::Policy::DropMips : TextureCache::Policy::Evict;
+		TextureCache cache(mipped(128), policy, stubGL(), stubLoader());
+		cache.beginFrame();
+		GLuint first = cache.acquire("p:128");
+		GLuint second = cache.acquire("q:128");
+		cache.setBudget(0);
+		check(stubTextures[first].alive && stubTextures[second].alive && cache.droppedLevels("p:128") == 0 &&
+			cache.droppedLevels("q:128") == 0, p ? "DropMips: neither trimmed nor deleted" : "Evict: none deleted");
+		check(cache.stats().residentBytes == 2 * mipped(128) && cache.stats().evictions == 0 && cache.stats().mipDrops == 0,
+			"the cache stays over budget instead");
+		cache.beginFrame();
+		cache.setBudget(mipped(128));
+		cache.acquire("r:128");
+		check(!cache.isResident("p:128") && !cache.isResident("q:128") && cache.isResident("r:128"),
+			"next frame they are fair game");
+	}
+}
+
+static void checkStats()
+{
+	std::cout << "stats" << std::endl;
+	TextureCache cache(mipped(64) + mipped(32), TextureCache::Policy::Evict, stubGL(), stubLoader());
+	cache.acquire("a:64");
+	cache.acquire("a:64");
+	cache.acquire("b:32");
+	check(cache.acquire("missing") == 0 && !cache.isResident("missing"), "a failed load returns 0 and isn't kept");
+	TextureParams nearest;
+	nearest.minFilter = GL_NEAREST;
+	cache.acquire("b:32", nearest);	// different params reload, but aren't a hit or a miss
+	const TextureCacheStats& stats = cache.stats();
+	check(stats.hits == 1 && stats.misses == 3 && stats.loadFailures == 1 && stats.restreams == 0, "hits, misses and load failures");
+	check(stats.residentBytes == mipped(64) + TextureCache::textureBytes(32, 32, false), "resident bytes follow the mip setup");
+	check(stats.peakBytes == mipped(64) + mipped(32), "peak bytes");
+	cache.beginFrame();
+	cache.acquire("c:64");
+	check(stats.evictions == 1 && !cache.isResident("a:64") && cache.isResident("b:32"), "evictions");
+	check(stats.residentBytes == mipped(64) + TextureCache::textureBytes(32, 32, false) &&
+		stats.peakBytes == mipped(64) + mipped(32), "peak bytes don't go down");
+	cache.clear();
+	check(stats.residentBytes == 0, "clear releases everything");
+}
+
+int main()
+{
+	checkLruOrder();
+	checkDropMips();
+	checkPinned();
+	checkStats();
+
+	size_t leaked = 0;
+	for (auto& texture : stubTextures)
+		leaked += texture.second.alive;
+	check(leaked == 0, "every texture deleted with its cache");
+	std::cout << (failures ? "FAILED" : "all passed") << std::endl;
+	return failures;
+}
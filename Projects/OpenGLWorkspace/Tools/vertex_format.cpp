@@ -0,0 +1,361 @@
+// vertex_format - check the quantized vertex layouts against the float source
+//
+//   vertex_format
+//
+// Packs generated spheres with packMesh and chooseVertexLayout/packVertices,
+// then reads every attribute back the way GL would from the type, normalized
+// flag and offset in the layout, and compares it with the source:
+// - half positions and texture coordinates stay within positionError (of the
+//   largest extent) and texCoordError, and fall back when they wouldn't;
+// - int16 positions are rounded to the nearest step of the bounds and come
+//   back through positionTransform();
+// - 10_10_10_2 normals are within half a step of 1/511 and have w = 0;
+// - unorm8 colors are within half of 1/255, with alpha 1 when there is none.
+// It also checks that every offset and stride is a multiple of 4, that apply()
+// makes one glVertexAttribPointer/glEnableVertexAttribArray pair per attribute,
+// and prints the packed stride next to the 32-byte float one. Prints each check
+// and exits with the number that failed.
+//
+//   g++ -std=c++11 -O2 -I../OpenGLWorkspace -I../../../glm -I../../../glad/include vertex_format.cpp
+//       ../OpenGLWorkspace/VertexFormat.cpp ../OpenGLWorkspace/PackArray.cpp ../OpenGLWorkspace/CpuFeatures.cpp
+//       -o vertex_format
+//   cl /O2 /EHsc /I..\OpenGLWorkspace /I..\..\..\glm /I..\..\..\glad\include vertex_format.cpp
+//       ..\OpenGLWorkspace\VertexFormat.cpp ..\OpenGLWorkspace\PackArray.cpp ..\OpenGLWorkspace\CpuFeatures.cpp
+
+#include "vertex_format.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// VertexLayoutGL::current reads these; glad isn't linked, the checks never call it
+PFNGLVERTEXATTRIBPOINTERPROC glad_glVertexAttribPointer;
+PFNGLENABLEVERTEXATTRIBARRAYPROC glad_glEnableVertexAttribArray;
+
+// one glVertexAttribPointer call as the stub GL saw it
+struct StubPointer
+{
+	GLuint index;
+	GLint size;
+	GLenum type;
+	GLboolean normalized;
+	GLsizei stride;
+	size_t pointer;
+	bool enabled;
+};
+
+static std::vector<StubPointer> stubPointers;
+
+static void APIENTRY stubVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+	const void* pointer)
+{
+	StubPointer call = { index, size, type, normalized, stride, (size_t)pointer, false };
+	stubPointers.push_back(call);
+}
+
+static void APIENTRY stubEnableVertexAttribArray(GLuint index)
+{
+	for (StubPointer& call : stubPointers)
+		if (call.index == index)
+			call.enabled = true;
+}
+
+static VertexLayoutGL stubGL()
+{
+	VertexLayoutGL gl;
+	gl.VertexAttribPointer = stubVertexAttribPointer;
+	gl.EnableVertexAttribArray = stubEnableVertexAttribArray;
+	return gl;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what)
+{
+	std::cout << (ok ? "  ok      " : "  FAILED  ") << what << std::endl;
+	if (!ok)
+		failures++;
+}
+
+// rings x segments vertices on a sphere around 'center', uvs repeated 'tiles' times
+static Mesh sphere(glm::vec3 center, float radius, int rings, int segments, float tiles)
+{
+	Mesh mesh;
+	for (int r = 0; r <= rings; r++)
+		for (int s = 0; s <= segments; s++)
+		{
+			float theta = 3.14159265f * r / rings;
+			float phi = 2.0f * 3.14159265f * s / segments;
+			glm::vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+			glm::vec3 position = center + normal * radius;
+			MeshVertex vertex;
+			for (int c = 0; c < 3; c++)
+			{
+				vertex.position[c] = position[c];
+				vertex.normal[c] = normal[c];
+			}
+			vertex.uv[0] = tiles * s / segments;
+			vertex.uv[1] = tiles * r / rings;
+			mesh.vertices.push_back(vertex);
+		}
+	return mesh;
+}
+
+// attribute 'a' of vertex 'v' as the vertex shader would get it; GL_SHORT
+// positions still need positionTransform()
+static glm::vec4 fetch(const VertexLayout& layout, const std::vector<unsigned char>& vertices, size_t v, size_t a)
+{
+	const VertexAttribute& attribute = layout.attributes[a];
+	const unsigned char* in = vertices.data() + v * layout.stride + attribute.offset;
+	glm::vec4 value(0.0f, 0.0f, 0.0f, 1.0f);
+	switch (attribute.type)
+	{
+	case GL_FLOAT:
+		std::memcpy(&value[0], in, attribute.components * sizeof(float));
+		break;
+	case GL_HALF_FLOAT:
+		for (int c = 0; c < attribute.components; c++)
+		{
+			uint16_t half;
+			std::memcpy(&half, in + c * 2, 2);
+			value[c] = glm::unpackHalf1x16(half);
+		}
+		break;
+	case GL_SHORT:
+		for (int c = 0; c < attribute.components; c++)
+		{
+			int16_t word;
+			std::memcpy(&word, in + c * 2, 2);
+			value[c] = word;
+		}
+		break;
+	case GL_INT_2_10_10_10_REV:
+	{
+		uint32_t packed;
+		std::memcpy(&packed, in, 4);
+		for (int c = 0; c < 3; c++)
+		{
+			int field = (int)((packed >> (c * 10)) & 0x3ff);
+			field -= field & 0x200 ? 0x400 : 0;
+			value[c] = std::max(field / 511.0f, -1.0f);
+		}
+		int w = (int)(packed >> 30);
+		value.w = (float)std::max(w >= 2 ? w - 4 : w, -1);
+		break;
+	}
+	case GL_UNSIGNED_BYTE:
+		for (int c = 0; c < 4; c++)
+			value[c] = in[c] / 255.0f;
+		break;
+	}
+	return value;
+}
+
+static bool aligned(const VertexLayout& layout)
+{
+	bool ok = layout.stride % 4 == 0;
+	for (const VertexAttribute& attribute : layout.attributes)
+		ok = ok && attribute.offset % 4 == 0 && attribute.offset < (GLuint)layout.stride;
+	return ok;
+}
+
+// largest difference between the fetched positions and the source, per component
+static float positionError(const Mesh& mesh, const VertexLayout& layout, const std::vector<unsigned char>& vertices)
+{
+	glm::mat4 transform = layout.positionTransform();
+	float error = 0.0f;
+	for (size_t v = 0; v < mesh.vertices.size(); v++)
+	{
+		glm::vec4 stored = fetch(layout, vertices, v, 0);
+		glm::vec3 position = glm::vec3(transform * glm::vec4(glm::vec3(stored), 1.0f));
+		for (int c = 0; c < 3; c++)
+			error = std::max(error, std::fabs(position[c] - mesh.vertices[v].position[c]));
+	}
+	return error;
+}
+
+static float largestExtent(const Mesh& mesh)
+{
+	glm::vec3 low(FLT_MAX), high(-FLT_MAX);
+	for (const MeshVertex& vertex : mesh.vertices)
+		for (int c = 0; c < 3; c++)
+		{
+			low[c] = std::min(low[c], vertex.position[c]);
+			high[c] = std::max(high[c], vertex.position[c]);
+		}
+	glm::vec3 extent = high - low;
+	return std::max(extent.x, std::max(extent.y, extent.z));
+}
+
+static void checkMesh()
+{
+	std::cout << "unit sphere" << std::endl;
+	Mesh mesh = sphere(glm::vec3(0.0f), 1.0f, 48, 96, 1.0f);
+	VertexFormatSettings settings;
+	std::vector<unsigned char> vertices;
+	VertexLayout layout = packMesh(mesh, vertices, settings);
+	check(layout.attributes.size() == 3 && layout.attributes[0].format == AttributeFormat::Half &&
+		layout.attributes[1].format == AttributeFormat::Snorm10 && layout.attributes[2].format == AttributeFormat::Half,
+		"positions and uvs go to half, normals to 10_10_10_2");
+	check(vertices.size() == mesh.vertices.size() * layout.stride, "one stride per vertex");
+	check(positionError(mesh, layout, vertices) <= settings.positionError * largestExtent(mesh),
+		"half positions within positionError of the extent");
+
+	float normalError = 0.0f, uvError = 0.0f;
+	bool wZero = true;
+	for (size_t v = 0; v < mesh.vertices.size(); v++)
+	{
+		glm::vec4 normal = fetch(layout, vertices, v, 1);
+		glm::vec4 uv = fetch(layout, vertices, v, 2);
+		for (int c = 0; c < 3; c++)
+			normalError = std::max(normalError, std::fabs(normal[c] - mesh.vertices[v].normal[c]));
+		for (int c = 0; c < 2; c++)
+			uvError = std::max(uvError, std::fabs(uv[c] - mesh.vertices[v].uv[c]));
+		wZero = wZero && normal.w == 0.0f;
+	}
+	check(normalError <= 0.5f / 511.0f + 1e-6f, "normals within half a 10-bit step");
+	check(wZero, "normals have w = 0");
+	check(uvError <= settings.texCoordError, "uvs within texCoordError");
+
+	VertexFormatSettings floats;
+	floats.quantize = false;
+	std::vector<unsigned char> unpacked;
+	VertexLayout full = packMesh(mesh, unpacked, floats);
+	check(full.stride == (GLsizei)sizeof(MeshVertex) && unpacked.size() == mesh.vertices.size() * sizeof(MeshVertex) &&
+		std::memcmp(unpacked.data(), mesh.vertices.data(), unpacked.size()) == 0, "quantize = false keeps the float layout as is");
+	check(aligned(layout) && aligned(full), "offsets and strides are multiples of 4");
+	check(layout.stride * 2 <= full.stride, "the packed vertex is at most half the float one");
+	std::cout << "          " << layout.stride << " bytes per vertex instead of " << full.stride << ", "
+		<< (float)full.stride / layout.stride << "x less to fetch" << std::endl;
+}
+
+static void checkFallbacks()
+{
+	std::cout << "fallbacks" << std::endl;
+	// far from the origin, half steps are much coarser than the sphere is precise
+	Mesh mesh = sphere(glm::vec3(1000.0f, -500.0f, 250.0f), 1.0f, 24, 48, 8.0f);
+	VertexFormatSettings settings;
+	std::vector<unsigned char> vertices;
+	VertexLayout layout = packMesh(mesh, vertices, settings);
+	const VertexAttribute& position = layout.attributes[0];
+	check(position.format == AttributeFormat::Int16 && position.type == GL_SHORT && !position.normalized,
+		"an offset mesh goes to unnormalized int16");
+	// in steps, so float rounding around 1000 doesn't hide an off-by-one
+	double rounding = 0.0;
+	float largest = 0.0f;
+	for (size_t v = 0; v < mesh.vertices.size(); v++)
+		for (int c = 0; c < 3; c++)
+		{
+			float stored = fetch(layout, vertices, v, 0)[c];
+			double exact = ((double)mesh.vertices[v].position[c] - layout.positionOffset[c]) / layout.positionScale[c];
+			rounding = std::max(rounding, std::fabs(stored - exact));
+			largest = std::max(largest, std::fabs(stored));
+		}
+	check(rounding <= 0.5 + 1e-3, "int16 is rounded to the nearest step");
+	check(largest == 32767.0f, "and the bounds use the whole range");
+	check(positionError(mesh, layout, vertices) <= settings.positionError * largestExtent(mesh),
+		"positionTransform() brings it back within positionError");
+	check(glm::all(glm::lessThan(glm::abs(layout.positionOffset - glm::vec3(1000.0f, -500.0f, 250.0f)), glm::vec3(1e-3f))),
+		"the offset is the center of the bounds");
+	check(layout.attributes[2].format == AttributeFormat::Float,
+		"uvs tiled 8 times stay float; half would be off by up to 1/512");
+
+	// half is off by up to 1/1024 between 2 and 4, twice what a 2-wide mesh allows
+	Mesh near = sphere(glm::vec3(2.5f, 0.0f, 0.0f), 1.0f, 24, 48, 1.0f);
+	layout = packMesh(near, vertices, settings);
+	check(layout.attributes[0].format == AttributeFormat::Int16 &&
+		positionError(near, layout, vertices) <= settings.positionError * largestExtent(near),
+		"so does one where half is just too coarse");
+
+	VertexFormatSettings tight;
+	tight.positionError = 1e-7f;
+	layout = packMesh(mesh, vertices, tight);
+	check(layout.attributes[0].format == AttributeFormat::Float && positionError(mesh, layout, vertices) == 0.0f,
+		"positions stay float when int16 isn't precise enough either");
+	check(layout.positionTransform() == glm::mat4(1.0f), "and the transform is the identity");
+	check(aligned(layout), "offsets and strides are multiples of 4");
+}
+
+static void checkColors()
+{
+	std::cout << "colors" << std::endl;
+	const size_t count = 1000;
+	std::vector<float> data(count * 10);
+	for (size_t v = 0; v < count; v++)
+	{
+		float* vertex = &data[v * 10];
+		vertex[0] = v * 0.001f;							// 1 position component
+		for (int c = 0; c < 3; c++)
+			vertex[1 + c] = ((v * 37 + c * 101) % 256) / 255.0f + (c - 1) * 0.0007f * (v % 3);
+		vertex[1] = std::min(std::max(vertex[1], 0.0f), 1.0f);
+		vertex[3] = std::min(std::max(vertex[3], 0.0f), 1.0f);
+		for (int c = 0; c < 4; c++)
+			vertex[4 + c] = (v % 50) * 0.1f + c;		// HDR, out of [0, 1]
+		vertex[8] = v / (float)count;					// 1 texture coordinate
+		vertex[9] = 0.0f;
+	}
+	VertexSource sources[] =
+	{
+		{ AttributeKind::Position, 0, 1, &data[0], 10 },
+		{ AttributeKind::Color, 3, 3, &data[1], 10 },
+		{ AttributeKind::Color, 4, 4, &data[4], 10 },
+		{ AttributeKind::TexCoord, 2, 1, &data[8], 10 },
+	};
+	VertexLayout layout = chooseVertexLayout(sources, 4, count);
+	std::vector<unsigned char> vertices;
+	packVertices(sources, 4, count, layout, vertices);
+	const VertexAttribute& color = layout.attributes[1];
+	check(color.format == AttributeFormat::Unorm8 && color.type == GL_UNSIGNED_BYTE && color.normalized &&
+		color.components == 4, "colors in [0, 1] go to unorm8");
+	check(layout.attributes[2].format == AttributeFormat::Half, "colors outside it go to half");
+	float error = 0.0f;
+	bool opaque = true;
+	for (size_t v = 0; v < count; v++)
+	{
+		glm::vec4 value = fetch(layout, vertices, v, 1);
+		for (int c = 0; c < 3; c++)
+			error = std::max(error, std::fabs(value[c] - data[v * 10 + 1 + c]));
+		opaque = opaque && value.w == 1.0f;
+	}
+	check(error <= 0.5f / 255.0f + 1e-6f, "unorm8 within half a step");
+	check(opaque, "alpha is 1 when the source has none");
+	check(layout.attributes[0].offset == 0 && layout.attributes[1].offset == 4 && layout.attributes[2].offset == 8 &&
+		layout.attributes[3].offset == 16 && layout.stride == 20, "2-byte attributes are padded to 4");
+}
+
+static void checkApply()
+{
+	std::cout << "apply" << std::endl;
+	Mesh mesh = sphere(glm::vec3(0.0f), 1.0f, 4, 8, 1.0f);
+	std::vector<unsigned char> vertices;
+	VertexLayout layout = packMesh(mesh, vertices);
+	stubPointers.clear();
+	layout.apply(64, stubGL());
+	bool same = stubPointers.size() == layout.attributes.size();
+	for (size_t a = 0; same && a < stubPointers.size(); a++)
+	{
+		const StubPointer& call = stubPointers[a];
+		const VertexAttribute& attribute = layout.attributes[a];
+		same = call.index == attribute.location && call.size == attribute.components && call.type == attribute.type &&
+			call.normalized == attribute.normalized && call.stride == layout.stride &&
+			call.pointer == 64 + attribute.offset && call.enabled;
+	}
+	check(same, "one enabled pointer per attribute, at the buffer offset plus the attribute's");
+}
+
+int main()
+{
+	checkMesh();
+	checkFallbacks();
+	checkColors();
+	checkApply();
+
+	std::cout << (failures ? "FAILED" : "all passed") << std::endl;
+	return failures;
+}
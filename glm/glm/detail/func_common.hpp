@@ -389,6 +389,14 @@ namespace glm
 	template <typename genType>
 	GLM_FUNC_DECL genType fma(genType const & a, genType const & b, genType const & c);
 
+	/// Computes and returns a * b + c for each component, in one fused
+	/// multiply-add instruction for aligned float vectors of 4 components in
+	/// AVX2 builds that enable FMA (-mfma with GCC and Clang).
+	/// 
+	/// @see <a href="http://www.opengl.org/sdk/docs/manglsl/xhtml/fma.xml">GLSL fma man page</a>
+	template <typename T, precision P, template <typename, precision> class vecType>
+	GLM_FUNC_DECL vecType<T, P> fma(vecType<T, P> const & a, vecType<T, P> const & b, vecType<T, P> const & c);
+
 	/// Splits x into a floating-point significand in the range
 	/// [0.5, 1.0) and an integral exponent of two, such that:
 	/// x = significand * exp(2, exponent)
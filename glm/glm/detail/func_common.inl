@@ -284,6 +284,15 @@ namespace detail
 		}
 	};
 
+	template <typename T, precision P, template <typename, precision> class vecType, bool Aligned>
+	struct compute_fma_vector
+	{
+		GLM_FUNC_QUALIFIER static vecType<T, P> call(vecType<T, P> const & a, vecType<T, P> const & b, vecType<T, P> const & c)
+		{
+			return a * b + c;
+		}
+	};
+
 	template <typename T, precision P, template <typename, precision> class vecType, bool Aligned>
 	struct compute_step_vector
 	{
@@ -744,6 +753,12 @@ namespace detail
 		return a * b + c;
 	}
 
+	template <typename T, precision P, template <typename, precision> class vecType>
+	GLM_FUNC_QUALIFIER vecType<T, P> fma(vecType<T, P> const & a, vecType<T, P> const & b, vecType<T, P> const & c)
+	{
+		return detail::compute_fma_vector<T, P, vecType, detail::is_aligned<P>::value>::call(a, b, c);
+	}
+
 	template <typename genType>
 	GLM_FUNC_QUALIFIER genType frexp(genType x, int & exp)
 	{
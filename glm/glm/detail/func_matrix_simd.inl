@@ -39,6 +39,21 @@ namespace detail
 		}
 	};
 
+	template <precision P>
+	struct compute_transpose<tmat4x4, float, P, false>
+	{
+		GLM_FUNC_QUALIFIER static tmat4x4<float, P> call(tmat4x4<float, P> const & m)
+		{
+			// glm_mat4_transpose_avx loses to this on its cross-lane shuffles, so AVX builds keep it too
+			tmat4x4<float, P> result(uninitialize);
+			glm_vec4 in[4], out[4];
+			glm_mat4_load(&m[0][0], in);
+			glm_mat4_transpose(in, out);
+			glm_mat4_store(out, &result[0][0]);
+			return result;
+		}
+	};
+
 	template <precision P>
 	struct compute_determinant<tmat4x4, float, P, true>
 	{
@@ -58,6 +73,20 @@ namespace detail
 			return Result;
 		}
 	};
+
+	template <precision P>
+	struct compute_inverse<tmat4x4, float, P, false>
+	{
+		GLM_FUNC_QUALIFIER static tmat4x4<float, P> call(tmat4x4<float, P> const& m)
+		{
+			tmat4x4<float, P> Result(uninitialize);
+			glm_vec4 in[4], out[4];
+			glm_mat4_load(&m[0][0], in);
+			glm_mat4_inverse(in, out);
+			glm_mat4_store(out, &Result[0][0]);
+			return Result;
+		}
+	};
 }//namespace detail
 
 	template<>
@@ -9,11 +9,14 @@
 namespace glm{
 namespace detail
 {
+	// Signed bytes: an unsigned char array gives the vector unions holding it
+	// typeless storage, and GCC 12 at -O2 then deletes stores to components
+	// that are later read through operator[].
 	template <typename T, std::size_t size, bool aligned>
 	struct storage
 	{
 		typedef struct type {
-			uint8 data[size];
+			int8 data[size];
 		} type;
 	};
 
@@ -21,7 +24,7 @@ namespace detail
 		template <typename T> \
 		struct storage<T, x, true> { \
 			GLM_ALIGNED_STRUCT(x) type { \
-				uint8 data[x]; \
+				int8 data[x]; \
 			}; \
 		};
 
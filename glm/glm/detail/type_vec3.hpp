@@ -79,10 +79,10 @@ namespace glm
 
 		/// Return the count of components of the vector
 		typedef length_t length_type;
-		GLM_FUNC_DECL static length_type length(){return 3;}
+		GLM_FUNC_DECL static GLM_CONSTEXPR_CXX14 length_type length(){return 3;}
 
-		GLM_FUNC_DECL T & operator[](length_type i);
-		GLM_FUNC_DECL T const & operator[](length_type i) const;
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 T & operator[](length_type i);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 T const & operator[](length_type i) const;
 
 		// -- Implicit basic constructors --
 
@@ -153,31 +153,31 @@ namespace glm
 		GLM_FUNC_DECL tvec3<T, P> & operator=(tvec3<T, P> const & v) GLM_DEFAULT;
 
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator=(tvec3<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator=(tvec3<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator+=(U scalar);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator+=(U scalar);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator+=(tvec1<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator+=(tvec1<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator+=(tvec3<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator+=(tvec3<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator-=(U scalar);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator-=(U scalar);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator-=(tvec1<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator-=(tvec1<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator-=(tvec3<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator-=(tvec3<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator*=(U scalar);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator*=(U scalar);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator*=(tvec1<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator*=(tvec1<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator*=(tvec3<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator*=(tvec3<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator/=(U scalar);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator/=(U scalar);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator/=(tvec1<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator/=(tvec1<U, P> const & v);
 		template <typename U>
-		GLM_FUNC_DECL tvec3<T, P> & operator/=(tvec3<U, P> const & v);
+		GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> & operator/=(tvec3<U, P> const & v);
 
 		// -- Increment and decrement operators --
 
@@ -229,72 +229,72 @@ namespace glm
 	// -- Unary operators --
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator+(tvec3<T, P> const & v);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator+(tvec3<T, P> const & v);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator-(tvec3<T, P> const & v);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator-(tvec3<T, P> const & v);
 
 	// -- Binary operators --
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator+(tvec3<T, P> const & v, T scalar);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator+(tvec3<T, P> const & v, T scalar);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator+(tvec3<T, P> const & v, tvec1<T, P> const & scalar);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator+(tvec3<T, P> const & v, tvec1<T, P> const & scalar);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator+(T scalar, tvec3<T, P> const & v);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator+(T scalar, tvec3<T, P> const & v);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator+(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator+(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator+(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator+(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator-(tvec3<T, P> const & v, T scalar);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator-(tvec3<T, P> const & v, T scalar);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator-(tvec3<T, P> const & v1, tvec1<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator-(tvec3<T, P> const & v1, tvec1<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator-(T scalar, tvec3<T, P> const & v);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator-(T scalar, tvec3<T, P> const & v);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator-(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator-(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator-(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator-(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator*(tvec3<T, P> const & v, T scalar);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator*(tvec3<T, P> const & v, T scalar);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator*(tvec3<T, P> const & v1, tvec1<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator*(tvec3<T, P> const & v1, tvec1<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator*(T scalar, tvec3<T, P> const & v);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator*(T scalar, tvec3<T, P> const & v);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator*(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator*(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator*(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator*(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator/(tvec3<T, P> const & v, T scalar);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator/(tvec3<T, P> const & v, T scalar);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator/(tvec3<T, P> const & v1, tvec1<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator/(tvec3<T, P> const & v1, tvec1<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator/(T scalar, tvec3<T, P> const & v);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator/(T scalar, tvec3<T, P> const & v);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator/(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator/(tvec1<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL tvec3<T, P> operator/(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tvec3<T, P> operator/(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
 	GLM_FUNC_DECL tvec3<T, P> operator%(tvec3<T, P> const & v, T scalar);
@@ -392,10 +392,10 @@ namespace glm
 	// -- Boolean operators --
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL bool operator==(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 bool operator==(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <typename T, precision P>
-	GLM_FUNC_DECL bool operator!=(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 bool operator!=(tvec3<T, P> const & v1, tvec3<T, P> const & v2);
 
 	template <precision P>
 	GLM_FUNC_DECL tvec3<bool, P> operator&&(tvec3<bool, P> const & v1, tvec3<bool, P> const & v2);
@@ -59,6 +59,7 @@
 #	include "./gtc/type_aligned.hpp"
 #endif
 
+#include "./gtx/approx.hpp"
 #include "./gtx/associated_min_max.hpp"
 #include "./gtx/bit.hpp"
 #include "./gtx/closest_point.hpp"
@@ -94,6 +95,7 @@
 #include "./gtx/polar_coordinates.hpp"
 #include "./gtx/projection.hpp"
 #include "./gtx/quaternion.hpp"
+#include "./gtx/quaternion_soa.hpp"
 #include "./gtx/raw_data.hpp"
 #include "./gtx/rotate_vector.hpp"
 
@@ -16,6 +16,12 @@
 /// (perspective, ortho, etc) are designed to expect. The OpenGL compatibility
 /// specifications defines the particular layout of this eye space.
 ///
+/// translate, scale, ortho and frustum are constexpr when GLM_HAS_CONSTEXPR_CXX14
+/// is set (C++14 with GCC 9, Clang 9 or later), so constant matrices built from
+/// them can be declared GLM_CONSTEXPR_CXX14 and are computed by the compiler.
+/// The functions that take an angle or normalize a vector call std::sin, tan
+/// and sqrt, which aren't constexpr, and stay runtime only.
+///
 /// <glm/gtc/matrix_transform.hpp> need to be included to use these functionalities.
 
 #pragma once
@@ -55,7 +61,7 @@ namespace glm
 	/// @see - translate(tmat4x4<T, P> const & m, T x, T y, T z)
 	/// @see - translate(tvec3<T, P> const & v)
 	template <typename T, precision P>
-	GLM_FUNC_DECL tmat4x4<T, P> translate(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, P> translate(
 		tmat4x4<T, P> const & m,
 		tvec3<T, P> const & v);
 		
@@ -83,7 +89,7 @@ namespace glm
 	/// @see - scale(tmat4x4<T, P> const & m, T x, T y, T z)
 	/// @see - scale(tvec3<T, P> const & v)
 	template <typename T, precision P>
-	GLM_FUNC_DECL tmat4x4<T, P> scale(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, P> scale(
 		tmat4x4<T, P> const & m,
 		tvec3<T, P> const & v);
 
@@ -99,7 +105,7 @@ namespace glm
 	/// @see gtc_matrix_transform
 	/// @see - glm::ortho(T const & left, T const & right, T const & bottom, T const & top)
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> ortho(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> ortho(
 		T left,
 		T right,
 		T bottom,
@@ -119,7 +125,7 @@ namespace glm
 	/// @see gtc_matrix_transform
 	/// @see - glm::ortho(T const & left, T const & right, T const & bottom, T const & top)
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> orthoLH(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> orthoLH(
 		T left,
 		T right,
 		T bottom,
@@ -139,7 +145,7 @@ namespace glm
 	/// @see gtc_matrix_transform
 	/// @see - glm::ortho(T const & left, T const & right, T const & bottom, T const & top)
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> orthoRH(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> orthoRH(
 		T left,
 		T right,
 		T bottom,
@@ -157,7 +163,7 @@ namespace glm
 	/// @see gtc_matrix_transform
 	/// @see - glm::ortho(T const & left, T const & right, T const & bottom, T const & top, T const & zNear, T const & zFar)
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> ortho(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> ortho(
 		T left,
 		T right,
 		T bottom,
@@ -174,7 +180,7 @@ namespace glm
 	/// @tparam T Value type used to build the matrix. Currently supported: half (not recommanded), float or double.
 	/// @see gtc_matrix_transform
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> frustum(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> frustum(
 		T left,
 		T right,
 		T bottom,
@@ -193,7 +199,7 @@ namespace glm
 	/// @tparam T Value type used to build the matrix. Currently supported: half (not recommanded), float or double.
 	/// @see gtc_matrix_transform
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> frustumLH(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> frustumLH(
 		T left,
 		T right,
 		T bottom,
@@ -212,7 +218,7 @@ namespace glm
 	/// @tparam T Value type used to build the matrix. Currently supported: half (not recommanded), float or double.
 	/// @see gtc_matrix_transform
 	template <typename T>
-	GLM_FUNC_DECL tmat4x4<T, defaultp> frustumRH(
+	GLM_FUNC_DECL GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> frustumRH(
 		T left,
 		T right,
 		T bottom,
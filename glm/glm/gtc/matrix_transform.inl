@@ -8,7 +8,7 @@
 namespace glm
 {
 	template <typename T, precision P>
-	GLM_FUNC_QUALIFIER tmat4x4<T, P> translate(tmat4x4<T, P> const & m, tvec3<T, P> const & v)
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, P> translate(tmat4x4<T, P> const & m, tvec3<T, P> const & v)
 	{
 		tmat4x4<T, P> Result(m);
 		Result[3] = m[0] * v[0] + m[1] * v[1] + m[2] * v[2] + m[3];
@@ -76,14 +76,9 @@ namespace glm
 	}
 
 	template <typename T, precision P>
-	GLM_FUNC_QUALIFIER tmat4x4<T, P> scale(tmat4x4<T, P> const & m, tvec3<T, P> const & v)
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, P> scale(tmat4x4<T, P> const & m, tvec3<T, P> const & v)
 	{
-		tmat4x4<T, P> Result(uninitialize);
-		Result[0] = m[0] * v[0];
-		Result[1] = m[1] * v[1];
-		Result[2] = m[2] * v[2];
-		Result[3] = m[3];
-		return Result;
+		return tmat4x4<T, P>(m[0] * v[0], m[1] * v[1], m[2] * v[2], m[3]);
 	}
 
 	template <typename T, precision P>
@@ -97,7 +92,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> ortho
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> ortho
 	(
 		T left, T right,
 		T bottom, T top,
@@ -112,7 +107,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> orthoLH
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> orthoLH
 	(
 		T left, T right,
 		T bottom, T top,
@@ -137,7 +132,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> orthoRH
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> orthoRH
 	(
 		T left, T right,
 		T bottom, T top,
@@ -162,7 +157,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> ortho
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> ortho
 	(
 		T left, T right,
 		T bottom, T top
@@ -178,7 +173,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> frustum
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> frustum
 	(
 		T left, T right,
 		T bottom, T top,
@@ -193,7 +188,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> frustumLH
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> frustumLH
 	(
 		T left, T right,
 		T bottom, T top,
@@ -219,7 +214,7 @@ namespace glm
 	}
 
 	template <typename T>
-	GLM_FUNC_QUALIFIER tmat4x4<T, defaultp> frustumRH
+	GLM_FUNC_QUALIFIER GLM_CONSTEXPR_CXX14 tmat4x4<T, defaultp> frustumRH
 	(
 		T left, T right,
 		T bottom, T top,
@@ -36,6 +36,16 @@ namespace glm
 		tmat4x4<T, P> const & modelMatrix,
 		tvec3<T, P> & scale, tquat<T, P> & orientation, tvec3<T, P> & translation, tvec3<T, P> & skew, tvec4<T, P> & perspective);
 
+	/// Builds the model matrix translate(translation) * mat4_cast(orientation) * scale(scale),
+	/// the inverse of decompose without skew or perspective. The quaternion's
+	/// rotation columns are scaled and the translation is written in place,
+	/// where the chain of translate, rotate and scale builds the same matrix
+	/// with two 4 * 4 matrix multiplications. The orientation has to be normalized.
+	/// @see gtx_matrix_decompose
+	template <typename T, precision P>
+	GLM_FUNC_DECL tmat4x4<T, P> composeTRS(
+		tvec3<T, P> const & translation, tquat<T, P> const & orientation, tvec3<T, P> const & scale);
+
 	/// @}
 }//namespace glm
 
@@ -191,4 +191,25 @@ namespace detail
 
 		return true;
 	}
+
+	template <typename T, precision P>
+	GLM_FUNC_QUALIFIER tmat4x4<T, P> composeTRS(tvec3<T, P> const & Translation, tquat<T, P> const & Orientation, tvec3<T, P> const & Scale)
+	{
+		// mat3_cast's terms, each column times its scale
+		T const qxx(Orientation.x * Orientation.x);
+		T const qyy(Orientation.y * Orientation.y);
+		T const qzz(Orientation.z * Orientation.z);
+		T const qxz(Orientation.x * Orientation.z);
+		T const qxy(Orientation.x * Orientation.y);
+		T const qyz(Orientation.y * Orientation.z);
+		T const qwx(Orientation.w * Orientation.x);
+		T const qwy(Orientation.w * Orientation.y);
+		T const qwz(Orientation.w * Orientation.z);
+
+		return tmat4x4<T, P>(
+			(T(1) - T(2) * (qyy + qzz)) * Scale.x, T(2) * (qxy + qwz) * Scale.x, T(2) * (qxz - qwy) * Scale.x, T(0),
+			T(2) * (qxy - qwz) * Scale.y, (T(1) - T(2) * (qxx + qzz)) * Scale.y, T(2) * (qyz + qwx) * Scale.y, T(0),
+			T(2) * (qxz + qwy) * Scale.z, T(2) * (qyz - qwx) * Scale.z, (T(1) - T(2) * (qxx + qyy)) * Scale.z, T(0),
+			Translation.x, Translation.y, Translation.z, T(1));
+	}
 }//namespace glm
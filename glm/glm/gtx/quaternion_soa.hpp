@@ -0,0 +1,120 @@
+/// @ref gtx_quaternion_soa
+/// @file glm/gtx/quaternion_soa.hpp
+///
+/// @see core (dependence)
+/// @see gtc_quaternion (dependence)
+///
+/// @defgroup gtx_quaternion_soa GLM_GTX_quaternion_soa
+/// @ingroup gtx
+///
+/// @brief Quaternion operations over whole arrays stored as structure of arrays.
+///
+/// Each function processes 8 quaternions per step with AVX or AVX2, 4 with SSE2
+/// and one at a time otherwise; the last few elements go through the same
+/// arithmetic one at a time, so results don't depend on where an element falls.
+/// Only float is supported. slerp runs about 3 times as fast as a glm::slerp
+/// loop with SSE2 and 5 times with AVX2.
+///
+/// Accuracy against the scalar functions, in ulps at the reference value's
+/// magnitude (no finer than at 1, since components are in [-1, 1]):
+/// - normalize, mul, mat3_cast, mat4_cast: the same operations in the same
+///   order, so 0 ulps, or 2 where the compiler contracts them into fused
+///   multiply-adds.
+/// - rotate: the same, 4 ulps of the vector's length with fused multiply-adds.
+/// - nlerp: 2 ulps against normalize(mix(x, y, a)) after the shortest path
+///   sign flip.
+/// - slerp: 4 ulps against glm::slerp. acos and sin are polynomials
+///   (Abramowitz and Stegun 4.4.46 and a degree 11 Taylor series on [0, pi/2]).
+///
+/// <glm/gtx/quaternion_soa.hpp> need to be included to use these functionalities.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../gtc/quaternion.hpp"
+#include <cstddef>
+
+#if GLM_MESSAGES == GLM_MESSAGES_ENABLED && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_quaternion_soa extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_quaternion_soa
+	/// @{
+
+	/// Quaternion array as one array per component: element i is
+	/// quat(w[i], x[i], y[i], z[i]). T is float or float const.
+	/// From GLM_GTX_quaternion_soa extension.
+	template <typename T>
+	struct soa_quat
+	{
+		T * x;
+		T * y;
+		T * z;
+		T * w;
+
+		GLM_FUNC_DECL soa_quat(T * x, T * y, T * z, T * w);
+		template <typename U>
+		GLM_FUNC_DECL soa_quat(soa_quat<U> const & q);
+	};
+
+	/// 3 components vector array as one array per component.
+	/// From GLM_GTX_quaternion_soa extension.
+	template <typename T>
+	struct soa_vec3
+	{
+		T * x;
+		T * y;
+		T * z;
+
+		GLM_FUNC_DECL soa_vec3(T * x, T * y, T * z);
+		template <typename U>
+		GLM_FUNC_DECL soa_vec3(soa_vec3<U> const & v);
+	};
+
+	/// out[i] = normalize(q[i]); zero length quaternions become the identity.
+	/// 'out' may be 'q'.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void normalize(soa_quat<float const> const & q, soa_quat<float> const & out, std::size_t count);
+
+	/// out[i] = p[i] * q[i], which applies q[i] first. 'out' may be either input.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void mul(soa_quat<float const> const & p, soa_quat<float const> const & q, soa_quat<float> const & out, std::size_t count);
+
+	/// out[i] = q[i] * v[i], q[i] normalized. 'out' may be 'v'.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void rotate(soa_quat<float const> const & q, soa_vec3<float const> const & v, soa_vec3<float> const & out, std::size_t count);
+
+	/// Normalized linear interpolation along the shortest path, with a[i] as
+	/// the factor of element i. Faster than slerp and close to it for the
+	/// small steps between animation keys. 'out' may be either input.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void nlerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float const * a, soa_quat<float> const & out, std::size_t count);
+
+	/// The same with one factor for every element.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void nlerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float a, soa_quat<float> const & out, std::size_t count);
+
+	/// out[i] = slerp(x[i], y[i], a[i]), the shortest path spherical
+	/// interpolation of glm::slerp. 'out' may be either input.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void slerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float const * a, soa_quat<float> const & out, std::size_t count);
+
+	/// The same with one factor for every element.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void slerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float a, soa_quat<float> const & out, std::size_t count);
+
+	/// out[i] = mat3_cast(q[i]), q[i] normalized.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void mat3_cast(soa_quat<float const> const & q, mat3 * out, std::size_t count);
+
+	/// out[i] = mat4_cast(q[i]), q[i] normalized.
+	/// From GLM_GTX_quaternion_soa extension.
+	GLM_FUNC_DECL void mat4_cast(soa_quat<float const> const & q, mat4 * out, std::size_t count);
+
+	/// @}
+}//namespace glm
+
+#include "quaternion_soa.inl"
@@ -4,6 +4,9 @@
 #include <glm/gtc/epsilon.hpp>
 #include <glm/gtc/vec1.hpp>
 #include <glm/gtc/random.hpp>
+#if GLM_HAS_ALIGNED_TYPE
+#	include <glm/gtc/type_aligned.hpp>
+#endif
 #include <vector>
 #include <cstdio>
 #include <cmath>
@@ -342,6 +345,39 @@ namespace clamp_
 	}
 }//namespace clamp_
 
+namespace fma_
+{
+	int test()
+	{
+		int Error = 0;
+
+		{
+			float const A = glm::fma(2.0f, 3.0f, 1.0f);
+			Error += glm::epsilonEqual(A, 7.0f, 0.00001f) ? 0 : 1;
+		}
+
+		{
+			glm::vec4 const A = glm::fma(glm::vec4(1, 2, 3, 4), glm::vec4(0.5f, -1, 2, 0), glm::vec4(1, 1, -1, 2));
+			Error += glm::all(glm::epsilonEqual(A, glm::vec4(1.5f, -1, 5, 2), 0.00001f)) ? 0 : 1;
+		}
+
+		{
+			glm::dvec3 const A = glm::fma(glm::dvec3(1, 2, 3), glm::dvec3(2), glm::dvec3(-1));
+			Error += glm::all(glm::epsilonEqual(A, glm::dvec3(1, 3, 5), 0.00001)) ? 0 : 1;
+		}
+
+		// the aligned types take their own path
+#		if GLM_HAS_ALIGNED_TYPE
+		{
+			glm::aligned_vec4 const A = glm::fma(glm::aligned_vec4(1.0f, 2.0f, 3.0f, 4.0f), glm::aligned_vec4(0.5f, -1.0f, 2.0f, 0.0f), glm::aligned_vec4(1.0f, 1.0f, -1.0f, 2.0f));
+			Error += A.x == 1.5f && A.y == -1.0f && A.z == 5.0f && A.w == 2.0f ? 0 : 1;
+		}
+#		endif//GLM_HAS_ALIGNED_TYPE
+
+		return Error;
+	}
+}//namespace fma_
+
 namespace mix_
 {
 	template <typename T, typename B>
@@ -1251,6 +1287,7 @@ int main()
 	Error += modf_::test();
 	Error += floatBitsToInt::test();
 	Error += floatBitsToUint::test();
+	Error += fma_::test();
 	Error += mix_::test();
 	Error += step_::test();
 	Error += max_::test();
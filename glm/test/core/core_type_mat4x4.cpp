@@ -9,7 +9,11 @@
 #include <glm/mat4x2.hpp>
 #include <glm/mat4x3.hpp>
 #include <glm/mat4x4.hpp>
+#if GLM_HAS_ALIGNED_TYPE
+#	include <glm/gtc/type_aligned.hpp>
+#endif
 #include <cstdio>
+#include <ctime>
 #include <vector>
 
 
@@ -242,11 +246,263 @@ int test_ctr()
 	return Error;
 }
 
-int perf_mul()
+// float matrices take the SIMD paths on SSE2 and AVX builds; double ones and
+// the plain loops below are the reference
+static glm::dmat4 reference(glm::mat4 const & m)
+{
+	return glm::dmat4(m);
+}
+
+static int same(glm::mat4 const & a, glm::dmat4 const & b, double Epsilon)
 {
 	int Error = 0;
+	for(glm::length_t i = 0; i < a.length(); ++i)
+		Error += glm::all(glm::lessThanEqual(glm::abs(glm::dvec4(a[i]) - b[i]), glm::dvec4(Epsilon))) ? 0 : 1;
+	return Error;
+}
+
+static glm::mat4 sample(std::size_t i)
+{
+	float const f = static_cast<float>(i) * 0.37f + 0.1f;
+	return glm::mat4(
+		glm::vec4(1.0f + f, 0.2f * f, 0.3f, 0.4f - f),
+		glm::vec4(0.2f, 0.7f + f, 0.5f, 0.3f),
+		glm::vec4(0.3f * f, 0.5f, 0.7f, 0.2f),
+		glm::vec4(f, -f, 2.0f * f, 1.0f));
+}
+
+int test_simd()
+{
+	int Error = 0;
+
+	for(std::size_t i = 0; i < 16; ++i)
+	{
+		glm::mat4 const A = sample(i);
+		glm::mat4 const B = sample(i + 7);
+		glm::vec4 const V(0.5f, -1.0f, 2.0f, 1.0f);
+
+		Error += same(A * B, reference(A) * reference(B), 0.0001);
+		Error += same(glm::transpose(A), glm::transpose(reference(A)), 0.0);
+		Error += same(glm::inverse(A), glm::inverse(reference(A)), 0.001);
+
+		glm::vec4 const U = A * V;
+		glm::dvec4 const W = reference(A) * glm::dvec4(V);
+		Error += glm::all(glm::lessThanEqual(glm::abs(glm::dvec4(U) - W), glm::dvec4(0.0001))) ? 0 : 1;
+	}
+
+	// the aligned types take their own path
+#	if GLM_HAS_ALIGNED_TYPE
+	{
+		typedef glm::tmat4x4<float, glm::aligned_highp> aligned_mat4;
+		aligned_mat4 const A(sample(3));
+		aligned_mat4 const B(sample(5));
+		aligned_mat4 const C = A * B;
+		glm::aligned_vec4 const U = A * glm::aligned_vec4(0.5f, -1.0f, 2.0f, 1.0f);
+		glm::mat4 const D = sample(3) * sample(5);
+		glm::vec4 const W = sample(3) * glm::vec4(0.5f, -1.0f, 2.0f, 1.0f);
+		for(glm::length_t i = 0; i < C.length(); ++i)
+		for(glm::length_t j = 0; j < C[i].length(); ++j)
+			Error += glm::abs(C[i][j] - D[i][j]) <= 0.0001f ? 0 : 1;
+		for(glm::length_t j = 0; j < U.length(); ++j)
+			Error += glm::abs(U[j] - W[j]) <= 0.0001f ? 0 : 1;
+	}
+#	endif//GLM_HAS_ALIGNED_TYPE
+
+	return Error;
+}
 
+namespace scalar
+{
+	static glm::mat4 mul(glm::mat4 const & a, glm::mat4 const & b)
+	{
+		glm::mat4 r(glm::uninitialize);
+		for(glm::length_t c = 0; c < 4; ++c)
+		for(glm::length_t i = 0; i < 4; ++i)
+			r[c][i] = a[0][i] * b[c][0] + a[1][i] * b[c][1] + a[2][i] * b[c][2] + a[3][i] * b[c][3];
+		return r;
+	}
+
+	static glm::vec4 mul(glm::mat4 const & m, glm::vec4 const & v)
+	{
+		glm::vec4 r(glm::uninitialize);
+		for(glm::length_t i = 0; i < 4; ++i)
+			r[i] = m[0][i] * v[0] + m[1][i] * v[1] + m[2][i] * v[2] + m[3][i] * v[3];
+		return r;
+	}
+
+	static glm::mat4 transpose(glm::mat4 const & m)
+	{
+		glm::mat4 r(glm::uninitialize);
+		for(glm::length_t c = 0; c < 4; ++c)
+		for(glm::length_t i = 0; i < 4; ++i)
+			r[c][i] = m[i][c];
+		return r;
+	}
+
+	static glm::mat4 inverse(glm::mat4 const & m)
+	{
+		return glm::mat4(glm::inverse(glm::dmat4(m)));
+	}
+}//namespace scalar
+
+struct simd
+{
+	static glm::mat4 mul(glm::mat4 const & a, glm::mat4 const & b) { return a * b; }
+	static glm::vec4 mul(glm::mat4 const & m, glm::vec4 const & v) { return m * v; }
+	static glm::mat4 transpose(glm::mat4 const & m) { return glm::transpose(m); }
+	static glm::mat4 inverse(glm::mat4 const & m) { return glm::inverse(m); }
+};
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+struct sse2
+{
+	static glm::mat4 mul(glm::mat4 const & a, glm::mat4 const & b)
+	{
+		glm_vec4 x[4], y[4], r[4];
+		glm_mat4_load(&a[0][0], x);
+		glm_mat4_load(&b[0][0], y);
+		glm_mat4_mul(x, y, r);
+		glm::mat4 Result(glm::uninitialize);
+		glm_mat4_store(r, &Result[0][0]);
+		return Result;
+	}
+
+	static glm::vec4 mul(glm::mat4 const & m, glm::vec4 const & v)
+	{
+		glm_vec4 x[4];
+		glm_mat4_load(&m[0][0], x);
+		glm::vec4 Result(glm::uninitialize);
+		_mm_storeu_ps(&Result[0], glm_mat4_mul_vec4(x, _mm_loadu_ps(&v[0])));
+		return Result;
+	}
+
+	static glm::mat4 transpose(glm::mat4 const & m)
+	{
+		glm_vec4 x[4], r[4];
+		glm_mat4_load(&m[0][0], x);
+		glm_mat4_transpose(x, r);
+		glm::mat4 Result(glm::uninitialize);
+		glm_mat4_store(r, &Result[0][0]);
+		return Result;
+	}
+
+	static glm::mat4 inverse(glm::mat4 const & m)
+	{
+		glm_vec4 x[4], r[4];
+		glm_mat4_load(&m[0][0], x);
+		glm_mat4_inverse(x, r);
+		glm::mat4 Result(glm::uninitialize);
+		glm_mat4_store(r, &Result[0][0]);
+		return Result;
+	}
+};
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+struct avx
+{
+	static glm::mat4 mul(glm::mat4 const & a, glm::mat4 const & b)
+	{
+		glm::mat4 Result(glm::uninitialize);
+		glm_mat4_mul_avx(&a[0][0], &b[0][0], &Result[0][0]);
+		return Result;
+	}
+
+	static glm::vec4 mul(glm::mat4 const & m, glm::vec4 const & v)
+	{
+		glm::vec4 Result(glm::uninitialize);
+		_mm_storeu_ps(&Result[0], glm_mat4_mul_vec4_avx(&m[0][0], &v[0]));
+		return Result;
+	}
+
+	static glm::mat4 transpose(glm::mat4 const & m)
+	{
+		glm::mat4 Result(glm::uninitialize);
+		glm_mat4_transpose_avx(&m[0][0], &Result[0][0]);
+		return Result;
+	}
+
+	// no AVX inverse; the SSE one already works on whole columns
+	static glm::mat4 inverse(glm::mat4 const & m) { return sse2::inverse(m); }
+};
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+struct plain
+{
+	static glm::mat4 mul(glm::mat4 const & a, glm::mat4 const & b) { return scalar::mul(a, b); }
+	static glm::vec4 mul(glm::mat4 const & m, glm::vec4 const & v) { return scalar::mul(m, v); }
+	static glm::mat4 transpose(glm::mat4 const & m) { return scalar::transpose(m); }
+	static glm::mat4 inverse(glm::mat4 const & m) { return scalar::inverse(m); }
+};
+
+// independent operations over arrays, so this measures throughput rather than latency
+template <typename ops>
+static void perf_mul_ops(std::vector<glm::mat4> const & Mats, std::size_t Rounds, char const * Message)
+{
+	std::vector<glm::mat4> Out(Mats.size());
+	std::vector<glm::vec4> Vecs(Mats.size());
+	for(std::size_t i = 0; i < Vecs.size(); ++i)
+		Vecs[i] = Mats[i][3];
+	std::vector<glm::vec4> OutVecs(Vecs.size());
+
+	std::clock_t StartTime = std::clock();
+	for(std::size_t r = 0; r < Rounds; ++r)
+	for(std::size_t i = 1; i < Mats.size(); ++i)
+		Out[i] = ops::mul(Mats[i - 1], Mats[i]);
+	std::clock_t const MulTime = std::clock() - StartTime;
+
+	StartTime = std::clock();
+	for(std::size_t r = 0; r < Rounds; ++r)
+	for(std::size_t i = 0; i < Mats.size(); ++i)
+		OutVecs[i] = ops::mul(Mats[i], Vecs[i]);
+	std::clock_t const MulVecTime = std::clock() - StartTime;
+
+	StartTime = std::clock();
+	for(std::size_t r = 0; r < Rounds; ++r)
+	for(std::size_t i = 0; i < Mats.size(); ++i)
+		Out[i ^ 1] = ops::transpose(Mats[i]);
+	std::clock_t const TransposeTime = std::clock() - StartTime;
+
+	StartTime = std::clock();
+	for(std::size_t r = 0; r < Rounds / 4; ++r)
+	for(std::size_t i = 0; i < Mats.size(); ++i)
+		Out[i ^ 2] = ops::inverse(Mats[i]);
+	std::clock_t const InverseTime = std::clock() - StartTime;
+
+	float Sum = 0.0f;
+	for(std::size_t i = 0; i < Out.size(); ++i)
+		Sum += Out[i][0][0] + OutVecs[i].x;
+
+	printf("%-8s mul %6lu, mul vec4 %6lu, transpose %6lu, inverse %6lu (%f)\n", Message,
+		static_cast<unsigned long>(MulTime), static_cast<unsigned long>(MulVecTime),
+		static_cast<unsigned long>(TransposeTime), static_cast<unsigned long>(InverseTime), Sum);
+}
+
+// clock ticks for the plain loops, the SSE2 and AVX kernels called directly, and
+// glm::mat4's operators, which use whichever kernel measured faster for the build:
+// SSE2 by default on x86-64, AVX with GLM_TEST_ENABLE_SIMD_AVX or _AVX2
+int perf_mul()
+{
+	int Error = 0;
 
+	std::vector<glm::mat4> Mats(1024);
+	for(std::size_t i = 0; i < Mats.size(); ++i)
+		Mats[i] = sample(i);
+
+#	ifdef NDEBUG
+		std::size_t const Rounds = 1000;
+#	else
+		std::size_t const Rounds = 10;
+#	endif
+
+	perf_mul_ops<plain>(Mats, Rounds, "scalar");
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		perf_mul_ops<sse2>(Mats, Rounds, "SSE2");
+#	endif
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+		perf_mul_ops<avx>(Mats, Rounds, "AVX");
+#	endif
+	perf_mul_ops<simd>(Mats, Rounds, "glm::mat4");
 
 	return Error;
 }
@@ -321,6 +577,7 @@ int main()
 	Error += test_operators();
 	Error += test_inverse();
 	Error += test_size();
+	Error += test_simd();
 
 	Error += perf_mul();
 
@@ -41,10 +41,41 @@ int test_translate()
 	return Error;
 }
 
+// The results are compared in static_asserts, so a failure breaks the build
+int test_constexpr()
+{
+	int Error = 0;
+
+#	if GLM_HAS_CONSTEXPR_CXX14
+		constexpr glm::mat4 Translate = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+		static_assert(Translate[3] == glm::vec4(1.0f, 2.0f, 3.0f, 1.0f), "GLM: constexpr translate failed");
+
+		constexpr glm::mat4 Scale = glm::scale(Translate, glm::vec3(2.0f));
+		static_assert(Scale[0].x == 2.0f && Scale[1].y == 2.0f && Scale[2].z == 2.0f && Scale[3] == Translate[3], "GLM: constexpr scale failed");
+
+		constexpr glm::mat4 Ortho = glm::ortho(-2.0f, 2.0f, -1.0f, 1.0f);
+		static_assert(Ortho[0][0] == 0.5f && Ortho[1][1] == 1.0f && Ortho[2][2] == -1.0f, "GLM: constexpr ortho failed");
+
+		constexpr glm::mat4 Frustum = glm::frustum(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 3.0f);
+		static_assert(Frustum[2][3] == -1.0f && Frustum[0][0] == 1.0f, "GLM: constexpr frustum failed");
+
+		// mat4 * mat4 and mat4 * vec4 take the SIMD paths at runtime
+		constexpr glm::mat4 Model = Scale * Translate;
+		static_assert(Model * glm::vec4(0, 0, 0, 1) == glm::vec4(3.0f, 6.0f, 9.0f, 1.0f), "GLM: constexpr product failed");
+
+		glm::mat4 const Runtime = Scale * Translate;
+		Error += Runtime == Model ? 0 : 1;
+#	endif//GLM_HAS_CONSTEXPR_CXX14
+
+	return Error;
+}
+
 int main()
 {
 	int Error = 0;
 
+	Error += test_constexpr();
+
 	Error += test_translate();
 	Error += test_tweakedInfinitePerspective();
 	Error += test_pick();
@@ -0,0 +1,265 @@
+#include <glm/gtx/approx.hpp>
+#include <glm/gtc/constants.hpp>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+// an odd count so the one at a time tail runs after the SIMD steps
+static std::size_t const Count = 100003;
+
+// units in the last place of the float nearest to 'reference'
+static double ulps(float value, double reference)
+{
+	int exponent = 0;
+	std::frexp(reference, &exponent);
+	double const ulp = std::ldexp(1.0, glm::max(exponent, -125) - 24);
+	return std::fabs(static_cast<double>(value) - reference) / ulp;
+}
+
+// evenly spread over [low, high], both ends included
+static std::vector<float> spread(float low, float high, std::size_t count)
+{
+	std::vector<float> Result(count);
+	for(std::size_t i = 0; i < count; ++i)
+		Result[i] = low + (high - low) * static_cast<float>(i) / static_cast<float>(count - 1);
+	return Result;
+}
+
+// every exponent from 2^-126 to 2^127 with a deterministic spread of mantissas
+static std::vector<float> positive_normals(std::size_t count)
+{
+	std::vector<float> Result(count);
+	unsigned int seed = 1;
+	for(std::size_t i = 0; i < count; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		float const Mantissa = 1.0f + static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+		Result[i] = std::ldexp(Mantissa, -126 + static_cast<int>(i % 254));
+	}
+	return Result;
+}
+
+static int test_sin_cos()
+{
+	int Error = 0;
+
+	std::vector<float> x = spread(-8192.0f, 8192.0f, Count);
+	x[1] = 0.0f;
+	x[2] = glm::half_pi<float>();
+	x[3] = -glm::pi<float>();
+	x[4] = 1e-20f;
+	std::vector<float> s(Count), c(Count);
+	glm::approx::sin(&x[0], &s[0], Count);
+	glm::approx::cos(&x[0], &c[0], Count);
+
+	double Largest = 0.0;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Largest = glm::max(Largest, std::fabs(s[i] - std::sin(static_cast<double>(x[i]))));
+		Largest = glm::max(Largest, std::fabs(c[i] - std::cos(static_cast<double>(x[i]))));
+	}
+	Error += Largest <= 2e-7 ? 0 : 1;
+	Error += s[1] == 0.0f && c[1] == 1.0f ? 0 : 1;
+	Error += s[4] == 1e-20f ? 0 : 1;
+
+	std::printf("sin, cos: %.2e absolute\n", Largest);
+	return Error;
+}
+
+static int test_exp()
+{
+	int Error = 0;
+
+	std::vector<float> x = spread(-87.0f, 88.3f, Count);
+	x[1] = 0.0f;
+	x[2] = 100.0f;
+	x[3] = -100.0f;
+	std::vector<float> y(Count);
+	glm::approx::exp(&x[0], &y[0], Count);
+
+	double Largest = 0.0;
+	for(std::size_t i = 4; i < Count; ++i)
+		Largest = glm::max(Largest, ulps(y[i], std::exp(static_cast<double>(x[i]))));
+	Error += Largest <= 2.0 ? 0 : 1;
+	Error += y[1] == 1.0f ? 0 : 1;
+	Error += y[2] == std::numeric_limits<float>::infinity() ? 0 : 1;
+	Error += y[3] == 0.0f ? 0 : 1;
+
+	std::printf("exp: %.2f ulps\n", Largest);
+	return Error;
+}
+
+static int test_log()
+{
+	int Error = 0;
+
+	std::vector<float> x = positive_normals(Count);
+	x[1] = 1.0f;
+	x[2] = 0.0f;
+	x[3] = -1.0f;
+	x[4] = std::numeric_limits<float>::infinity();
+	std::vector<float> y(Count);
+	glm::approx::log(&x[0], &y[0], Count);
+
+	double Largest = 0.0;
+	for(std::size_t i = 5; i < Count; ++i)
+		Largest = glm::max(Largest, ulps(y[i], std::log(static_cast<double>(x[i]))));
+	Error += Largest <= 2.0 ? 0 : 1;
+	Error += y[1] == 0.0f ? 0 : 1;
+	Error += y[2] == -std::numeric_limits<float>::infinity() ? 0 : 1;
+	Error += y[3] != y[3] ? 0 : 1;
+	Error += y[4] == std::numeric_limits<float>::infinity() ? 0 : 1;
+
+	std::printf("log: %.2f ulps\n", Largest);
+	return Error;
+}
+
+static int test_pow()
+{
+	int Error = 0;
+
+	std::vector<float> x = spread(0.01f, 100.0f, Count);
+	std::vector<float> y = spread(-4.0f, 4.0f, Count);
+	for(std::size_t i = 0; i < Count; i += 2)
+		y[i] = -y[i];
+	std::vector<float> z(Count), z2(Count);
+	glm::approx::pow(&x[0], &y[0], &z[0], Count);
+	glm::approx::pow(&x[0], 2.2f, &z2[0], Count);
+
+	double Largest = 0.0;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		double const Scale = 2.0 + 2.0 * std::fabs(y[i] * std::log(static_cast<double>(x[i])));
+		Largest = glm::max(Largest, ulps(z[i], std::pow(static_cast<double>(x[i]), static_cast<double>(y[i]))) / Scale);
+		double const Scale2 = 2.0 + 2.0 * std::fabs(2.2 * std::log(static_cast<double>(x[i])));
+		Largest = glm::max(Largest, ulps(z2[i], std::pow(static_cast<double>(x[i]), static_cast<double>(2.2f))) / Scale2);
+	}
+	Error += Largest <= 1.0 ? 0 : 1;
+
+	std::printf("pow: %.2f of the bound\n", Largest);
+	return Error;
+}
+
+static int test_inversesqrt()
+{
+	int Error = 0;
+
+	std::vector<float> x = positive_normals(Count);
+	x[1] = 0.0f;
+	x[2] = 4.0f;
+	std::vector<float> y(Count);
+	glm::approx::inversesqrt(&x[0], &y[0], Count);
+
+	double Largest = 0.0;
+	for(std::size_t i = 2; i < Count; ++i)
+		Largest = glm::max(Largest, ulps(y[i], 1.0 / std::sqrt(static_cast<double>(x[i]))));
+	Error += Largest <= 4.0 ? 0 : 1;
+	Error += y[1] == std::numeric_limits<float>::infinity() ? 0 : 1;
+
+	std::printf("inversesqrt: %.2f ulps\n", Largest);
+	return Error;
+}
+
+// vec4 takes the array path, and float the one at a time one
+static int test_overloads()
+{
+	int Error = 0;
+
+	glm::vec4 const x(0.25f, 1.5f, 3.0f, 10.0f);
+	glm::vec4 const y(2.0f, -0.5f, 1.0f, 0.1f);
+	float a[4];
+
+	glm::approx::sin(&x[0], a, 4);
+	Error += glm::approx::sin(x) == glm::vec4(a[0], a[1], a[2], a[3]) ? 0 : 1;
+	glm::approx::cos(&x[0], a, 4);
+	Error += glm::approx::cos(x) == glm::vec4(a[0], a[1], a[2], a[3]) ? 0 : 1;
+	glm::approx::exp(&x[0], a, 4);
+	Error += glm::approx::exp(x) == glm::vec4(a[0], a[1], a[2], a[3]) ? 0 : 1;
+	glm::approx::log(&x[0], a, 4);
+	Error += glm::approx::log(x) == glm::vec4(a[0], a[1], a[2], a[3]) ? 0 : 1;
+	glm::approx::pow(&x[0], &y[0], a, 4);
+	Error += glm::approx::pow(x, y) == glm::vec4(a[0], a[1], a[2], a[3]) ? 0 : 1;
+	glm::approx::inversesqrt(&x[0], a, 4);
+	Error += glm::approx::inversesqrt(x) == glm::vec4(a[0], a[1], a[2], a[3]) ? 0 : 1;
+
+	Error += std::fabs(glm::approx::sin(1.0f) - std::sin(1.0f)) <= 2e-7f ? 0 : 1;
+	Error += std::fabs(glm::approx::cos(1.0f) - std::cos(1.0f)) <= 2e-7f ? 0 : 1;
+	Error += ulps(glm::approx::exp(1.0f), std::exp(1.0)) <= 2.0 ? 0 : 1;
+	Error += ulps(glm::approx::log(3.0f), std::log(3.0)) <= 2.0 ? 0 : 1;
+	Error += ulps(glm::approx::pow(2.0f, 0.5f), std::sqrt(2.0)) <= 3.0 ? 0 : 1;
+	Error += ulps(glm::approx::inversesqrt(2.0f), 1.0 / std::sqrt(2.0)) <= 4.0 ? 0 : 1;
+
+	return Error;
+}
+
+template <typename function, typename approx_function>
+static float perf_function(char const * Name, function Reference, approx_function Approx, std::vector<float> const & x)
+{
+	int const Rounds = 256;
+	std::vector<float> y(x.size());
+
+	std::clock_t const StartStd = std::clock();
+	for(int r = 0; r < Rounds; ++r)
+	for(std::size_t i = 0; i < x.size(); ++i)
+		y[i] = Reference(x[i]);
+	std::clock_t const StartApprox = std::clock();
+	float Sum = y[x.size() / 2];
+	for(int r = 0; r < Rounds; ++r)
+		Approx(&x[0], &y[0], x.size());
+	std::clock_t const End = std::clock();
+
+	std::printf("std::%s %d clocks, glm::approx::%s %d clocks\n", Name,
+		static_cast<int>(StartApprox - StartStd), Name, static_cast<int>(End - StartApprox));
+	return Sum + y[x.size() / 2];
+}
+
+static float std_sin(float x){return std::sin(x);}
+static float std_cos(float x){return std::cos(x);}
+static float std_exp(float x){return std::exp(x);}
+static float std_log(float x){return std::log(x);}
+static float std_pow(float x){return std::pow(x, 2.2f);}
+static float std_inversesqrt(float x){return 1.0f / std::sqrt(x);}
+static void approx_sin(float const * x, float * y, std::size_t n){glm::approx::sin(x, y, n);}
+static void approx_cos(float const * x, float * y, std::size_t n){glm::approx::cos(x, y, n);}
+static void approx_exp(float const * x, float * y, std::size_t n){glm::approx::exp(x, y, n);}
+static void approx_log(float const * x, float * y, std::size_t n){glm::approx::log(x, y, n);}
+static void approx_pow(float const * x, float * y, std::size_t n){glm::approx::pow(x, 2.2f, y, n);}
+static void approx_inversesqrt(float const * x, float * y, std::size_t n){glm::approx::inversesqrt(x, y, n);}
+
+int perf()
+{
+	std::size_t const Size = 4096;
+	std::vector<float> const Angles = spread(-100.0f, 100.0f, Size);
+	std::vector<float> const Exponents = spread(-80.0f, 80.0f, Size);
+	std::vector<float> const Positives = spread(0.001f, 1000.0f, Size);
+
+	float Sum = 0.0f;
+	Sum += perf_function("sin", std_sin, approx_sin, Angles);
+	Sum += perf_function("cos", std_cos, approx_cos, Angles);
+	Sum += perf_function("exp", std_exp, approx_exp, Exponents);
+	Sum += perf_function("log", std_log, approx_log, Positives);
+	Sum += perf_function("pow", std_pow, approx_pow, Positives);
+	Sum += perf_function("inversesqrt", std_inversesqrt, approx_inversesqrt, Positives);
+
+	return Sum == Sum ? 0 : 1;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_sin_cos();
+	Error += test_exp();
+	Error += test_log();
+	Error += test_pow();
+	Error += test_inversesqrt();
+	Error += test_overloads();
+
+#	ifdef NDEBUG
+		Error += perf();
+#	endif//NDEBUG
+
+	return Error;
+}
@@ -1,6 +1,10 @@
 #include <glm/gtx/matrix_decompose.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cstdio>
+#include <ctime>
+#include <vector>
 
-int main()
+int test_decompose()
 {
 	int Error(0);
 
@@ -16,3 +20,103 @@ int main()
 
 	return Error;
 }
+
+static bool equal_mat4(glm::mat4 const & a, glm::mat4 const & b, float Epsilon)
+{
+	for(glm::length_t i = 0; i < 4; ++i)
+		if(!glm::all(glm::epsilonEqual(a[i], b[i], Epsilon)))
+			return false;
+	return true;
+}
+
+// a scene node's local transform, as an animation system would hold it
+struct node
+{
+	glm::vec3 Translation;
+	glm::quat Orientation;
+	glm::vec3 Scale;
+};
+
+static std::vector<node> make_nodes(std::size_t Count)
+{
+	std::vector<node> Nodes(Count);
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		float const f = static_cast<float>(i);
+		Nodes[i].Translation = glm::vec3(f * 0.5f, -f, 3.0f - f * 0.25f);
+		Nodes[i].Orientation = glm::angleAxis(f * 0.37f, glm::normalize(glm::vec3(1.0f, f * 0.1f, -2.0f)));
+		Nodes[i].Scale = glm::vec3(1.0f + f * 0.01f, 0.5f, 2.0f - f * 0.001f);
+	}
+	return Nodes;
+}
+
+int test_composeTRS()
+{
+	int Error(0);
+
+	std::vector<node> const Nodes = make_nodes(64);
+	for(std::size_t i = 0; i < Nodes.size(); ++i)
+	{
+		node const & Node = Nodes[i];
+		glm::mat4 const Chain = glm::scale(glm::translate(glm::mat4(1), Node.Translation) * glm::mat4_cast(Node.Orientation), Node.Scale);
+		glm::mat4 const Composed = glm::composeTRS(Node.Translation, Node.Orientation, Node.Scale);
+		Error += equal_mat4(Chain, Composed, 0.0001f) ? 0 : 1;
+
+		glm::vec3 Scale;
+		glm::quat Orientation;
+		glm::vec3 Translation;
+		glm::vec3 Skew;
+		glm::vec4 Perspective;
+		Error += glm::decompose(Composed, Scale, Orientation, Translation, Skew, Perspective) ? 0 : 1;
+		Error += glm::all(glm::epsilonEqual(Translation, Node.Translation, 0.0001f)) ? 0 : 1;
+		Error += glm::all(glm::epsilonEqual(Scale, Node.Scale, 0.0001f)) ? 0 : 1;
+	}
+
+	// the identity transform
+	Error += glm::composeTRS(glm::vec3(0), glm::quat(1, 0, 0, 0), glm::vec3(1)) == glm::mat4(1) ? 0 : 1;
+
+	return Error;
+}
+
+// rebuilds every local matrix from its node, as a scene update does each frame
+int perf_composeTRS()
+{
+	int Error(0);
+
+	std::size_t const Count = 4096;
+	int const Rounds = 256;
+	std::vector<node> const Nodes = make_nodes(Count);
+	std::vector<glm::mat4> Locals(Count);
+
+	std::clock_t const StartChain = std::clock();
+	for(int r = 0; r < Rounds; ++r)
+	for(std::size_t i = 0; i < Count; ++i)
+		Locals[i] = glm::scale(glm::translate(glm::mat4(1), Nodes[i].Translation) * glm::mat4_cast(Nodes[i].Orientation), Nodes[i].Scale);
+	std::clock_t const StartComposed = std::clock();
+	glm::mat4 const Last = Locals[Count - 1];
+	for(int r = 0; r < Rounds; ++r)
+	for(std::size_t i = 0; i < Count; ++i)
+		Locals[i] = glm::composeTRS(Nodes[i].Translation, Nodes[i].Orientation, Nodes[i].Scale);
+	std::clock_t const End = std::clock();
+
+	std::printf("translate * mat4_cast * scale %d clocks, composeTRS %d clocks\n",
+		static_cast<int>(StartComposed - StartChain), static_cast<int>(End - StartComposed));
+
+	Error += equal_mat4(Last, Locals[Count - 1], 0.001f) ? 0 : 1;
+
+	return Error;
+}
+
+int main()
+{
+	int Error(0);
+
+	Error += test_decompose();
+	Error += test_composeTRS();
+
+#	ifdef NDEBUG
+		Error += perf_composeTRS();
+#	endif//NDEBUG
+
+	return Error;
+}
@@ -0,0 +1,277 @@
+#include <glm/gtx/quaternion_soa.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <vector>
+
+// an odd count so the one at a time tail runs after the SIMD steps
+static std::size_t const Count = 1003;
+
+// ulps at the reference's magnitude, but no finer than at 1
+static float ulps(float value, float reference)
+{
+	return glm::abs(value - reference) / (glm::epsilon<float>() * glm::max(1.0f, glm::abs(reference)));
+}
+
+struct quats
+{
+	std::vector<float> x, y, z, w;
+
+	explicit quats(std::size_t count) : x(count), y(count), z(count), w(count) {}
+
+	glm::quat get(std::size_t i) const {return glm::quat(w[i], x[i], y[i], z[i]);}
+	void set(std::size_t i, glm::quat const & q) {x[i] = q.x; y[i] = q.y; z[i] = q.z; w[i] = q.w;}
+
+	glm::soa_quat<float> soa() {return glm::soa_quat<float>(&x[0], &y[0], &z[0], &w[0]);}
+	glm::soa_quat<float const> soa() const {return glm::soa_quat<float const>(&x[0], &y[0], &z[0], &w[0]);}
+};
+
+// a deterministic spread of normalized quaternions
+static glm::quat random_quat(unsigned int & seed)
+{
+	float v[4];
+	for(int i = 0; i < 4; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		v[i] = static_cast<float>(seed >> 8) / static_cast<float>(1 << 24) * 2.0f - 1.0f;
+	}
+	return glm::normalize(glm::quat(v[3], v[0], v[1], v[2]));
+}
+
+static float max_ulps(glm::quat const & value, glm::quat const & reference)
+{
+	float Result = 0.0f;
+	for(glm::length_t i = 0; i < 4; ++i)
+		Result = glm::max(Result, ulps(value[i], reference[i]));
+	return Result;
+}
+
+// x random; y random, a small step from x, or a small step from -x so that
+// both slerp branches and the shortest path flip get covered
+static void make_pairs(quats & x, quats & y, std::vector<float> & a)
+{
+	unsigned int seed = 1;
+	for(std::size_t i = 0; i < x.x.size(); ++i)
+	{
+		glm::quat const q = random_quat(seed);
+		glm::quat r = random_quat(seed);
+		if(i % 3 == 1)
+			r = glm::normalize(q + r * 1e-3f);
+		else if(i % 3 == 2)
+			r = -glm::normalize(q + r * 1e-8f);
+		x.set(i, q);
+		y.set(i, r);
+		a[i] = static_cast<float>(i % 11) / 10.0f;
+	}
+}
+
+static int test_normalize()
+{
+	int Error = 0;
+
+	quats q(Count), out(Count);
+	unsigned int seed = 2;
+	for(std::size_t i = 0; i < Count; ++i)
+		q.set(i, random_quat(seed) * (0.5f + static_cast<float>(i % 7)));
+	q.set(5, glm::quat(0.0f, 0.0f, 0.0f, 0.0f));
+
+	glm::normalize(q.soa(), out.soa(), Count);
+
+	float Largest = 0.0f;
+	for(std::size_t i = 0; i < Count; ++i)
+		Largest = glm::max(Largest, max_ulps(out.get(i), glm::normalize(q.get(i))));
+	Error += Largest <= 2.0f ? 0 : 1;
+
+	std::printf("normalize: %.1f ulps\n", Largest);
+	return Error;
+}
+
+static int test_mul()
+{
+	int Error = 0;
+
+	quats p(Count), q(Count), out(Count);
+	unsigned int seed = 3;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		p.set(i, random_quat(seed));
+		q.set(i, random_quat(seed));
+	}
+
+	glm::mul(p.soa(), q.soa(), out.soa(), Count);
+
+	float Largest = 0.0f;
+	for(std::size_t i = 0; i < Count; ++i)
+		Largest = glm::max(Largest, max_ulps(out.get(i), p.get(i) * q.get(i)));
+	Error += Largest <= 2.0f ? 0 : 1;
+
+	std::printf("mul: %.1f ulps\n", Largest);
+	return Error;
+}
+
+static int test_rotate()
+{
+	int Error = 0;
+
+	quats q(Count);
+	std::vector<float> x(Count), y(Count), z(Count), ox(Count), oy(Count), oz(Count);
+	unsigned int seed = 4;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		q.set(i, random_quat(seed));
+		glm::quat const v = random_quat(seed);
+		x[i] = v.x * 10.0f;
+		y[i] = v.y * 10.0f;
+		z[i] = v.z * 10.0f;
+	}
+
+	glm::rotate(q.soa(), glm::soa_vec3<float const>(&x[0], &y[0], &z[0]), glm::soa_vec3<float>(&ox[0], &oy[0], &oz[0]), Count);
+
+	float Largest = 0.0f;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		// components can cancel out, so measure against the vector's length
+		glm::vec3 const Reference = q.get(i) * glm::vec3(x[i], y[i], z[i]);
+		float const Distance = glm::length(glm::vec3(ox[i], oy[i], oz[i]) - Reference);
+		Largest = glm::max(Largest, Distance / (glm::epsilon<float>() * glm::max(1.0f, glm::length(Reference))));
+	}
+	Error += Largest <= 4.0f ? 0 : 1;
+
+	std::printf("rotate: %.1f ulps\n", Largest);
+	return Error;
+}
+
+static int test_nlerp()
+{
+	int Error = 0;
+
+	quats x(Count), y(Count), out(Count);
+	std::vector<float> a(Count);
+	make_pairs(x, y, a);
+
+	glm::nlerp(x.soa(), y.soa(), &a[0], out.soa(), Count);
+
+	float Largest = 0.0f;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		glm::quat const z = glm::dot(x.get(i), y.get(i)) < 0.0f ? -y.get(i) : y.get(i);
+		glm::quat const Reference = glm::normalize(glm::quat(
+			glm::mix(x.get(i).w, z.w, a[i]), glm::mix(x.get(i).x, z.x, a[i]),
+			glm::mix(x.get(i).y, z.y, a[i]), glm::mix(x.get(i).z, z.z, a[i])));
+		Largest = glm::max(Largest, max_ulps(out.get(i), Reference));
+	}
+	Error += Largest <= 2.0f ? 0 : 1;
+
+	std::printf("nlerp: %.1f ulps\n", Largest);
+	return Error;
+}
+
+static int test_slerp()
+{
+	int Error = 0;
+
+	quats x(Count), y(Count), out(Count), single(Count);
+	std::vector<float> a(Count);
+	make_pairs(x, y, a);
+
+	glm::slerp(x.soa(), y.soa(), &a[0], out.soa(), Count);
+	glm::slerp(x.soa(), y.soa(), 0.3f, single.soa(), Count);
+
+	float Largest = 0.0f;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		Largest = glm::max(Largest, max_ulps(out.get(i), glm::slerp(x.get(i), y.get(i), a[i])));
+		Largest = glm::max(Largest, max_ulps(single.get(i), glm::slerp(x.get(i), y.get(i), 0.3f)));
+	}
+	Error += Largest <= 4.0f ? 0 : 1;
+
+	// in place
+	glm::slerp(x.soa(), y.soa(), &a[0], x.soa(), Count);
+	for(std::size_t i = 0; i < Count; ++i)
+		Error += x.get(i) == out.get(i) ? 0 : 1;
+
+	std::printf("slerp: %.1f ulps\n", Largest);
+	return Error;
+}
+
+static int test_mat_cast()
+{
+	int Error = 0;
+
+	quats q(Count);
+	unsigned int seed = 5;
+	for(std::size_t i = 0; i < Count; ++i)
+		q.set(i, random_quat(seed));
+
+	std::vector<glm::mat3> m3(Count);
+	std::vector<glm::mat4> m4(Count);
+	glm::mat3_cast(q.soa(), &m3[0], Count);
+	glm::mat4_cast(q.soa(), &m4[0], Count);
+
+	float Largest = 0.0f;
+	for(std::size_t i = 0; i < Count; ++i)
+	{
+		glm::mat3 const Reference3 = glm::mat3_cast(q.get(i));
+		glm::mat4 const Reference4 = glm::mat4_cast(q.get(i));
+		for(glm::length_t c = 0; c < 3; ++c)
+		for(glm::length_t r = 0; r < 3; ++r)
+			Largest = glm::max(Largest, ulps(m3[i][c][r], Reference3[c][r]));
+		for(glm::length_t c = 0; c < 4; ++c)
+		for(glm::length_t r = 0; r < 4; ++r)
+			Largest = glm::max(Largest, ulps(m4[i][c][r], Reference4[c][r]));
+	}
+	Error += Largest <= 2.0f ? 0 : 1;
+
+	std::printf("mat3_cast, mat4_cast: %.1f ulps\n", Largest);
+	return Error;
+}
+
+int perf_slerp()
+{
+	std::size_t const Size = 4096;
+	int const Rounds = 256;
+
+	quats x(Size), y(Size), out(Size);
+	std::vector<float> a(Size);
+	make_pairs(x, y, a);
+	std::vector<glm::quat> qx(Size), qy(Size), qout(Size);
+	for(std::size_t i = 0; i < Size; ++i)
+	{
+		qx[i] = x.get(i);
+		qy[i] = y.get(i);
+	}
+
+	std::clock_t const StartScalar = std::clock();
+	for(int r = 0; r < Rounds; ++r)
+	for(std::size_t i = 0; i < Size; ++i)
+		qout[i] = glm::slerp(qx[i], qy[i], a[i]);
+	std::clock_t const StartBatch = std::clock();
+	for(int r = 0; r < Rounds; ++r)
+		glm::slerp(x.soa(), y.soa(), &a[0], out.soa(), Size);
+	std::clock_t const End = std::clock();
+
+	std::printf("glm::slerp %d clocks, soa slerp %d clocks\n",
+		static_cast<int>(StartBatch - StartScalar), static_cast<int>(End - StartBatch));
+
+	return qout[Size / 2] == qout[Size / 2] && out.get(Size / 2) == out.get(Size / 2) ? 0 : 1;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_normalize();
+	Error += test_mul();
+	Error += test_rotate();
+	Error += test_nlerp();
+	Error += test_slerp();
+	Error += test_mat_cast();
+
+#	ifdef NDEBUG
+		Error += perf_slerp();
+#	endif//NDEBUG
+
+	return Error;
+}
@@ -0,0 +1,329 @@
+// stb_image_batch.c - decode a batch of small PNGs on N threads
+//
+// Compares the default allocator against a per-thread stbi_arena that is
+// reset after each image. The sprites are generated in memory, so no data
+// files are needed.
+//
+//   gcc -O2 -I../Includes stb_image_batch.c -o stb_image_batch -lpthread -lm
+//   cl /O2 /I..\Includes stb_image_batch.c
+//
+//   stb_image_batch [threads] [images] [size]      defaults: 4 10000 32
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "stb_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE bench_thread;
+static double bench_now(void)
+{
+   LARGE_INTEGER f, t;
+   QueryPerformanceFrequency(&f);
+   QueryPerformanceCounter(&t);
+   return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#include <pthread.h>
+#include <time.h>
+typedef pthread_t bench_thread;
+static double bench_now(void)
+{
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+#endif
+
+#define MAX_THREADS 64
+#define ARENA_SIZE  (1 << 20)
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// minimal PNG writer: RGBA, filter "sub", fixed-Huffman deflate that only
+// codes runs of the previous pixel, which is enough to give the inflater
+// literals, lengths and distances to work through
+//
+
+typedef struct
+{
+   unsigned char *data;
+   int len, cap;
+   unsigned int bits;
+   int nbits;
+} bench_buf;
+
+static void buf_put(bench_buf *b, unsigned char c)
+{
+   if (b->len == b->cap) {
+      b->cap = b->cap ? b->cap * 2 : 256;
+      b->data = (unsigned char *) realloc(b->data, b->cap);
+   }
+   b->data[b->len++] = c;
+}
+
+static void buf_put32(bench_buf *b, unsigned int v)
+{
+   buf_put(b, (unsigned char) (v >> 24)); buf_put(b, (unsigned char) (v >> 16));
+   buf_put(b, (unsigned char) (v >>  8)); buf_put(b, (unsigned char) v);
+}
+
+// deflate bits go out LSB first; Huffman codes are sent MSB first
+static void buf_bits(bench_buf *b, unsigned int v, int n)
+{
+   b->bits |= v << b->nbits;
+   b->nbits += n;
+   while (b->nbits >= 8) {
+      buf_put(b, (unsigned char) b->bits);
+      b->bits >>= 8;
+      b->nbits -= 8;
+   }
+}
+
+static void buf_code(bench_buf *b, unsigned int code, int n)
+{
+   unsigned int r = 0;
+   int i;
+   for (i=0; i < n; ++i)
+      r |= ((code >> i) & 1) << (n-1-i);
+   buf_bits(b, r, n);
+}
+
+static void deflate_literal(bench_buf *b, int c)
+{
+   if (c < 144) buf_code(b, 0x30 + c, 8);
+   else         buf_code(b, 0x190 + c - 144, 9);
+}
+
+static void deflate_match(bench_buf *b, int len, int dist)
+{
+   static const int lbase[] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+   static const int lextra[] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+   static const int dbase[] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+   static const int dextra[] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+   int i = 28, d = 29, sym;
+   while (lbase[i] > len) --i;
+   sym = 257 + i;
+   if (sym < 280) buf_code(b, sym - 256, 7);
+   else           buf_code(b, 0xc0 + sym - 280, 8);
+   buf_bits(b, len - lbase[i], lextra[i]);
+   while (dbase[d] > dist) --d;
+   buf_code(b, d, 5);
+   buf_bits(b, dist - dbase[d], dextra[d]);
+}
+
+static unsigned int crc32_png(unsigned char *p, int n)
+{
+   unsigned int c = 0xffffffffu;
+   int i, k;
+   for (i=0; i < n; ++i) {
+      c ^= p[i];
+      for (k=0; k < 8; ++k)
+         c = (c >> 1) ^ (0xedb88320u & (0u - (c & 1)));
+   }
+   return ~c;
+}
+
+static void png_chunk(bench_buf *out, const char *type, bench_buf *body)
+{
+   int start;
+   buf_put32(out, body ? body->len : 0);
+   start = out->len;
+   buf_put(out, type[0]); buf_put(out, type[1]); buf_put(out, type[2]); buf_put(out, type[3]);
+   if (body) {
+      int i;
+      for (i=0; i < body->len; ++i) buf_put(out, body->data[i]);
+   }
+   buf_put32(out, crc32_png(out->data + start, out->len - start));
+}
+
+// a sprite: a few flat-colored discs on a transparent background plus some
+// noise, so rows have both long runs and literal stretches
+static unsigned char *make_png(int size, unsigned int seed, int *len)
+{
+   bench_buf raw = { 0 }, z = { 0 }, ihdr = { 0 }, png = { 0 };
+   unsigned int a = 1, bsum = 0, noise = seed;
+   int cx[3], cy[3], x, y, i, k;
+
+   for (k=0; k < 3; ++k) {
+      cx[k] = (int) ((seed >> (k*5)) % size);
+      cy[k] = (int) ((seed >> (k*5+3)) % size);
+   }
+   for (y=0; y < size; ++y) {
+      unsigned char prev[4] = { 0,0,0,0 };
+      buf_put(&raw, 1); // sub filter
+      for (x=0; x < size; ++x) {
+         unsigned char px[4] = { 0,0,0,0 };
+         for (k=0; k < 3; ++k) {
+            int r = size/4 + k;
+            if ((x-cx[k])*(x-cx[k]) + (y-cy[k])*(y-cy[k]) < r*r) {
+               px[0] = (unsigned char) (seed * (k+1)); px[1] = (unsigned char) (seed >> 8); px[2] = (unsigned char) (k * 80); px[3] = 255;
+            }
+         }
+         noise = noise * 1664525u + 1013904223u;
+         if ((noise >> 28) == 0) px[0] ^= (unsigned char) (noise >> 20);
+         for (k=0; k < 4; ++k) {
+            buf_put(&raw, (unsigned char) (px[k] - prev[k]));
+            prev[k] = px[k];
+         }
+      }
+   }
+
+   // zlib stream: one fixed-Huffman block
+   buf_put(&z, 0x78); buf_put(&z, 0x01);
+   buf_bits(&z, 1, 1); buf_bits(&z, 1, 2);
+   for (i=0; i < raw.len; ) {
+      int run = 0;
+      if (i >= 4)
+         while (i + run < raw.len && run < 258 && raw.data[i+run] == raw.data[i+run-4]) ++run;
+      if (run >= 3) {
+         deflate_match(&z, run, 4);
+         i += run;
+      } else
+         deflate_literal(&z, raw.data[i++]);
+   }
+   buf_code(&z, 0, 7); // end of block
+   if (z.nbits) buf_bits(&z, 0, 8 - z.nbits);
+   for (i=0; i < raw.len; ++i) {
+      a = (a + raw.data[i]) % 65521;
+      bsum = (bsum + a) % 65521;
+   }
+   buf_put32(&z, (bsum << 16) | a);
+
+   buf_put32(&ihdr, size); buf_put32(&ihdr, size);
+   buf_put(&ihdr, 8); buf_put(&ihdr, 6); buf_put(&ihdr, 0); buf_put(&ihdr, 0); buf_put(&ihdr, 0);
+
+   for (i=0; i < 8; ++i) buf_put(&png, "\x89PNG\r\n\x1a\n"[i]);
+   png_chunk(&png, "IHDR", &ihdr);
+   png_chunk(&png, "IDAT", &z);
+   png_chunk(&png, "IEND", NULL);
+
+   free(raw.data); free(z.data); free(ihdr.data);
+   *len = png.len;
+   return png.data;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// benchmark
+//
+
+typedef struct
+{
+   unsigned char **files;
+   int *lens;
+   int first, count;
+   int use_arena;
+   unsigned long checksum;
+   int failures;
+} bench_job;
+
+#ifdef _WIN32
+static DWORD WINAPI bench_worker(LPVOID arg)
+#else
+static void *bench_worker(void *arg)
+#endif
+{
+   bench_job *job = (bench_job *) arg;
+   stbi_arena arena;
+   stbi_allocator allocator;
+   unsigned char *memory = NULL;
+   int i;
+
+   if (job->use_arena) {
+      memory = (unsigned char *) malloc(ARENA_SIZE);
+      stbi_arena_init(&arena, memory, ARENA_SIZE);
+      allocator = stbi_arena_allocator(&arena);
+      stbi_set_allocator_thread(&allocator);
+   }
+   for (i=job->first; i < job->first + job->count; ++i) {
+      int x, y, n;
+      stbi_uc *data = stbi_load_from_memory(job->files[i], job->lens[i], &x, &y, &n, 4);
+      if (data) {
+         job->checksum += data[(x*y*4) / 2];
+         stbi_image_free(data);
+      } else
+         ++job->failures;
+      if (job->use_arena)
+         stbi_arena_reset(&arena);
+   }
+   if (job->use_arena) {
+      stbi_set_allocator_thread(NULL);
+      free(memory);
+   }
+   return 0;
+}
+
+static double run(unsigned char **files, int *lens, int images, int threads, int use_arena, unsigned long *checksum)
+{
+   bench_job jobs[MAX_THREADS];
+   bench_thread handles[MAX_THREADS];
+   double start = bench_now();
+   int t;
+   for (t=0; t < threads; ++t) {
+      jobs[t].files = files;
+      jobs[t].lens = lens;
+      jobs[t].first = images * t / threads;
+      jobs[t].count = images * (t+1) / threads - jobs[t].first;
+      jobs[t].use_arena = use_arena;
+      jobs[t].checksum = 0;
+      jobs[t].failures = 0;
+#ifdef _WIN32
+      handles[t] = CreateThread(NULL, 0, bench_worker, &jobs[t], 0, NULL);
+#else
+      pthread_create(&handles[t], NULL, bench_worker, &jobs[t]);
+#endif
+   }
+   *checksum = 0;
+   for (t=0; t < threads; ++t) {
+#ifdef _WIN32
+      WaitForSingleObject(handles[t], INFINITE);
+      CloseHandle(handles[t]);
+#else
+      pthread_join(handles[t], NULL);
+#endif
+      *checksum += jobs[t].checksum;
+      if (jobs[t].failures) printf("  %d images failed to decode\n", jobs[t].failures);
+   }
+   return bench_now() - start;
+}
+
+int main(int argc, char **argv)
+{
+   int threads = argc > 1 ? atoi(argv[1]) : 4;
+   int images  = argc > 2 ? atoi(argv[2]) : 10000;
+   int size    = argc > 3 ? atoi(argv[3]) : 32;
+   unsigned char **files;
+   int *lens, i, pass;
+   long total = 0;
+
+   if (threads < 1) threads = 1;
+   if (threads > MAX_THREADS) threads = MAX_THREADS;
+   if (images < 1 || size < 1) return 1;
+
+   files = (unsigned char **) malloc(images * sizeof(*files));
+   lens = (int *) malloc(images * sizeof(*lens));
+   for (i=0; i < images; ++i) {
+      files[i] = make_png(size, 0x9e3779b9u * (i+1), &lens[i]);
+      total += lens[i];
+   }
+   printf("%d PNGs of %dx%d RGBA, %.1f KB compressed, %d threads\n", images, size, size, total / 1024.0, threads);
+
+   for (pass=0; pass < 3; ++pass) {
+      unsigned long sum_heap, sum_arena;
+      double heap = run(files, lens, images, threads, 0, &sum_heap);
+      double arena = run(files, lens, images, threads, 1, &sum_arena);
+      printf("  malloc: %7.1f ms  %8.0f images/s     arena: %7.1f ms  %8.0f images/s%s\n",
+             heap * 1000, images / heap, arena * 1000, images / arena,
+             sum_heap == sum_arena ? "" : "   (checksum mismatch)");
+   }
+
+   for (i=0; i < images; ++i) free(files[i]);
+   free(files);
+   free(lens);
+   return 0;
+}
@@ -0,0 +1,313 @@
+// stb_image_decode.c - single-thread PNG decode throughput
+//
+// Decodes large PNGs whose rows cycle through all five filter types, so
+// both inflate and every unfilter path are timed: RGBA and RGB at
+// 1024x1024, grey at 2048x1024. Before timing it checks that zlib streams
+// ending in a single literal decode into an exactly sized buffer. The images
+// are generated in memory, so no data files are needed.
+//
+//   gcc -O2 -I../Includes stb_image_decode.c -o stb_image_decode -lm
+//   cl /O2 /I..\Includes stb_image_decode.c
+//
+//   stb_image_decode [decodes]      default: 20
+//
+// Build with -DSTBI_NO_AVX2 or -DSTBI_NO_SIMD to time the narrower paths.
+
+#define STB_IMAGE_IMPLEMENTATION
+#define STBI_ONLY_PNG
+#include "stb_image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+static double bench_now(void)
+{
+   LARGE_INTEGER f, t;
+   QueryPerformanceFrequency(&f);
+   QueryPerformanceCounter(&t);
+   return (double) t.QuadPart / (double) f.QuadPart;
+}
+#else
+#include <time.h>
+static double bench_now(void)
+{
+   struct timespec t;
+   clock_gettime(CLOCK_MONOTONIC, &t);
+   return t.tv_sec + t.tv_nsec * 1e-9;
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// minimal PNG writer: filtered rows, fixed-Huffman deflate that codes runs
+// matching the previous pixel or the previous row
+//
+
+typedef struct
+{
+   unsigned char *data;
+   int len, cap;
+   unsigned int bits;
+   int nbits;
+} bench_buf;
+
+static void buf_put(bench_buf *b, unsigned char c)
+{
+   if (b->len == b->cap) {
+      b->cap = b->cap ? b->cap * 2 : 256;
+      b->data = (unsigned char *) realloc(b->data, b->cap);
+   }
+   b->data[b->len++] = c;
+}
+
+static void buf_put32(bench_buf *b, unsigned int v)
+{
+   buf_put(b, (unsigned char) (v >> 24)); buf_put(b, (unsigned char) (v >> 16));
+   buf_put(b, (unsigned char) (v >>  8)); buf_put(b, (unsigned char) v);
+}
+
+// deflate bits go out LSB first; Huffman codes are sent MSB first
+static void buf_bits(bench_buf *b, unsigned int v, int n)
+{
+   b->bits |= v << b->nbits;
+   b->nbits += n;
+   while (b->nbits >= 8) {
+      buf_put(b, (unsigned char) b->bits);
+      b->bits >>= 8;
+      b->nbits -= 8;
+   }
+}
+
+static void buf_code(bench_buf *b, unsigned int code, int n)
+{
+   unsigned int r = 0;
+   int i;
+   for (i=0; i < n; ++i)
+      r |= ((code >> i) & 1) << (n-1-i);
+   buf_bits(b, r, n);
+}
+
+static void deflate_literal(bench_buf *b, int c)
+{
+   if (c < 144) buf_code(b, 0x30 + c, 8);
+   else         buf_code(b, 0x190 + c - 144, 9);
+}
+
+static void deflate_match(bench_buf *b, int len, int dist)
+{
+   static const int lbase[] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+   static const int lextra[] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+   static const int dbase[] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+   static const int dextra[] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+   int i = 28, d = 29, sym;
+   while (lbase[i] > len) --i;
+   sym = 257 + i;
+   if (sym < 280) buf_code(b, sym - 256, 7);
+   else           buf_code(b, 0xc0 + sym - 280, 8);
+   buf_bits(b, len - lbase[i], lextra[i]);
+   while (dbase[d] > dist) --d;
+   buf_code(b, d, 5);
+   buf_bits(b, dist - dbase[d], dextra[d]);
+}
+
+static int match_length(const unsigned char *p, int i, int n, int dist)
+{
+   int run = 0;
+   if (i >= dist)
+      while (i + run < n && run < 258 && p[i+run] == p[i+run-dist]) ++run;
+   return run;
+}
+
+// a zlib stream of one fixed-Huffman block; dist2 is a second match
+// distance to try besides dist, 0 for none
+static void zlib_compress(bench_buf *z, const unsigned char *p, int n, int dist, int dist2)
+{
+   unsigned int a = 1, bsum = 0;
+   int i;
+   buf_put(z, 0x78); buf_put(z, 0x01);
+   buf_bits(z, 1, 1); buf_bits(z, 1, 2);
+   for (i=0; i < n; ) {
+      int run = match_length(p, i, n, dist), d = dist;
+      if (dist2 && dist2 <= 32768) {
+         int run2 = match_length(p, i, n, dist2);
+         if (run2 > run) { run = run2; d = dist2; }
+      }
+      if (run >= 3) {
+         deflate_match(z, run, d);
+         i += run;
+      } else
+         deflate_literal(z, p[i++]);
+   }
+   buf_code(z, 0, 7); // end of block
+   if (z->nbits) buf_bits(z, 0, 8 - z->nbits);
+   for (i=0; i < n; ++i) {
+      a = (a + p[i]) % 65521;
+      bsum = (bsum + a) % 65521;
+   }
+   buf_put32(z, (bsum << 16) | a);
+}
+
+static unsigned int crc32_png(unsigned char *p, int n)
+{
+   unsigned int c = 0xffffffffu;
+   int i, k;
+   for (i=0; i < n; ++i) {
+      c ^= p[i];
+      for (k=0; k < 8; ++k)
+         c = (c >> 1) ^ (0xedb88320u & (0u - (c & 1)));
+   }
+   return ~c;
+}
+
+static void png_chunk(bench_buf *out, const char *type, bench_buf *body)
+{
+   int start;
+   buf_put32(out, body ? body->len : 0);
+   start = out->len;
+   buf_put(out, type[0]); buf_put(out, type[1]); buf_put(out, type[2]); buf_put(out, type[3]);
+   if (body) {
+      int i;
+      for (i=0; i < body->len; ++i) buf_put(out, body->data[i]);
+   }
+   buf_put32(out, crc32_png(out->data + start, out->len - start));
+}
+
+static int paeth(int a, int b, int c)
+{
+   int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+   if (pa <= pb && pa <= pc) return a;
+   if (pb <= pc) return b;
+   return c;
+}
+
+// smooth gradients with a few hard-edged bands and sparse noise; row y uses
+// filter y % 5. The pixels are returned in *pixels for checking the decode.
+static unsigned char *make_png(int w, int h, int channels, int *len, unsigned char **pixels)
+{
+   static const int color_type[5] = { 0, 0, 0, 2, 6 };
+   bench_buf raw = { 0 }, z = { 0 }, ihdr = { 0 }, png = { 0 };
+   int stride = w * channels, x, y, k, i;
+   unsigned int noise = 12345;
+   unsigned char *img = (unsigned char *) malloc((size_t) stride * h);
+
+   for (y=0; y < h; ++y) {
+      for (x=0; x < w; ++x) {
+         unsigned char *px = img + (size_t) y * stride + x * channels;
+         for (k=0; k < channels; ++k)
+            px[k] = (unsigned char) ((x * (k+1) + y * (3-k)) >> 2);
+         if (((x >> 6) + (y >> 5)) % 7 == 0)
+            px[0] = (unsigned char) (200 + (y & 31));
+         noise = noise * 1664525u + 1013904223u;
+         if ((noise >> 27) == 0) px[channels-1] ^= (unsigned char) (noise >> 19);
+      }
+   }
+
+   for (y=0; y < h; ++y) {
+      const unsigned char *row = img + (size_t) y * stride;
+      const unsigned char *up = y ? row - stride : NULL;
+      int filter = y % 5;
+      buf_put(&raw, (unsigned char) filter);
+      for (i=0; i < stride; ++i) {
+         int a = i >= channels ? row[i-channels] : 0;
+         int b = up ? up[i] : 0;
+         int c = (up && i >= channels) ? up[i-channels] : 0;
+         int pred = 0;
+         switch (filter) {
+            case 1: pred = a; break;
+            case 2: pred = b; break;
+            case 3: pred = (a + b) >> 1; break;
+            case 4: pred = paeth(a, b, c); break;
+         }
+         buf_put(&raw, (unsigned char) (row[i] - pred));
+      }
+   }
+   zlib_compress(&z, raw.data, raw.len, channels, stride + 1);
+
+   buf_put32(&ihdr, w); buf_put32(&ihdr, h);
+   buf_put(&ihdr, 8); buf_put(&ihdr, (unsigned char) color_type[channels]); buf_put(&ihdr, 0); buf_put(&ihdr, 0); buf_put(&ihdr, 0);
+
+   for (i=0; i < 8; ++i) buf_put(&png, "\x89PNG\r\n\x1a\n"[i]);
+   png_chunk(&png, "IHDR", &ihdr);
+   png_chunk(&png, "IDAT", &z);
+   png_chunk(&png, "IEND", NULL);
+
+   free(raw.data); free(z.data); free(ihdr.data);
+   *pixels = img;
+   *len = png.len;
+   return png.data;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// checks and benchmark
+//
+
+// zlib streams of every length up to 1000 whose last symbol is a literal,
+// decoded into buffers of exactly that length; returns the failures
+static int check_exact_buffers(void)
+{
+   unsigned char data[1000];
+   char out[1000];
+   int n, i, failures = 0;
+   for (i=0; i < 1000; ++i)
+      data[i] = (unsigned char) ((i * 7) ^ (i >> 3));
+   for (n=1; n <= 1000; ++n) {
+      bench_buf z = { 0 };
+      int got;
+      zlib_compress(&z, data, n, 1, 0);
+      got = stbi_zlib_decode_buffer(out, n, (const char *) z.data, z.len);
+      if (got != n || memcmp(out, data, n) != 0) {
+         if (failures < 5)
+            printf("  exact-size zlib decode of %d bytes returned %d\n", n, got);
+         ++failures;
+      }
+      free(z.data);
+   }
+   return failures;
+}
+
+int main(int argc, char **argv)
+{
+   static const struct { int w, h, channels; const char *name; } images[] = {
+      { 1024, 1024, 4, "RGBA 1024x1024" },
+      { 1024, 1024, 3, "RGB  1024x1024" },
+      { 2048, 1024, 1, "grey 2048x1024" },
+   };
+   int decodes = argc > 1 ? atoi(argv[1]) : 20;
+   int i, k, failures;
+   double total_bytes = 0, total_time = 0;
+
+   if (decodes < 1) return 1;
+
+   failures = check_exact_buffers();
+   printf("exact-size zlib buffers: %s\n", failures ? "FAILED" : "ok");
+
+   for (i=0; i < (int) (sizeof(images) / sizeof(images[0])); ++i) {
+      unsigned char *pixels, *file;
+      int len, x, y, n, same = 1;
+      size_t bytes = (size_t) images[i].w * images[i].h * images[i].channels;
+      double start, t;
+
+      file = make_png(images[i].w, images[i].h, images[i].channels, &len, &pixels);
+      start = bench_now();
+      for (k=0; k < decodes; ++k) {
+         stbi_uc *data = stbi_load_from_memory(file, len, &x, &y, &n, 0);
+         if (!data) { same = 0; break; }
+         if (k == 0) same = memcmp(data, pixels, bytes) == 0;
+         stbi_image_free(data);
+      }
+      t = bench_now() - start;
+      printf("  %s  %6.1f KB  %7.1f ms/decode  %6.1f MB/s%s\n", images[i].name, len / 1024.0,
+             t * 1000 / decodes, bytes * decodes / t / (1024 * 1024), same ? "" : "  MISMATCH");
+      if (!same) ++failures;
+      total_bytes += (double) bytes * decodes;
+      total_time += t;
+      free(file);
+      free(pixels);
+   }
+   printf("overall %.1f MB/s\n", total_bytes / total_time / (1024 * 1024));
+   return failures ? 1 : 0;
+}
@@ -186,6 +186,17 @@ namespace detail
 		}
 	};
 
+	template <precision P>
+	struct compute_fma_vector<float, P, tvec4, true>
+	{
+		GLM_FUNC_QUALIFIER static tvec4<float, P> call(tvec4<float, P> const & a, tvec4<float, P> const & b, tvec4<float, P> const & c)
+		{
+			tvec4<float, P> result(uninitialize);
+			result.data = glm_vec4_fma(a.data, b.data, c.data);
+			return result;
+		}
+	};
+
 	template <precision P>
 	struct compute_mix_vector<float, bool, P, tvec4, true>
 	{
@@ -687,6 +687,7 @@
 #	define GLM_ALIGNED_TYPEDEF(type, name, alignment) typedef __declspec(align(alignment)) type name
 #	define GLM_RESTRICT_FUNC __declspec(restrict)
 #	define GLM_RESTRICT __restrict
+#	define GLM_UNREACHABLE() __assume(0)
 #	if GLM_COMPILER >= GLM_COMPILER_VC12
 #		define GLM_VECTOR_CALL __vectorcall
 #	else
@@ -699,6 +700,7 @@
 #	define GLM_ALIGNED_TYPEDEF(type, name, alignment) typedef type name __attribute__((aligned(alignment)))
 #	define GLM_RESTRICT_FUNC __restrict__
 #	define GLM_RESTRICT __restrict__
+#	define GLM_UNREACHABLE() __builtin_unreachable()
 #	if GLM_COMPILER & GLM_COMPILER_CLANG
 #		if GLM_COMPILER >= GLM_COMPILER_CLANG37
 #			define GLM_VECTOR_CALL __vectorcall
@@ -715,6 +717,7 @@
 #	define GLM_ALIGNED_TYPEDEF(type, name, alignment) typedef type name __align__(x)
 #	define GLM_RESTRICT_FUNC __restrict__
 #	define GLM_RESTRICT __restrict__
+#	define GLM_UNREACHABLE()
 #	define GLM_VECTOR_CALL
 #else
 #	define GLM_DEPRECATED
@@ -723,6 +726,7 @@
 #	define GLM_ALIGNED_TYPEDEF(type, name, alignment) typedef type name
 #	define GLM_RESTRICT_FUNC
 #	define GLM_RESTRICT
+#	define GLM_UNREACHABLE()
 #	define GLM_VECTOR_CALL
 #endif//GLM_COMPILER
 
@@ -756,7 +760,31 @@
 #	define GLM_RELAXED_CONSTEXPR const
 #endif
 
-#if GLM_ARCH == GLM_ARCH_PURE
+// C++14 relaxed constexpr (N3652) for the vector and matrix operators and the
+// gtc/matrix_transform builders that don't need trigonometry or square roots.
+// The SIMD specializations of mat4 products can't be constant expressions, so
+// they check __builtin_is_constant_evaluated(), the builtin behind C++20's
+// std::is_constant_evaluated, and take the generic code there. Visual C++ is
+// left out, as for GLM_CONSTEXPR_CTOR.
+#if defined(__has_builtin) && !(GLM_COMPILER & GLM_COMPILER_VC)
+#	if __has_builtin(__builtin_is_constant_evaluated)
+#		define GLM_HAS_IS_CONSTANT_EVALUATED 1
+#	endif
+#endif
+#ifndef GLM_HAS_IS_CONSTANT_EVALUATED
+#	define GLM_HAS_IS_CONSTANT_EVALUATED 0
+#endif
+
+#define GLM_HAS_CONSTEXPR_CXX14 ((GLM_LANG & GLM_LANG_CXX14_FLAG) && GLM_HAS_CONSTEXPR && GLM_HAS_INITIALIZER_LISTS && GLM_HAS_IS_CONSTANT_EVALUATED)
+
+#if GLM_HAS_CONSTEXPR_CXX14
+#	define GLM_CONSTEXPR_CXX14 constexpr
+#	define GLM_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#	define GLM_CONSTEXPR_CXX14
+#endif
+
+#if GLM_ARCH == GLM_ARCH_PURE || GLM_HAS_CONSTEXPR_CXX14
 #	define GLM_CONSTEXPR_SIMD GLM_CONSTEXPR_CTOR
 #else
 #	define GLM_CONSTEXPR_SIMD
@@ -1,7 +1,105 @@
 /// @ref core
-/// @file glm/detail/type_mat4x4_sse2.inl
+/// @file glm/detail/type_mat4x4_simd.inl
 
-namespace glm
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#include "../simd/matrix.h"
+
+namespace glm{
+namespace detail
 {
+	// Packed matrices store their columns as float[4], so they go through
+	// unaligned loads. AVX builds multiply two columns per instruction. Under
+	// C++14 the products are constexpr, and constant evaluation takes the
+	// generic ones of type_mat4x4.inl.
+
+	template <precision P>
+	struct compute_mat4_mul<float, P, false>
+	{
+		GLM_FUNC_QUALIFIER static GLM_CONSTEXPR_CXX14 tmat4x4<float, P> call(tmat4x4<float, P> const & m1, tmat4x4<float, P> const & m2)
+		{
+#			if GLM_HAS_CONSTEXPR_CXX14
+				if(GLM_IS_CONSTANT_EVALUATED())
+					return mat4_mul(m1, m2);
+#			endif
+			return simd(m1, m2);
+		}
+
+		GLM_FUNC_QUALIFIER static tmat4x4<float, P> simd(tmat4x4<float, P> const & m1, tmat4x4<float, P> const & m2)
+		{
+			tmat4x4<float, P> Result(uninitialize);
+#			if GLM_ARCH & GLM_ARCH_AVX_BIT
+				glm_mat4_mul_avx(&m1[0][0], &m2[0][0], &Result[0][0]);
+#			else
+				glm_vec4 a[4], b[4], r[4];
+				glm_mat4_load(&m1[0][0], a);
+				glm_mat4_load(&m2[0][0], b);
+				glm_mat4_mul(a, b, r);
+				glm_mat4_store(r, &Result[0][0]);
+#			endif
+			return Result;
+		}
+	};
 
+	template <precision P>
+	struct compute_mat4_mul<float, P, true>
+	{
+		GLM_FUNC_QUALIFIER static tmat4x4<float, P> call(tmat4x4<float, P> const & m1, tmat4x4<float, P> const & m2)
+		{
+			tmat4x4<float, P> Result(uninitialize);
+#			if GLM_ARCH & GLM_ARCH_AVX_BIT
+				glm_mat4_mul_avx(&m1[0][0], &m2[0][0], &Result[0][0]);
+#			else
+				glm_mat4_mul(
+					*reinterpret_cast<glm_vec4 const(*)[4]>(&m1[0].data),
+					*reinterpret_cast<glm_vec4 const(*)[4]>(&m2[0].data),
+					*reinterpret_cast<glm_vec4(*)[4]>(&Result[0].data));
+#			endif
+			return Result;
+		}
+	};
+
+	template <precision P>
+	struct compute_mat4_mul_vec4<float, P, false>
+	{
+		GLM_FUNC_QUALIFIER static GLM_CONSTEXPR_CXX14 tvec4<float, P> call(tmat4x4<float, P> const & m, tvec4<float, P> const & v)
+		{
+#			if GLM_HAS_CONSTEXPR_CXX14
+				if(GLM_IS_CONSTANT_EVALUATED())
+					return mat4_mul_vec4(m, v);
+#			endif
+			return simd(m, v);
+		}
+
+		GLM_FUNC_QUALIFIER static tvec4<float, P> simd(tmat4x4<float, P> const & m, tvec4<float, P> const & v)
+		{
+			tvec4<float, P> Result(uninitialize);
+#			if GLM_ARCH & GLM_ARCH_AVX_BIT
+				_mm_storeu_ps(&Result[0], glm_mat4_mul_vec4_avx(&m[0][0], &v[0]));
+#			else
+				glm_vec4 a[4];
+				glm_mat4_load(&m[0][0], a);
+				_mm_storeu_ps(&Result[0], glm_mat4_mul_vec4(a, _mm_loadu_ps(&v[0])));
+#			endif
+			return Result;
+		}
+	};
+
+	template <precision P>
+	struct compute_mat4_mul_vec4<float, P, true>
+	{
+		GLM_FUNC_QUALIFIER static tvec4<float, P> call(tmat4x4<float, P> const & m, tvec4<float, P> const & v)
+		{
+			tvec4<float, P> Result(uninitialize);
+#			if GLM_ARCH & GLM_ARCH_AVX_BIT
+				Result.data = glm_mat4_mul_vec4_avx(&m[0][0], &v[0]);
+#			else
+				Result.data = glm_mat4_mul_vec4(*reinterpret_cast<glm_vec4 const(*)[4]>(&m[0].data), v.data);
+#			endif
+			return Result;
+		}
+	};
+}//namespace detail
 }//namespace glm
+
+#endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -0,0 +1,151 @@
+/// @ref gtx_approx
+/// @file glm/gtx/approx.hpp
+///
+/// @see core (dependence)
+/// @see gtx_fast_trigonometry
+/// @see gtx_fast_square_root
+///
+/// @defgroup gtx_approx GLM_GTX_approx
+/// @ingroup gtx
+///
+/// @brief Polynomial approximations of sin, cos, exp, log, pow and inversesqrt
+/// over float, vec4 and whole arrays, in namespace glm::approx.
+///
+/// The array functions process 8 values per step with AVX or AVX2, 4 with SSE2
+/// and one at a time otherwise; the last few values go through the same
+/// arithmetic one at a time, so results don't depend on where a value falls.
+/// vec4 goes through the 4 wide path. Only float is supported.
+///
+/// The polynomials are the minimax ones of the Cephes library, after range
+/// reduction. Largest error against the standard library in double, as
+/// checked by test/gtx/gtx_approx.cpp:
+/// - sin, cos: 2e-7 absolute for |x| up to 8192; the range reduction loses
+///   accuracy further out.
+/// - exp: 2 ulps. x below -87.34 gives 0, x above 88.376 gives +infinity.
+/// - log: 2 ulps for normal x > 0. 0 and denormals give -infinity, negative x
+///   gives NaN.
+/// - pow: exp(y * log(x)) for x > 0, 2 ulps plus 2 * |y * log(x)| ulps.
+/// - inversesqrt: 4 ulps for normal x > 0, from one Newton step on the SSE
+///   estimate. The estimate differs between CPU vendors, so the last bits may
+///   too. Without SSE2 it refines 1 / sqrt(x) and stays within 2 ulps.
+///
+/// Millions of values per second over arrays on one core of an AVX-512 server
+/// CPU, built with -O2 and -msse2, -mavx or -mavx2 -mfma. std is a loop over
+/// the standard library float functions; pow has the same exponent for every
+/// value:
+///
+///                   std     SSE2     AVX      AVX2
+///   sin, cos        ~180    ~650     ~1000    ~1500
+///   exp             ~220    ~550     ~850     ~1350
+///   log             ~200    ~350     ~500     ~850
+///   pow             ~120    ~150     ~230     ~400
+///   inversesqrt     ~450    ~2200    ~3300    ~4500
+///
+/// Without SSE2 the bit manipulation goes through memory and these are
+/// slower than the standard library; they are meant for SIMD builds.
+///
+/// <glm/gtx/approx.hpp> need to be included to use these functionalities.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include <cstddef>
+
+#if GLM_MESSAGES == GLM_MESSAGES_ENABLED && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_approx extension included")
+#endif
+
+namespace glm{
+namespace approx
+{
+	/// @addtogroup gtx_approx
+	/// @{
+
+	/// Approximated sine of an angle in radians.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL float sin(float x);
+
+	/// Approximated sine of each component.
+	/// From GLM_GTX_approx extension.
+	template <precision P>
+	GLM_FUNC_DECL tvec4<float, P> sin(tvec4<float, P> const & x);
+
+	/// out[i] = sin(x[i]). 'out' may be 'x'.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void sin(float const * x, float * out, std::size_t count);
+
+	/// Approximated cosine of an angle in radians.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL float cos(float x);
+
+	/// Approximated cosine of each component.
+	/// From GLM_GTX_approx extension.
+	template <precision P>
+	GLM_FUNC_DECL tvec4<float, P> cos(tvec4<float, P> const & x);
+
+	/// out[i] = cos(x[i]). 'out' may be 'x'.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void cos(float const * x, float * out, std::size_t count);
+
+	/// Approximated natural exponentiation of x.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL float exp(float x);
+
+	/// Approximated natural exponentiation of each component.
+	/// From GLM_GTX_approx extension.
+	template <precision P>
+	GLM_FUNC_DECL tvec4<float, P> exp(tvec4<float, P> const & x);
+
+	/// out[i] = exp(x[i]). 'out' may be 'x'.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void exp(float const * x, float * out, std::size_t count);
+
+	/// Approximated natural logarithm of x.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL float log(float x);
+
+	/// Approximated natural logarithm of each component.
+	/// From GLM_GTX_approx extension.
+	template <precision P>
+	GLM_FUNC_DECL tvec4<float, P> log(tvec4<float, P> const & x);
+
+	/// out[i] = log(x[i]). 'out' may be 'x'.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void log(float const * x, float * out, std::size_t count);
+
+	/// Approximated x raised to the y power, for x > 0.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL float pow(float x, float y);
+
+	/// Approximated pow of each component.
+	/// From GLM_GTX_approx extension.
+	template <precision P>
+	GLM_FUNC_DECL tvec4<float, P> pow(tvec4<float, P> const & x, tvec4<float, P> const & y);
+
+	/// out[i] = pow(x[i], y[i]). 'out' may be either input.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void pow(float const * x, float const * y, float * out, std::size_t count);
+
+	/// out[i] = pow(x[i], y), the same exponent for every value.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void pow(float const * x, float y, float * out, std::size_t count);
+
+	/// Approximated 1 / sqrt(x).
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL float inversesqrt(float x);
+
+	/// Approximated 1 / sqrt(x) of each component.
+	/// From GLM_GTX_approx extension.
+	template <precision P>
+	GLM_FUNC_DECL tvec4<float, P> inversesqrt(tvec4<float, P> const & x);
+
+	/// out[i] = inversesqrt(x[i]). 'out' may be 'x'.
+	/// From GLM_GTX_approx extension.
+	GLM_FUNC_DECL void inversesqrt(float const * x, float * out, std::size_t count);
+
+	/// @}
+}//namespace approx
+}//namespace glm
+
+#include "approx.inl"
@@ -0,0 +1,476 @@
+/// @ref gtx_approx
+/// @file glm/gtx/approx.inl
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace glm{
+namespace detail
+{
+	// One lane type per instruction set, as in gtx/quaternion_soa. Beside the
+	// arithmetic they give access to the bits a float is made of.
+	struct approx_lanes1
+	{
+		typedef float type;
+		typedef bool mask;
+		static std::size_t const size = 1;
+
+		GLM_FUNC_QUALIFIER static type load(float const * p){return *p;}
+		GLM_FUNC_QUALIFIER static void store(float * p, type v){*p = v;}
+		GLM_FUNC_QUALIFIER static type set(float s){return s;}
+		GLM_FUNC_QUALIFIER static type add(type a, type b){return a + b;}
+		GLM_FUNC_QUALIFIER static type sub(type a, type b){return a - b;}
+		GLM_FUNC_QUALIFIER static type mul(type a, type b){return a * b;}
+		GLM_FUNC_QUALIFIER static mask less(type a, type b){return a < b;}
+		GLM_FUNC_QUALIFIER static mask greater(type a, type b){return a > b;}
+		GLM_FUNC_QUALIFIER static mask equal(type a, type b){return a == b;}
+		GLM_FUNC_QUALIFIER static mask not_equal(type a, type b){return a != b;}
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b){return m ? a : b;}
+		GLM_FUNC_QUALIFIER static type negate(mask m, type a){return m ? -a : a;}
+
+		// whether bit 'bit' of a's representation is set
+		GLM_FUNC_QUALIFIER static mask bit_set(type a, int bit)
+		{
+			int i;
+			std::memcpy(&i, &a, sizeof(i));
+			return ((i >> bit) & 1) != 0;
+		}
+
+		// 2^n for an integral n in [-126, 127]
+		GLM_FUNC_QUALIFIER static type pow2(type n)
+		{
+			int const i = (static_cast<int>(n) + 127) << 23;
+			float f;
+			std::memcpy(&f, &i, sizeof(f));
+			return f;
+		}
+
+		// a = m * 2^e with m in [0.5, 1), for a normal positive a
+		GLM_FUNC_QUALIFIER static type frexp(type a, type & e)
+		{
+			int i;
+			std::memcpy(&i, &a, sizeof(i));
+			e = static_cast<float>(((i >> 23) & 0xff) - 126);
+			i = (i & 0x807fffff) | 0x3f000000;
+			float m;
+			std::memcpy(&m, &i, sizeof(m));
+			return m;
+		}
+
+		// the one the wider lanes start from, so all of them refine the same value
+		GLM_FUNC_QUALIFIER static type rsqrt_estimate(type a)
+		{
+#			if GLM_ARCH & GLM_ARCH_SSE2_BIT
+				return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+#			else
+				return 1.0f / std::sqrt(a);
+#			endif
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct approx_lanes4
+	{
+		typedef __m128 type;
+		typedef __m128 mask;
+		static std::size_t const size = 4;
+
+		GLM_FUNC_QUALIFIER static type load(float const * p){return _mm_loadu_ps(p);}
+		GLM_FUNC_QUALIFIER static void store(float * p, type v){_mm_storeu_ps(p, v);}
+		GLM_FUNC_QUALIFIER static type set(float s){return _mm_set1_ps(s);}
+		GLM_FUNC_QUALIFIER static type add(type a, type b){return _mm_add_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type sub(type a, type b){return _mm_sub_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type mul(type a, type b){return _mm_mul_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask less(type a, type b){return _mm_cmplt_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask greater(type a, type b){return _mm_cmpgt_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask equal(type a, type b){return _mm_cmpeq_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask not_equal(type a, type b){return _mm_cmpneq_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b){return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));}
+		GLM_FUNC_QUALIFIER static type negate(mask m, type a){return _mm_xor_ps(a, _mm_and_ps(m, _mm_set1_ps(-0.0f)));}
+
+		GLM_FUNC_QUALIFIER static mask bit_set(type a, int bit)
+		{
+			__m128i const b = _mm_set1_epi32(1 << bit);
+			return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_castps_si128(a), b), b));
+		}
+
+		GLM_FUNC_QUALIFIER static type pow2(type n)
+		{
+			return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23));
+		}
+
+		GLM_FUNC_QUALIFIER static type frexp(type a, type & e)
+		{
+			__m128i const i = _mm_castps_si128(a);
+			__m128i const exponent = _mm_and_si128(_mm_srli_epi32(i, 23), _mm_set1_epi32(0xff));
+			e = _mm_cvtepi32_ps(_mm_sub_epi32(exponent, _mm_set1_epi32(126)));
+			return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(i, _mm_set1_epi32(static_cast<int>(0x807fffff))), _mm_set1_epi32(0x3f000000)));
+		}
+
+		GLM_FUNC_QUALIFIER static type rsqrt_estimate(type a){return _mm_rsqrt_ps(a);}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	struct approx_lanes8
+	{
+		typedef __m256 type;
+		typedef __m256 mask;
+		static std::size_t const size = 8;
+
+		GLM_FUNC_QUALIFIER static type load(float const * p){return _mm256_loadu_ps(p);}
+		GLM_FUNC_QUALIFIER static void store(float * p, type v){_mm256_storeu_ps(p, v);}
+		GLM_FUNC_QUALIFIER static type set(float s){return _mm256_set1_ps(s);}
+		GLM_FUNC_QUALIFIER static type add(type a, type b){return _mm256_add_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type sub(type a, type b){return _mm256_sub_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type mul(type a, type b){return _mm256_mul_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask less(type a, type b){return _mm256_cmp_ps(a, b, _CMP_LT_OQ);}
+		GLM_FUNC_QUALIFIER static mask greater(type a, type b){return _mm256_cmp_ps(a, b, _CMP_GT_OQ);}
+		GLM_FUNC_QUALIFIER static mask equal(type a, type b){return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);}
+		GLM_FUNC_QUALIFIER static mask not_equal(type a, type b){return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ);}
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b){return _mm256_or_ps(_mm256_and_ps(m, a), _mm256_andnot_ps(m, b));}
+		GLM_FUNC_QUALIFIER static type negate(mask m, type a){return _mm256_xor_ps(a, _mm256_and_ps(m, _mm256_set1_ps(-0.0f)));}
+		GLM_FUNC_QUALIFIER static type rsqrt_estimate(type a){return _mm256_rsqrt_ps(a);}
+
+#		if GLM_ARCH & GLM_ARCH_AVX2_BIT
+			GLM_FUNC_QUALIFIER static mask bit_set(type a, int bit)
+			{
+				__m256i const b = _mm256_set1_epi32(1 << bit);
+				return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_castps_si256(a), b), b));
+			}
+
+			GLM_FUNC_QUALIFIER static type pow2(type n)
+			{
+				return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(127)), 23));
+			}
+
+			GLM_FUNC_QUALIFIER static type frexp(type a, type & e)
+			{
+				__m256i const i = _mm256_castps_si256(a);
+				__m256i const exponent = _mm256_and_si256(_mm256_srli_epi32(i, 23), _mm256_set1_epi32(0xff));
+				e = _mm256_cvtepi32_ps(_mm256_sub_epi32(exponent, _mm256_set1_epi32(126)));
+				return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(i, _mm256_set1_epi32(static_cast<int>(0x807fffff))), _mm256_set1_epi32(0x3f000000)));
+			}
+#		else
+			// AVX has no 256-bit integer instructions: the bit work goes half by half
+			GLM_FUNC_QUALIFIER static type join(__m128 l, __m128 h){return _mm256_insertf128_ps(_mm256_castps128_ps256(l), h, 1);}
+			GLM_FUNC_QUALIFIER static __m128 low(type a){return _mm256_castps256_ps128(a);}
+			GLM_FUNC_QUALIFIER static __m128 high(type a){return _mm256_extractf128_ps(a, 1);}
+
+			GLM_FUNC_QUALIFIER static mask bit_set(type a, int bit)
+			{
+				return join(approx_lanes4::bit_set(low(a), bit), approx_lanes4::bit_set(high(a), bit));
+			}
+
+			GLM_FUNC_QUALIFIER static type pow2(type n)
+			{
+				return join(approx_lanes4::pow2(low(n)), approx_lanes4::pow2(high(n)));
+			}
+
+			GLM_FUNC_QUALIFIER static type frexp(type a, type & e)
+			{
+				__m128 lowE, highE;
+				type const m = join(approx_lanes4::frexp(low(a), lowE), approx_lanes4::frexp(high(a), highE));
+				e = join(lowE, highE);
+				return m;
+			}
+#		endif//GLM_ARCH & GLM_ARCH_AVX2_BIT
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+	// a + 1.5 * 2^23 rounds a to the nearest integer, ties to even, for
+	// |a| < 2^22, and leaves that integer in the low bits of the sum
+	GLM_FUNC_QUALIFIER float approx_round_shift(){return 12582912.0f;}
+
+	// sin(x), or cos(x) as sin(x + pi / 2). The angle is reduced to r in
+	// [-pi / 4, pi / 4] with x = r + j * pi / 2, pi / 2 split in 3 so j * pi / 2
+	// stays exact; bits 0 and 1 of j pick the polynomial and the sign.
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type approx_sin(typename L::type x, bool cosine)
+	{
+		typedef typename L::type type;
+
+		type shifted = L::add(L::mul(x, L::set(0.636619772367581f)), L::set(approx_round_shift()));
+		type const j = L::sub(shifted, L::set(approx_round_shift()));
+		if(cosine)
+			shifted = L::add(shifted, L::set(1.0f));
+
+		type r = L::sub(x, L::mul(j, L::set(1.5703125f)));
+		r = L::sub(r, L::mul(j, L::set(4.837512969970703125e-4f)));
+		r = L::sub(r, L::mul(j, L::set(7.549789948768648e-8f)));
+		type const z = L::mul(r, r);
+
+		type s = L::set(-1.9515295891e-4f);
+		s = L::add(L::mul(s, z), L::set(8.3321608736e-3f));
+		s = L::add(L::mul(s, z), L::set(-1.6666654611e-1f));
+		s = L::add(L::mul(L::mul(s, z), r), r);
+
+		type c = L::set(2.443315711809948e-5f);
+		c = L::add(L::mul(c, z), L::set(-1.388731625493765e-3f));
+		c = L::add(L::mul(c, z), L::set(4.166664568298827e-2f));
+		c = L::add(L::sub(L::mul(L::mul(c, z), z), L::mul(L::set(0.5f), z)), L::set(1.0f));
+
+		return L::negate(L::bit_set(shifted, 1), L::select(L::bit_set(shifted, 0), c, s));
+	}
+
+	// x = r + n * ln(2), r in [-ln(2) / 2, ln(2) / 2], then exp(x) = exp(r) * 2^n
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type approx_exp(typename L::type x)
+	{
+		typedef typename L::type type;
+
+		type const high = L::set(88.3762626647949f);
+		type const low = L::set(-87.3365447505531f);
+		typename L::mask const overflow = L::greater(x, high);
+		typename L::mask const underflow = L::less(x, low);
+		type const a = L::select(overflow, high, L::select(underflow, low, x));
+
+		type const n = L::sub(L::add(L::mul(a, L::set(1.44269504088896341f)), L::set(approx_round_shift())), L::set(approx_round_shift()));
+		type r = L::sub(a, L::mul(n, L::set(0.693359375f)));
+		r = L::sub(r, L::mul(n, L::set(-2.12194440e-4f)));
+		type const z = L::mul(r, r);
+
+		type p = L::set(1.9875691500e-4f);
+		p = L::add(L::mul(p, r), L::set(1.3981999507e-3f));
+		p = L::add(L::mul(p, r), L::set(8.3334519073e-3f));
+		p = L::add(L::mul(p, r), L::set(4.1665795894e-2f));
+		p = L::add(L::mul(p, r), L::set(1.6666665459e-1f));
+		p = L::add(L::mul(p, r), L::set(5.0000001201e-1f));
+		p = L::add(L::add(L::mul(p, z), r), L::set(1.0f));
+
+		type const y = L::mul(p, L::pow2(n));
+		return L::select(overflow, L::set(std::numeric_limits<float>::infinity()), L::select(underflow, L::set(0.0f), y));
+	}
+
+	// x = m * 2^e with m in [sqrt(2) / 2, sqrt(2)), then log(x) = log(m) + e * ln(2)
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type approx_log(typename L::type x)
+	{
+		typedef typename L::type type;
+
+		type e;
+		type m = L::frexp(x, e);
+		typename L::mask const small = L::less(m, L::set(0.707106781186547524f));
+		e = L::sub(e, L::select(small, L::set(1.0f), L::set(0.0f)));
+		m = L::sub(L::select(small, L::add(m, m), m), L::set(1.0f));
+		type const z = L::mul(m, m);
+
+		type p = L::set(7.0376836292e-2f);
+		p = L::add(L::mul(p, m), L::set(-1.1514610310e-1f));
+		p = L::add(L::mul(p, m), L::set(1.1676998740e-1f));
+		p = L::add(L::mul(p, m), L::set(-1.2420140846e-1f));
+		p = L::add(L::mul(p, m), L::set(1.4249322787e-1f));
+		p = L::add(L::mul(p, m), L::set(-1.6668057665e-1f));
+		p = L::add(L::mul(p, m), L::set(2.0000714765e-1f));
+		p = L::add(L::mul(p, m), L::set(-2.4999993993e-1f));
+		p = L::add(L::mul(p, m), L::set(3.3333331174e-1f));
+		p = L::mul(L::mul(p, m), z);
+		p = L::add(p, L::mul(e, L::set(-2.12194440e-4f)));
+		p = L::sub(p, L::mul(L::set(0.5f), z));
+		type y = L::add(m, p);
+		y = L::add(y, L::mul(e, L::set(0.693359375f)));
+
+		type const infinity = L::set(std::numeric_limits<float>::infinity());
+		y = L::select(L::less(x, L::set(1.17549435e-38f)), L::set(-std::numeric_limits<float>::infinity()), y);
+		y = L::select(L::less(x, L::set(0.0f)), L::set(std::numeric_limits<float>::quiet_NaN()), y);
+		y = L::select(L::equal(x, infinity), infinity, y);
+		return L::select(L::not_equal(x, x), x, y);
+	}
+
+	// one Newton step: y * (1.5 - 0.5 * x * y * y). 0, infinity and anything
+	// negative make it NaN, where the estimate already is the answer.
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type approx_inversesqrt(typename L::type x)
+	{
+		typedef typename L::type type;
+
+		type const y = L::rsqrt_estimate(x);
+		type const refined = L::mul(L::mul(L::set(0.5f), y), L::sub(L::set(3.0f), L::mul(L::mul(x, y), y)));
+		return L::select(L::not_equal(refined, refined), y, refined);
+	}
+
+	enum approx_function
+	{
+		APPROX_SIN,
+		APPROX_COS,
+		APPROX_EXP,
+		APPROX_LOG,
+		APPROX_POW,
+		APPROX_INVERSESQRT
+	};
+
+	// The function is a template parameter, so each loop has only its own
+	// arithmetic in it.
+	template <approx_function F>
+	struct approx_kernel
+	{
+		float const * x;
+		float const * y;
+		float y0;
+		float * out;
+
+		GLM_FUNC_QUALIFIER approx_kernel(float const * x, float const * y, float y0, float * out) :
+			x(x), y(y), y0(y0), out(out)
+		{}
+
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typename L::type const a = L::load(x + i);
+			switch(F)
+			{
+			case APPROX_SIN:
+				L::store(out + i, approx_sin<L>(a, false));
+				break;
+			case APPROX_COS:
+				L::store(out + i, approx_sin<L>(a, true));
+				break;
+			case APPROX_EXP:
+				L::store(out + i, approx_exp<L>(a));
+				break;
+			case APPROX_LOG:
+				L::store(out + i, approx_log<L>(a));
+				break;
+			case APPROX_POW:
+				L::store(out + i, approx_exp<L>(L::mul(y ? L::load(y + i) : L::set(y0), approx_log<L>(a))));
+				break;
+			case APPROX_INVERSESQRT:
+				L::store(out + i, approx_inversesqrt<L>(a));
+				break;
+			}
+		}
+	};
+
+	// Runs Kernel.step<L>(i) over [0, count) with the widest lanes available,
+	// then narrower ones for what is left.
+	template <approx_function F>
+	GLM_FUNC_QUALIFIER void approx_run(float const * x, float const * y, float y0, float * out, std::size_t count)
+	{
+		approx_kernel<F> const Kernel(x, y, y0, out);
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			for(; i + approx_lanes8::size <= count; i += approx_lanes8::size)
+				Kernel.template step<approx_lanes8>(i);
+#		endif
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			for(; i + approx_lanes4::size <= count; i += approx_lanes4::size)
+				Kernel.template step<approx_lanes4>(i);
+#		endif
+		for(; i < count; ++i)
+			Kernel.template step<approx_lanes1>(i);
+	}
+
+	template <approx_function F, precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> approx_vec4(tvec4<float, P> const & x, float const * y)
+	{
+		tvec4<float, P> Result;
+		approx_run<F>(&x[0], y, 0.0f, &Result[0], 4);
+		return Result;
+	}
+}//namespace detail
+
+namespace approx
+{
+	GLM_FUNC_QUALIFIER float sin(float x)
+	{
+		return detail::approx_sin<detail::approx_lanes1>(x, false);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> sin(tvec4<float, P> const & x)
+	{
+		return detail::approx_vec4<detail::APPROX_SIN>(x, 0);
+	}
+
+	GLM_FUNC_QUALIFIER void sin(float const * x, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_SIN>(x, 0, 0.0f, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER float cos(float x)
+	{
+		return detail::approx_sin<detail::approx_lanes1>(x, true);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> cos(tvec4<float, P> const & x)
+	{
+		return detail::approx_vec4<detail::APPROX_COS>(x, 0);
+	}
+
+	GLM_FUNC_QUALIFIER void cos(float const * x, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_COS>(x, 0, 0.0f, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER float exp(float x)
+	{
+		return detail::approx_exp<detail::approx_lanes1>(x);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> exp(tvec4<float, P> const & x)
+	{
+		return detail::approx_vec4<detail::APPROX_EXP>(x, 0);
+	}
+
+	GLM_FUNC_QUALIFIER void exp(float const * x, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_EXP>(x, 0, 0.0f, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER float log(float x)
+	{
+		return detail::approx_log<detail::approx_lanes1>(x);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> log(tvec4<float, P> const & x)
+	{
+		return detail::approx_vec4<detail::APPROX_LOG>(x, 0);
+	}
+
+	GLM_FUNC_QUALIFIER void log(float const * x, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_LOG>(x, 0, 0.0f, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER float pow(float x, float y)
+	{
+		return detail::approx_exp<detail::approx_lanes1>(y * detail::approx_log<detail::approx_lanes1>(x));
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> pow(tvec4<float, P> const & x, tvec4<float, P> const & y)
+	{
+		return detail::approx_vec4<detail::APPROX_POW>(x, &y[0]);
+	}
+
+	GLM_FUNC_QUALIFIER void pow(float const * x, float const * y, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_POW>(x, y, 0.0f, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER void pow(float const * x, float y, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_POW>(x, 0, y, out, count);
+	}
+
+	GLM_FUNC_QUALIFIER float inversesqrt(float x)
+	{
+		return detail::approx_inversesqrt<detail::approx_lanes1>(x);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4<float, P> inversesqrt(tvec4<float, P> const & x)
+	{
+		return detail::approx_vec4<detail::APPROX_INVERSESQRT>(x, 0);
+	}
+
+	GLM_FUNC_QUALIFIER void inversesqrt(float const * x, float * out, std::size_t count)
+	{
+		detail::approx_run<detail::APPROX_INVERSESQRT>(x, 0, 0.0f, out, count);
+	}
+}//namespace approx
+}//namespace glm
@@ -0,0 +1,498 @@
+/// @ref gtx_quaternion_soa
+/// @file glm/gtx/quaternion_soa.inl
+
+#include "../gtc/constants.hpp"
+#include <cmath>
+
+namespace glm{
+namespace detail
+{
+	// One lane type per instruction set. The kernels are written once against
+	// this interface, so the one at a time tail runs the SIMD body's arithmetic.
+	struct soa_lanes1
+	{
+		typedef float type;
+		typedef bool mask;
+		static std::size_t const size = 1;
+
+		GLM_FUNC_QUALIFIER static type load(float const * p){return *p;}
+		GLM_FUNC_QUALIFIER static void store(float * p, type v){*p = v;}
+		GLM_FUNC_QUALIFIER static type set(float s){return s;}
+		GLM_FUNC_QUALIFIER static type add(type a, type b){return a + b;}
+		GLM_FUNC_QUALIFIER static type sub(type a, type b){return a - b;}
+		GLM_FUNC_QUALIFIER static type mul(type a, type b){return a * b;}
+		GLM_FUNC_QUALIFIER static type div(type a, type b){return a / b;}
+		GLM_FUNC_QUALIFIER static type sqrt(type a){return std::sqrt(a);}
+		GLM_FUNC_QUALIFIER static mask less(type a, type b){return a < b;}
+		GLM_FUNC_QUALIFIER static mask less_equal(type a, type b){return a <= b;}
+		GLM_FUNC_QUALIFIER static mask greater(type a, type b){return a > b;}
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b){return m ? a : b;}
+		GLM_FUNC_QUALIFIER static type negate(mask m, type a){return m ? -a : a;}
+
+		// m holds the upper 3x3 part, column by column
+		GLM_FUNC_QUALIFIER static void store_mat4(mat4 * out, type const m[9])
+		{
+			*out = mat4(
+				m[0], m[1], m[2], 0.0f,
+				m[3], m[4], m[5], 0.0f,
+				m[6], m[7], m[8], 0.0f,
+				0.0f, 0.0f, 0.0f, 1.0f);
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	struct soa_lanes4
+	{
+		typedef __m128 type;
+		typedef __m128 mask;
+		static std::size_t const size = 4;
+
+		GLM_FUNC_QUALIFIER static type load(float const * p){return _mm_loadu_ps(p);}
+		GLM_FUNC_QUALIFIER static void store(float * p, type v){_mm_storeu_ps(p, v);}
+		GLM_FUNC_QUALIFIER static type set(float s){return _mm_set1_ps(s);}
+		GLM_FUNC_QUALIFIER static type add(type a, type b){return _mm_add_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type sub(type a, type b){return _mm_sub_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type mul(type a, type b){return _mm_mul_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type div(type a, type b){return _mm_div_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type sqrt(type a){return _mm_sqrt_ps(a);}
+		GLM_FUNC_QUALIFIER static mask less(type a, type b){return _mm_cmplt_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask less_equal(type a, type b){return _mm_cmple_ps(a, b);}
+		GLM_FUNC_QUALIFIER static mask greater(type a, type b){return _mm_cmpgt_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b){return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));}
+		GLM_FUNC_QUALIFIER static type negate(mask m, type a){return _mm_xor_ps(a, _mm_and_ps(m, _mm_set1_ps(-0.0f)));}
+
+		// each column's lanes transposed into one register per matrix
+		GLM_FUNC_QUALIFIER static void store_mat4(mat4 * out, type const m[9])
+		{
+			for(length_t c = 0; c < 3; ++c)
+			{
+				__m128 r0 = m[c * 3 + 0];
+				__m128 r1 = m[c * 3 + 1];
+				__m128 r2 = m[c * 3 + 2];
+				__m128 r3 = _mm_setzero_ps();
+				_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+				_mm_storeu_ps(&out[0][c][0], r0);
+				_mm_storeu_ps(&out[1][c][0], r1);
+				_mm_storeu_ps(&out[2][c][0], r2);
+				_mm_storeu_ps(&out[3][c][0], r3);
+			}
+			__m128 const w = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+			for(std::size_t k = 0; k < size; ++k)
+				_mm_storeu_ps(&out[k][3][0], w);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	struct soa_lanes8
+	{
+		typedef __m256 type;
+		typedef __m256 mask;
+		static std::size_t const size = 8;
+
+		GLM_FUNC_QUALIFIER static type load(float const * p){return _mm256_loadu_ps(p);}
+		GLM_FUNC_QUALIFIER static void store(float * p, type v){_mm256_storeu_ps(p, v);}
+		GLM_FUNC_QUALIFIER static type set(float s){return _mm256_set1_ps(s);}
+		GLM_FUNC_QUALIFIER static type add(type a, type b){return _mm256_add_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type sub(type a, type b){return _mm256_sub_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type mul(type a, type b){return _mm256_mul_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type div(type a, type b){return _mm256_div_ps(a, b);}
+		GLM_FUNC_QUALIFIER static type sqrt(type a){return _mm256_sqrt_ps(a);}
+		GLM_FUNC_QUALIFIER static mask less(type a, type b){return _mm256_cmp_ps(a, b, _CMP_LT_OQ);}
+		GLM_FUNC_QUALIFIER static mask less_equal(type a, type b){return _mm256_cmp_ps(a, b, _CMP_LE_OQ);}
+		GLM_FUNC_QUALIFIER static mask greater(type a, type b){return _mm256_cmp_ps(a, b, _CMP_GT_OQ);}
+		GLM_FUNC_QUALIFIER static type select(mask m, type a, type b){return _mm256_or_ps(_mm256_and_ps(m, a), _mm256_andnot_ps(m, b));}
+		GLM_FUNC_QUALIFIER static type negate(mask m, type a){return _mm256_xor_ps(a, _mm256_and_ps(m, _mm256_set1_ps(-0.0f)));}
+
+		// the transposes stay within 128-bit halves, which is cheaper than crossing lanes
+		GLM_FUNC_QUALIFIER static void store_mat4(mat4 * out, type const m[9])
+		{
+			__m128 low[9], high[9];
+			for(int j = 0; j < 9; ++j)
+			{
+				low[j] = _mm256_castps256_ps128(m[j]);
+				high[j] = _mm256_extractf128_ps(m[j], 1);
+			}
+			soa_lanes4::store_mat4(out, low);
+			soa_lanes4::store_mat4(out + 4, high);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
+	template <typename L>
+	GLM_FUNC_QUALIFIER void soa_load(soa_quat<float const> const & q, std::size_t i,
+		typename L::type & x, typename L::type & y, typename L::type & z, typename L::type & w)
+	{
+		x = L::load(q.x + i);
+		y = L::load(q.y + i);
+		z = L::load(q.z + i);
+		w = L::load(q.w + i);
+	}
+
+	template <typename L>
+	GLM_FUNC_QUALIFIER void soa_store(soa_quat<float> const & q, std::size_t i,
+		typename L::type x, typename L::type y, typename L::type z, typename L::type w)
+	{
+		L::store(q.x + i, x);
+		L::store(q.y + i, y);
+		L::store(q.z + i, z);
+		L::store(q.w + i, w);
+	}
+
+	// dot product in the order of compute_dot<tquat>
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type soa_dot(
+		typename L::type ax, typename L::type ay, typename L::type az, typename L::type aw,
+		typename L::type bx, typename L::type by, typename L::type bz, typename L::type bw)
+	{
+		return L::add(L::add(L::mul(ax, bx), L::mul(ay, by)), L::add(L::mul(az, bz), L::mul(aw, bw)));
+	}
+
+	// glm::normalize(tquat)
+	template <typename L>
+	GLM_FUNC_QUALIFIER void soa_normalize(typename L::type & x, typename L::type & y, typename L::type & z, typename L::type & w)
+	{
+		typename L::type const len = L::sqrt(soa_dot<L>(x, y, z, w, x, y, z, w));
+		typename L::mask const degenerate = L::less_equal(len, L::set(0.0f));
+		typename L::type const oneOverLen = L::div(L::set(1.0f), len);
+		x = L::select(degenerate, L::set(0.0f), L::mul(x, oneOverLen));
+		y = L::select(degenerate, L::set(0.0f), L::mul(y, oneOverLen));
+		z = L::select(degenerate, L::set(0.0f), L::mul(z, oneOverLen));
+		w = L::select(degenerate, L::set(1.0f), L::mul(w, oneOverLen));
+	}
+
+	// x + a * (y - x), as glm::mix
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type soa_mix(typename L::type x, typename L::type y, typename L::type a)
+	{
+		return L::add(x, L::mul(a, L::sub(y, x)));
+	}
+
+	// acos on [0, 1], Abramowitz and Stegun 4.4.46: absolute error below 2e-8
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type soa_acos(typename L::type x)
+	{
+		typename L::type p = L::set(-0.0012624911f);
+		p = L::add(L::mul(p, x), L::set(0.0066700901f));
+		p = L::add(L::mul(p, x), L::set(-0.0170881256f));
+		p = L::add(L::mul(p, x), L::set(0.0308918810f));
+		p = L::add(L::mul(p, x), L::set(-0.0501743046f));
+		p = L::add(L::mul(p, x), L::set(0.0889789874f));
+		p = L::add(L::mul(p, x), L::set(-0.2145988016f));
+		p = L::add(L::mul(p, x), L::set(1.5707963050f));
+		return L::mul(L::sqrt(L::sub(L::set(1.0f), x)), p);
+	}
+
+	// sin on [0, pi/2], Taylor series to degree 11: absolute error below 6e-8
+	template <typename L>
+	GLM_FUNC_QUALIFIER typename L::type soa_sin(typename L::type x)
+	{
+		typename L::type const x2 = L::mul(x, x);
+		typename L::type p = L::set(-1.0f / 39916800.0f);
+		p = L::add(L::mul(p, x2), L::set(1.0f / 362880.0f));
+		p = L::add(L::mul(p, x2), L::set(-1.0f / 5040.0f));
+		p = L::add(L::mul(p, x2), L::set(1.0f / 120.0f));
+		p = L::add(L::mul(p, x2), L::set(-1.0f / 6.0f));
+		p = L::mul(p, x2);
+		return L::add(x, L::mul(x, p));
+	}
+
+	// glm::mat3_cast, column by column
+	template <typename L>
+	GLM_FUNC_QUALIFIER void soa_mat3(typename L::type x, typename L::type y, typename L::type z, typename L::type w, typename L::type m[9])
+	{
+		typename L::type const qxx = L::mul(x, x);
+		typename L::type const qyy = L::mul(y, y);
+		typename L::type const qzz = L::mul(z, z);
+		typename L::type const qxz = L::mul(x, z);
+		typename L::type const qxy = L::mul(x, y);
+		typename L::type const qyz = L::mul(y, z);
+		typename L::type const qwx = L::mul(w, x);
+		typename L::type const qwy = L::mul(w, y);
+		typename L::type const qwz = L::mul(w, z);
+		typename L::type const one = L::set(1.0f);
+		typename L::type const two = L::set(2.0f);
+
+		m[0] = L::sub(one, L::mul(two, L::add(qyy, qzz)));
+		m[1] = L::mul(two, L::add(qxy, qwz));
+		m[2] = L::mul(two, L::sub(qxz, qwy));
+
+		m[3] = L::mul(two, L::sub(qxy, qwz));
+		m[4] = L::sub(one, L::mul(two, L::add(qxx, qzz)));
+		m[5] = L::mul(two, L::add(qyz, qwx));
+
+		m[6] = L::mul(two, L::add(qxz, qwy));
+		m[7] = L::mul(two, L::sub(qyz, qwx));
+		m[8] = L::sub(one, L::mul(two, L::add(qxx, qyy)));
+	}
+
+	// Runs Kernel.step<L>(i) over [0, count) with the widest lanes available,
+	// then narrower ones for what is left.
+	template <typename kernel>
+	GLM_FUNC_QUALIFIER void soa_run(kernel const & Kernel, std::size_t count)
+	{
+		std::size_t i = 0;
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			for(; i + soa_lanes8::size <= count; i += soa_lanes8::size)
+				Kernel.template step<soa_lanes8>(i);
+#		endif
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			for(; i + soa_lanes4::size <= count; i += soa_lanes4::size)
+				Kernel.template step<soa_lanes4>(i);
+#		endif
+		for(; i < count; ++i)
+			Kernel.template step<soa_lanes1>(i);
+	}
+
+	struct soa_normalize_kernel
+	{
+		soa_quat<float const> q;
+		soa_quat<float> out;
+
+		GLM_FUNC_QUALIFIER soa_normalize_kernel(soa_quat<float const> const & q, soa_quat<float> const & out) :
+			q(q), out(out)
+		{}
+
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typename L::type x, y, z, w;
+			soa_load<L>(q, i, x, y, z, w);
+			soa_normalize<L>(x, y, z, w);
+			soa_store<L>(out, i, x, y, z, w);
+		}
+	};
+
+	struct soa_mul_kernel
+	{
+		soa_quat<float const> p;
+		soa_quat<float const> q;
+		soa_quat<float> out;
+
+		GLM_FUNC_QUALIFIER soa_mul_kernel(soa_quat<float const> const & p, soa_quat<float const> const & q, soa_quat<float> const & out) :
+			p(p), q(q), out(out)
+		{}
+
+		// tquat::operator*=
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typename L::type px, py, pz, pw, qx, qy, qz, qw;
+			soa_load<L>(p, i, px, py, pz, pw);
+			soa_load<L>(q, i, qx, qy, qz, qw);
+
+			typename L::type const w = L::sub(L::sub(L::sub(L::mul(pw, qw), L::mul(px, qx)), L::mul(py, qy)), L::mul(pz, qz));
+			typename L::type const x = L::sub(L::add(L::add(L::mul(pw, qx), L::mul(px, qw)), L::mul(py, qz)), L::mul(pz, qy));
+			typename L::type const y = L::sub(L::add(L::add(L::mul(pw, qy), L::mul(py, qw)), L::mul(pz, qx)), L::mul(px, qz));
+			typename L::type const z = L::sub(L::add(L::add(L::mul(pw, qz), L::mul(pz, qw)), L::mul(px, qy)), L::mul(py, qx));
+			soa_store<L>(out, i, x, y, z, w);
+		}
+	};
+
+	struct soa_rotate_kernel
+	{
+		soa_quat<float const> q;
+		soa_vec3<float const> v;
+		soa_vec3<float> out;
+
+		GLM_FUNC_QUALIFIER soa_rotate_kernel(soa_quat<float const> const & q, soa_vec3<float const> const & v, soa_vec3<float> const & out) :
+			q(q), v(v), out(out)
+		{}
+
+		// operator*(tquat, tvec3): v + ((uv * w) + uuv) * 2 with two cross products
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typename L::type qx, qy, qz, qw;
+			soa_load<L>(q, i, qx, qy, qz, qw);
+			typename L::type const vx = L::load(v.x + i);
+			typename L::type const vy = L::load(v.y + i);
+			typename L::type const vz = L::load(v.z + i);
+
+			typename L::type const uvx = L::sub(L::mul(qy, vz), L::mul(vy, qz));
+			typename L::type const uvy = L::sub(L::mul(qz, vx), L::mul(vz, qx));
+			typename L::type const uvz = L::sub(L::mul(qx, vy), L::mul(vx, qy));
+			typename L::type const uuvx = L::sub(L::mul(qy, uvz), L::mul(uvy, qz));
+			typename L::type const uuvy = L::sub(L::mul(qz, uvx), L::mul(uvz, qx));
+			typename L::type const uuvz = L::sub(L::mul(qx, uvy), L::mul(uvx, qy));
+
+			typename L::type const two = L::set(2.0f);
+			L::store(out.x + i, L::add(vx, L::mul(L::add(L::mul(uvx, qw), uuvx), two)));
+			L::store(out.y + i, L::add(vy, L::mul(L::add(L::mul(uvy, qw), uuvy), two)));
+			L::store(out.z + i, L::add(vz, L::mul(L::add(L::mul(uvz, qw), uuvz), two)));
+		}
+	};
+
+	struct soa_interpolate_kernel
+	{
+		soa_quat<float const> x;
+		soa_quat<float const> y;
+		float const * a;
+		float a0;
+		soa_quat<float> out;
+		bool spherical;
+
+		GLM_FUNC_QUALIFIER soa_interpolate_kernel(soa_quat<float const> const & x, soa_quat<float const> const & y,
+			float const * a, float a0, soa_quat<float> const & out, bool spherical) :
+			x(x), y(y), a(a), a0(a0), out(out), spherical(spherical)
+		{}
+
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typedef typename L::type type;
+
+			type const t = a ? L::load(a + i) : L::set(a0);
+			type xx, xy, xz, xw, yx, yy, yz, yw;
+			soa_load<L>(x, i, xx, xy, xz, xw);
+			soa_load<L>(y, i, yx, yy, yz, yw);
+
+			// the shortest path: flip y where the two are more than half a turn apart
+			type cosTheta = soa_dot<L>(xx, xy, xz, xw, yx, yy, yz, yw);
+			typename L::mask const flip = L::less(cosTheta, L::set(0.0f));
+			cosTheta = L::negate(flip, cosTheta);
+			type const zx = L::negate(flip, yx);
+			type const zy = L::negate(flip, yy);
+			type const zz = L::negate(flip, yz);
+			type const zw = L::negate(flip, yw);
+
+			type rx = soa_mix<L>(xx, zx, t);
+			type ry = soa_mix<L>(xy, zy, t);
+			type rz = soa_mix<L>(xz, zz, t);
+			type rw = soa_mix<L>(xw, zw, t);
+
+			if(spherical)
+			{
+				// glm::slerp: linear where sin(angle) gets too close to 0 to divide by
+				type const angle = soa_acos<L>(cosTheta);
+				type const s0 = soa_sin<L>(L::mul(L::sub(L::set(1.0f), t), angle));
+				type const s1 = soa_sin<L>(L::mul(t, angle));
+				type const s = soa_sin<L>(angle);
+				typename L::mask const linear = L::greater(cosTheta, L::set(1.0f - epsilon<float>()));
+				rx = L::select(linear, rx, L::div(L::add(L::mul(xx, s0), L::mul(zx, s1)), s));
+				ry = L::select(linear, ry, L::div(L::add(L::mul(xy, s0), L::mul(zy, s1)), s));
+				rz = L::select(linear, rz, L::div(L::add(L::mul(xz, s0), L::mul(zz, s1)), s));
+				rw = L::select(linear, rw, L::div(L::add(L::mul(xw, s0), L::mul(zw, s1)), s));
+			}
+			else
+				soa_normalize<L>(rx, ry, rz, rw);
+
+			soa_store<L>(out, i, rx, ry, rz, rw);
+		}
+	};
+
+	struct soa_mat3_cast_kernel
+	{
+		soa_quat<float const> q;
+		mat3 * out;
+
+		GLM_FUNC_QUALIFIER soa_mat3_cast_kernel(soa_quat<float const> const & q, mat3 * out) :
+			q(q), out(out)
+		{}
+
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typename L::type x, y, z, w, m[9];
+			soa_load<L>(q, i, x, y, z, w);
+			soa_mat3<L>(x, y, z, w, m);
+
+			// a mat3 column is 3 floats, so there's no whole register store to use
+			float tmp[9][L::size];
+			for(int j = 0; j < 9; ++j)
+				L::store(tmp[j], m[j]);
+			for(std::size_t k = 0; k < L::size; ++k)
+				out[i + k] = mat3(
+					tmp[0][k], tmp[1][k], tmp[2][k],
+					tmp[3][k], tmp[4][k], tmp[5][k],
+					tmp[6][k], tmp[7][k], tmp[8][k]);
+		}
+	};
+
+	struct soa_mat4_cast_kernel
+	{
+		soa_quat<float const> q;
+		mat4 * out;
+
+		GLM_FUNC_QUALIFIER soa_mat4_cast_kernel(soa_quat<float const> const & q, mat4 * out) :
+			q(q), out(out)
+		{}
+
+		template <typename L>
+		GLM_FUNC_QUALIFIER void step(std::size_t i) const
+		{
+			typename L::type x, y, z, w, m[9];
+			soa_load<L>(q, i, x, y, z, w);
+			soa_mat3<L>(x, y, z, w, m);
+			L::store_mat4(out + i, m);
+		}
+	};
+}//namespace detail
+
+	template <typename T>
+	GLM_FUNC_QUALIFIER soa_quat<T>::soa_quat(T * x, T * y, T * z, T * w) :
+		x(x), y(y), z(z), w(w)
+	{}
+
+	template <typename T>
+	template <typename U>
+	GLM_FUNC_QUALIFIER soa_quat<T>::soa_quat(soa_quat<U> const & q) :
+		x(q.x), y(q.y), z(q.z), w(q.w)
+	{}
+
+	template <typename T>
+	GLM_FUNC_QUALIFIER soa_vec3<T>::soa_vec3(T * x, T * y, T * z) :
+		x(x), y(y), z(z)
+	{}
+
+	template <typename T>
+	template <typename U>
+	GLM_FUNC_QUALIFIER soa_vec3<T>::soa_vec3(soa_vec3<U> const & v) :
+		x(v.x), y(v.y), z(v.z)
+	{}
+
+	GLM_FUNC_QUALIFIER void normalize(soa_quat<float const> const & q, soa_quat<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_normalize_kernel(q, out), count);
+	}
+
+	GLM_FUNC_QUALIFIER void mul(soa_quat<float const> const & p, soa_quat<float const> const & q, soa_quat<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_mul_kernel(p, q, out), count);
+	}
+
+	GLM_FUNC_QUALIFIER void rotate(soa_quat<float const> const & q, soa_vec3<float const> const & v, soa_vec3<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_rotate_kernel(q, v, out), count);
+	}
+
+	GLM_FUNC_QUALIFIER void nlerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float const * a, soa_quat<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_interpolate_kernel(x, y, a, 0.0f, out, false), count);
+	}
+
+	GLM_FUNC_QUALIFIER void nlerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float a, soa_quat<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_interpolate_kernel(x, y, 0, a, out, false), count);
+	}
+
+	GLM_FUNC_QUALIFIER void slerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float const * a, soa_quat<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_interpolate_kernel(x, y, a, 0.0f, out, true), count);
+	}
+
+	GLM_FUNC_QUALIFIER void slerp(soa_quat<float const> const & x, soa_quat<float const> const & y, float a, soa_quat<float> const & out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_interpolate_kernel(x, y, 0, a, out, true), count);
+	}
+
+	GLM_FUNC_QUALIFIER void mat3_cast(soa_quat<float const> const & q, mat3 * out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_mat3_cast_kernel(q, out), count);
+	}
+
+	GLM_FUNC_QUALIFIER void mat4_cast(soa_quat<float const> const & q, mat4 * out, std::size_t count)
+	{
+		detail::soa_run(detail::soa_mat4_cast_kernel(q, out), count);
+	}
+}//namespace glm
@@ -1025,4 +1025,87 @@ GLM_FUNC_QUALIFIER void glm_mat4_outerProduct(__m128 const & c, __m128 const & r
 	out[3] = _mm_mul_ps(c, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3)));
 }
 
+// Unaligned loads and stores, for the packed matrix types whose columns are float[4]
+GLM_FUNC_QUALIFIER void glm_mat4_load(float const in[16], glm_vec4 out[4])
+{
+	out[0] = _mm_loadu_ps(in + 0);
+	out[1] = _mm_loadu_ps(in + 4);
+	out[2] = _mm_loadu_ps(in + 8);
+	out[3] = _mm_loadu_ps(in + 12);
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_store(glm_vec4 const in[4], float out[16])
+{
+	_mm_storeu_ps(out + 0, in[0]);
+	_mm_storeu_ps(out + 4, in[1]);
+	_mm_storeu_ps(out + 8, in[2]);
+	_mm_storeu_ps(out + 12, in[3]);
+}
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+// The AVX versions keep two columns per 256-bit register, columns 0 and 1 in
+// one and 2 and 3 in the other, and take column-major float storage that
+// doesn't need to be aligned
+
+GLM_FUNC_QUALIFIER void glm_mat4_mul_avx(float const in1[16], float const in2[16], float out[16])
+{
+	// in1's columns in both halves, each half multiplied by a different column of in2
+	__m256 const a0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 0));
+	__m256 const a1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 4));
+	__m256 const a2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 8));
+	__m256 const a3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(in1 + 12));
+
+	__m256 const b01 = _mm256_loadu_ps(in2 + 0);
+	__m256 const b23 = _mm256_loadu_ps(in2 + 8);
+
+	__m256 const m0 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m256 const m1 = _mm256_mul_ps(a1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)));
+	__m256 const m2 = _mm256_mul_ps(a2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2)));
+	__m256 const m3 = _mm256_mul_ps(a3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3)));
+	_mm256_storeu_ps(out + 0, _mm256_add_ps(_mm256_add_ps(m0, m1), _mm256_add_ps(m2, m3)));
+
+	__m256 const n0 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0)));
+	__m256 const n1 = _mm256_mul_ps(a1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)));
+	__m256 const n2 = _mm256_mul_ps(a2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2)));
+	__m256 const n3 = _mm256_mul_ps(a3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3)));
+	_mm256_storeu_ps(out + 8, _mm256_add_ps(_mm256_add_ps(n0, n1), _mm256_add_ps(n2, n3)));
+}
+
+GLM_FUNC_QUALIFIER glm_vec4 glm_mat4_mul_vec4_avx(float const m[16], float const v[4])
+{
+	// v.x for column 0 and v.y for column 1 in one register, v.z and v.w in the other;
+	// broadcasting v from memory keeps the lane crossing off the dependency chain
+	__m256 const vv = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(v));
+	__m256 const v01 = _mm256_permutevar_ps(vv, _mm256_set_epi32(1, 1, 1, 1, 0, 0, 0, 0));
+	__m256 const v23 = _mm256_permutevar_ps(vv, _mm256_set_epi32(3, 3, 3, 3, 2, 2, 2, 2));
+
+	__m256 const m01 = _mm256_mul_ps(_mm256_loadu_ps(m + 0), v01);
+	__m256 const m23 = _mm256_mul_ps(_mm256_loadu_ps(m + 8), v23);
+	__m256 const sum = _mm256_add_ps(m01, m23);
+
+	return _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+}
+
+GLM_FUNC_QUALIFIER void glm_mat4_transpose_avx(float const in[16], float out[16])
+{
+	__m256 const c01 = _mm256_loadu_ps(in + 0);
+	__m256 const c23 = _mm256_loadu_ps(in + 8);
+
+	// x and y of columns 0 and 2 | of columns 1 and 3, then the same for z and w
+	__m256 const xy = _mm256_unpacklo_ps(c01, c23);
+	__m256 const zw = _mm256_unpackhi_ps(c01, c23);
+	__m256 const xy02zw02 = _mm256_permute2f128_ps(xy, zw, 0x20);
+	__m256 const xy13zw13 = _mm256_permute2f128_ps(xy, zw, 0x31);
+
+	// rows 0 | 2 and rows 1 | 3
+	__m256 const r02 = _mm256_unpacklo_ps(xy02zw02, xy13zw13);
+	__m256 const r13 = _mm256_unpackhi_ps(xy02zw02, xy13zw13);
+
+	_mm256_storeu_ps(out + 0, _mm256_permute2f128_ps(r02, r13, 0x20));
+	_mm256_storeu_ps(out + 8, _mm256_permute2f128_ps(r02, r13, 0x31));
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
@@ -436,6 +436,14 @@
 #	include <emmintrin.h>
 #endif//GLM_ARCH
 
+// Every AVX2 processor has FMA3, but GCC and Clang only declare its
+// intrinsics when the build enables them, with -mfma or -march.
+#if (GLM_ARCH & GLM_ARCH_AVX2_BIT) && (defined(__FMA__) || (GLM_COMPILER & GLM_COMPILER_VC))
+#	define GLM_HAS_FMA_INTRINSICS 1
+#else
+#	define GLM_HAS_FMA_INTRINSICS 0
+#endif
+
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 	typedef __m128		glm_vec4;
 	typedef __m128i		glm_ivec4;
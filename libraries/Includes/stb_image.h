@@ -215,6 +215,89 @@ RECENT REVISION HISTORY:
 //
 // ===========================================================================
 //
+// Multi-threaded decoding
+//
+// stbi_load_mt and stbi_load_from_memory_mt take a parallel-for callback from
+// your own thread pool, which must run task(ctx,i) for every i in [0,count)
+// and return only when all of them have finished:
+//
+//     void my_parallel_for(void *pool, void (*task)(void *ctx, int index), void *ctx, int count)
+//     {
+//        my_pool_run_and_wait((my_pool *) pool, task, ctx, count);
+//     }
+//
+//     data = stbi_load_mt(filename, &x, &y, &n, 0, my_parallel_for, pool);
+//
+// For JPEG, scans with restart markers (DRI) have their restart intervals
+// entropy-decoded on several threads, and the progressive IDCT, upsampling
+// and color conversion are split into bands of rows for every JPEG. The
+// output of a well-formed file is bit-identical to stbi_load. Other formats
+// decode on the calling thread. stbi_load_mt reads the whole file into
+// memory first, since restart markers are found by scanning ahead in the
+// compressed data.
+//
+// ===========================================================================
+//
+// Custom allocators
+//
+// STBI_MALLOC/STBI_REALLOC/STBI_FREE pick the allocator at compile time. To
+// pick one at runtime, install an stbi_allocator; the setting is per thread,
+// so each decode thread can have its own:
+//
+//     stbi_allocator a = { my_alloc, my_resize, my_release, my_heap };
+//     stbi_set_allocator_thread(&a);   // NULL goes back to STBI_MALLOC etc.
+//
+// Everything stb_image allocates on that thread goes through it, including
+// the image it returns, so free that with stbi_image_free on the same thread
+// while the same allocator is installed. resize is given the old size, as
+// with STBI_REALLOC_SIZED. Threads running stbi_load_mt tasks use their own
+// setting for the few blocks a task allocates and frees itself.
+//
+// For batches of small images, stbi_arena is a bump allocator over a block
+// you supply; blocks that don't fit come from STBI_MALLOC instead, and
+// stbi_arena_reset makes all of the block available again:
+//
+//     stbi_arena arena;
+//     stbi_allocator a;
+//     stbi_arena_init(&arena, memory, memory_size);
+//     a = stbi_arena_allocator(&arena);
+//     stbi_set_allocator_thread(&a);
+//     for (...) {
+//        data = stbi_load_from_memory(...);   // or decode with stbi_load_from_memory_into
+//        ...use data...
+//        stbi_image_free(data);
+//        stbi_arena_reset(&arena);
+//     }
+//
+// Without compiler support for thread-local variables (C11, C++11, GCC,
+// MSVC), or with STBI_NO_THREAD_LOCALS defined, the setting is global.
+//
+// ===========================================================================
+//
+// Decoding into your own buffer
+//
+// The _into functions decode into memory you provide, e.g. a mapped pixel
+// buffer object, rather than returning a malloc'd image:
+//
+//     stbi_info(filename, &x, &y, &n);
+//     stride = x * 4;                    // at least x * channels, any padding
+//     ...get stride * y bytes at 'dest'...
+//     ok = stbi_load_into(filename, dest, stride, stride * y, &x, &y, &n, 4);
+//
+// Row j of the image starts at dest + j*stride, or at dest + (y-1-j)*stride
+// when stbi_set_flip_vertically_on_load is on; the bytes between the end of
+// a row and the next stride are left untouched. Pass desired_channels != 0
+// unless you know the file's channel count, since stbi_info can't always
+// tell (a PNG tRNS chunk adds alpha). If the image would need more than
+// dest_size bytes the load fails with "dest too small".
+//
+// JPEG and plain non-interlaced 8-bit-or-less PNG are decoded and flipped
+// straight into the buffer. Other files (16-bit, palette or tRNS PNG,
+// interlaced PNG, and the other formats) are decoded to a temporary image
+// and copied in.
+//
+// ===========================================================================
+//
 // HDR image support   (disable by defining STBI_NO_HDR)
 //
 // stb_image now supports loading HDR images in general, and currently
@@ -299,12 +382,18 @@ RECENT REVISION HISTORY:
 //   - If you use STBI_NO_PNG (or _ONLY_ without PNG), and you still
 //     want the zlib decoder to be available, #define STBI_SUPPORT_ZLIB
 //
+//   - On x86/x64 a few byte loops (PNG unfiltering) have AVX2 versions that
+//     are picked at runtime when the CPU supports them. #define STBI_NO_AVX2
+//     to compile only the SSE2 paths.
+//
 
 
 #ifndef STBI_NO_STDIO
 #include <stdio.h>
 #endif // STBI_NO_STDIO
 
+#include <stddef.h> // size_t
+
 #define STBI_VERSION 1
 
 enum
@@ -360,6 +449,35 @@ STBIDEF stbi_uc *stbi_load_from_file  (FILE *f, int *x, int *y, int *channels_in
 // for stbi_load_from_file, file pointer is left pointing immediately after image
 #endif
 
+////////////////////////////////////
+//
+// multi-threaded 8-bits-per-channel interface
+//
+
+// runs task(ctx,index) for each index in [0,count), returns when all are done
+typedef void stbi_parallel_for(void *pool, void (*task)(void *ctx, int index), void *ctx, int count);
+
+STBIDEF stbi_uc *stbi_load_from_memory_mt(stbi_uc const *buffer, int len, int *x, int *y, int *channels_in_file, int desired_channels, stbi_parallel_for *parallel_for, void *pool);
+
+#ifndef STBI_NO_STDIO
+STBIDEF stbi_uc *stbi_load_mt          (char const *filename, int *x, int *y, int *channels_in_file, int desired_channels, stbi_parallel_for *parallel_for, void *pool);
+#endif
+
+////////////////////////////////////
+//
+// decode-into-buffer 8-bits-per-channel interface
+//
+
+// decodes into the caller's 'dest' instead of a malloc'd image; returns 1 on
+// success, 0 on failure. see "Decoding into your own buffer" above
+STBIDEF int stbi_load_from_memory_into   (stbi_uc           const *buffer, int len   , stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *channels_in_file, int desired_channels);
+STBIDEF int stbi_load_from_callbacks_into(stbi_io_callbacks const *clbk  , void *user, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *channels_in_file, int desired_channels);
+
+#ifndef STBI_NO_STDIO
+STBIDEF int stbi_load_into            (char const *filename, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *channels_in_file, int desired_channels);
+STBIDEF int stbi_load_from_file_into  (FILE *f, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *channels_in_file, int desired_channels);
+#endif
+
 ////////////////////////////////////
 //
 // 16-bits-per-channel interface
@@ -410,7 +528,7 @@ STBIDEF int      stbi_is_hdr_from_file(FILE *f);
 // NOT THREADSAFE
 STBIDEF const char *stbi_failure_reason  (void);
 
-// free the loaded image -- this is just free()
+// free the loaded image -- this is just free(), unless an allocator is set
 STBIDEF void     stbi_image_free      (void *retval_from_stbi_load);
 
 // get image dimensions & components without fully decoding
@@ -436,6 +554,31 @@ STBIDEF void stbi_convert_iphone_png_to_rgb(int flag_true_if_should_convert);
 
 // flip the image vertically, so the first pixel in the output array is the bottom left
 STBIDEF void stbi_set_flip_vertically_on_load(int flag_true_if_should_flip);
+// same, for the calling thread only; a negative flag goes back to the global setting
+STBIDEF void stbi_set_flip_vertically_on_load_thread(int flag_true_if_should_flip);
+
+// runtime allocator, see "Custom allocators" above
+typedef struct
+{
+   void *(*alloc)  (void *user, size_t size);
+   void *(*resize) (void *user, void *p, size_t old_size, size_t new_size);
+   void  (*release)(void *user, void *p);
+   void *user;
+} stbi_allocator;
+
+// use 'allocator' for everything this thread allocates; NULL restores the default
+STBIDEF void stbi_set_allocator_thread(stbi_allocator const *allocator);
+
+typedef struct
+{
+   unsigned char *base;
+   size_t size, used;
+   size_t last;   // offset of the most recent block, which can grow in place
+} stbi_arena;
+
+STBIDEF void           stbi_arena_init     (stbi_arena *arena, void *memory, size_t size);
+STBIDEF void           stbi_arena_reset    (stbi_arena *arena);
+STBIDEF stbi_allocator stbi_arena_allocator(stbi_arena *arena);
 
 // ZLIB client - used by PNG, available for other purposes
 
@@ -578,6 +721,22 @@ typedef unsigned char validate_uint32[sizeof(stbi__uint32)==4 ? 1 : -1];
 #define STBI_REALLOC_SIZED(p,oldsz,newsz) STBI_REALLOC(p,newsz)
 #endif
 
+#ifndef STBI_NO_THREAD_LOCALS
+   #if defined(__cplusplus) && __cplusplus >= 201103L
+      #define STBI_THREAD_LOCAL       thread_local
+   #elif defined(__GNUC__)
+      #define STBI_THREAD_LOCAL       __thread
+   #elif defined(_MSC_VER)
+      #define STBI_THREAD_LOCAL       __declspec(thread)
+   #elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+      #define STBI_THREAD_LOCAL       _Thread_local
+   #endif
+#endif
+
+#ifndef STBI_THREAD_LOCAL
+   #define STBI_THREAD_LOCAL
+#endif
+
 // x86/x64 detection
 #if defined(__x86_64__) || defined(_M_X64)
 #define STBI__X64_TARGET
@@ -658,6 +817,38 @@ static int stbi__sse2_available(void)
 #endif
 #endif
 
+// AVX2 is only used for a few wide byte loops and is always selected at
+// runtime, so a single binary still runs on SSE2-only machines. On GCC/Clang
+// the AVX2 functions are compiled with a target attribute instead of -mavx2.
+#if defined(STBI_SSE2) && !defined(STBI_NO_AVX2) && ((defined(_MSC_VER) && _MSC_VER >= 1700) || (defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))))
+#define STBI_AVX2
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#define STBI__AVX2_TARGET
+
+static int stbi__avx2_available(void)
+{
+   int info[4];
+   __cpuid(info,0);
+   if (info[0] < 7) return 0;
+   __cpuid(info,1);
+   // need OSXSAVE and AVX, and the OS has to preserve the ymm registers
+   if ((info[2] & 0x18000000) != 0x18000000) return 0;
+   if ((_xgetbv(0) & 6) != 6) return 0;
+   __cpuidex(info,7,0);
+   return (info[1] >> 5) & 1;
+}
+#else
+#define STBI__AVX2_TARGET __attribute__((target("avx2")))
+
+static int stbi__avx2_available(void)
+{
+   return __builtin_cpu_supports("avx2");
+}
+#endif
+#endif
+
 // ARM NEON
 #if defined(STBI_NO_SIMD) && defined(STBI_NEON)
 #undef STBI_NEON
@@ -693,6 +884,12 @@ typedef struct
 
    stbi_uc *img_buffer, *img_buffer_end;
    stbi_uc *img_buffer_original, *img_buffer_original_end;
+
+   stbi_parallel_for *parallel_for; // NULL unless loaded through an _mt function
+   void *pool;
+
+   stbi_uc *dest;   // caller's output buffer, NULL unless loaded through an _into function
+   int dest_stride, dest_size;
 } stbi__context;
 
 
@@ -705,6 +902,9 @@ static void stbi__start_mem(stbi__context *s, stbi_uc const *buffer, int len)
    s->read_from_callbacks = 0;
    s->img_buffer = s->img_buffer_original = (stbi_uc *) buffer;
    s->img_buffer_end = s->img_buffer_original_end = (stbi_uc *) buffer+len;
+   s->parallel_for = NULL;
+   s->pool = NULL;
+   s->dest = NULL;
 }
 
 // initialize a callback-based context
@@ -715,6 +915,9 @@ static void stbi__start_callbacks(stbi__context *s, stbi_io_callbacks *c, void *
    s->buflen = sizeof(s->buffer_start);
    s->read_from_callbacks = 1;
    s->img_buffer_original = s->buffer_start;
+   s->parallel_for = NULL;
+   s->pool = NULL;
+   s->dest = NULL;
    stbi__refill_buffer(s);
    s->img_buffer_original_end = s->img_buffer_end;
 }
@@ -772,6 +975,7 @@ typedef struct
    int bits_per_channel;
    int num_channels;
    int channel_order;
+   int in_dest;          // image was decoded straight into stbi__context::dest
 } stbi__result_info;
 
 #ifndef STBI_NO_JPEG
@@ -842,9 +1046,119 @@ static int stbi__err(const char *str)
    return 0;
 }
 
+// allocator installed with stbi_set_allocator_thread; alloc == NULL means
+// use STBI_MALLOC/STBI_REALLOC_SIZED/STBI_FREE
+static STBI_THREAD_LOCAL stbi_allocator stbi__allocator;
+
+STBIDEF void stbi_set_allocator_thread(stbi_allocator const *allocator)
+{
+   if (allocator)
+      stbi__allocator = *allocator;
+   else
+      stbi__allocator.alloc = NULL;
+}
+
 static void *stbi__malloc(size_t size)
 {
-    return STBI_MALLOC(size);
+   if (stbi__allocator.alloc)
+      return stbi__allocator.alloc(stbi__allocator.user, size);
+   return STBI_MALLOC(size);
+}
+
+static void *stbi__realloc_sized(void *p, size_t old_size, size_t new_size)
+{
+   if (stbi__allocator.alloc)
+      return stbi__allocator.resize(stbi__allocator.user, p, old_size, new_size);
+   return STBI_REALLOC_SIZED(p, old_size, new_size);
+}
+
+static void stbi__free(void *p)
+{
+   if (stbi__allocator.alloc)
+      stbi__allocator.release(stbi__allocator.user, p);
+   else
+      STBI_FREE(p);
+}
+
+#define STBI__ARENA_ALIGN 16
+
+STBIDEF void stbi_arena_init(stbi_arena *arena, void *memory, size_t size)
+{
+   // start on an aligned address, and keep only whole aligned blocks
+   size_t skip = (STBI__ARENA_ALIGN - ((size_t) memory & (STBI__ARENA_ALIGN-1))) & (STBI__ARENA_ALIGN-1);
+   if (size < skip) skip = size;
+   arena->base = (unsigned char *) memory + skip;
+   arena->size = (size - skip) & ~(size_t) (STBI__ARENA_ALIGN-1);
+   stbi_arena_reset(arena);
+}
+
+STBIDEF void stbi_arena_reset(stbi_arena *arena)
+{
+   arena->used = 0;
+   arena->last = 0;
+}
+
+static int stbi__arena_owns(stbi_arena *arena, void *p)
+{
+   return (unsigned char *) p >= arena->base && (unsigned char *) p < arena->base + arena->size;
+}
+
+static void *stbi__arena_alloc(void *user, size_t size)
+{
+   stbi_arena *arena = (stbi_arena *) user;
+   size_t rounded = (size + STBI__ARENA_ALIGN-1) & ~(size_t) (STBI__ARENA_ALIGN-1);
+   void *p;
+   if (rounded < size || rounded > arena->size - arena->used)
+      return STBI_MALLOC(size); // doesn't fit; fall back to the heap
+   p = arena->base + arena->used;
+   arena->last = arena->used;
+   arena->used += rounded;
+   return p;
+}
+
+static void *stbi__arena_resize(void *user, void *p, size_t old_size, size_t new_size)
+{
+   stbi_arena *arena = (stbi_arena *) user;
+   void *q;
+   if (p == NULL)
+      return stbi__arena_alloc(user, new_size);
+   if (!stbi__arena_owns(arena, p))
+      return STBI_REALLOC_SIZED(p, old_size, new_size);
+   if ((unsigned char *) p == arena->base + arena->last) {
+      // the most recent block just moves the top of the arena, which is
+      // what repeated zlib output growth hits
+      size_t rounded = (new_size + STBI__ARENA_ALIGN-1) & ~(size_t) (STBI__ARENA_ALIGN-1);
+      if (rounded >= new_size && rounded <= arena->size - arena->last) {
+         arena->used = arena->last + rounded;
+         return p;
+      }
+   }
+   q = stbi__arena_alloc(user, new_size);
+   if (q) memcpy(q, p, old_size < new_size ? old_size : new_size);
+   return q;
+}
+
+static void stbi__arena_release(void *user, void *p)
+{
+   stbi_arena *arena = (stbi_arena *) user;
+   if (!stbi__arena_owns(arena, p)) {
+      STBI_FREE(p);
+      return;
+   }
+   // freeing the most recent block gives its space back; anything else
+   // waits for stbi_arena_reset
+   if ((unsigned char *) p == arena->base + arena->last)
+      arena->used = arena->last;
+}
+
+STBIDEF stbi_allocator stbi_arena_allocator(stbi_arena *arena)
+{
+   stbi_allocator a;
+   a.alloc = stbi__arena_alloc;
+   a.resize = stbi__arena_resize;
+   a.release = stbi__arena_release;
+   a.user = arena;
+   return a;
 }
 
 // stb_image uses ints pervasively, including for offset calculations.
@@ -935,7 +1249,7 @@ static void *stbi__malloc_mad4(int a, int b, int c, int d, int add)
 
 STBIDEF void stbi_image_free(void *retval_from_stbi_load)
 {
-   STBI_FREE(retval_from_stbi_load);
+   stbi__free(retval_from_stbi_load);
 }
 
 #ifndef STBI_NO_LINEAR
@@ -946,13 +1260,22 @@ static float   *stbi__ldr_to_hdr(stbi_uc *data, int x, int y, int comp);
 static stbi_uc *stbi__hdr_to_ldr(float   *data, int x, int y, int comp);
 #endif
 
-static int stbi__vertically_flip_on_load = 0;
+static int stbi__vertically_flip_on_load_global = 0;
+static STBI_THREAD_LOCAL int stbi__vertically_flip_on_load_local, stbi__vertically_flip_on_load_set;
 
 STBIDEF void stbi_set_flip_vertically_on_load(int flag_true_if_should_flip)
 {
-    stbi__vertically_flip_on_load = flag_true_if_should_flip;
+    stbi__vertically_flip_on_load_global = flag_true_if_should_flip;
 }
 
+STBIDEF void stbi_set_flip_vertically_on_load_thread(int flag_true_if_should_flip)
+{
+    stbi__vertically_flip_on_load_local = flag_true_if_should_flip;
+    stbi__vertically_flip_on_load_set = flag_true_if_should_flip >= 0;
+}
+
+#define stbi__vertically_flip_on_load  (stbi__vertically_flip_on_load_set ? stbi__vertically_flip_on_load_local : stbi__vertically_flip_on_load_global)
+
 static void *stbi__load_main(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri, int bpc)
 {
    memset(ri, 0, sizeof(*ri)); // make sure it's initialized if we add new fields
@@ -1010,7 +1333,7 @@ static stbi_uc *stbi__convert_16_to_8(stbi__uint16 *orig, int w, int h, int chan
    for (i = 0; i < img_len; ++i)
       reduced[i] = (stbi_uc)((orig[i] >> 8) & 0xFF); // top half of each byte is sufficient approx of 16->8 bit scaling
 
-   STBI_FREE(orig);
+   stbi__free(orig);
    return reduced;
 }
 
@@ -1026,7 +1349,7 @@ static stbi__uint16 *stbi__convert_8_to_16(stbi_uc *orig, int w, int h, int chan
    for (i = 0; i < img_len; ++i)
       enlarged[i] = (stbi__uint16)((orig[i] << 8) + orig[i]); // replicate to high and low byte, maps 0->0, 255->0xffff
 
-   STBI_FREE(orig);
+   stbi__free(orig);
    return enlarged;
 }
 
@@ -1054,6 +1377,24 @@ static void stbi__vertical_flip(void *image, int w, int h, int bytes_per_pixel)
    }
 }
 
+// first row of the caller's buffer to decode a w*h image with n channels
+// into, and the signed step between rows (negative when flipping), or NULL
+// if the image doesn't fit
+static stbi_uc *stbi__dest_rows(stbi__context *s, int w, int h, int n, int *step)
+{
+   int row;
+   if (!stbi__mul2sizes_valid(w, n)) return stbi__errpuc("too large", "Image too large to decode");
+   row = w * n;
+   if (s->dest_stride < row || !stbi__mad2sizes_valid(h-1, s->dest_stride, row) || (h-1) * s->dest_stride + row > s->dest_size)
+      return stbi__errpuc("dest too small", "Image does not fit the destination buffer");
+   if (stbi__vertically_flip_on_load) {
+      *step = -s->dest_stride;
+      return s->dest + (h-1) * s->dest_stride;
+   }
+   *step = s->dest_stride;
+   return s->dest;
+}
+
 static unsigned char *stbi__load_and_postprocess_8bit(stbi__context *s, int *x, int *y, int *comp, int req_comp)
 {
    stbi__result_info ri;
@@ -1103,6 +1444,39 @@ static stbi__uint16 *stbi__load_and_postprocess_16bit(stbi__context *s, int *x,
    return (stbi__uint16 *) result;
 }
 
+// decoders that can write rows anywhere fill s->dest directly; everything
+// else is decoded as usual and copied in, flipping on the way
+static int stbi__load_into_dest(stbi__context *s, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__result_info ri;
+   void *result;
+   stbi_uc *row;
+   int j, step, n;
+
+   if (!dest || dest_stride <= 0 || dest_size <= 0) return stbi__err("bad dest", "Invalid destination buffer");
+   s->dest = dest;
+   s->dest_stride = dest_stride;
+   s->dest_size = dest_size;
+   result = stbi__load_main(s, x, y, comp, req_comp, &ri, 8);
+   if (result == NULL)
+      return 0;
+   if (ri.in_dest)
+      return 1;
+
+   n = req_comp ? req_comp : *comp;
+   if (ri.bits_per_channel != 8) {
+      STBI_ASSERT(ri.bits_per_channel == 16);
+      result = stbi__convert_16_to_8((stbi__uint16 *) result, *x, *y, n);
+      if (result == NULL) return 0;
+   }
+   row = stbi__dest_rows(s, *x, *y, n, &step);
+   if (row)
+      for (j=0; j < *y; ++j, row += step)
+         memcpy(row, (stbi_uc *) result + (size_t) j * *x * n, (size_t) *x * n);
+   stbi__free(result);
+   return row != NULL;
+}
+
 #ifndef STBI_NO_HDR
 static void stbi__float_postprocess(float *result, int *x, int *y, int *comp, int req_comp)
 {
@@ -1138,6 +1512,30 @@ STBIDEF stbi_uc *stbi_load(char const *filename, int *x, int *y, int *comp, int
    return result;
 }
 
+STBIDEF stbi_uc *stbi_load_mt(char const *filename, int *x, int *y, int *comp, int req_comp, stbi_parallel_for *parallel_for, void *pool)
+{
+   FILE *f = stbi__fopen(filename, "rb");
+   stbi_uc *buffer, *result;
+   long len;
+   if (!f) return stbi__errpuc("can't fopen", "Unable to open file");
+   // restart markers are found by scanning ahead, so read the whole file
+   fseek(f, 0, SEEK_END);
+   len = ftell(f);
+   fseek(f, 0, SEEK_SET);
+   if (len <= 0 || len != (int) len) { fclose(f); return stbi__errpuc("bad file size", "Unable to read file"); }
+   buffer = (stbi_uc *) stbi__malloc(len);
+   if (!buffer) { fclose(f); return stbi__errpuc("outofmem", "Out of memory"); }
+   if (fread(buffer, 1, len, f) != (size_t) len) {
+      fclose(f);
+      stbi__free(buffer);
+      return stbi__errpuc("can't fread", "Unable to read file");
+   }
+   fclose(f);
+   result = stbi_load_from_memory_mt(buffer, (int) len, x, y, comp, req_comp, parallel_for, pool);
+   stbi__free(buffer);
+   return result;
+}
+
 STBIDEF stbi_uc *stbi_load_from_file(FILE *f, int *x, int *y, int *comp, int req_comp)
 {
    unsigned char *result;
@@ -1151,6 +1549,29 @@ STBIDEF stbi_uc *stbi_load_from_file(FILE *f, int *x, int *y, int *comp, int req
    return result;
 }
 
+STBIDEF int stbi_load_into(char const *filename, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *comp, int req_comp)
+{
+   FILE *f = stbi__fopen(filename, "rb");
+   int result;
+   if (!f) return stbi__err("can't fopen", "Unable to open file");
+   result = stbi_load_from_file_into(f,dest,dest_stride,dest_size,x,y,comp,req_comp);
+   fclose(f);
+   return result;
+}
+
+STBIDEF int stbi_load_from_file_into(FILE *f, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *comp, int req_comp)
+{
+   int result;
+   stbi__context s;
+   stbi__start_file(&s,f);
+   result = stbi__load_into_dest(&s,dest,dest_stride,dest_size,x,y,comp,req_comp);
+   if (result) {
+      // need to 'unget' all the characters in the IO buffer
+      fseek(f, - (int) (s.img_buffer_end - s.img_buffer), SEEK_CUR);
+   }
+   return result;
+}
+
 STBIDEF stbi__uint16 *stbi_load_from_file_16(FILE *f, int *x, int *y, int *comp, int req_comp)
 {
    stbi__uint16 *result;
@@ -1198,6 +1619,15 @@ STBIDEF stbi_uc *stbi_load_from_memory(stbi_uc const *buffer, int len, int *x, i
    return stbi__load_and_postprocess_8bit(&s,x,y,comp,req_comp);
 }
 
+STBIDEF stbi_uc *stbi_load_from_memory_mt(stbi_uc const *buffer, int len, int *x, int *y, int *comp, int req_comp, stbi_parallel_for *parallel_for, void *pool)
+{
+   stbi__context s;
+   stbi__start_mem(&s,buffer,len);
+   s.parallel_for = parallel_for;
+   s.pool = pool;
+   return stbi__load_and_postprocess_8bit(&s,x,y,comp,req_comp);
+}
+
 STBIDEF stbi_uc *stbi_load_from_callbacks(stbi_io_callbacks const *clbk, void *user, int *x, int *y, int *comp, int req_comp)
 {
    stbi__context s;
@@ -1205,6 +1635,20 @@ STBIDEF stbi_uc *stbi_load_from_callbacks(stbi_io_callbacks const *clbk, void *u
    return stbi__load_and_postprocess_8bit(&s,x,y,comp,req_comp);
 }
 
+STBIDEF int stbi_load_from_memory_into(stbi_uc const *buffer, int len, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__context s;
+   stbi__start_mem(&s,buffer,len);
+   return stbi__load_into_dest(&s,dest,dest_stride,dest_size,x,y,comp,req_comp);
+}
+
+STBIDEF int stbi_load_from_callbacks_into(stbi_io_callbacks const *clbk, void *user, stbi_uc *dest, int dest_stride, int dest_size, int *x, int *y, int *comp, int req_comp)
+{
+   stbi__context s;
+   stbi__start_callbacks(&s, (stbi_io_callbacks *) clbk, user);
+   return stbi__load_into_dest(&s,dest,dest_stride,dest_size,x,y,comp,req_comp);
+}
+
 #ifndef STBI_NO_LINEAR
 static float *stbi__loadf_main(stbi__context *s, int *x, int *y, int *comp, int req_comp)
 {
@@ -1478,7 +1922,7 @@ static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int r
 
    good = (unsigned char *) stbi__malloc_mad3(req_comp, x, y, 0);
    if (good == NULL) {
-      STBI_FREE(data);
+      stbi__free(data);
       return stbi__errpuc("outofmem", "Out of memory");
    }
 
@@ -1508,7 +1952,7 @@ static unsigned char *stbi__convert_format(unsigned char *data, int img_n, int r
       #undef STBI__CASE
    }
 
-   STBI_FREE(data);
+   stbi__free(data);
    return good;
 }
 
@@ -1527,7 +1971,7 @@ static stbi__uint16 *stbi__convert_format16(stbi__uint16 *data, int img_n, int r
 
    good = (stbi__uint16 *) stbi__malloc(req_comp * x * y * 2);
    if (good == NULL) {
-      STBI_FREE(data);
+      stbi__free(data);
       return (stbi__uint16 *) stbi__errpuc("outofmem", "Out of memory");
    }
 
@@ -1557,7 +2001,7 @@ static stbi__uint16 *stbi__convert_format16(stbi__uint16 *data, int img_n, int r
       #undef STBI__CASE
    }
 
-   STBI_FREE(data);
+   stbi__free(data);
    return good;
 }
 
@@ -1566,18 +2010,22 @@ static float   *stbi__ldr_to_hdr(stbi_uc *data, int x, int y, int comp)
 {
    int i,k,n;
    float *output;
+   float gamma[256];
    if (!data) return NULL;
    output = (float *) stbi__malloc_mad4(x, y, comp, sizeof(float), 0);
-   if (output == NULL) { STBI_FREE(data); return stbi__errpf("outofmem", "Out of memory"); }
+   if (output == NULL) { stbi__free(data); return stbi__errpf("outofmem", "Out of memory"); }
+   // one pow per possible byte value rather than per texel
+   for (i=0; i < 256; ++i)
+      gamma[i] = (float) (pow(i/255.0f, stbi__l2h_gamma) * stbi__l2h_scale);
    // compute number of non-alpha components
    if (comp & 1) n = comp; else n = comp-1;
    for (i=0; i < x*y; ++i) {
       for (k=0; k < n; ++k) {
-         output[i*comp + k] = (float) (pow(data[i*comp+k]/255.0f, stbi__l2h_gamma) * stbi__l2h_scale);
+         output[i*comp + k] = gamma[data[i*comp+k]];
       }
       if (k < comp) output[i*comp + k] = data[i*comp+k]/255.0f;
    }
-   STBI_FREE(data);
+   stbi__free(data);
    return output;
 }
 #endif
@@ -1590,7 +2038,7 @@ static stbi_uc *stbi__hdr_to_ldr(float   *data, int x, int y, int comp)
    stbi_uc *output;
    if (!data) return NULL;
    output = (stbi_uc *) stbi__malloc_mad3(x, y, comp, 0);
-   if (output == NULL) { STBI_FREE(data); return stbi__errpuc("outofmem", "Out of memory"); }
+   if (output == NULL) { stbi__free(data); return stbi__errpuc("outofmem", "Out of memory"); }
    // compute number of non-alpha components
    if (comp & 1) n = comp; else n = comp-1;
    for (i=0; i < x*y; ++i) {
@@ -1607,7 +2055,7 @@ static stbi_uc *stbi__hdr_to_ldr(float   *data, int x, int y, int comp)
          output[i*comp + k] = (stbi_uc) stbi__float2int(z);
       }
    }
-   STBI_FREE(data);
+   stbi__free(data);
    return output;
 }
 #endif
@@ -2758,6 +3206,171 @@ static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
    }
 }
 
+// decode MCU number m of the current scan; this is the body of the loops in
+// stbi__parse_entropy_coded_data, addressed by index so that any range of
+// restart intervals can be decoded on its own
+static int stbi__jpeg_decode_mcu(stbi__jpeg *z, int m)
+{
+   STBI_SIMD_ALIGN(short, data[64]);
+   if (z->scan_n == 1) {
+      int n = z->order[0];
+      int w = (z->img_comp[n].x+7) >> 3;
+      int i = m % w, j = m / w;
+      if (!z->progressive) {
+         int ha = z->img_comp[n].ha;
+         if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+         z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+      } else {
+         short *coeff = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
+         if (z->spec_start == 0) {
+            if (!stbi__jpeg_decode_block_prog_dc(z, coeff, &z->huff_dc[z->img_comp[n].hd], n))
+               return 0;
+         } else {
+            int ha = z->img_comp[n].ha;
+            if (!stbi__jpeg_decode_block_prog_ac(z, coeff, &z->huff_ac[ha], z->fast_ac[ha]))
+               return 0;
+         }
+      }
+   } else {
+      int i = m % z->img_mcu_x, j = m / z->img_mcu_x;
+      int k,x,y;
+      for (k=0; k < z->scan_n; ++k) {
+         int n = z->order[k];
+         for (y=0; y < z->img_comp[n].v; ++y) {
+            for (x=0; x < z->img_comp[n].h; ++x) {
+               int x2 = (i*z->img_comp[n].h + x);
+               int y2 = (j*z->img_comp[n].v + y);
+               if (!z->progressive) {
+                  int ha = z->img_comp[n].ha;
+                  if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                  z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*y2*8+x2*8, z->img_comp[n].w2, data);
+               } else {
+                  short *coeff = z->img_comp[n].coeff + 64 * (x2 + y2 * z->img_comp[n].coeff_w);
+                  if (!stbi__jpeg_decode_block_prog_dc(z, coeff, &z->huff_dc[z->img_comp[n].hd], n))
+                     return 0;
+               }
+            }
+         }
+      }
+   }
+   return 1;
+}
+
+// never split work into pieces smaller than this many MCUs
+#define STBI__JPEG_MT_MIN_MCUS   64
+#define STBI__JPEG_MT_MAX_TASKS  32
+
+typedef struct
+{
+   stbi__jpeg *z;
+   stbi_uc **starts;   // first entropy-coded byte of each restart interval
+   stbi_uc *scan_end;
+   int intervals, intervals_per_task, total_mcus;
+   int status[STBI__JPEG_MT_MAX_TASKS];
+} stbi__jpeg_mt_scan;
+
+static void stbi__jpeg_decode_intervals_task(void *ctx, int index)
+{
+   stbi__jpeg_mt_scan *mt = (stbi__jpeg_mt_scan *) ctx;
+   int first = index * mt->intervals_per_task;
+   int first_mcu = first * mt->z->restart_interval;
+   int end_mcu = (first + mt->intervals_per_task) * mt->z->restart_interval;
+   int m;
+   stbi__context s;
+   stbi__jpeg *z = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+   mt->status[index] = 0;
+   if (!z) { stbi__err("outofmem", "Out of memory"); return; }
+   // private copy of the decoder state (huffman tables, kernels, component
+   // buffers) reading from the interval's position in the shared data
+   memcpy(z, mt->z, sizeof(stbi__jpeg));
+   stbi__start_mem(&s, mt->starts[first], (int) (mt->scan_end - mt->starts[first]));
+   z->s = &s;
+   if (end_mcu > mt->total_mcus) end_mcu = mt->total_mcus;
+   stbi__jpeg_reset(z);
+   for (m=first_mcu; m < end_mcu; ++m) {
+      if (!stbi__jpeg_decode_mcu(z, m)) { stbi__free(z); return; }
+      if (--z->todo <= 0) {
+         if (z->code_bits < 24) stbi__grow_buffer_unsafe(z);
+         // same as the serial decoder: stop, rather than fail, on a missing RST
+         if (!STBI__RESTART(z->marker)) break;
+         stbi__jpeg_reset(z);
+      }
+   }
+   stbi__free(z);
+   mt->status[index] = 1;
+}
+
+// decodes the current scan with its restart intervals spread over the
+// caller's thread pool. returns -1 if the scan can't be split this way
+// (no pool, no DRI, callback input, or fewer intervals than the markers
+// found), in which case nothing has been consumed
+static int stbi__parse_entropy_coded_data_mt(stbi__jpeg *z)
+{
+   stbi__jpeg_mt_scan mt;
+   stbi__context *s = z->s;
+   stbi_uc *p, *end;
+   int total, expected, found, tasks, i;
+
+   if (!s->parallel_for || !z->restart_interval || s->read_from_callbacks)
+      return -1;
+   if (z->scan_n == 1) {
+      int n = z->order[0];
+      total = ((z->img_comp[n].x+7) >> 3) * ((z->img_comp[n].y+7) >> 3);
+   } else
+      total = z->img_mcu_x * z->img_mcu_y;
+   expected = (total + z->restart_interval - 1) / z->restart_interval;
+   tasks = total / STBI__JPEG_MT_MIN_MCUS;
+   if (tasks > STBI__JPEG_MT_MAX_TASKS) tasks = STBI__JPEG_MT_MAX_TASKS;
+   if (tasks > expected) tasks = expected;
+   if (tasks < 2) return -1;
+
+   mt.starts = (stbi_uc **) stbi__malloc_mad2(expected, sizeof(stbi_uc *), 0);
+   if (!mt.starts) return -1;
+
+   // find the RSTn markers up to the first other marker, which ends the scan
+   p = s->img_buffer;
+   end = s->img_buffer_end;
+   mt.starts[0] = p;
+   found = 1;
+   for (;;) {
+      p = (stbi_uc *) memchr(p, 0xff, end - p);
+      if (!p || p + 1 >= end) { p = end; break; }
+      if (p[1] == 0x00) { p += 2; continue; } // stuffed 0xff data byte
+      if (p[1] == 0xff) { p += 1; continue; } // fill byte
+      if (!STBI__RESTART(p[1])) break;
+      if (found == expected) { found = 0; break; }
+      mt.starts[found++] = p + 2;
+      p += 2;
+   }
+   if (found != expected) {
+      stbi__free(mt.starts);
+      return -1;
+   }
+
+   mt.z = z;
+   mt.scan_end = p;
+   mt.intervals = expected;
+   mt.intervals_per_task = (expected + tasks - 1) / tasks;
+   mt.total_mcus = total;
+   tasks = (expected + mt.intervals_per_task - 1) / mt.intervals_per_task;
+   s->parallel_for(s->pool, stbi__jpeg_decode_intervals_task, &mt, tasks);
+   stbi__free(mt.starts);
+
+   // a failed task has already set the failure reason
+   for (i=0; i < tasks; ++i)
+      if (!mt.status[i]) return 0;
+
+   // leave the stream just past the marker that ended the scan, as if the
+   // serial decoder had read it from the entropy-coded data
+   stbi__jpeg_reset(z);
+   if (p + 1 < end) {
+      z->marker = p[1];
+      s->img_buffer = p + 2;
+   } else
+      s->img_buffer = end;
+   return 1;
+}
+
 static void stbi__jpeg_dequantize(short *data, stbi__uint16 *dequant)
 {
    int i;
@@ -2765,25 +3378,53 @@ static void stbi__jpeg_dequantize(short *data, stbi__uint16 *dequant)
       data[i] *= dequant[i];
 }
 
-static void stbi__jpeg_finish(stbi__jpeg *z)
+// number of row bands to split per-pixel work into, 1 if single-threaded
+static int stbi__jpeg_band_count(stbi__jpeg *z)
 {
-   if (z->progressive) {
-      // dequantize and idct the data
-      int i,j,n;
-      for (n=0; n < z->s->img_n; ++n) {
-         int w = (z->img_comp[n].x+7) >> 3;
-         int h = (z->img_comp[n].y+7) >> 3;
-         for (j=0; j < h; ++j) {
-            for (i=0; i < w; ++i) {
-               short *data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
-               stbi__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
-               z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
-            }
+   stbi__uint32 bands;
+   if (!z->s->parallel_for) return 1;
+   bands = (z->s->img_x * z->s->img_y) / (STBI__JPEG_MT_MIN_MCUS * 64);
+   if (bands > z->s->img_y / 8) bands = z->s->img_y / 8;
+   if (bands > STBI__JPEG_MT_MAX_TASKS) bands = STBI__JPEG_MT_MAX_TASKS;
+   return bands < 1 ? 1 : (int) bands;
+}
+
+// dequantize and idct every block row of every component that falls in 'band'
+static void stbi__jpeg_finish_rows(stbi__jpeg *z, int band, int bands)
+{
+   int i,j,n;
+   for (n=0; n < z->s->img_n; ++n) {
+      int w = (z->img_comp[n].x+7) >> 3;
+      int h = (z->img_comp[n].y+7) >> 3;
+      int j0 = h * band / bands, j1 = h * (band+1) / bands;
+      for (j=j0; j < j1; ++j) {
+         for (i=0; i < w; ++i) {
+            short *data = z->img_comp[n].coeff + 64 * (i + j * z->img_comp[n].coeff_w);
+            stbi__jpeg_dequantize(data, z->dequant[z->img_comp[n].tq]);
+            z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
          }
       }
    }
 }
 
+static void stbi__jpeg_finish_task(void *ctx, int index)
+{
+   stbi__jpeg *z = (stbi__jpeg *) ctx;
+   stbi__jpeg_finish_rows(z, index, stbi__jpeg_band_count(z));
+}
+
+static void stbi__jpeg_finish(stbi__jpeg *z)
+{
+   if (z->progressive) {
+      // dequantize and idct the data; block rows are independent
+      int bands = stbi__jpeg_band_count(z);
+      if (bands > 1)
+         z->s->parallel_for(z->s->pool, stbi__jpeg_finish_task, z, bands);
+      else
+         stbi__jpeg_finish_rows(z, 0, 1);
+   }
+}
+
 static int stbi__process_marker(stbi__jpeg *z, int m)
 {
    int L;
@@ -2931,17 +3572,17 @@ static int stbi__free_jpeg_components(stbi__jpeg *z, int ncomp, int why)
    int i;
    for (i=0; i < ncomp; ++i) {
       if (z->img_comp[i].raw_data) {
-         STBI_FREE(z->img_comp[i].raw_data);
+         stbi__free(z->img_comp[i].raw_data);
          z->img_comp[i].raw_data = NULL;
          z->img_comp[i].data = NULL;
       }
       if (z->img_comp[i].raw_coeff) {
-         STBI_FREE(z->img_comp[i].raw_coeff);
+         stbi__free(z->img_comp[i].raw_coeff);
          z->img_comp[i].raw_coeff = 0;
          z->img_comp[i].coeff = 0;
       }
       if (z->img_comp[i].linebuf) {
-         STBI_FREE(z->img_comp[i].linebuf);
+         stbi__free(z->img_comp[i].linebuf);
          z->img_comp[i].linebuf = NULL;
       }
    }
@@ -3077,8 +3718,11 @@ static int stbi__decode_jpeg_image(stbi__jpeg *j)
    m = stbi__get_marker(j);
    while (!stbi__EOI(m)) {
       if (stbi__SOS(m)) {
+         int r;
          if (!stbi__process_scan_header(j)) return 0;
-         if (!stbi__parse_entropy_coded_data(j)) return 0;
+         r = stbi__parse_entropy_coded_data_mt(j);
+         if (r < 0) r = stbi__parse_entropy_coded_data(j);
+         if (!r) return 0;
          if (j->marker == STBI__MARKER_none ) {
             // handle 0s at the end of image data from IP Kamera 9060
             while (!stbi__at_eof(j->s)) {
@@ -3521,6 +4165,165 @@ static stbi_uc stbi__blinn_8x8(stbi_uc x, stbi_uc y)
    return (stbi_uc) ((t + (t >>8)) >> 8);
 }
 
+// resample and color-convert output rows [j0,j1) into 'output', which points
+// at row j0, with 'step' bytes from one row to the next. res_comp holds the
+// resampler state for row j0 and is advanced past the last row.
+//
+// the 3-channel paths, and 4-to-1 channel, write one byte past the end of
+// each row. if 'spare' is NULL that byte must be writable; otherwise any
+// row whose trailing byte isn't covered by the next row of this call goes
+// through 'spare'
+static void stbi__jpeg_convert_rows(stbi__jpeg *z, stbi_uc *output, int step, stbi__resample *res_comp, stbi_uc **linebuf, int n, int decode_n, int is_rgb, stbi__uint32 j0, stbi__uint32 j1, stbi_uc *spare)
+{
+   int k;
+   unsigned int i,j;
+   stbi_uc *coutput[4];
+   int overrun = n == 3 || (n == 1 && z->s->img_n == 4);
+
+   for (j=j0; j < j1; ++j) {
+      stbi_uc *row = output + step * (int) (j - j0);
+      int spill = spare && overrun && (step != n * (int) z->s->img_x || j+1 == j1);
+      stbi_uc *out = spill ? spare : row;
+      for (k=0; k < decode_n; ++k) {
+         stbi__resample *r = &res_comp[k];
+         int y_bot = r->ystep >= (r->vs >> 1);
+         coutput[k] = r->resample(linebuf[k],
+                                  y_bot ? r->line1 : r->line0,
+                                  y_bot ? r->line0 : r->line1,
+                                  r->w_lores, r->hs);
+         if (++r->ystep >= r->vs) {
+            r->ystep = 0;
+            r->line0 = r->line1;
+            if (++r->ypos < z->img_comp[k].y)
+               r->line1 += z->img_comp[k].w2;
+         }
+      }
+      if (n >= 3) {
+         stbi_uc *y = coutput[0];
+         if (z->s->img_n == 3) {
+            if (is_rgb) {
+               for (i=0; i < z->s->img_x; ++i) {
+                  out[0] = y[i];
+                  out[1] = coutput[1][i];
+                  out[2] = coutput[2][i];
+                  out[3] = 255;
+                  out += n;
+               }
+            } else {
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+            }
+         } else if (z->s->img_n == 4) {
+            if (z->app14_color_transform == 0) { // CMYK
+               for (i=0; i < z->s->img_x; ++i) {
+                  stbi_uc m = coutput[3][i];
+                  out[0] = stbi__blinn_8x8(coutput[0][i], m);
+                  out[1] = stbi__blinn_8x8(coutput[1][i], m);
+                  out[2] = stbi__blinn_8x8(coutput[2][i], m);
+                  out[3] = 255;
+                  out += n;
+               }
+            } else if (z->app14_color_transform == 2) { // YCCK
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+               for (i=0; i < z->s->img_x; ++i) {
+                  stbi_uc m = coutput[3][i];
+                  out[0] = stbi__blinn_8x8(255 - out[0], m);
+                  out[1] = stbi__blinn_8x8(255 - out[1], m);
+                  out[2] = stbi__blinn_8x8(255 - out[2], m);
+                  out += n;
+               }
+            } else { // YCbCr + alpha?  Ignore the fourth channel for now
+               z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
+            }
+         } else
+            for (i=0; i < z->s->img_x; ++i) {
+               out[0] = out[1] = out[2] = y[i];
+               out[3] = 255; // not used if n==3
+               out += n;
+            }
+      } else {
+         if (is_rgb) {
+            if (n == 1)
+               for (i=0; i < z->s->img_x; ++i)
+                  *out++ = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+            else {
+               for (i=0; i < z->s->img_x; ++i, out += 2) {
+                  out[0] = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
+                  out[1] = 255;
+               }
+            }
+         } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
+            for (i=0; i < z->s->img_x; ++i) {
+               stbi_uc m = coutput[3][i];
+               stbi_uc r = stbi__blinn_8x8(coutput[0][i], m);
+               stbi_uc g = stbi__blinn_8x8(coutput[1][i], m);
+               stbi_uc b = stbi__blinn_8x8(coutput[2][i], m);
+               out[0] = stbi__compute_y(r, g, b);
+               out[1] = 255;
+               out += n;
+            }
+         } else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
+            for (i=0; i < z->s->img_x; ++i) {
+               out[0] = stbi__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
+               out[1] = 255;
+               out += n;
+            }
+         } else {
+            stbi_uc *y = coutput[0];
+            if (n == 1)
+               for (i=0; i < z->s->img_x; ++i) out[i] = y[i];
+            else
+               for (i=0; i < z->s->img_x; ++i) *out++ = y[i], *out++ = 255;
+         }
+      }
+      if (spill) memcpy(row, spare, n * z->s->img_x);
+   }
+}
+
+// advance a resampler by 'rows' output rows without producing them, so a
+// band of rows can start from the same state the serial loop would reach
+static void stbi__resample_skip(stbi__resample *r, int comp_y, int w2, stbi__uint32 rows)
+{
+   while (rows--) {
+      if (++r->ystep >= r->vs) {
+         r->ystep = 0;
+         r->line0 = r->line1;
+         if (++r->ypos < comp_y)
+            r->line1 += w2;
+      }
+   }
+}
+
+typedef struct
+{
+   stbi__jpeg *z;
+   stbi_uc *output;
+   int step;
+   stbi__resample *res_comp;
+   stbi_uc *scratch;   // band_size bytes for each band
+   int band_size;
+   int n, decode_n, is_rgb, bands;
+} stbi__jpeg_mt_convert;
+
+static void stbi__jpeg_convert_task(void *ctx, int index)
+{
+   stbi__jpeg_mt_convert *c = (stbi__jpeg_mt_convert *) ctx;
+   stbi__jpeg *z = c->z;
+   stbi__uint32 j0 = z->s->img_y * index / c->bands;
+   stbi__uint32 j1 = z->s->img_y * (index+1) / c->bands;
+   stbi_uc *scratch = c->scratch + (size_t) index * c->band_size;
+   stbi__resample res_comp[4];
+   stbi_uc *linebuf[4];
+   int k;
+   for (k=0; k < c->decode_n; ++k) {
+      res_comp[k] = c->res_comp[k];
+      stbi__resample_skip(&res_comp[k], z->img_comp[k].y, z->img_comp[k].w2, j0);
+      linebuf[k] = scratch + k * (z->s->img_x + 3);
+   }
+   // the spare row keeps the byte written past a band's last row from
+   // landing in another band while that band is running
+   stbi__jpeg_convert_rows(z, c->output + c->step * (int) j0, c->step, res_comp, linebuf, c->n, c->decode_n, c->is_rgb, j0, j1, scratch + c->decode_n * (z->s->img_x + 3));
+}
+
 static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp)
 {
    int n, decode_n, is_rgb;
@@ -3544,10 +4347,11 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
 
    // resample and color-convert
    {
-      int k;
-      unsigned int i,j;
+      int k, bands, step;
       stbi_uc *output;
-      stbi_uc *coutput[4];
+      stbi_uc *linebuf[4];
+      stbi_uc *band_scratch = NULL, *spare = NULL;
+      int band_size = decode_n * (z->s->img_x + 3) + n * z->s->img_x + 1;
 
       stbi__resample res_comp[4];
 
@@ -3573,105 +4377,49 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
          else                               r->resample = stbi__resample_row_generic;
       }
 
-      // can't error after this so, this is safe
-      output = (stbi_uc *) stbi__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
-      if (!output) { stbi__cleanup_jpeg(z); return stbi__errpuc("outofmem", "Out of memory"); }
+      // each band needs its own line buffers and a spare output row; if they
+      // can't be had, convert serially
+      bands = stbi__jpeg_band_count(z);
+      if (bands > 1)
+         band_scratch = (stbi_uc *) stbi__malloc_mad2(bands, band_size, 0);
+
+      if (z->s->dest) {
+         // convert straight into the caller's rows. there's no slack byte
+         // after them, so the serial path needs a spare row too
+         output = stbi__dest_rows(z->s, z->s->img_x, z->s->img_y, n, &step);
+         if (output && !band_scratch) {
+            spare = (stbi_uc *) stbi__malloc_mad2(n, z->s->img_x, 1);
+            if (!spare) output = stbi__errpuc("outofmem", "Out of memory");
+         }
+      } else {
+         // can't error after this so, this is safe
+         output = (stbi_uc *) stbi__malloc_mad3(n, z->s->img_x, z->s->img_y, 1);
+         if (!output) stbi__err("outofmem", "Out of memory");
+         step = n * z->s->img_x;
+      }
+      if (!output) { if (band_scratch) stbi__free(band_scratch); stbi__cleanup_jpeg(z); return NULL; }
 
       // now go ahead and resample
-      for (j=0; j < z->s->img_y; ++j) {
-         stbi_uc *out = output + n * z->s->img_x * j;
-         for (k=0; k < decode_n; ++k) {
-            stbi__resample *r = &res_comp[k];
-            int y_bot = r->ystep >= (r->vs >> 1);
-            coutput[k] = r->resample(z->img_comp[k].linebuf,
-                                     y_bot ? r->line1 : r->line0,
-                                     y_bot ? r->line0 : r->line1,
-                                     r->w_lores, r->hs);
-            if (++r->ystep >= r->vs) {
-               r->ystep = 0;
-               r->line0 = r->line1;
-               if (++r->ypos < z->img_comp[k].y)
-                  r->line1 += z->img_comp[k].w2;
-            }
-         }
-         if (n >= 3) {
-            stbi_uc *y = coutput[0];
-            if (z->s->img_n == 3) {
-               if (is_rgb) {
-                  for (i=0; i < z->s->img_x; ++i) {
-                     out[0] = y[i];
-                     out[1] = coutput[1][i];
-                     out[2] = coutput[2][i];
-                     out[3] = 255;
-                     out += n;
-                  }
-               } else {
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-               }
-            } else if (z->s->img_n == 4) {
-               if (z->app14_color_transform == 0) { // CMYK
-                  for (i=0; i < z->s->img_x; ++i) {
-                     stbi_uc m = coutput[3][i];
-                     out[0] = stbi__blinn_8x8(coutput[0][i], m);
-                     out[1] = stbi__blinn_8x8(coutput[1][i], m);
-                     out[2] = stbi__blinn_8x8(coutput[2][i], m);
-                     out[3] = 255;
-                     out += n;
-                  }
-               } else if (z->app14_color_transform == 2) { // YCCK
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-                  for (i=0; i < z->s->img_x; ++i) {
-                     stbi_uc m = coutput[3][i];
-                     out[0] = stbi__blinn_8x8(255 - out[0], m);
-                     out[1] = stbi__blinn_8x8(255 - out[1], m);
-                     out[2] = stbi__blinn_8x8(255 - out[2], m);
-                     out += n;
-                  }
-               } else { // YCbCr + alpha?  Ignore the fourth channel for now
-                  z->YCbCr_to_RGB_kernel(out, y, coutput[1], coutput[2], z->s->img_x, n);
-               }
-            } else
-               for (i=0; i < z->s->img_x; ++i) {
-                  out[0] = out[1] = out[2] = y[i];
-                  out[3] = 255; // not used if n==3
-                  out += n;
-               }
-         } else {
-            if (is_rgb) {
-               if (n == 1)
-                  for (i=0; i < z->s->img_x; ++i)
-                     *out++ = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-               else {
-                  for (i=0; i < z->s->img_x; ++i, out += 2) {
-                     out[0] = stbi__compute_y(coutput[0][i], coutput[1][i], coutput[2][i]);
-                     out[1] = 255;
-                  }
-               }
-            } else if (z->s->img_n == 4 && z->app14_color_transform == 0) {
-               for (i=0; i < z->s->img_x; ++i) {
-                  stbi_uc m = coutput[3][i];
-                  stbi_uc r = stbi__blinn_8x8(coutput[0][i], m);
-                  stbi_uc g = stbi__blinn_8x8(coutput[1][i], m);
-                  stbi_uc b = stbi__blinn_8x8(coutput[2][i], m);
-                  out[0] = stbi__compute_y(r, g, b);
-                  out[1] = 255;
-                  out += n;
-               }
-            } else if (z->s->img_n == 4 && z->app14_color_transform == 2) {
-               for (i=0; i < z->s->img_x; ++i) {
-                  out[0] = stbi__blinn_8x8(255 - coutput[0][i], coutput[3][i]);
-                  out[1] = 255;
-                  out += n;
-               }
-            } else {
-               stbi_uc *y = coutput[0];
-               if (n == 1)
-                  for (i=0; i < z->s->img_x; ++i) out[i] = y[i];
-               else
-                  for (i=0; i < z->s->img_x; ++i) *out++ = y[i], *out++ = 255;
-            }
-         }
+      if (bands > 1 && band_scratch) {
+         stbi__jpeg_mt_convert c;
+         c.z = z;
+         c.output = output;
+         c.step = step;
+         c.res_comp = res_comp;
+         c.scratch = band_scratch;
+         c.band_size = band_size;
+         c.n = n;
+         c.decode_n = decode_n;
+         c.is_rgb = is_rgb;
+         c.bands = bands;
+         z->s->parallel_for(z->s->pool, stbi__jpeg_convert_task, &c, bands);
+      } else {
+         for (k=0; k < decode_n; ++k)
+            linebuf[k] = z->img_comp[k].linebuf;
+         stbi__jpeg_convert_rows(z, output, step, res_comp, linebuf, n, decode_n, is_rgb, 0, z->s->img_y, spare);
       }
+      if (band_scratch) stbi__free(band_scratch);
+      if (spare) stbi__free(spare);
       stbi__cleanup_jpeg(z);
       *out_x = z->s->img_x;
       *out_y = z->s->img_y;
@@ -3684,11 +4432,11 @@ static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int re
 {
    unsigned char* result;
    stbi__jpeg* j = (stbi__jpeg*) stbi__malloc(sizeof(stbi__jpeg));
-   STBI_NOTUSED(ri);
    j->s = s;
    stbi__setup_jpeg(j);
    result = load_jpeg_image(j, x,y,comp,req_comp);
-   STBI_FREE(j);
+   ri->in_dest = s->dest != NULL; // always converts straight into it
+   stbi__free(j);
    return result;
 }
 
@@ -3700,7 +4448,7 @@ static int stbi__jpeg_test(stbi__context *s)
    stbi__setup_jpeg(j);
    r = stbi__decode_jpeg_header(j, STBI__SCAN_type);
    stbi__rewind(s);
-   STBI_FREE(j);
+   stbi__free(j);
    return r;
 }
 
@@ -3722,7 +4470,7 @@ static int stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp)
    stbi__jpeg* j = (stbi__jpeg*) (stbi__malloc(sizeof(stbi__jpeg)));
    j->s = s;
    result = stbi__jpeg_info_raw(j, x, y, comp);
-   STBI_FREE(j);
+   stbi__free(j);
    return result;
 }
 #endif
@@ -3740,6 +4488,23 @@ static int stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp)
 #define STBI__ZFAST_BITS  9 // accelerate all cases in default tables
 #define STBI__ZFAST_MASK  ((1 << STBI__ZFAST_BITS) - 1)
 
+// second-level table on the literal/length alphabet that resolves up to two
+// literals, or a match length including its extra bits, in a single lookup
+#define STBI__ZLIT_BITS   11
+#define STBI__ZLIT_MASK   ((1 << STBI__ZLIT_BITS) - 1)
+
+// on 64-bit little-endian targets the bit buffer is refilled a word at a time
+#if defined(STBI__X64_TARGET) || (defined(__aarch64__) && !defined(__AARCH64EB__)) || defined(_M_ARM64)
+#define STBI__ZBITS64
+#ifdef _MSC_VER
+typedef unsigned __int64 stbi__zbits;
+#else
+typedef unsigned long long stbi__zbits;
+#endif
+#else
+typedef stbi__uint32 stbi__zbits;
+#endif
+
 // zlib-style huffman encoding
 // (jpegs packs from left, zlib from right, so can't share code)
 typedef struct
@@ -3826,7 +4591,8 @@ typedef struct
 {
    stbi_uc *zbuffer, *zbuffer_end;
    int num_bits;
-   stbi__uint32 code_buffer;
+   int num_zeros;   // zero bytes padded in past zbuffer_end
+   stbi__zbits code_buffer;
 
    char *zout;
    char *zout_start;
@@ -3834,6 +4600,7 @@ typedef struct
    int   z_expandable;
 
    stbi__zhuffman z_length, z_distance;
+   stbi__uint32 z_lit[1 << STBI__ZLIT_BITS];
 } stbi__zbuf;
 
 stbi_inline static stbi_uc stbi__zget8(stbi__zbuf *z)
@@ -3844,18 +4611,38 @@ stbi_inline static stbi_uc stbi__zget8(stbi__zbuf *z)
 
 static void stbi__fill_bits(stbi__zbuf *z)
 {
+#ifdef STBI__ZBITS64
+   // load 8 bytes but only claim the whole bytes that fit; the bits above
+   // num_bits are the start of the next byte, which the next refill ORs in
+   // again at the same position, so they never need to be masked off
+   if (z->zbuffer_end - z->zbuffer >= 8) {
+      stbi__zbits v;
+      memcpy(&v, z->zbuffer, 8);
+      z->code_buffer |= v << z->num_bits;
+      z->zbuffer += (63 - z->num_bits) >> 3;
+      z->num_bits |= 56;
+      return;
+   }
+   do {
+      if (z->zbuffer >= z->zbuffer_end) ++z->num_zeros;
+      z->code_buffer |= (stbi__zbits) stbi__zget8(z) << z->num_bits;
+      z->num_bits += 8;
+   } while (z->num_bits <= 56);
+#else
    do {
       STBI_ASSERT(z->code_buffer < (1U << z->num_bits));
+      if (z->zbuffer >= z->zbuffer_end) ++z->num_zeros;
       z->code_buffer |= (unsigned int) stbi__zget8(z) << z->num_bits;
       z->num_bits += 8;
    } while (z->num_bits <= 24);
+#endif
 }
 
 stbi_inline static unsigned int stbi__zreceive(stbi__zbuf *z, int n)
 {
    unsigned int k;
    if (z->num_bits < n) stbi__fill_bits(z);
-   k = z->code_buffer & ((1 << n) - 1);
+   k = (unsigned int) z->code_buffer & ((1 << n) - 1);
    z->code_buffer >>= n;
    z->num_bits -= n;
    return k;
@@ -3866,7 +4653,7 @@ static int stbi__zhuffman_decode_slowpath(stbi__zbuf *a, stbi__zhuffman *z)
    int b,s,k;
    // not resolved by fast table, so compute it the slow way
    // use jpeg approach, which requires MSbits at top
-   k = stbi__bit_reverse(a->code_buffer, 16);
+   k = stbi__bit_reverse((int) (a->code_buffer & 0xffff), 16);
    for (s=STBI__ZFAST_BITS+1; ; ++s)
       if (k < z->maxcode[s])
          break;
@@ -3903,7 +4690,7 @@ static int stbi__zexpand(stbi__zbuf *z, char *zout, int n)  // need to make room
    limit = old_limit = (int) (z->zout_end - z->zout_start);
    while (cur + n > limit)
       limit *= 2;
-   q = (char *) STBI_REALLOC_SIZED(z->zout_start, old_limit, limit);
+   q = (char *) stbi__realloc_sized(z->zout_start, old_limit, limit);
    STBI_NOTUSED(old_limit);
    if (q == NULL) return stbi__err("outofmem", "Out of memory");
    z->zout_start = q;
@@ -3926,21 +4713,76 @@ static int stbi__zdist_base[32] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,
 static int stbi__zdist_extra[32] =
 { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13};
 
+// z_lit entries: bits 0-15 hold one or two literals or a resolved match
+// length, bits 16-19 the total bits consumed, bits 20-21 the entry kind
+#define STBI__ZLIT_ONE    1
+#define STBI__ZLIT_TWO    2
+#define STBI__ZLIT_LENGTH 3
+
+static void stbi__zbuild_lit_table(stbi__zbuf *a)
+{
+   stbi__zhuffman *z = &a->z_length;
+   int i;
+   for (i=0; i < (1 << STBI__ZLIT_BITS); ++i) {
+      stbi__uint32 e = 0;
+      int b = z->fast[i & STBI__ZFAST_MASK];
+      if (b) {
+         int s = b >> 9, v = b & 511;
+         if (v < 256) {
+            // the bits after the first code are only valid up to
+            // STBI__ZLIT_BITS, so the second code must fit in what's left
+            int b2 = z->fast[(i >> s) & STBI__ZFAST_MASK];
+            e = (STBI__ZLIT_ONE << 20) | (s << 16) | v;
+            if (b2 && (b2 & 511) < 256 && s + (b2 >> 9) <= STBI__ZLIT_BITS)
+               e = (STBI__ZLIT_TWO << 20) | ((s + (b2 >> 9)) << 16) | ((b2 & 511) << 8) | v;
+         } else if (v > 256 && v < 286) {
+            int x = stbi__zlength_extra[v-257];
+            if (s + x <= STBI__ZLIT_BITS)
+               e = (STBI__ZLIT_LENGTH << 20) | ((s + x) << 16) | (stbi__zlength_base[v-257] + ((i >> s) & ((1 << x) - 1)));
+         }
+      }
+      a->z_lit[i] = e;
+   }
+}
+
 static int stbi__parse_huffman_block(stbi__zbuf *a)
 {
    char *zout = a->zout;
    for(;;) {
-      int z = stbi__zhuffman_decode(a, &a->z_length);
-      if (z < 256) {
-         if (z < 0) return stbi__err("bad huffman code","Corrupt PNG"); // error in huffman codes
-         if (zout >= a->zout_end) {
-            if (!stbi__zexpand(a, zout, 1)) return 0;
-            zout = a->zout;
+      stbi_uc *p;
+      int z,len,dist;
+      stbi__uint32 e;
+      if (a->num_bits < 16) stbi__fill_bits(a);
+      e = a->z_lit[a->code_buffer & STBI__ZLIT_MASK];
+      if (e) {
+         int s = (e >> 16) & 15;
+         a->code_buffer >>= s;
+         a->num_bits -= s;
+         if ((e >> 20) != STBI__ZLIT_LENGTH) {
+            // reserve only what this entry writes, so a fixed-size output
+            // buffer that ends on a single literal still fits exactly
+            int n = (int) (e >> 20);
+            if (zout + n > a->zout_end) {
+               if (!stbi__zexpand(a, zout, n)) return 0;
+               zout = a->zout;
+            }
+            *zout++ = (char) (e & 255);
+            if (n == STBI__ZLIT_TWO)
+               *zout++ = (char) ((e >> 8) & 255);
+            continue;
          }
-         *zout++ = (char) z;
+         len = e & 0xffff;
       } else {
-         stbi_uc *p;
-         int len,dist;
+         z = stbi__zhuffman_decode(a, &a->z_length);
+         if (z < 256) {
+            if (z < 0) return stbi__err("bad huffman code","Corrupt PNG"); // error in huffman codes
+            if (zout >= a->zout_end) {
+               if (!stbi__zexpand(a, zout, 1)) return 0;
+               zout = a->zout;
+            }
+            *zout++ = (char) z;
+            continue;
+         }
          if (z == 256) {
             a->zout = zout;
             return 1;
@@ -3948,22 +4790,32 @@ static int stbi__parse_huffman_block(stbi__zbuf *a)
          z -= 257;
          len = stbi__zlength_base[z];
          if (stbi__zlength_extra[z]) len += stbi__zreceive(a, stbi__zlength_extra[z]);
-         z = stbi__zhuffman_decode(a, &a->z_distance);
-         if (z < 0) return stbi__err("bad huffman code","Corrupt PNG");
-         dist = stbi__zdist_base[z];
-         if (stbi__zdist_extra[z]) dist += stbi__zreceive(a, stbi__zdist_extra[z]);
-         if (zout - a->zout_start < dist) return stbi__err("bad dist","Corrupt PNG");
-         if (zout + len > a->zout_end) {
-            if (!stbi__zexpand(a, zout, len)) return 0;
-            zout = a->zout;
-         }
-         p = (stbi_uc *) (zout - dist);
-         if (dist == 1) { // run of one byte; common in images.
-            stbi_uc v = *p;
-            if (len) { do *zout++ = v; while (--len); }
-         } else {
-            if (len) { do *zout++ = *p++; while (--len); }
-         }
+      }
+      z = stbi__zhuffman_decode(a, &a->z_distance);
+      if (z < 0) return stbi__err("bad huffman code","Corrupt PNG");
+      dist = stbi__zdist_base[z];
+      if (stbi__zdist_extra[z]) dist += stbi__zreceive(a, stbi__zdist_extra[z]);
+      if (zout - a->zout_start < dist) return stbi__err("bad dist","Corrupt PNG");
+      if (zout + len > a->zout_end) {
+         if (!stbi__zexpand(a, zout, len)) return 0;
+         zout = a->zout;
+      }
+      p = (stbi_uc *) (zout - dist);
+      if (dist == 1) { // run of one byte; common in images.
+         memset(zout, *p, len);
+         zout += len;
+      } else if (dist >= 8 && a->zout_end - zout >= len + 7) {
+         // copy a word at a time; the source never overlaps the word being
+         // written, and the overshoot past len is rewritten by later output
+         char *end = zout + len;
+         do {
+            memcpy(zout, p, 8);
+            zout += 8;
+            p += 8;
+         } while (zout < end);
+         zout = end;
+      } else {
+         if (len) { do *zout++ = *p++; while (--len); }
       }
    }
 }
@@ -4025,12 +4877,22 @@ static int stbi__parse_uncompressed_block(stbi__zbuf *a)
       stbi__zreceive(a, a->num_bits & 7); // discard
    // drain the bit-packed data into header
    k = 0;
-   while (a->num_bits > 0) {
+   while (a->num_bits > 0 && k < 4) {
       header[k++] = (stbi_uc) (a->code_buffer & 255); // suppress MSVC run-time check
       a->code_buffer >>= 8;
       a->num_bits -= 8;
    }
-   STBI_ASSERT(a->num_bits == 0);
+   if (a->num_bits > 0) {
+      // a wide refill read past the header; give back the whole bytes
+      // still in the bit buffer, except ones padded in past the end
+      int n = a->num_bits >> 3;
+      a->zbuffer -= n > a->num_zeros ? n - a->num_zeros : 0;
+   }
+   // the stored bytes are copied straight from zbuffer, so restart the
+   // bit buffer empty (a wide refill may have left look-ahead bits in it)
+   a->num_zeros = 0;
+   a->code_buffer = 0;
+   a->num_bits = 0;
    // now fill header the normal way
    while (k < 4)
       header[k++] = stbi__zget8(a);
@@ -4094,6 +4956,7 @@ static int stbi__parse_zlib(stbi__zbuf *a, int parse_header)
    if (parse_header)
       if (!stbi__parse_zlib_header(a)) return 0;
    a->num_bits = 0;
+   a->num_zeros = 0;
    a->code_buffer = 0;
    do {
       final = stbi__zreceive(a,1);
@@ -4110,6 +4973,7 @@ static int stbi__parse_zlib(stbi__zbuf *a, int parse_header)
          } else {
             if (!stbi__compute_huffman_codes(a)) return 0;
          }
+         stbi__zbuild_lit_table(a);
          if (!stbi__parse_huffman_block(a)) return 0;
       }
    } while (!final);
@@ -4137,7 +5001,7 @@ STBIDEF char *stbi_zlib_decode_malloc_guesssize(const char *buffer, int len, int
       if (outlen) *outlen = (int) (a.zout - a.zout_start);
       return a.zout_start;
    } else {
-      STBI_FREE(a.zout_start);
+      stbi__free(a.zout_start);
       return NULL;
    }
 }
@@ -4158,7 +5022,7 @@ STBIDEF char *stbi_zlib_decode_malloc_guesssize_headerflag(const char *buffer, i
       if (outlen) *outlen = (int) (a.zout - a.zout_start);
       return a.zout_start;
    } else {
-      STBI_FREE(a.zout_start);
+      stbi__free(a.zout_start);
       return NULL;
    }
 }
@@ -4185,7 +5049,7 @@ STBIDEF char *stbi_zlib_decode_noheader_malloc(char const *buffer, int len, int
       if (outlen) *outlen = (int) (a.zout - a.zout_start);
       return a.zout_start;
    } else {
-      STBI_FREE(a.zout_start);
+      stbi__free(a.zout_start);
       return NULL;
    }
 }
@@ -4241,6 +5105,7 @@ typedef struct
    stbi__context *s;
    stbi_uc *idata, *expanded, *out;
    int depth;
+   int direct;   // unfilter straight into s->dest, leaving 'out' NULL
 } stbi__png;
 
 
@@ -4277,6 +5142,124 @@ static int stbi__paeth(int a, int b, int c)
 
 static stbi_uc stbi__depth_scale_table[9] = { 0, 0xff, 0x55, 0, 0x11, 0,0,0, 0x01 };
 
+#ifdef STBI_SSE2
+// sub/avg/paeth depend on the pixel to the left, so these run one pixel per
+// iteration with the left, up and up-left pixels kept in registers; only
+// "up" is data-parallel across the whole row
+stbi_inline static __m128i stbi__png_load_px(stbi_uc const *p, int bpp)
+{
+   stbi__uint32 v;
+   if (bpp == 4)
+      memcpy(&v, p, 4);
+   else
+      v = p[0] | (p[1] << 8) | (p[2] << 16);
+   return _mm_cvtsi32_si128((int) v);
+}
+
+stbi_inline static void stbi__png_store_px(stbi_uc *p, __m128i x, int bpp)
+{
+   stbi__uint32 v = (stbi__uint32) _mm_cvtsi128_si32(x);
+   if (bpp == 4)
+      memcpy(p, &v, 4);
+   else {
+      p[0] = STBI__BYTECAST(v);
+      p[1] = STBI__BYTECAST(v >> 8);
+      p[2] = STBI__BYTECAST(v >> 16);
+   }
+}
+
+#ifdef STBI_AVX2
+STBI__AVX2_TARGET
+static int stbi__png_unfilter_up_avx2(stbi_uc *cur, stbi_uc const *prior, stbi_uc const *raw, int nk)
+{
+   int k;
+   for (k=0; k + 32 <= nk; k += 32) {
+      __m256i x = _mm256_loadu_si256((__m256i const *) (raw + k));
+      __m256i b = _mm256_loadu_si256((__m256i const *) (prior + k));
+      _mm256_storeu_si256((__m256i *) (cur + k), _mm256_add_epi8(x, b));
+   }
+   return k;
+}
+#endif
+
+// returns 0 if the row was not handled and the scalar loop has to run
+static int stbi__png_unfilter_row_simd(int filter, stbi_uc *cur, stbi_uc const *prior, stbi_uc const *raw, int nk, int bpp, int avx2)
+{
+   __m128i zero = _mm_setzero_si128();
+   int k = 0;
+
+   if (filter == STBI__F_up) {
+#ifdef STBI_AVX2
+      if (avx2)
+         k = stbi__png_unfilter_up_avx2(cur, prior, raw, nk);
+#else
+      STBI_NOTUSED(avx2);
+#endif
+      for (; k + 16 <= nk; k += 16) {
+         __m128i x = _mm_loadu_si128((__m128i const *) (raw + k));
+         __m128i b = _mm_loadu_si128((__m128i const *) (prior + k));
+         _mm_storeu_si128((__m128i *) (cur + k), _mm_add_epi8(x, b));
+      }
+      for (; k < nk; ++k)
+         cur[k] = STBI__BYTECAST(raw[k] + prior[k]);
+      return 1;
+   }
+
+   if (bpp != 3 && bpp != 4)
+      return 0;
+
+   switch (filter) {
+      case STBI__F_sub: {
+         __m128i a = stbi__png_load_px(cur - bpp, bpp);
+         for (; k < nk; k += bpp) {
+            a = _mm_add_epi8(a, stbi__png_load_px(raw + k, bpp));
+            stbi__png_store_px(cur + k, a, bpp);
+         }
+         return 1;
+      }
+      case STBI__F_avg: {
+         // avg_epu8 rounds up, so subtract the carry to get (a+b)>>1
+         __m128i one = _mm_set1_epi8(1);
+         __m128i a = stbi__png_load_px(cur - bpp, bpp);
+         for (; k < nk; k += bpp) {
+            __m128i b = stbi__png_load_px(prior + k, bpp);
+            __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+            a = _mm_add_epi8(avg, stbi__png_load_px(raw + k, bpp));
+            stbi__png_store_px(cur + k, a, bpp);
+         }
+         return 1;
+      }
+      case STBI__F_paeth: {
+         // same predictor as stbi__paeth in 16-bit lanes, with p-a == b-c,
+         // p-b == a-c and p-c == (b-c)+(a-c); ties favor a, then b
+         __m128i a = _mm_unpacklo_epi8(stbi__png_load_px(cur - bpp, bpp), zero);
+         __m128i c = _mm_unpacklo_epi8(stbi__png_load_px(prior - bpp, bpp), zero);
+         for (; k < nk; k += bpp) {
+            __m128i b = _mm_unpacklo_epi8(stbi__png_load_px(prior + k, bpp), zero);
+            __m128i pa = _mm_sub_epi16(b, c);
+            __m128i pb = _mm_sub_epi16(a, c);
+            __m128i pc = _mm_add_epi16(pa, pb);
+            __m128i smallest, ma, mb, nearest, x;
+            pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+            pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+            pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+            smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+            ma = _mm_cmpeq_epi16(smallest, pa);
+            mb = _mm_cmpeq_epi16(smallest, pb);
+            nearest = _mm_or_si128(_mm_and_si128(mb, b), _mm_andnot_si128(mb, c));
+            nearest = _mm_or_si128(_mm_and_si128(ma, a), _mm_andnot_si128(ma, nearest));
+            x = _mm_add_epi8(_mm_packus_epi16(nearest, nearest), stbi__png_load_px(raw + k, bpp));
+            stbi__png_store_px(cur + k, x, bpp);
+            a = _mm_unpacklo_epi8(x, zero);
+            c = b;
+         }
+         return 1;
+      }
+   }
+   return 0;
+}
+#endif
+
 // create the png data from post-deflated data
 static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 raw_len, int out_n, stbi__uint32 x, stbi__uint32 y, int depth, int color)
 {
@@ -4284,16 +5267,35 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
    stbi__context *s = a->s;
    stbi__uint32 i,j,stride = x*out_n*bytes;
    stbi__uint32 img_len, img_width_bytes;
-   int k;
+   int k, step;
    int img_n = s->img_n; // copy it into a local for later
+   stbi_uc *rows;
 
    int output_bytes = out_n*bytes;
    int filter_bytes = img_n*bytes;
    int width = x;
+#ifdef STBI_SSE2
+   int simd = stbi__sse2_available();
+#ifdef STBI_AVX2
+   int avx2 = simd && stbi__avx2_available();
+#else
+   int avx2 = 0;
+#endif
+#endif
 
    STBI_ASSERT(out_n == s->img_n || out_n == s->img_n+1);
-   a->out = (stbi_uc *) stbi__malloc_mad3(x, y, output_bytes, 0); // extra bytes to write off the end into
-   if (!a->out) return stbi__err("outofmem", "Out of memory");
+   if (a->direct) {
+      // rows are only ever addressed relative to the previous one, so they
+      // can go straight into the caller's buffer at its stride
+      STBI_ASSERT(depth <= 8);
+      rows = stbi__dest_rows(s, x, y, out_n, &step);
+      if (!rows) return 0;
+   } else {
+      a->out = (stbi_uc *) stbi__malloc_mad3(x, y, output_bytes, 0); // extra bytes to write off the end into
+      if (!a->out) return stbi__err("outofmem", "Out of memory");
+      rows = a->out;
+      step = stride;
+   }
 
    img_width_bytes = (((img_n * x * depth) + 7) >> 3);
    img_len = (img_width_bytes + 1) * y;
@@ -4303,7 +5305,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
    if (raw_len < img_len) return stbi__err("not enough pixels","Corrupt PNG");
 
    for (j=0; j < y; ++j) {
-      stbi_uc *cur = a->out + stride*j;
+      stbi_uc *cur = rows + step*(int)j;
       stbi_uc *prior;
       int filter = *raw++;
 
@@ -4316,7 +5318,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          filter_bytes = 1;
          width = img_width_bytes;
       }
-      prior = cur - stride; // bugfix: need to compute this after 'cur +=' computation above
+      prior = cur - step; // bugfix: need to compute this after 'cur +=' computation above
 
       // if first row, use special filter that doesn't sample previous row
       if (j == 0) filter = first_row_filter[filter];
@@ -4357,10 +5359,15 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
       // this is a little gross, so that we don't switch per-pixel or per-component
       if (depth < 8 || img_n == out_n) {
          int nk = (width - 1)*filter_bytes;
+         int done = 0;
+#ifdef STBI_SSE2
+         if (simd && filter != STBI__F_none)
+            done = stbi__png_unfilter_row_simd(filter, cur, prior, raw, nk, filter_bytes, avx2);
+#endif
          #define STBI__CASE(f) \
              case f:     \
                 for (k=0; k < nk; ++k)
-         switch (filter) {
+         if (!done) switch (filter) {
             // "none" filter turns into a memcpy here; make that explicit.
             case STBI__F_none:         memcpy(cur, raw, nk); break;
             STBI__CASE(STBI__F_sub)          { cur[k] = STBI__BYTECAST(raw[k] + cur[k-filter_bytes]); } break;
@@ -4392,7 +5399,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          // the loop above sets the high byte of the pixels' alpha, but for
          // 16 bit png files we also need the low byte set. we'll do that here.
          if (depth == 16) {
-            cur = a->out + stride*j; // start at the beginning of the row again
+            cur = rows + step*(int)j; // start at the beginning of the row again
             for (i=0; i < x; ++i,cur+=output_bytes) {
                cur[filter_bytes+1] = 255;
             }
@@ -4405,8 +5412,8 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
    // intefere with filtering but will still be in the cache.
    if (depth < 8) {
       for (j=0; j < y; ++j) {
-         stbi_uc *cur = a->out + stride*j;
-         stbi_uc *in  = a->out + stride*j + x*out_n - img_width_bytes;
+         stbi_uc *cur = rows + step*(int)j;
+         stbi_uc *in  = rows + step*(int)j + x*out_n - img_width_bytes;
          // unpack 1/2/4-bit into a 8-bit buffer. allows us to keep the common 8-bit path optimal at minimal cost for 1/2/4-bit
          // png guarante byte alignment, if width is not multiple of 8/4/2 we'll decode dummy trailing data that will be skipped in the later loop
          stbi_uc scale = (color == 0) ? stbi__depth_scale_table[depth] : 1; // scale grayscale values to 0..255 range
@@ -4455,7 +5462,7 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
          if (img_n != out_n) {
             int q;
             // insert alpha = 255
-            cur = a->out + stride*j;
+            cur = rows + step*(int)j;
             if (img_n == 1) {
                for (q=x-1; q >= 0; --q) {
                   cur[q*2+1] = 255;
@@ -4480,7 +5487,16 @@ static int stbi__create_png_image_raw(stbi__png *a, stbi_uc *raw, stbi__uint32 r
       stbi_uc *cur = a->out;
       stbi__uint16 *cur16 = (stbi__uint16*)cur;
 
-      for(i=0; i < x*y*out_n; ++i,cur16++,cur+=2) {
+      i = 0;
+#ifdef STBI_SSE2
+      if (simd) {
+         for (; i + 8 <= x*y*out_n; i += 8, cur16 += 8, cur += 16) {
+            __m128i v = _mm_loadu_si128((__m128i *) cur);
+            _mm_storeu_si128((__m128i *) cur, _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+         }
+      }
+#endif
+      for(; i < x*y*out_n; ++i,cur16++,cur+=2) {
          *cur16 = (cur[0] << 8) | cur[1];
       }
    }
@@ -4511,7 +5527,7 @@ static int stbi__create_png_image(stbi__png *a, stbi_uc *image_data, stbi__uint3
       if (x && y) {
          stbi__uint32 img_len = ((((a->s->img_n * x * depth) + 7) >> 3) + 1) * y;
          if (!stbi__create_png_image_raw(a, image_data, image_data_len, out_n, x, y, depth, color)) {
-            STBI_FREE(final);
+            stbi__free(final);
             return 0;
          }
          for (j=0; j < y; ++j) {
@@ -4522,7 +5538,7 @@ static int stbi__create_png_image(stbi__png *a, stbi_uc *image_data, stbi__uint3
                       a->out + (j*x+i)*out_bytes, out_bytes);
             }
          }
-         STBI_FREE(a->out);
+         stbi__free(a->out);
          image_data += img_len;
          image_data_len -= img_len;
       }
@@ -4611,7 +5627,7 @@ static int stbi__expand_png_palette(stbi__png *a, stbi_uc *palette, int len, int
          p += 4;
       }
    }
-   STBI_FREE(a->out);
+   stbi__free(a->out);
    a->out = temp_out;
 
    STBI_NOTUSED(len);
@@ -4779,7 +5795,7 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
                while (ioff + c.length > idata_limit)
                   idata_limit *= 2;
                STBI_NOTUSED(idata_limit_old);
-               p = (stbi_uc *) STBI_REALLOC_SIZED(z->idata, idata_limit_old, idata_limit); if (p == NULL) return stbi__err("outofmem", "Out of memory");
+               p = (stbi_uc *) stbi__realloc_sized(z->idata, idata_limit_old, idata_limit); if (p == NULL) return stbi__err("outofmem", "Out of memory");
                z->idata = p;
             }
             if (!stbi__getn(s, z->idata+ioff,c.length)) return stbi__err("outofdata","Corrupt PNG");
@@ -4797,11 +5813,15 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
             raw_len = bpl * s->img_y * s->img_n /* pixels */ + s->img_y /* filter mode per row */;
             z->expanded = (stbi_uc *) stbi_zlib_decode_malloc_guesssize_headerflag((char *) z->idata, ioff, raw_len, (int *) &raw_len, !is_iphone);
             if (z->expanded == NULL) return 0; // zlib should set error
-            STBI_FREE(z->idata); z->idata = NULL;
+            stbi__free(z->idata); z->idata = NULL;
             if ((req_comp == s->img_n+1 && req_comp != 3 && !pal_img_n) || has_trans)
                s->img_out_n = s->img_n+1;
             else
                s->img_out_n = s->img_n;
+            // the passes that follow unfiltering work on the packed image,
+            // so only plain 1..8-bit images can go straight to s->dest
+            z->direct = s->dest && !interlace && z->depth <= 8 && !has_trans && !pal_img_n && !is_iphone &&
+                        (req_comp == 0 || req_comp == s->img_out_n);
             if (!stbi__create_png_image(z, z->expanded, raw_len, s->img_out_n, z->depth, color, interlace)) return 0;
             if (has_trans) {
                if (z->depth == 16) {
@@ -4823,7 +5843,7 @@ static int stbi__parse_png_file(stbi__png *z, int scan, int req_comp)
                // non-paletted image with tRNS -> source image has (constant) alpha
                ++s->img_n;
             }
-            STBI_FREE(z->expanded); z->expanded = NULL;
+            stbi__free(z->expanded); z->expanded = NULL;
             return 1;
          }
 
@@ -4860,7 +5880,10 @@ static void *stbi__do_png(stbi__png *p, int *x, int *y, int *n, int req_comp, st
          ri->bits_per_channel = p->depth;
       result = p->out;
       p->out = NULL;
-      if (req_comp && req_comp != p->s->img_out_n) {
+      if (p->direct) {
+         result = p->s->dest;
+         ri->in_dest = 1;
+      } else if (req_comp && req_comp != p->s->img_out_n) {
          if (ri->bits_per_channel == 8)
             result = stbi__convert_format((unsigned char *) result, p->s->img_out_n, req_comp, p->s->img_x, p->s->img_y);
          else
@@ -4872,9 +5895,9 @@ static void *stbi__do_png(stbi__png *p, int *x, int *y, int *n, int req_comp, st
       *y = p->s->img_y;
       if (n) *n = p->s->img_n;
    }
-   STBI_FREE(p->out);      p->out      = NULL;
-   STBI_FREE(p->expanded); p->expanded = NULL;
-   STBI_FREE(p->idata);    p->idata    = NULL;
+   stbi__free(p->out);      p->out      = NULL;
+   stbi__free(p->expanded); p->expanded = NULL;
+   stbi__free(p->idata);    p->idata    = NULL;
 
    return result;
 }
@@ -4883,6 +5906,7 @@ static void *stbi__png_load(stbi__context *s, int *x, int *y, int *comp, int req
 {
    stbi__png p;
    p.s = s;
+   p.direct = 0;
    return stbi__do_png(&p, x,y,comp,req_comp, ri);
 }
 
@@ -5116,7 +6140,7 @@ static void *stbi__bmp_load(stbi__context *s, int *x, int *y, int *comp, int req
    if (!out) return stbi__errpuc("outofmem", "Out of memory");
    if (info.bpp < 16) {
       int z=0;
-      if (psize == 0 || psize > 256) { STBI_FREE(out); return stbi__errpuc("invalid", "Corrupt BMP"); }
+      if (psize == 0 || psize > 256) { stbi__free(out); return stbi__errpuc("invalid", "Corrupt BMP"); }
       for (i=0; i < psize; ++i) {
          pal[i][2] = stbi__get8(s);
          pal[i][1] = stbi__get8(s);
@@ -5127,7 +6151,7 @@ static void *stbi__bmp_load(stbi__context *s, int *x, int *y, int *comp, int req
       stbi__skip(s, info.offset - 14 - info.hsz - psize * (info.hsz == 12 ? 3 : 4));
       if (info.bpp == 4) width = (s->img_x + 1) >> 1;
       else if (info.bpp == 8) width = s->img_x;
-      else { STBI_FREE(out); return stbi__errpuc("bad bpp", "Corrupt BMP"); }
+      else { stbi__free(out); return stbi__errpuc("bad bpp", "Corrupt BMP"); }
       pad = (-width)&3;
       for (j=0; j < (int) s->img_y; ++j) {
          for (i=0; i < (int) s->img_x; i += 2) {
@@ -5165,7 +6189,7 @@ static void *stbi__bmp_load(stbi__context *s, int *x, int *y, int *comp, int req
             easy = 2;
       }
       if (!easy) {
-         if (!mr || !mg || !mb) { STBI_FREE(out); return stbi__errpuc("bad masks", "Corrupt BMP"); }
+         if (!mr || !mg || !mb) { stbi__free(out); return stbi__errpuc("bad masks", "Corrupt BMP"); }
          // right shift amt to put high bit in position #7
          rshift = stbi__high_bit(mr)-7; rcount = stbi__bitcount(mr);
          gshift = stbi__high_bit(mg)-7; gcount = stbi__bitcount(mg);
@@ -5437,7 +6461,7 @@ static void *stbi__tga_load(stbi__context *s, int *x, int *y, int *comp, int req
          //   load the palette
          tga_palette = (unsigned char*)stbi__malloc_mad2(tga_palette_len, tga_comp, 0);
          if (!tga_palette) {
-            STBI_FREE(tga_data);
+            stbi__free(tga_data);
             return stbi__errpuc("outofmem", "Out of memory");
          }
          if (tga_rgb16) {
@@ -5448,8 +6472,8 @@ static void *stbi__tga_load(stbi__context *s, int *x, int *y, int *comp, int req
                pal_entry += tga_comp;
             }
          } else if (!stbi__getn(s, tga_palette, tga_palette_len * tga_comp)) {
-               STBI_FREE(tga_data);
-               STBI_FREE(tga_palette);
+               stbi__free(tga_data);
+               stbi__free(tga_palette);
                return stbi__errpuc("bad palette", "Corrupt TGA");
          }
       }
@@ -5530,7 +6554,7 @@ static void *stbi__tga_load(stbi__context *s, int *x, int *y, int *comp, int req
       //   clear my palette, if I had one
       if ( tga_palette != NULL )
       {
-         STBI_FREE( tga_palette );
+         stbi__free( tga_palette );
       }
    }
 
@@ -5718,7 +6742,7 @@ static void *stbi__psd_load(stbi__context *s, int *x, int *y, int *comp, int req
          } else {
             // Read the RLE data.
             if (!stbi__psd_decode_rle(s, p, pixelCount)) {
-               STBI_FREE(out);
+               stbi__free(out);
                return stbi__errpuc("corrupt", "bad RLE data");
             }
          }
@@ -6005,7 +7029,7 @@ static void *stbi__pic_load(stbi__context *s,int *px,int *py,int *comp,int req_c
    memset(result, 0xff, x*y*4);
 
    if (!stbi__pic_load_core(s,x,y,comp, result)) {
-      STBI_FREE(result);
+      stbi__free(result);
       result=0;
    }
    *px = x;
@@ -6112,13 +7136,13 @@ static int stbi__gif_info_raw(stbi__context *s, int *x, int *y, int *comp)
 {
    stbi__gif* g = (stbi__gif*) stbi__malloc(sizeof(stbi__gif));
    if (!stbi__gif_header(s, g, comp, 1)) {
-      STBI_FREE(g);
+      stbi__free(g);
       stbi__rewind( s );
       return 0;
    }
    if (x) *x = g->w;
    if (y) *y = g->h;
-   STBI_FREE(g);
+   stbi__free(g);
    return 1;
 }
 
@@ -6387,8 +7411,8 @@ static void *stbi__gif_load(stbi__context *s, int *x, int *y, int *comp, int req
          u = stbi__convert_format(u, 4, req_comp, g->w, g->h);
    }
    else if (g->out)
-      STBI_FREE(g->out);
-   STBI_FREE(g);
+      stbi__free(g->out);
+   stbi__free(g);
    return u;
 }
 
@@ -6557,16 +7581,16 @@ static float *stbi__hdr_load(stbi__context *s, int *x, int *y, int *comp, int re
             stbi__hdr_convert(hdr_data, rgbe, req_comp);
             i = 1;
             j = 0;
-            STBI_FREE(scanline);
+            stbi__free(scanline);
             goto main_decode_loop; // yes, this makes no sense
          }
          len <<= 8;
          len |= stbi__get8(s);
-         if (len != width) { STBI_FREE(hdr_data); STBI_FREE(scanline); return stbi__errpf("invalid decoded scanline length", "corrupt HDR"); }
+         if (len != width) { stbi__free(hdr_data); stbi__free(scanline); return stbi__errpf("invalid decoded scanline length", "corrupt HDR"); }
          if (scanline == NULL) {
             scanline = (stbi_uc *) stbi__malloc_mad2(width, 4, 0);
             if (!scanline) {
-               STBI_FREE(hdr_data);
+               stbi__free(hdr_data);
                return stbi__errpf("outofmem", "Out of memory");
             }
          }
@@ -6580,12 +7604,12 @@ static float *stbi__hdr_load(stbi__context *s, int *x, int *y, int *comp, int re
                   // Run
                   value = stbi__get8(s);
                   count -= 128;
-                  if (count > nleft) { STBI_FREE(hdr_data); STBI_FREE(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
+                  if (count > nleft) { stbi__free(hdr_data); stbi__free(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
                   for (z = 0; z < count; ++z)
                      scanline[i++ * 4 + k] = value;
                } else {
                   // Dump
-                  if (count > nleft) { STBI_FREE(hdr_data); STBI_FREE(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
+                  if (count > nleft) { stbi__free(hdr_data); stbi__free(scanline); return stbi__errpf("corrupt", "bad RLE data in HDR"); }
                   for (z = 0; z < count; ++z)
                      scanline[i++ * 4 + k] = stbi__get8(s);
                }
@@ -6595,7 +7619,7 @@ static float *stbi__hdr_load(stbi__context *s, int *x, int *y, int *comp, int re
             stbi__hdr_convert(hdr_data+(j*width + i)*req_comp, scanline + i*4, req_comp);
       }
       if (scanline)
-         STBI_FREE(scanline);
+         stbi__free(scanline);
    }
 
    return hdr_data;